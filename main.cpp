@@ -9,6 +9,7 @@
 #include <iostream>
 #include <vector>
 #include <cfloat>
+#include <cstdio>
 #include <random>
 
 #include "src/ecs/Registry.h"
@@ -25,7 +26,10 @@
 #include "src/ecs/systems/UISystem.h"
 #include "src/ecs/systems/MinimapSystem.h"
 #include "src/ecs/systems/CinematicSystem.h"
+#include "src/ecs/systems/LODSystem.h"
+#include "src/ecs/systems/VertexAnimationSystem.h"
 #include "src/assets/AssetLoader.h"
+#include "src/assets/AssetCooker.h"
 #include "src/DebugRenderer.h"
 #include "src/Shader.h"
 #include "src/scenes/SceneManager.h"
@@ -39,6 +43,7 @@
 #include "src/scenes/impl/PauseMenuScene.h"
 #include "src/scenes/impl/YouDiedScene.h"
 #include "src/scenes/impl/DeathCinematicScene.h"
+#include "src/scenes/impl/BenchmarkScene.h"
 #include "src/systems/MonsterManager.h"
 #include "src/procedural/BuildingGenerator.h"
 #include "src/core/GameConfig.h"
@@ -47,13 +52,40 @@
 #include "src/culling/BuildingCuller.h"
 #include "src/core/AssetManager.h"
 #include "src/rendering/RenderPipeline.h"
+#include "src/rendering/LodSelection.h"
 #include "src/core/ConfigLoader.h"
+#include "src/core/CpuProfiler.h"
+#include "src/core/BenchmarkRecorder.h"
 
 int main(int argc, char* argv[]) {
     ConfigLoader::load("config.xml");
+    ConfigLoader::applyCommandLine(argc, argv);
+
+    // Offline cook step: no window or GL context needed
+    if (GameConfig::COOK_ASSETS) {
+        CookOptions options;
+        options.compressTextures = (GameConfig::TEXTURE_COMPRESSION != "none");
+        options.bc7 = (GameConfig::TEXTURE_COMPRESSION == "bc7");
+        options.compressAnimations = GameConfig::COMPRESS_ANIMATIONS;
+        options.animation = configuredAnimationCompression();
+        options.bakeVertexAnimation = GameConfig::VERTEX_ANIMATION;
+        options.vertexAnimationRate = GameConfig::VERTEX_ANIMATION_RATE;
+        return cookAssetPack(modelManifest(), textureManifest(), GameConfig::ASSET_PACK, options) ? 0 : 1;
+    }
+
+    // Startup capture includes window/context creation and asset loading
+    CpuProfiler::instance().setThreadName("Main");
+    if (GameConfig::PROFILE_CAPTURE_FRAMES > 0) {
+        CpuProfiler::instance().requestCapture(GameConfig::PROFILE_CAPTURE_FRAMES, GameConfig::PROFILE_OUTPUT);
+    }
 
     WindowManager windowManager;
-    if (!windowManager.init()) {
+    bool windowReady = false;
+    {
+        CPU_PROFILE_ZONE("WindowManager::init");
+        windowReady = windowManager.init();
+    }
+    if (!windowReady) {
         return -1;
     }
 
@@ -75,9 +107,28 @@ int main(int argc, char* argv[]) {
     SkeletonSystem skeletonSystem;
     PhysicsSystem physicsSystem;
     CollisionSystem collisionSystem;
+    LODSystem lodSystem;
+    VertexAnimationSystem vertexAnimationSystem;
     RenderSystem renderSystem;
     renderSystem.loadShaders();
 
+    // Pose update rate of distant animated entities
+    AnimationLODSettings animationLod;
+    animationLod.enabled = GameConfig::ANIMATION_LOD;
+    animationLod.halfRateSize = GameConfig::ANIMATION_HALF_RATE_SIZE;
+    animationLod.quarterRateSize = GameConfig::ANIMATION_QUARTER_RATE_SIZE;
+    animationLod.frozenSize = GameConfig::ANIMATION_FROZEN_SIZE;
+    animationLod.leafJointSize = GameConfig::ANIMATION_LEAF_JOINT_SIZE;
+    animationSystem.setLODSettings(animationLod);
+    animationSystem.setSharedPosePhases(static_cast<uint32_t>(std::max(GameConfig::ANIMATION_SHARED_POSE_PHASES, 0)));
+
+    // Distant crowd members drawn from baked vertex animation
+    VertexAnimationSettings vertexAnimation;
+    vertexAnimation.enabled = GameConfig::VERTEX_ANIMATION;
+    vertexAnimation.distance = GameConfig::VERTEX_ANIMATION_DISTANCE;
+    vertexAnimation.hysteresis = GameConfig::LOD_HYSTERESIS;
+    vertexAnimationSystem.setSettings(vertexAnimation);
+
     UISystem uiSystem;
     if (!uiSystem.init()) {
         std::cerr << "Failed to initialize UI system" << std::endl;
@@ -122,13 +173,13 @@ int main(int argc, char* argv[]) {
     inputSystem.setWindow(windowManager.window());
 
     // === Protagonist ===
-    LoadedModel& protagonistData = assetManager.getModel("protagonist");
+    // Models stream in while the menu runs: entities are created here and get their
+    // meshes, skeletons and clips once the model is resident (see AssetManager::whenModelResident)
     Entity protagonist = registry.create();
     Transform protagonistTransform;
     protagonistTransform.position = GameConfig::INTRO_CHARACTER_POS;
     protagonistTransform.scale = glm::vec3(GameConfig::PLAYER_SCALE);
     registry.addTransform(protagonist, protagonistTransform);
-    registry.addMeshGroup(protagonist, std::move(protagonistData.meshGroup));
     Renderable protagonistRenderable;
     protagonistRenderable.shader = ShaderType::Skinned;
     protagonistRenderable.meshOffset = glm::vec3(0.0f, -25.0f, 0.0f);
@@ -145,27 +196,26 @@ int main(int argc, char* argv[]) {
     facingDir.turnSpeed = GameConfig::PLAYER_TURN_SPEED;
     registry.addFacingDirection(protagonist, facingDir);
 
-    if (protagonistData.skeleton) {
-        registry.addSkeleton(protagonist, std::move(*protagonistData.skeleton));
+    assetManager.whenModelResident("protagonist", [&registry, protagonist](LoadedModel& protagonistData) {
+        registry.addMeshGroup(protagonist, std::move(protagonistData.meshGroup));
+        if (protagonistData.skeleton) {
+            registry.addSkeleton(protagonist, Skeleton(protagonistData.skeleton));
 
-        // Add animation component with clips (clips now live in component)
-        Animation anim;
-        anim.clipIndex = 0;
-        anim.playing = false;
-        anim.clips = std::move(protagonistData.clips);  // Clips stored in component
-        registry.addAnimation(protagonist, anim);
-    }
-
-    // Get FING building models - high detail and LOD versions
-    LoadedModel& fingBuildingData = assetManager.getModel("fingHighDetail");
-    LoadedModel& fingBuildingLodData = assetManager.getModel("fingLowDetail");
+            // Add animation component referencing the model's shared clips
+            Animation anim;
+            anim.clipIndex = 0;
+            anim.playing = false;
+            anim.clipSet = protagonistData.clips;
+            registry.addAnimation(protagonist, anim);
+        }
+    });
 
-    // Reference mesh groups for LOD switching (owned by AssetManager)
-    MeshGroup& fingHighDetail = fingBuildingData.meshGroup;
-    MeshGroup& fingLowDetail = fingBuildingLodData.meshGroup;
+    // Models referenced by the FING LOD levels (owned by AssetManager, empty until streamed in)
+    LoadedModel& fingHighDetail = assetManager.getModel("fingHighDetail");
+    LoadedModel& fingLowDetail = assetManager.getModel("fingLowDetail");
 
-    // Store model-space bounds for AABB calculation
-    ModelBounds fingModelBounds = fingBuildingData.bounds;
+    // Store model-space bounds for AABB calculation (read from the asset pack ahead of the meshes)
+    ModelBounds fingModelBounds = assetManager.modelBounds("fingHighDetail");
 
     Entity fingBuilding = registry.create();
     Transform fingTransform;
@@ -174,11 +224,32 @@ int main(int argc, char* argv[]) {
     fingTransform.rotation = glm::angleAxis(glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));  // Rotate to stand upright
     fingTransform.scale = glm::vec3(2.5f);  // 2x larger (was 1.25)
     registry.addTransform(fingBuilding, fingTransform);
-    registry.addMeshGroup(fingBuilding, MeshGroup{fingLowDetail.meshes});  // Start with LOD (far away)
     Renderable fingRenderable;
     fingRenderable.shader = ShaderType::Model;  // Non-animated model
     registry.addRenderable(fingBuilding, fingRenderable);
 
+    // FING LOD chain: the full model and its cooked LODs up close, then the hand-made
+    // low detail model from LOD switchDistance on (a camera distance, so it holds at any
+    // render size) and its own cooked LODs. LODSystem skips cooked levels the switch
+    // overtakes. Rebuilt as each model streams in.
+    auto fingLevelOfDetail = [&fingHighDetail, &fingLowDetail, fingModelBounds]() {
+        LevelOfDetail lod = modelLevelOfDetail(fingHighDetail, GameConfig::LOD_ERROR_PIXELS);
+        lod.boundsCenter = fingModelBounds.center();
+        lod.boundsRadius = glm::length(fingModelBounds.halfExtents());
+        lod.levels.push_back({&fingLowDetail.meshGroup, 0.0f, GameConfig::LOD_SWITCH_DISTANCE});
+        for (const ModelLod& level : fingLowDetail.lods) {
+            float screenSize = 2.0f * lod.boundsRadius * GameConfig::LOD_ERROR_PIXELS / level.error;
+            lod.levels.push_back({&level.meshGroup, screenSize});
+        }
+        return lod;
+    };
+    registry.addLevelOfDetail(fingBuilding, fingLevelOfDetail());
+    for (const char* name : {"fingHighDetail", "fingLowDetail"}) {
+        assetManager.whenModelResident(name, [&registry, fingBuilding, fingLevelOfDetail](LoadedModel&) {
+            registry.addLevelOfDetail(fingBuilding, fingLevelOfDetail());
+        });
+    }
+
     // Compute world-space AABB for FING building (apply rotation and scale)
     // Model is rotated -90 around X (Y and Z swap), then scaled
     glm::mat4 fingRotMat = glm::toMat4(fingTransform.rotation);
@@ -204,12 +275,8 @@ int main(int argc, char* argv[]) {
               << " max(" << fingWorldMax.x << ", " << fingWorldMax.y << ", " << fingWorldMax.z << ")"
               << " halfExtents(" << fingWorldHalfExtents.x << ", " << fingWorldHalfExtents.y << ", " << fingWorldHalfExtents.z << ")" << std::endl;
 
-    // LOD settings
-    const float lodSwitchDistance = GameConfig::LOD_SWITCH_DISTANCE;
-
-    // Get comet model for sky effect
-    LoadedModel& cometData = assetManager.getModel("comet");
-    MeshGroup& cometMeshGroup = cometData.meshGroup;
+    // Get comet model for sky effect (instance attributes are added once it is resident)
+    LoadedModel& cometModel = assetManager.getModel("comet");
 
     // === Create NPC entities (2 military, 2 scientist) near GodMode camera start ===
     // GodMode camera starts at (5, 3, 5) looking at -45 yaw (toward origin)
@@ -224,8 +291,6 @@ int main(int argc, char* argv[]) {
     std::vector<std::string> npcModelNames = {"military", "military", "scientist", "scientist"};
 
     for (int i = 0; i < 4; ++i) {
-        LoadedModel& npcModelData = assetManager.getModel(npcModelNames[i]);
-
         Entity npc = registry.create();
         Transform npcTransform;
         npcTransform.position = glm::vec3(npcBaseX + i * npcSpacing, npcY, npcBaseZ);
@@ -234,11 +299,6 @@ int main(int argc, char* argv[]) {
         npcTransform.rotation = glm::angleAxis(glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
         registry.addTransform(npc, npcTransform);
 
-        // Copy the mesh group (don't move it since we may reuse the model)
-        MeshGroup npcMeshGroup;
-        npcMeshGroup.meshes = npcModelData.meshGroup.meshes;
-        registry.addMeshGroup(npc, std::move(npcMeshGroup));
-
         Renderable npcRenderable;
         npcRenderable.shader = ShaderType::Skinned;
         npcRenderable.meshOffset = glm::vec3(0.0f, -25.0f, 0.0f);  // Same as protagonist
@@ -249,42 +309,34 @@ int main(int argc, char* argv[]) {
         npcFacing.yaw = 0.0f;  // Face opposite direction (away from FING)
         registry.addFacingDirection(npc, npcFacing);
 
-        // Add skeleton and animation if the model has them
-        if (npcModelData.skeleton) {
-            // Copy skeleton data
-            Skeleton npcSkeleton = *npcModelData.skeleton;
-            registry.addSkeleton(npc, std::move(npcSkeleton));
-
-            // Add animation component - use dancing animation
-            // Military: index 1, Scientist: index 2
-            Animation anim;
-            anim.clipIndex = (npcModelNames[i] == "military") ? 1 : 2;
-            anim.playing = true;
-            anim.time = 0.0f;
-            anim.clips = npcModelData.clips;
-            registry.addAnimation(npc, anim);
-
-            std::cout << "NPC " << i << " (" << npcModelNames[i] << ") dancing with anim index "
-                      << anim.clipIndex << std::endl;
-        }
+        const std::string& modelName = npcModelNames[i];
+        assetManager.whenModelResident(modelName, [&registry, npc, i, modelName](LoadedModel& npcModelData) {
+            // Reference the model's meshes and cooked LODs (shared by NPCs of the same model)
+            registry.addLevelOfDetail(npc, modelLevelOfDetail(npcModelData, GameConfig::LOD_ERROR_PIXELS));
+
+            // Add skeleton and animation if the model has them
+            if (npcModelData.skeleton) {
+                // Own pose over the model's shared joint hierarchy
+                registry.addSkeleton(npc, Skeleton(npcModelData.skeleton));
+
+                // Add animation component - use dancing animation
+                // Military: index 1, Scientist: index 2
+                Animation anim;
+                anim.clipIndex = (modelName == "military") ? 1 : 2;
+                anim.playing = true;
+                anim.time = 0.0f;
+                anim.clipSet = npcModelData.clips;
+                registry.addAnimation(npc, anim);
+
+                std::cout << "NPC " << i << " (" << modelName << ") dancing with anim index "
+                          << anim.clipIndex << std::endl;
+            }
+        });
 
         npcEntities.push_back(npc);
     }
 
     // === Monster (debug entity near NPCs for GodMode visibility) ===
-    LoadedModel& monsterData = assetManager.getModel("monster");
-    std::cout << "=== MONSTER DEBUG ===" << std::endl;
-    std::cout << "  Meshes: " << monsterData.meshGroup.meshes.size() << std::endl;
-    std::cout << "  Has skeleton: " << (monsterData.skeleton.has_value() ? "YES" : "NO") << std::endl;
-    std::cout << "  Animation clips: " << monsterData.clips.size() << std::endl;
-    std::cout << "  Bounds valid: " << (monsterData.bounds.isValid() ? "YES" : "NO") << std::endl;
-    if (monsterData.bounds.isValid()) {
-        std::cout << "  Bounds min: (" << monsterData.bounds.min.x << ", " << monsterData.bounds.min.y << ", " << monsterData.bounds.min.z << ")" << std::endl;
-        std::cout << "  Bounds max: (" << monsterData.bounds.max.x << ", " << monsterData.bounds.max.y << ", " << monsterData.bounds.max.z << ")" << std::endl;
-        glm::vec3 size = monsterData.bounds.max - monsterData.bounds.min;
-        std::cout << "  Model size: (" << size.x << ", " << size.y << ", " << size.z << ")" << std::endl;
-    }
-
     Entity monster = registry.create();
     Transform monsterTransform;
     // Position near NPCs (at 34, 0, 34) so visible in GodMode
@@ -295,11 +347,6 @@ int main(int argc, char* argv[]) {
     glm::quat rotY = glm::angleAxis(glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
     monsterTransform.rotation = rotY * rotX;
     registry.addTransform(monster, monsterTransform);
-    std::cout << "  Final scale: " << monsterTransform.scale.x << " (PLAYER_SCALE=" << GameConfig::PLAYER_SCALE << ")" << std::endl;
-
-    MeshGroup monsterMeshGroup;
-    monsterMeshGroup.meshes = monsterData.meshGroup.meshes;
-    registry.addMeshGroup(monster, std::move(monsterMeshGroup));
 
     Renderable monsterRenderable;
     monsterRenderable.shader = ShaderType::Skinned;
@@ -310,23 +357,40 @@ int main(int argc, char* argv[]) {
     monsterFacing.yaw = 0.0f;  // Face toward origin (like NPCs)
     registry.addFacingDirection(monster, monsterFacing);
 
-    if (monsterData.skeleton) {
-        Skeleton monsterSkeleton = *monsterData.skeleton;
-        registry.addSkeleton(monster, std::move(monsterSkeleton));
+    // Initialize monster manager; AI monsters spawn once the monster model is resident
+    monsterManager.init(&registry, &assetManager);
 
-        Animation monsterAnim;
-        monsterAnim.clipIndex = 0;  // First animation clip
-        monsterAnim.playing = true;
-        monsterAnim.time = 0.0f;
-        monsterAnim.clips = monsterData.clips;
-        registry.addAnimation(monster, monsterAnim);
+    assetManager.whenModelResident("monster", [&registry, &monsterManager, monster](LoadedModel& monsterData) {
+        std::cout << "=== MONSTER DEBUG ===" << std::endl;
+        std::cout << "  Meshes: " << monsterData.meshGroup.meshes.size() << std::endl;
+        std::cout << "  Has skeleton: " << (monsterData.skeleton ? "YES" : "NO") << std::endl;
+        std::cout << "  Animation clips: " << monsterData.clips->clips.size() << std::endl;
+        std::cout << "  Bounds valid: " << (monsterData.bounds.isValid() ? "YES" : "NO") << std::endl;
+        if (monsterData.bounds.isValid()) {
+            std::cout << "  Bounds min: (" << monsterData.bounds.min.x << ", " << monsterData.bounds.min.y << ", " << monsterData.bounds.min.z << ")" << std::endl;
+            std::cout << "  Bounds max: (" << monsterData.bounds.max.x << ", " << monsterData.bounds.max.y << ", " << monsterData.bounds.max.z << ")" << std::endl;
+            glm::vec3 size = monsterData.bounds.max - monsterData.bounds.min;
+            std::cout << "  Model size: (" << size.x << ", " << size.y << ", " << size.z << ")" << std::endl;
+        }
+        std::cout << "  Final scale: " << registry.getTransform(monster)->scale.x << " (PLAYER_SCALE=" << GameConfig::PLAYER_SCALE << ")" << std::endl;
 
-        std::cout << "Monster entity created with " << monsterData.clips.size() << " animation clips" << std::endl;
-    }
+        registry.addLevelOfDetail(monster, modelLevelOfDetail(monsterData, GameConfig::LOD_ERROR_PIXELS));
 
-    // Initialize monster manager and spawn AI monsters
-    monsterManager.init(&registry, &assetManager);
-    monsterManager.spawnAll(0.12f, 54321);  // 12% density, ~300 monsters in 50x50 area
+        if (monsterData.skeleton) {
+            registry.addSkeleton(monster, Skeleton(monsterData.skeleton));
+
+            Animation monsterAnim;
+            monsterAnim.clipIndex = 0;  // First animation clip
+            monsterAnim.playing = true;
+            monsterAnim.time = 0.0f;
+            monsterAnim.clipSet = monsterData.clips;
+            registry.addAnimation(monster, monsterAnim);
+
+            std::cout << "Monster entity created with " << monsterData.clips->clips.size() << " animation clips" << std::endl;
+        }
+
+        monsterManager.spawnAll(0.12f, 54321);  // 12% density, ~300 monsters in 50x50 area
+    });
 
     // Game state - all runtime variables in one place
     GameState gameState;
@@ -361,7 +425,7 @@ int main(int argc, char* argv[]) {
     // Get building footprints for minimap
     auto buildingFootprints = BuildingGenerator::getBuildingFootprints(buildingDataList);
 
-    // Create ground plane entity using AssetManager's planeVAO
+    // Create ground plane entity using AssetManager's plane mesh
     const float planeSize = GameConfig::GROUND_SIZE;
 
     Entity ground = registry.create();
@@ -369,13 +433,8 @@ int main(int argc, char* argv[]) {
     groundTransform.position = glm::vec3(0.0f, 0.0f, 0.0f);
     registry.addTransform(ground, groundTransform);
 
-    // Create ground mesh using AssetManager's plane VAO
-    GLuint planeVAO = assetManager.primitiveVAOs().planeVAO;
-    Mesh planeMesh;
-    planeMesh.vao = planeVAO;
-    planeMesh.indexCount = 6;
-    planeMesh.indexType = GL_UNSIGNED_SHORT;
-    planeMesh.hasSkinning = false;
+    // Create ground mesh using AssetManager's plane mesh
+    Mesh planeMesh = assetManager.primitiveVAOs().plane;
     planeMesh.texture = snowTexture;
 
     MeshGroup groundMeshGroup;
@@ -507,6 +566,19 @@ int main(int argc, char* argv[]) {
     godModeText.visible = false;
     registry.addUIText(godModeHint, godModeText);
 
+    // Streaming progress (main menu / intro text while models are still loading)
+    Entity loadingText = registry.create();
+    UIText loadingTextData;
+    loadingTextData.text = "LOADING 0%";
+    loadingTextData.fontId = "oxanium";
+    loadingTextData.fontSize = 28;
+    loadingTextData.anchor = AnchorPoint::BottomCenter;
+    loadingTextData.offset = glm::vec2(0.0f, 40.0f);
+    loadingTextData.horizontalAlign = HorizontalAlign::Center;
+    loadingTextData.color = glm::vec4(160.0f, 160.0f, 160.0f, 255.0f);
+    loadingTextData.visible = false;
+    registry.addUIText(loadingText, loadingTextData);
+
     // Death screen UI
     Entity youDiedText = registry.create();
     UIText youDiedTextData;
@@ -714,8 +786,7 @@ int main(int argc, char* argv[]) {
     Shader* cometShader = assetManager.getShader(AssetShader::Comet);
     Shader* depthShader = assetManager.getShader(AssetShader::Depth);
     Shader* skinnedDepthShader = assetManager.getShader(AssetShader::SkinnedDepth);
-    Shader* motionBlurShader = assetManager.getShader(AssetShader::MotionBlur);
-    Shader* toonPostShader = assetManager.getShader(AssetShader::ToonPost);
+    Shader* postProcessShader = assetManager.getShader(AssetShader::PostProcess);
     Shader* blitShader = assetManager.getShader(AssetShader::Blit);
     Shader* overlayShader = assetManager.getShader(AssetShader::Overlay);
     Shader* solidOverlayShader = assetManager.getShader(AssetShader::SolidOverlay);
@@ -735,8 +806,6 @@ int main(int argc, char* argv[]) {
     GLuint motionBlurFBO = renderTargets.motionBlurFBO;
     GLuint motionBlurColorTex = renderTargets.motionBlurColorTex;
     GLuint motionBlurDepthTex = renderTargets.motionBlurDepthTex;
-    GLuint toonFBO = renderTargets.toonFBO;
-    GLuint toonColorTex = renderTargets.toonColorTex;
 
     // Building culling system (octree + frustum + instanced rendering)
     BuildingCuller buildingCuller;
@@ -793,17 +862,23 @@ int main(int argc, char* argv[]) {
     glBufferData(GL_ARRAY_BUFFER, cometInstances.size() * sizeof(glm::vec4), cometInstances.data(), GL_STATIC_DRAW);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    // Setup instance attribute on comet mesh VAO(s)
-    for (auto& mesh : cometMeshGroup.meshes) {
-        glBindVertexArray(mesh.vao);
-        glBindBuffer(GL_ARRAY_BUFFER, cometInstanceVBO);
-        // location 3: instance data (vec4: xyz position, w timeOffset)
-        glEnableVertexAttribArray(3);
-        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void*)0);
-        glVertexAttribDivisor(3, 1);  // One per instance
-        glBindVertexArray(0);
-    }
-    std::cout << "Setup " << NUM_COMETS << " comet instances" << std::endl;
+    // Setup instance attribute on comet mesh VAO(s) once the comet model is resident
+    assetManager.whenModelResident("comet", [cometInstanceVBO, NUM_COMETS](LoadedModel& comet) {
+        auto addInstanceAttribute = [cometInstanceVBO](const MeshGroup& group) {
+            for (const auto& mesh : group.meshes) {
+                glBindVertexArray(mesh.vao);
+                glBindBuffer(GL_ARRAY_BUFFER, cometInstanceVBO);
+                // location 3: instance data (vec4: xyz position, w timeOffset)
+                glEnableVertexAttribArray(3);
+                glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void*)0);
+                glVertexAttribDivisor(3, 1);  // One per instance
+                glBindVertexArray(0);
+            }
+        };
+        addInstanceAttribute(comet.meshGroup);
+        for (const ModelLod& lod : comet.lods) addInstanceAttribute(lod.meshGroup);
+        std::cout << "Setup " << NUM_COMETS << " comet instances" << std::endl;
+    });
 
     // Setup snow particle instances
     const int snowParticleCount = GameConfig::SNOW_PARTICLE_COUNT;
@@ -870,7 +945,7 @@ int main(int argc, char* argv[]) {
     // Timing
     uint64_t prevTime = SDL_GetPerformanceCounter();
     uint64_t frequency = SDL_GetPerformanceFrequency();
-    float aspectRatio = (float)GameConfig::WINDOW_WIDTH / (float)GameConfig::WINDOW_HEIGHT;
+    float aspectRatio = windowManager.aspectRatio();
 
     // Register scenes
     sceneManager.registerScene(SceneType::MainMenu, std::make_unique<MainMenuScene>());
@@ -881,6 +956,7 @@ int main(int argc, char* argv[]) {
     sceneManager.registerScene(SceneType::PauseMenu, std::make_unique<PauseMenuScene>());
     sceneManager.registerScene(SceneType::DeathCinematic, std::make_unique<DeathCinematicScene>());
     sceneManager.registerScene(SceneType::YouDied, std::make_unique<YouDiedScene>());
+    sceneManager.registerScene(SceneType::Benchmark, std::make_unique<BenchmarkScene>());
 
     // Create scene context with all shared resources
     SceneContext sceneCtx;
@@ -903,6 +979,8 @@ int main(int argc, char* argv[]) {
     sceneCtx.cameraOrbitSystem = &cameraOrbitSystem;
     sceneCtx.followCameraSystem = &followCameraSystem;
     sceneCtx.freeCameraSystem = &freeCameraSystem;
+    sceneCtx.lodSystem = &lodSystem;
+    sceneCtx.vertexAnimationSystem = &vertexAnimationSystem;
 
     // Building culling
     sceneCtx.buildingCuller = &buildingCuller;
@@ -920,8 +998,11 @@ int main(int argc, char* argv[]) {
     sceneCtx.cometShader = cometShader;
     sceneCtx.depthShader = depthShader;
     sceneCtx.skinnedDepthShader = skinnedDepthShader;
-    sceneCtx.motionBlurShader = motionBlurShader;
-    sceneCtx.toonPostShader = toonPostShader;
+    sceneCtx.vertexAnimationDepthShader = assetManager.getShader(AssetShader::VertexAnimationDepth);
+    sceneCtx.postProcessShader = postProcessShader;
+    sceneCtx.velocityTileMaxShader = assetManager.getShader(AssetShader::VelocityTileMax);
+    sceneCtx.velocityNeighborMaxShader = assetManager.getShader(AssetShader::VelocityNeighborMax);
+    sceneCtx.frozenFrameShader = assetManager.getShader(AssetShader::FrozenFrame);
     sceneCtx.blitShader = blitShader;
 
     // Textures
@@ -930,7 +1011,7 @@ int main(int argc, char* argv[]) {
     sceneCtx.brickNormalMap = brickNormalMap;
 
     // VAOs
-    sceneCtx.planeVAO = planeVAO;
+    sceneCtx.groundMesh = &planeMesh;
     sceneCtx.overlayVAO = overlayVAO;
     sceneCtx.sunVAO = sunVAO;
 
@@ -944,8 +1025,16 @@ int main(int argc, char* argv[]) {
     sceneCtx.motionBlurFBO = motionBlurFBO;
     sceneCtx.motionBlurColorTex = motionBlurColorTex;
     sceneCtx.motionBlurDepthTex = motionBlurDepthTex;
-    sceneCtx.toonFBO = toonFBO;
-    sceneCtx.toonColorTex = toonColorTex;
+    sceneCtx.velocityFBO = renderTargets.velocityFBO;
+    sceneCtx.velocityTex = renderTargets.velocityTex;
+    sceneCtx.tileMaxFBO = renderTargets.tileMaxFBO;
+    sceneCtx.tileMaxTex = renderTargets.tileMaxTex;
+    sceneCtx.neighborMaxFBO = renderTargets.neighborMaxFBO;
+    sceneCtx.neighborMaxTex = renderTargets.neighborMaxTex;
+    sceneCtx.frozenCaptureFBO = renderTargets.frozenCaptureFBO;
+    sceneCtx.frozenCaptureTex = renderTargets.frozenCaptureTex;
+    sceneCtx.frozenFrameFBO = renderTargets.frozenFrameFBO;
+    sceneCtx.frozenFrameTex = renderTargets.frozenFrameTex;
 
     // Motion blur state
     sceneCtx.prevViewProjection = &prevViewProjection;
@@ -960,15 +1049,13 @@ int main(int argc, char* argv[]) {
     sceneCtx.npcs = npcEntities;
     sceneCtx.monster = monster;
 
-    // FING building LOD
-    sceneCtx.fingHighDetail = &fingHighDetail;
-    sceneCtx.fingLowDetail = &fingLowDetail;
+    // FING building bounds
     sceneCtx.fingWorldCenter = fingWorldCenter;
     sceneCtx.fingWorldHalfExtents = fingWorldHalfExtents;
-    sceneCtx.lodSwitchDistance = lodSwitchDistance;
 
     // Comet data
-    sceneCtx.cometMeshGroup = &cometMeshGroup;
+    sceneCtx.cometModel = &cometModel;
+    sceneCtx.cometInstances = &cometInstances;
     sceneCtx.numComets = NUM_COMETS;
     sceneCtx.cometFallSpeed = COMET_FALL_SPEED;
     sceneCtx.cometCycleTime = COMET_CYCLE_TIME;
@@ -987,9 +1074,6 @@ int main(int argc, char* argv[]) {
     sceneCtx.dangerZoneShader = assetManager.getShader(AssetShader::DangerZone);
     sceneCtx.dangerZoneVAO = assetManager.primitiveVAOs().dangerZoneVAO;
 
-    // Radial blur for death cinematic
-    sceneCtx.radialBlurShader = assetManager.getShader(AssetShader::RadialBlur);
-
     // Light
     sceneCtx.lightDir = lightDir;
 
@@ -1002,6 +1086,7 @@ int main(int argc, char* argv[]) {
     sceneCtx.menuOption3 = menuOption3;
     sceneCtx.sprintHint = sprintHint;
     sceneCtx.godModeHint = godModeHint;
+    sceneCtx.loadingText = loadingText;
     sceneCtx.pauseFogToggle = pauseFogToggle;
     sceneCtx.pauseSnowToggle = pauseSnowToggle;
     sceneCtx.pauseSnowSpeed = pauseSnowSpeed;
@@ -1024,39 +1109,114 @@ int main(int argc, char* argv[]) {
     RenderPipeline renderPipeline;
     renderPipeline.init(&sceneCtx);
     sceneCtx.renderPipeline = &renderPipeline;
+    sceneCtx.assetManager = &assetManager;
+    renderPipeline.setOutputSize(windowManager.width(), windowManager.height());
+
+    // Benchmark mode starts straight into the camera paths
+    BenchmarkRecorder benchmarkRecorder;
+    if (GameConfig::BENCHMARK) {
+        assetManager.finishStreaming();  // Timings must not include streaming
+        benchmarkRecorder.init();
+        sceneCtx.benchmarkRecorder = &benchmarkRecorder;
+    }
 
     // Initialize the first scene
-    sceneManager.initialize(sceneCtx);
+    sceneManager.initialize(sceneCtx, GameConfig::BENCHMARK ? SceneType::Benchmark : SceneType::MainMenu);
 
     // Game loop
     bool running = true;
+    float idleTime = 0.0f;  // Seconds since last user input
+    int frameNumber = 0;
+
+    const bool dumpFrames = !GameConfig::FRAME_DUMP_DIR.empty() && GameConfig::FRAME_DUMP_INTERVAL > 0;
+    if (dumpFrames) {
+        SDL_CreateDirectory(GameConfig::FRAME_DUMP_DIR.c_str());
+    }
     while (running) {
         uint64_t currentTime = SDL_GetPerformanceCounter();
         float dt = (float)(currentTime - prevTime) / frequency;
         prevTime = currentTime;
+        if (GameConfig::BENCHMARK) {
+            dt = GameConfig::BENCHMARK_TIMESTEP;  // Same simulation every run
+            benchmarkRecorder.beginFrame();
+        }
         gameState.gameTime += dt;
 
         // Poll input events
-        InputState input = inputSystem.pollEvents();
+        InputState input;
+        {
+            CPU_PROFILE_ZONE("Input");
+            input = inputSystem.pollEvents();
+        }
         running = !input.quit && !gameState.shouldQuit;
+        if (input.profilePressed) {
+            CpuProfiler::instance().requestCapture(GameConfig::PROFILE_HOTKEY_FRAMES, GameConfig::PROFILE_OUTPUT);
+        }
 
         // Update context with per-frame data
         sceneCtx.input = input;
         sceneCtx.dt = dt;
 
+        // Models still streaming in get a slice of the frame
+        assetManager.updateStreaming(GameConfig::STREAM_BUDGET_MS);
+
         // Process scene transitions (calls onExit/onEnter)
         sceneManager.processTransitions(sceneCtx);
 
+        // Follow the drawable size (window resize / display scale); targets resize lazily
+        windowManager.updateDrawableSize();
+        renderPipeline.setOutputSize(windowManager.width(), windowManager.height());
+
         // Update and render current scene
         sceneManager.update(sceneCtx);
+        GPU_PROFILE_BEGIN_FRAME();
         sceneManager.render(sceneCtx);
+        GPU_PROFILE_END_FRAME();
+        ++frameNumber;
+        if (GameConfig::BENCHMARK) {
+            benchmarkRecorder.endSubmit();
+        }
 
-        windowManager.swapBuffers();
+        if (dumpFrames && frameNumber % GameConfig::FRAME_DUMP_INTERVAL == 0) {
+            char name[32];
+            snprintf(name, sizeof(name), "/frame_%05d.png", frameNumber);
+            windowManager.saveFramePNG(GameConfig::FRAME_DUMP_DIR + name);
+        }
+
+        {
+            CPU_PROFILE_ZONE("Present");
+            windowManager.swapBuffers();
+        }
+        if (GameConfig::BENCHMARK) {
+            benchmarkRecorder.endFrame();
+        }
+        GLDispatch::endFrame();
+        CpuProfiler::instance().endFrame();
+
+        // The benchmark quits by itself once every run is recorded
+        if (GameConfig::HEADLESS && !GameConfig::BENCHMARK && GameConfig::HEADLESS_FRAMES > 0 && frameNumber >= GameConfig::HEADLESS_FRAMES) {
+            running = false;
+        }
+
+        // Throttle static screens (main menu) once nobody is interacting and nothing is streaming
+        idleTime = input.activity ? 0.0f : idleTime + dt;
+        if (!GameConfig::HEADLESS && sceneManager.allowsIdleThrottle() && GameConfig::MENU_IDLE_FPS > 0.0f &&
+            idleTime >= GameConfig::MENU_IDLE_TIMEOUT && assetManager.streamingFinished()) {
+            float frameTime = (float)(SDL_GetPerformanceCounter() - currentTime) / frequency;
+            float budget = 1.0f / GameConfig::MENU_IDLE_FPS;
+            if (frameTime < budget) {
+                SDL_DelayNS(static_cast<Uint64>((budget - frameTime) * 1e9f));
+            }
+        }
     }
 
+    GLDispatch::printStats(std::cout);
+    CpuProfiler::instance().finishCapture();  // Quit before the requested frame count
+
     // Cleanup (WindowManager handles SDL/GL cleanup automatically)
     uiSystem.cleanup();
     axes.cleanup();
+    benchmarkRecorder.cleanup();
 
     return 0;
 }
@@ -1,6 +1,6 @@
 #version 450 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+layout (location = 0) in vec3 aPos;          // unorm16, relative to the mesh bounds
+layout (location = 1) in vec2 aNormal;       // Octahedral snorm8
 layout (location = 2) in vec2 aTexCoord;
 // Instanced model matrix (takes 4 attribute slots for mat4)
 layout (location = 5) in mat4 aInstanceModel;
@@ -14,16 +14,35 @@ out vec2 vTexCoord;
 out vec3 vFragPos;
 out vec4 vFragPosLightSpace;
 out vec3 vWorldNormal;  // For triplanar mapping
+out vec4 vCurrClip;
+out vec4 vPrevClip;
+
+// Quantized vertex decoding (see VertexFormat.h)
+uniform vec3 uPositionOffset = vec3(0.0);
+uniform vec3 uPositionScale = vec3(1.0);
+
+vec3 decodePosition(vec3 p) { return uPositionOffset + p * uPositionScale; }
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
 
 void main()
 {
     // Use instance model matrix instead of uniform
     mat4 model = aInstanceModel;
-    vec4 worldPos = model * vec4(aPos, 1.0);
+    vec4 worldPos = model * vec4(decodePosition(aPos), 1.0);
     vFragPos = worldPos.xyz;
     vFragPosLightSpace = uLightSpaceMatrix * worldPos;
-    vNormal = mat3(transpose(inverse(model))) * aNormal;
+    vNormal = mat3(transpose(inverse(model))) * octDecode(aNormal);
     vWorldNormal = normalize(vNormal);
     vTexCoord = aTexCoord;
     gl_Position = uProjection * uView * worldPos;
+
+    // Buildings are static: no object motion
+    vCurrClip = gl_Position;
+    vPrevClip = gl_Position;
 }
@@ -1,6 +1,6 @@
 #version 450 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+layout (location = 0) in vec3 aPos;          // unorm16, relative to the mesh bounds
+layout (location = 1) in vec2 aNormal;       // Octahedral snorm8
 layout (location = 2) in vec2 aTexCoord;
 // Instanced: position (xyz) + timeOffset (w)
 layout (location = 3) in vec4 aInstanceData;
@@ -26,6 +26,19 @@ out float vTrailFade; // 0 at head, 1 at tail - for fading the trail
 flat out vec3 vCometCenter; // World position of comet center (flat = no interpolation)
 flat out float vTrailLength; // Total trail length for normalization (flat = no interpolation)
 
+// Quantized vertex decoding (see VertexFormat.h)
+uniform vec3 uPositionOffset = vec3(0.0);
+uniform vec3 uPositionScale = vec3(1.0);
+
+vec3 decodePosition(vec3 p) { return uPositionOffset + p * uPositionScale; }
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
 // Build rotation matrix to align comet's -Z axis with fall direction
 mat3 buildRotationMatrix(vec3 targetDir) {
     // Comet's forward is -Z, so we want -Z to point along targetDir
@@ -43,6 +56,7 @@ mat3 buildRotationMatrix(vec3 targetDir) {
 
 void main()
 {
+    vec3 position = decodePosition(aPos);
     vec3 startPos = aInstanceData.xyz;
     float timeOffset = aInstanceData.w;
 
@@ -53,7 +67,7 @@ void main()
             // Debug: place comet at FIXED world position (not relative to camera)
             // This allows you to walk up to it and inspect the orientation
             vec3 debugPos = vec3(0.0, 3.0, 0.0);  // At origin, 3 units up
-            vec3 scaledPos = aPos * 2.0;  // Fixed size for debug
+            vec3 scaledPos = position * 2.0;  // Fixed size for debug
             worldPos = debugPos + scaledPos;
         } else {
             // Hide other instances in debug mode
@@ -87,7 +101,7 @@ void main()
 
         // Rotate comet to face its own fall direction (nose pointing where it's going)
         mat3 rotation = buildRotationMatrix(instanceFallDir);
-        vec3 rotatedPos = rotation * aPos;
+        vec3 rotatedPos = rotation * position;
 
         // Motion blur trail: stretch vertices along the fall direction (in local rotated space)
         // Vertices with positive Z (tail) get stretched backward more
@@ -112,9 +126,9 @@ void main()
     }
 
     vFragPos = worldPos;
-    vNormal = aNormal;
+    vNormal = octDecode(aNormal);
     vTexCoord = aTexCoord;
-    vLocalPos = aPos;  // Pass local position for axis coloring
+    vLocalPos = position;  // Pass local position for axis coloring
 
     gl_Position = uProjection * uView * vec4(worldPos, 1.0);
 
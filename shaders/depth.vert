@@ -1,9 +1,15 @@
 #version 450 core
-layout (location = 0) in vec3 aPos;
+layout (location = 0) in vec3 aPos;          // unorm16, relative to the mesh bounds
 
 uniform mat4 uModel;
 uniform mat4 uLightSpaceMatrix;
 
+// Quantized vertex decoding (see VertexFormat.h)
+uniform vec3 uPositionOffset = vec3(0.0);
+uniform vec3 uPositionScale = vec3(1.0);
+
+vec3 decodePosition(vec3 p) { return uPositionOffset + p * uPositionScale; }
+
 void main() {
-    gl_Position = uLightSpaceMatrix * uModel * vec4(aPos, 1.0);
+    gl_Position = uLightSpaceMatrix * uModel * vec4(decodePosition(aPos), 1.0);
 }
@@ -0,0 +1,23 @@
+#version 450 core
+// One-time processing of a captured frame used as a still background
+// (pause menu): 3x3 box blur plus darkening
+
+in vec2 vTexCoord;
+out vec4 FragColor;
+
+uniform sampler2D uScreenTexture;
+uniform vec2 uTexelSize;    // 1.0 / capture resolution
+uniform float uBlurRadius;  // Tap spacing in texels (0 = no blur)
+uniform float uDim;         // 0 = unchanged, 1 = black
+
+void main() {
+    vec3 color = vec3(0.0);
+    for (int y = -1; y <= 1; ++y) {
+        for (int x = -1; x <= 1; ++x) {
+            color += texture(uScreenTexture, vTexCoord + vec2(x, y) * uTexelSize * uBlurRadius).rgb;
+        }
+    }
+    color /= 9.0;
+
+    FragColor = vec4(color * (1.0 - uDim), 1.0);
+}
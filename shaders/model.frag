@@ -4,6 +4,8 @@ in vec2 vTexCoord;
 in vec3 vFragPos;
 in vec4 vFragPosLightSpace;
 in vec3 vWorldNormal;
+in vec4 vCurrClip;   // Current clip position
+in vec4 vPrevClip;   // Previous-frame object position, projected with the current camera
 
 uniform sampler2D uTexture;
 uniform sampler2D uNormalMap;
@@ -17,12 +19,17 @@ uniform int uShadowsEnabled;
 uniform int uTriplanarMapping;  // Use world-space UV projection
 uniform float uTextureScale;    // How many world units per texture repeat (default 4.0)
 
+// LOD cross-fade (screen-door): > 0 draws that fraction of the pixels of the
+// incoming level, < 0 the complementary 1 + uLodFade fraction of the outgoing one
+uniform float uLodFade = 0.0;
+
 // Fog parameters (configurable via uniforms, with defaults matching GameConfig)
 uniform vec3 uFogColor;         // Default: vec3(0.5, 0.5, 0.55)
 uniform float uFogDensity;      // Default: 0.02
 uniform float uFogDesaturation; // Default: 0.8
 
-out vec4 FragColor;
+layout (location = 0) out vec4 FragColor;
+layout (location = 1) out vec2 Velocity;  // Object motion in UV units (camera motion is added in post)
 
 // Convert to grayscale for desaturation
 float luminance(vec3 c)
@@ -30,6 +37,14 @@ float luminance(vec3 c)
     return dot(c, vec3(0.299, 0.587, 0.114));
 }
 
+// 4x4 ordered dither threshold in [0, 1)
+float bayer4(ivec2 p)
+{
+    const float m[16] = float[](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0,
+                                3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    return m[(p.y & 3) * 4 + (p.x & 3)] / 16.0;
+}
+
 // Poisson disk samples for smooth shadow sampling
 const vec2 poissonDisk[16] = vec2[](
     vec2(-0.94201624, -0.39906216),
@@ -85,7 +100,8 @@ float calculateShadow(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
 // Perturb normal using normal map sample (tangent space to world space for triplanar)
 vec3 perturbNormalTriplanar(vec3 normalSample, vec3 surfaceNormal, vec3 blendWeights)
 {
-    // Convert from [0,1] to [-1,1]
+    // Convert from [0,1] to [-1,1]. Only .xy is used below, so two-channel (BC5)
+    // normal maps work without reconstructing Z
     vec3 tangentNormal = normalSample * 2.0 - 1.0;
 
     // For triplanar, we blend the normal perturbations based on the dominant axis
@@ -123,6 +139,11 @@ vec3 perturbNormalTriplanar(vec3 normalSample, vec3 surfaceNormal, vec3 blendWei
 
 void main()
 {
+    if (uLodFade != 0.0) {
+        float threshold = bayer4(ivec2(gl_FragCoord.xy));
+        if (uLodFade > 0.0 ? threshold >= uLodFade : threshold < 1.0 + uLodFade) discard;
+    }
+
     vec3 normal = normalize(vNormal);
     vec3 lightDir = normalize(uLightDir);
 
@@ -215,4 +236,5 @@ void main()
     }
 
     FragColor = vec4(finalColor, 1.0);
+    Velocity = (vCurrClip.xy / vCurrClip.w - vPrevClip.xy / vPrevClip.w) * 0.5;
 }
@@ -1,26 +1,48 @@
 #version 450 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+layout (location = 0) in vec3 aPos;          // unorm16, relative to the mesh bounds
+layout (location = 1) in vec2 aNormal;       // Octahedral snorm8
 layout (location = 2) in vec2 aTexCoord;
 
 uniform mat4 uModel;
 uniform mat4 uView;
 uniform mat4 uProjection;
 uniform mat4 uLightSpaceMatrix;
+uniform mat4 uPrevModel;        // Last frame's model matrix (velocity buffer)
+uniform int uVelocityEnabled;
 
 out vec3 vNormal;
 out vec2 vTexCoord;
 out vec3 vFragPos;
 out vec4 vFragPosLightSpace;
 out vec3 vWorldNormal;  // For triplanar mapping
+out vec4 vCurrClip;
+out vec4 vPrevClip;
+
+// Quantized vertex decoding (see VertexFormat.h)
+uniform vec3 uPositionOffset = vec3(0.0);
+uniform vec3 uPositionScale = vec3(1.0);
+
+vec3 decodePosition(vec3 p) { return uPositionOffset + p * uPositionScale; }
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
 
 void main()
 {
-    vec4 worldPos = uModel * vec4(aPos, 1.0);
+    vec3 position = decodePosition(aPos);
+    vec4 worldPos = uModel * vec4(position, 1.0);
     vFragPos = worldPos.xyz;
     vFragPosLightSpace = uLightSpaceMatrix * worldPos;
-    vNormal = mat3(transpose(inverse(uModel))) * aNormal;
+    vNormal = mat3(transpose(inverse(uModel))) * octDecode(aNormal);
     vWorldNormal = normalize(vNormal);  // Normalized world-space normal
     vTexCoord = aTexCoord;
     gl_Position = uProjection * uView * worldPos;
+
+    // Object motion only: previous world position seen through the current camera
+    vCurrClip = gl_Position;
+    vPrevClip = (uVelocityEnabled == 1) ? uProjection * uView * (uPrevModel * vec4(position, 1.0)) : gl_Position;
 }
@@ -0,0 +1,200 @@
+#version 450 core
+
+// Fused post-processing pass: reads the once-resolved scene and writes the
+// final image straight to the default framebuffer.
+// Effects are toggled by uniforms so a single full-screen draw covers
+// toon shading (gameplay), camera motion blur (intro) and radial blur (death).
+
+in vec2 vTexCoord;
+out vec4 FragColor;
+
+uniform sampler2D uColorBuffer;      // Resolved scene color
+uniform sampler2D uDepthBuffer;      // Resolved scene depth (motion blur only)
+uniform vec2 uTexelSize;             // 1.0 / resolution
+
+uniform bool uToonEnabled;
+uniform bool uMotionBlurEnabled;
+uniform bool uRadialBlurEnabled;
+
+// Motion blur: reconstruction filter over a velocity buffer with tile/neighbor max
+// (McGuire et al. 2012, "A Reconstruction Filter for Plausible Motion Blur")
+uniform sampler2D uVelocityBuffer;   // Object motion, UV units
+uniform sampler2D uNeighborMax;      // Max velocity of the 3x3 tile neighborhood
+uniform int uTileSize;               // Render-resolution pixels per velocity tile
+uniform mat4 uPrevViewProjection;
+uniform mat4 uInvViewProjection;
+uniform float uMotionBlurStrength;
+uniform vec2 uNearFar;               // Camera near/far for depth linearization
+uniform int uMaxSamples;
+
+// Radial blur
+uniform float uRadialBlurStrength;
+uniform vec2 uRadialCenter;
+uniform int uNumSamples;
+
+float luminance(vec3 c)
+{
+    return dot(c, vec3(0.299, 0.587, 0.114));
+}
+
+// Sobel edge detection on the resolved scene
+float sobel()
+{
+    float tl = luminance(texture(uColorBuffer, vTexCoord + vec2(-1, -1) * uTexelSize).rgb);
+    float t  = luminance(texture(uColorBuffer, vTexCoord + vec2( 0, -1) * uTexelSize).rgb);
+    float tr = luminance(texture(uColorBuffer, vTexCoord + vec2( 1, -1) * uTexelSize).rgb);
+    float l  = luminance(texture(uColorBuffer, vTexCoord + vec2(-1,  0) * uTexelSize).rgb);
+    float r  = luminance(texture(uColorBuffer, vTexCoord + vec2( 1,  0) * uTexelSize).rgb);
+    float bl = luminance(texture(uColorBuffer, vTexCoord + vec2(-1,  1) * uTexelSize).rgb);
+    float b  = luminance(texture(uColorBuffer, vTexCoord + vec2( 0,  1) * uTexelSize).rgb);
+    float br = luminance(texture(uColorBuffer, vTexCoord + vec2( 1,  1) * uTexelSize).rgb);
+
+    float gx = -tl - 2.0*l - bl + tr + 2.0*r + br;
+    float gy = -tl - 2.0*t - tr + bl + 2.0*b + br;
+
+    return sqrt(gx*gx + gy*gy);
+}
+
+vec2 scaleVelocity(vec2 v)
+{
+    // Scale by blur strength and clamp to ~15% of the screen per frame
+    v *= uMotionBlurStrength;
+    float len = length(v);
+    float maxVelocity = 0.15;
+    return (len > maxVelocity) ? v * (maxVelocity / len) : v;
+}
+
+vec2 pixelVelocity(vec2 uv)
+{
+    // Camera motion from depth reprojection + object motion from the geometry pass
+    float depth = texture(uDepthBuffer, uv).r;
+    vec4 clipPos = vec4(uv * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 worldPos = uInvViewProjection * clipPos;
+    worldPos /= worldPos.w;
+    vec4 prevClipPos = uPrevViewProjection * worldPos;
+    prevClipPos /= prevClipPos.w;
+
+    vec2 velocity = (clipPos.xy - prevClipPos.xy) * 0.5 + texture(uVelocityBuffer, uv).xy;
+    return scaleVelocity(velocity);
+}
+
+float linearDepth(vec2 uv)
+{
+    float z = texture(uDepthBuffer, uv).r * 2.0 - 1.0;
+    return 2.0 * uNearFar.x * uNearFar.y / (uNearFar.y + uNearFar.x - z * (uNearFar.y - uNearFar.x));
+}
+
+// Sample y is in front of x (soft comparison, view-space units)
+float softDepthCompare(float zFront, float zBack)
+{
+    return clamp(1.0 - (zFront - zBack) / 0.5, 0.0, 1.0);
+}
+
+float cone(float dist, float velocityLen)
+{
+    return clamp(1.0 - dist / velocityLen, 0.0, 1.0);
+}
+
+float cylinder(float dist, float velocityLen)
+{
+    return 1.0 - smoothstep(0.95 * velocityLen, 1.05 * velocityLen, dist);
+}
+
+vec3 motionBlur()
+{
+    vec3 centerColor = texture(uColorBuffer, vTexCoord).rgb;
+    vec2 pixelSize = 1.0 / uTexelSize;
+
+    // Early-out: nothing in this tile or its neighbors moves more than half a pixel
+    ivec2 tile = min(ivec2(vTexCoord * pixelSize) / uTileSize, textureSize(uNeighborMax, 0) - 1);
+    vec2 vn = scaleVelocity(texelFetch(uNeighborMax, tile, 0).xy);
+    float vnLenPx = length(vn * pixelSize);
+    if (vnLenPx < 0.5) {
+        return centerColor;
+    }
+
+    // Sample count scales with local motion (about one sample per 2 pixels of blur)
+    int numSamples = clamp(int(ceil(vnLenPx * 0.5)), 3, uMaxSamples);
+
+    vec2 vx = pixelVelocity(vTexCoord);
+    float vxLenPx = max(length(vx * pixelSize), 0.5);
+    float zx = linearDepth(vTexCoord);
+
+    // Fade blur near screen edges to avoid artifacts
+    vec2 edgeDist = min(vTexCoord, vec2(1.0) - vTexCoord);
+    float edgeFade = smoothstep(0.0, 0.1, min(edgeDist.x, edgeDist.y));
+    vn *= edgeFade;
+    vnLenPx *= edgeFade;
+
+    float weight = 1.0 / vxLenPx;
+    vec3 sum = centerColor * weight;
+
+    for (int i = 0; i < numSamples; ++i) {
+        // Symmetric samples along the dominant neighborhood velocity
+        float t = mix(-0.5, 0.5, (float(i) + 0.5) / float(numSamples));
+        vec2 sampleUV = clamp(vTexCoord + vn * t, vec2(0.001), vec2(0.999));
+
+        float dist = abs(t) * vnLenPx;
+        float zy = linearDepth(sampleUV);
+        float vyLenPx = max(length(pixelVelocity(sampleUV) * pixelSize), 0.5);
+
+        float f = softDepthCompare(zy, zx);   // sample in front: it blurs over us
+        float b = softDepthCompare(zx, zy);   // sample behind: we blur over it
+        float w = f * cone(dist, vyLenPx) +
+                  b * cone(dist, vxLenPx) +
+                  cylinder(dist, vyLenPx) * cylinder(dist, vxLenPx) * 2.0;
+
+        weight += w;
+        sum += texture(uColorBuffer, sampleUV).rgb * w;
+    }
+
+    return sum / weight;
+}
+
+vec3 radialBlur(vec2 uv)
+{
+    vec2 dir = uv - uRadialCenter;
+    float dist = length(dir);
+
+    // Blur increases with distance from center (tunnel vision effect)
+    float blurAmount = dist * uRadialBlurStrength * 0.1;
+
+    vec3 color = vec3(0.0);
+    float totalWeight = 0.0;
+    for (int i = 0; i < uNumSamples; ++i) {
+        float t = float(i) / float(uNumSamples - 1) - 0.5;
+        vec2 sampleUV = clamp(uv - dir * t * blurAmount, vec2(0.001), vec2(0.999));
+
+        // Center samples weigh more (sharper)
+        float weight = 1.0 - abs(t);
+        color += texture(uColorBuffer, sampleUV).rgb * weight;
+        totalWeight += weight;
+    }
+    color /= totalWeight;
+
+    // Vignette: up to 80% black at the edges
+    float vignetteStrength = smoothstep(0.2, 0.8, dist) * 0.8;
+    return mix(color, vec3(0.0), vignetteStrength);
+}
+
+void main()
+{
+    vec3 color;
+    if (uMotionBlurEnabled) {
+        color = motionBlur();
+    } else if (uRadialBlurEnabled) {
+        color = radialBlur(vTexCoord);
+    } else {
+        color = texture(uColorBuffer, vTexCoord).rgb;
+    }
+
+    if (uToonEnabled) {
+        // Comic book style: white paper with black ink strokes
+        float inkLine = smoothstep(0.15, 0.4, sobel());
+        float paper = smoothstep(0.02, 0.15, luminance(color));
+        paper = mix(paper, 1.0, 0.7);
+        color = vec3(paper * (1.0 - inkLine));
+    }
+
+    FragColor = vec4(color, 1.0);
+}
@@ -1,9 +1,9 @@
 #version 450 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+layout (location = 0) in vec3 aPos;          // unorm16, relative to the mesh bounds
+layout (location = 1) in vec2 aNormal;       // Octahedral snorm8
 layout (location = 2) in vec2 aTexCoord;
-layout (location = 3) in vec4 aJoints;
-layout (location = 4) in vec4 aWeights;
+layout (location = 3) in uvec4 aJoints;      // uint8 bone indices
+layout (location = 4) in vec4 aWeights;      // unorm8
 
 uniform mat4 uModel;
 uniform mat4 uView;
@@ -11,33 +11,58 @@ uniform mat4 uProjection;
 uniform mat4 uLightSpaceMatrix;
 uniform mat4 uBones[128];
 uniform int uUseSkinning;
+uniform mat4 uPrevModel;        // Last frame's model matrix (velocity buffer)
+uniform int uVelocityEnabled;
+
+// Last frame's skinning matrices; kept in a storage buffer to stay within
+// the default-block uniform limits alongside uBones
+layout (std430, binding = 0) readonly buffer PrevBoneBuffer {
+    mat4 uPrevBones[];
+};
 
 out vec3 vNormal;
 out vec2 vTexCoord;
 out vec3 vFragPos;
 out vec4 vFragPosLightSpace;
 out vec3 vWorldNormal;  // For triplanar mapping (not used for skinned, but needed for shared frag shader)
+out vec4 vCurrClip;
+out vec4 vPrevClip;
+
+// Quantized vertex decoding (see VertexFormat.h)
+uniform vec3 uPositionOffset = vec3(0.0);
+uniform vec3 uPositionScale = vec3(1.0);
+
+vec3 decodePosition(vec3 p) { return uPositionOffset + p * uPositionScale; }
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
 
 void main()
 {
+    vec3 position = decodePosition(aPos);
+    vec3 normal = octDecode(aNormal);
     vec4 skinnedPos;
     vec3 skinnedNormal;
 
     if (uUseSkinning == 1)
     {
         mat4 skinMatrix =
-            aWeights.x * uBones[int(aJoints.x)] +
-            aWeights.y * uBones[int(aJoints.y)] +
-            aWeights.z * uBones[int(aJoints.z)] +
-            aWeights.w * uBones[int(aJoints.w)];
+            aWeights.x * uBones[aJoints.x] +
+            aWeights.y * uBones[aJoints.y] +
+            aWeights.z * uBones[aJoints.z] +
+            aWeights.w * uBones[aJoints.w];
 
-        skinnedPos = skinMatrix * vec4(aPos, 1.0);
-        skinnedNormal = mat3(skinMatrix) * aNormal;
+        skinnedPos = skinMatrix * vec4(position, 1.0);
+        skinnedNormal = mat3(skinMatrix) * normal;
     }
     else
     {
-        skinnedPos = vec4(aPos, 1.0);
-        skinnedNormal = aNormal;
+        skinnedPos = vec4(position, 1.0);
+        skinnedNormal = normal;
     }
 
     vec4 worldPos = uModel * skinnedPos;
@@ -47,4 +72,22 @@ void main()
     vWorldNormal = normalize(vNormal);  // For shared fragment shader compatibility
     vTexCoord = aTexCoord;
     gl_Position = uProjection * uView * worldPos;
+
+    // Object motion only: previous pose/position seen through the current camera
+    vCurrClip = gl_Position;
+    vPrevClip = gl_Position;
+    if (uVelocityEnabled == 1)
+    {
+        vec4 prevPos = vec4(position, 1.0);
+        if (uUseSkinning == 1)
+        {
+            mat4 prevSkinMatrix =
+                aWeights.x * uPrevBones[aJoints.x] +
+                aWeights.y * uPrevBones[aJoints.y] +
+                aWeights.z * uPrevBones[aJoints.z] +
+                aWeights.w * uPrevBones[aJoints.w];
+            prevPos = prevSkinMatrix * prevPos;
+        }
+        vPrevClip = uProjection * uView * (uPrevModel * prevPos);
+    }
 }
@@ -1,8 +1,8 @@
 #version 450 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;      // Not used but required for VAO compatibility
+layout (location = 0) in vec3 aPos;          // unorm16, relative to the mesh bounds
+layout (location = 1) in vec2 aNormal;      // Not used but required for VAO compatibility
 layout (location = 2) in vec2 aTexCoord;    // Not used but required for VAO compatibility
-layout (location = 3) in vec4 aJoints;
+layout (location = 3) in uvec4 aJoints;
 layout (location = 4) in vec4 aWeights;
 
 uniform mat4 uModel;
@@ -10,19 +10,26 @@ uniform mat4 uLightSpaceMatrix;
 uniform mat4 uBones[128];
 uniform int uUseSkinning;
 
+// Quantized vertex decoding (see VertexFormat.h)
+uniform vec3 uPositionOffset = vec3(0.0);
+uniform vec3 uPositionScale = vec3(1.0);
+
+vec3 decodePosition(vec3 p) { return uPositionOffset + p * uPositionScale; }
+
 void main() {
+    vec3 position = decodePosition(aPos);
     vec4 skinnedPos;
 
     if (uUseSkinning == 1) {
         mat4 skinMatrix =
-            aWeights.x * uBones[int(aJoints.x)] +
-            aWeights.y * uBones[int(aJoints.y)] +
-            aWeights.z * uBones[int(aJoints.z)] +
-            aWeights.w * uBones[int(aJoints.w)];
+            aWeights.x * uBones[aJoints.x] +
+            aWeights.y * uBones[aJoints.y] +
+            aWeights.z * uBones[aJoints.z] +
+            aWeights.w * uBones[aJoints.w];
 
-        skinnedPos = skinMatrix * vec4(aPos, 1.0);
+        skinnedPos = skinMatrix * vec4(position, 1.0);
     } else {
-        skinnedPos = vec4(aPos, 1.0);
+        skinnedPos = vec4(position, 1.0);
     }
 
     gl_Position = uLightSpaceMatrix * uModel * skinnedPos;
@@ -0,0 +1,31 @@
+#version 450 core
+
+// Velocity neighbor-max: longest tile-max velocity in the 3x3 tile neighborhood,
+// so blur from a fast object can spill into adjacent (static) tiles.
+
+out vec2 NeighborMax;
+
+uniform sampler2D uTileMax;
+
+void main()
+{
+    ivec2 size = textureSize(uTileMax, 0);
+    ivec2 tile = ivec2(gl_FragCoord.xy);
+
+    vec2 maxVelocity = vec2(0.0);
+    float maxLenSq = 0.0;
+    for (int y = -1; y <= 1; ++y) {
+        for (int x = -1; x <= 1; ++x) {
+            ivec2 p = clamp(tile + ivec2(x, y), ivec2(0), size - 1);
+            vec2 v = texelFetch(uTileMax, p, 0).xy;
+
+            float lenSq = dot(v, v);
+            if (lenSq > maxLenSq) {
+                maxLenSq = lenSq;
+                maxVelocity = v;
+            }
+        }
+    }
+
+    NeighborMax = maxVelocity;
+}
@@ -0,0 +1,48 @@
+#version 450 core
+
+// Velocity tile-max: one output texel per uTileSize x uTileSize block of the
+// full-resolution velocity, holding the longest velocity found in the block.
+// Velocity = camera motion (reprojected from depth) + object motion (MRT buffer).
+
+out vec2 TileMax;
+
+uniform sampler2D uVelocityBuffer;   // Object motion, UV units
+uniform sampler2D uDepthBuffer;
+uniform mat4 uPrevViewProjection;
+uniform mat4 uInvViewProjection;
+uniform int uTileSize;
+
+vec2 cameraVelocity(vec2 uv, float depth)
+{
+    vec4 clipPos = vec4(uv * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 worldPos = uInvViewProjection * clipPos;
+    worldPos /= worldPos.w;
+    vec4 prevClipPos = uPrevViewProjection * worldPos;
+    prevClipPos /= prevClipPos.w;
+    return (clipPos.xy - prevClipPos.xy) * 0.5;
+}
+
+void main()
+{
+    ivec2 size = textureSize(uVelocityBuffer, 0);
+    ivec2 base = ivec2(gl_FragCoord.xy) * uTileSize;
+
+    vec2 maxVelocity = vec2(0.0);
+    float maxLenSq = 0.0;
+    for (int y = 0; y < uTileSize; ++y) {
+        for (int x = 0; x < uTileSize; ++x) {
+            ivec2 p = min(base + ivec2(x, y), size - 1);
+            vec2 uv = (vec2(p) + 0.5) / vec2(size);
+            float depth = texelFetch(uDepthBuffer, p, 0).r;
+            vec2 v = cameraVelocity(uv, depth) + texelFetch(uVelocityBuffer, p, 0).xy;
+
+            float lenSq = dot(v, v);
+            if (lenSq > maxLenSq) {
+                maxLenSq = lenSq;
+                maxVelocity = v;
+            }
+        }
+    }
+
+    TileMax = maxVelocity;
+}
@@ -0,0 +1,83 @@
+#version 450 core
+layout (location = 0) in vec3 aPos;          // Bind pose, unused (frames come from uVertexAnimation)
+layout (location = 1) in vec2 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 5) in mat4 aInstanceModel;      // Locations 5-8 (VertexAnimationRenderer)
+layout (location = 9) in mat4 aInstancePrevModel;  // Locations 9-12
+layout (location = 13) in int aInstanceClip;
+layout (location = 14) in vec2 aInstanceTime;      // Clip time, last frame's clip time
+
+uniform mat4 uView;
+uniform mat4 uProjection;
+uniform mat4 uLightSpaceMatrix;
+uniform int uVelocityEnabled;
+
+// Baked frames (see VertexAnimationBaker.h): texel frame * uVertexCount + vertex,
+// xyz unorm16 over the animated bounds, w an octahedral snorm8 normal
+uniform usamplerBuffer uVertexAnimation;
+uniform int uVertexCount;
+uniform vec3 uAnimPositionOffset;
+uniform vec3 uAnimPositionScale;
+uniform vec4 uVertexAnimationClips[16];  // firstFrame, frameCount, duration
+
+out vec3 vNormal;
+out vec2 vTexCoord;
+out vec3 vFragPos;
+out vec4 vFragPosLightSpace;
+out vec3 vWorldNormal;
+out vec4 vCurrClip;
+out vec4 vPrevClip;
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
+void fetchFrame(int frame, out vec3 position, out vec3 normal) {
+    uvec4 texel = texelFetch(uVertexAnimation, frame * uVertexCount + gl_VertexID);
+    position = uAnimPositionOffset + vec3(texel.xyz) / 65535.0 * uAnimPositionScale;
+    int w = int(texel.w);
+    normal = octDecode(clamp(vec2(bitfieldExtract(w, 0, 8), bitfieldExtract(w, 8, 8)) / 127.0, -1.0, 1.0));
+}
+
+// Skinned position and normal at a clip time, blended between the two nearest frames
+void sampleClip(float time, out vec3 position, out vec3 normal) {
+    vec4 clip = uVertexAnimationClips[aInstanceClip];
+    float last = clip.y - 1.0;
+    float frame = clamp(mod(time, clip.z) / clip.z * last, 0.0, last);
+    int f0 = int(frame);
+    int f1 = min(f0 + 1, int(last));
+    float alpha = frame - float(f0);
+
+    vec3 p0, n0, p1, n1;
+    fetchFrame(int(clip.x) + f0, p0, n0);
+    fetchFrame(int(clip.x) + f1, p1, n1);
+    position = mix(p0, p1, alpha);
+    normal = normalize(mix(n0, n1, alpha));
+}
+
+void main()
+{
+    vec3 position, normal;
+    sampleClip(aInstanceTime.x, position, normal);
+
+    vec4 worldPos = aInstanceModel * vec4(position, 1.0);
+    vFragPos = worldPos.xyz;
+    vFragPosLightSpace = uLightSpaceMatrix * worldPos;
+    vNormal = mat3(transpose(inverse(aInstanceModel))) * normal;
+    vWorldNormal = normalize(vNormal);
+    vTexCoord = aTexCoord;
+    gl_Position = uProjection * uView * worldPos;
+
+    // Object motion only, as in skinned.vert
+    vCurrClip = gl_Position;
+    vPrevClip = gl_Position;
+    if (uVelocityEnabled == 1)
+    {
+        vec3 prevPosition, prevNormal;
+        sampleClip(aInstanceTime.y, prevPosition, prevNormal);
+        vPrevClip = uProjection * uView * (aInstancePrevModel * vec4(prevPosition, 1.0));
+    }
+}
@@ -0,0 +1,30 @@
+#version 450 core
+layout (location = 0) in vec3 aPos;          // Not used but required for VAO compatibility
+layout (location = 5) in mat4 aInstanceModel;  // Locations 5-8 (VertexAnimationRenderer)
+layout (location = 13) in int aInstanceClip;
+layout (location = 14) in vec2 aInstanceTime;  // Clip time, last frame's clip time
+
+uniform mat4 uLightSpaceMatrix;
+
+// Baked frames, as in vertex_animation.vert
+uniform usamplerBuffer uVertexAnimation;
+uniform int uVertexCount;
+uniform vec3 uAnimPositionOffset;
+uniform vec3 uAnimPositionScale;
+uniform vec4 uVertexAnimationClips[16];  // firstFrame, frameCount, duration
+
+vec3 fetchPosition(int frame) {
+    uvec4 texel = texelFetch(uVertexAnimation, frame * uVertexCount + gl_VertexID);
+    return uAnimPositionOffset + vec3(texel.xyz) / 65535.0 * uAnimPositionScale;
+}
+
+void main() {
+    vec4 clip = uVertexAnimationClips[aInstanceClip];
+    float last = clip.y - 1.0;
+    float frame = clamp(mod(aInstanceTime.x, clip.z) / clip.z * last, 0.0, last);
+    int f0 = int(frame);
+    int f1 = min(f0 + 1, int(last));
+    vec3 position = mix(fetchPosition(int(clip.x) + f0), fetchPosition(int(clip.x) + f1), frame - float(f0));
+
+    gl_Position = uLightSpaceMatrix * aInstanceModel * vec4(position, 1.0);
+}
@@ -155,6 +155,14 @@ void Shader::setVec4(const char* name, const glm::vec4& vec) const
     glUniform4fv(getUniformLocation(name), 1, glm::value_ptr(vec));
 }
 
+void Shader::setVec4Array(const char* name, const std::vector<glm::vec4>& vecs) const
+{
+    if (!vecs.empty())
+    {
+        glUniform4fv(getUniformLocation(name), static_cast<GLsizei>(vecs.size()), glm::value_ptr(vecs[0]));
+    }
+}
+
 void Shader::setInt(const char* name, int value) const
 {
     glUniform1i(getUniformLocation(name), value);
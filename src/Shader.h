@@ -28,6 +28,7 @@ public:
     void setVec2(const char* name, const glm::vec2& vec) const;
     void setVec3(const char* name, const glm::vec3& vec) const;
     void setVec4(const char* name, const glm::vec4& vec) const;
+    void setVec4Array(const char* name, const std::vector<glm::vec4>& vecs) const;
     void setInt(const char* name, int value) const;
     void setFloat(const char* name, float value) const;
 
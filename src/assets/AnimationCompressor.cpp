@@ -0,0 +1,316 @@
+#include "AnimationCompressor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Source sampling, as AnimationSystem does for uncompressed clips: keys are
+// clamped at both ends and blended linearly (slerp for rotations) between
+template <typename T, typename Blend>
+T sampleKeys(const std::vector<float>& times, const std::vector<T>& values, float t, const T& fallback, Blend blend) {
+    if (times.empty() || values.empty()) return fallback;
+    const size_t last = times.size() - 1;
+    if (last == 0 || t <= times[0]) return values[0];
+    if (!(t <= times[last])) return (last < values.size()) ? values[last] : fallback;
+
+    const size_t i = static_cast<size_t>(std::lower_bound(times.begin() + 1, times.end(), t) - times.begin()) - 1;
+    if (i + 1 >= values.size()) return fallback;
+    const float dt = times[i + 1] - times[i];
+    return blend(values[i], values[i + 1], (dt > 0.0f) ? (t - times[i]) / dt : 0.0f);
+}
+
+glm::quat sampleRotation(const AnimationChannel& channel, float t) {
+    return sampleKeys(channel.rotationTimes, channel.rotations, t, glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+                      [](const glm::quat& a, const glm::quat& b, float f) { return glm::slerp(a, b, f); });
+}
+
+glm::vec3 sampleTranslation(const AnimationChannel& channel, float t) {
+    return sampleKeys(channel.translationTimes, channel.translations, t, glm::vec3(0.0f),
+                      [](const glm::vec3& a, const glm::vec3& b, float f) { return glm::mix(a, b, f); });
+}
+
+glm::vec3 sampleScale(const AnimationChannel& channel, float t) {
+    return sampleKeys(channel.scaleTimes, channel.scales, t, glm::vec3(1.0f),
+                      [](const glm::vec3& a, const glm::vec3& b, float f) { return glm::mix(a, b, f); });
+}
+
+// Angle of conj(a) * b, in double and from the ratio of its vector and scalar
+// parts: 1 - dot^2 would bury small angles under float normalization error
+float rotationAngle(const glm::quat& a, const glm::quat& b) {
+    const double w = double(a.w) * b.w + double(a.x) * b.x + double(a.y) * b.y + double(a.z) * b.z;
+    const double x = double(a.w) * b.x - double(a.x) * b.w - double(a.y) * b.z + double(a.z) * b.y;
+    const double y = double(a.w) * b.y + double(a.x) * b.z - double(a.y) * b.w - double(a.z) * b.x;
+    const double z = double(a.w) * b.z - double(a.x) * b.y + double(a.y) * b.x - double(a.z) * b.w;
+    return static_cast<float>(2.0 * std::atan2(std::sqrt(x * x + y * y + z * z), std::abs(w)));
+}
+
+uint16_t quantize(float value, int maxValue) {
+    return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * static_cast<float>(maxValue)));
+}
+
+// Inverse of decodeSmallestThree (Animation.h)
+void encodeSmallestThree(const glm::quat& rotation, uint16_t* key) {
+    constexpr float RANGE = 0.70710678f;
+    const glm::quat q = glm::normalize(rotation);
+    const float c[4] = {q.x, q.y, q.z, q.w};
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (std::abs(c[i]) > std::abs(c[largest])) largest = i;
+    }
+    const float sign = (c[largest] < 0.0f) ? -1.0f : 1.0f;
+    for (int i = 0, k = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        key[k++] = quantize((c[i] * sign / RANGE) * 0.5f + 0.5f, 32767);
+    }
+    key[0] |= static_cast<uint16_t>((largest >> 1) << 15);
+    key[1] |= static_cast<uint16_t>((largest & 1) << 15);
+}
+
+// Range-relative unorm16 key column: fills min/extent and the keys of `column`
+void quantizeVec3Column(const std::vector<glm::vec3>& frames, uint32_t columns, int column,
+                        std::vector<uint16_t>& keys, glm::vec3& minValue, glm::vec3& extent) {
+    minValue = frames[0];
+    glm::vec3 maxValue = frames[0];
+    for (const glm::vec3& v : frames) {
+        minValue = glm::min(minValue, v);
+        maxValue = glm::max(maxValue, v);
+    }
+    extent = maxValue - minValue;
+    for (size_t f = 0; f < frames.size(); ++f) {
+        uint16_t* key = &keys[(f * columns + column) * 3];
+        for (int a = 0; a < 3; ++a) {
+            key[a] = (extent[a] > 0.0f) ? quantize((frames[f][a] - minValue[a]) / extent[a], 65535) : 0;
+        }
+    }
+}
+
+struct TrackFrames {
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> translations;
+    std::vector<glm::vec3> scales;
+};
+
+// Resample + quantize at `rate`. Components that never leave half a tolerance
+// of their first frame become constants (the other half is left for the error
+// that interpolation adds).
+CompressedClip buildClip(const std::vector<const AnimationChannel*>& channels, float duration, float rate,
+                         const AnimationCompression& settings, float translationTolerance) {
+    CompressedClip out;
+    out.frameCount = (duration > 0.0f) ? std::max<uint32_t>(2, static_cast<uint32_t>(std::ceil(duration * rate - 1e-3f)) + 1) : 1;
+    out.sampleRate = (duration > 0.0f) ? static_cast<float>(out.frameCount - 1) / duration : 0.0f;
+
+    std::vector<TrackFrames> frames(channels.size());
+    for (size_t c = 0; c < channels.size(); ++c) {
+        const AnimationChannel& channel = *channels[c];
+        TrackFrames& track = frames[c];
+        for (uint32_t f = 0; f < out.frameCount; ++f) {
+            float t = (f + 1 == out.frameCount) ? duration : static_cast<float>(f) / out.sampleRate;
+            if (out.frameCount == 1) t = 0.0f;
+            track.rotations.push_back(sampleRotation(channel, t));
+            track.translations.push_back(sampleTranslation(channel, t));
+            track.scales.push_back(sampleScale(channel, t));
+        }
+
+        CompressedTrack compressed;
+        compressed.jointIndex = channel.jointIndex;
+        compressed.constantRotation = glm::normalize(track.rotations[0]);
+        compressed.constantTranslation = track.translations[0];
+        compressed.constantScale = track.scales[0];
+
+        float rotationRange = 0.0f, translationRange = 0.0f, scaleRange = 0.0f;
+        for (uint32_t f = 1; f < out.frameCount; ++f) {
+            rotationRange = std::max(rotationRange, rotationAngle(track.rotations[f], track.rotations[0]));
+            translationRange = std::max(translationRange, glm::length(track.translations[f] - track.translations[0]));
+            scaleRange = std::max(scaleRange, glm::length(track.scales[f] - track.scales[0]));
+        }
+        if (rotationRange > settings.rotationTolerance * 0.5f) compressed.rotationColumn = static_cast<int>(out.rotationColumns++);
+        if (translationRange > translationTolerance * 0.5f) compressed.translationColumn = static_cast<int>(out.translationColumns++);
+        if (scaleRange > settings.scaleTolerance * 0.5f) compressed.scaleColumn = static_cast<int>(out.scaleColumns++);
+        out.tracks.push_back(compressed);
+    }
+
+    out.rotationKeys.assign(size_t(out.frameCount) * out.rotationColumns * 3, 0);
+    out.translationKeys.assign(size_t(out.frameCount) * out.translationColumns * 3, 0);
+    out.scaleKeys.assign(size_t(out.frameCount) * out.scaleColumns * 3, 0);
+    for (size_t c = 0; c < out.tracks.size(); ++c) {
+        CompressedTrack& track = out.tracks[c];
+        if (track.rotationColumn >= 0) {
+            for (uint32_t f = 0; f < out.frameCount; ++f) {
+                encodeSmallestThree(frames[c].rotations[f],
+                                    &out.rotationKeys[(size_t(f) * out.rotationColumns + track.rotationColumn) * 3]);
+            }
+        }
+        if (track.translationColumn >= 0) {
+            quantizeVec3Column(frames[c].translations, out.translationColumns, track.translationColumn,
+                               out.translationKeys, track.translationMin, track.translationExtent);
+        }
+        if (track.scaleColumn >= 0) {
+            quantizeVec3Column(frames[c].scales, out.scaleColumns, track.scaleColumn,
+                               out.scaleKeys, track.scaleMin, track.scaleExtent);
+        }
+    }
+    return out;
+}
+
+struct ClipError {
+    float rotation = 0.0f;
+    float translation = 0.0f;
+    float scale = 0.0f;
+};
+
+// Compressed vs source at every source key and at the quarter points between
+// frames, where the corrected nlerp strays furthest from slerp
+ClipError measureError(const CompressedClip& clip, const std::vector<const AnimationChannel*>& channels, float duration) {
+    std::vector<float> times;
+    for (const AnimationChannel* channel : channels) {
+        times.insert(times.end(), channel->rotationTimes.begin(), channel->rotationTimes.end());
+        times.insert(times.end(), channel->translationTimes.begin(), channel->translationTimes.end());
+        times.insert(times.end(), channel->scaleTimes.begin(), channel->scaleTimes.end());
+    }
+    for (uint32_t f = 0; f + 1 < clip.frameCount; ++f) {
+        for (float offset : {0.25f, 0.5f, 0.75f}) {
+            times.push_back((static_cast<float>(f) + offset) / clip.sampleRate);
+        }
+    }
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+
+    ClipError error;
+    for (float t : times) {
+        if (t < 0.0f || t > duration) continue;
+        uint32_t f0, f1;
+        float alpha;
+        compressedFrame(clip, t, f0, f1, alpha);
+        for (size_t c = 0; c < channels.size(); ++c) {
+            glm::quat rotation;
+            glm::vec3 translation, scale;
+            sampleCompressedTrack(clip, clip.tracks[c], f0, f1, alpha, rotation, translation, scale);
+            error.rotation = std::max(error.rotation, rotationAngle(rotation, glm::normalize(sampleRotation(*channels[c], t))));
+            error.translation = std::max(error.translation, glm::length(translation - sampleTranslation(*channels[c], t)));
+            error.scale = std::max(error.scale, glm::length(scale - sampleScale(*channels[c], t)));
+        }
+    }
+    return error;
+}
+
+// Exporters bake keys on a fixed grid that does not always divide the clip
+// exactly (e.g. 30.0005 Hz). Resampling next to such a grid puts every frame
+// between two source keys, so when the median key spacing is within 10% of
+// `rate` the rate is snapped onto it instead.
+float alignedRate(const std::vector<const AnimationChannel*>& channels, float duration, float rate) {
+    std::vector<float> intervals;
+    for (const AnimationChannel* channel : channels) {
+        for (const std::vector<float>* times : {&channel->rotationTimes, &channel->translationTimes, &channel->scaleTimes}) {
+            for (size_t i = 1; i < times->size(); ++i) intervals.push_back((*times)[i] - (*times)[i - 1]);
+        }
+    }
+    if (intervals.empty() || duration <= 0.0f) return rate;
+    std::nth_element(intervals.begin(), intervals.begin() + intervals.size() / 2, intervals.end());
+    const float spacing = intervals[intervals.size() / 2];
+    if (spacing <= 0.0f || std::abs(1.0f / spacing - rate) > 0.1f * rate) return rate;
+    return std::max(std::round(duration / spacing), 1.0f) / duration;
+}
+
+size_t sourceBytes(const AnimationClip& clip) {
+    size_t bytes = 0;
+    for (const AnimationChannel& channel : clip.channels) {
+        bytes += (channel.translationTimes.size() + channel.rotationTimes.size() + channel.scaleTimes.size()) * sizeof(float);
+        bytes += channel.translations.size() * sizeof(glm::vec3) + channel.scales.size() * sizeof(glm::vec3);
+        bytes += channel.rotations.size() * sizeof(glm::quat);
+    }
+    return bytes;
+}
+
+} // anonymous namespace
+
+float skeletonSize(const SkeletonDef* skeleton) {
+    float size = 0.0f;
+    if (skeleton) {
+        for (const Joint& joint : skeleton->joints) {
+            size = std::max(size, glm::length(glm::vec3(joint.localTransform[3])));
+        }
+    }
+    return (size > 0.0f) ? size : 1.0f;
+}
+
+void sampleClipLocalPose(const AnimationClip& clip, float time, const SkeletonDef& skeleton,
+                         std::vector<glm::mat4>& locals) {
+    const int jointCount = static_cast<int>(skeleton.joints.size());
+    locals.resize(skeleton.joints.size());
+    for (int i = 0; i < jointCount; ++i) locals[i] = skeleton.joints[i].localTransform;
+
+    auto compose = [](const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale) {
+        glm::mat4 local = glm::mat4_cast(rotation);  // T * R * S
+        local[0] *= scale.x;
+        local[1] *= scale.y;
+        local[2] *= scale.z;
+        local[3] = glm::vec4(translation, 1.0f);
+        return local;
+    };
+
+    if (clip.isCompressed()) {
+        uint32_t f0, f1;
+        float alpha;
+        compressedFrame(clip.compressed, time, f0, f1, alpha);
+        for (const CompressedTrack& track : clip.compressed.tracks) {
+            if (track.jointIndex < 0 || track.jointIndex >= jointCount) continue;
+            glm::quat rotation;
+            glm::vec3 translation, scale;
+            sampleCompressedTrack(clip.compressed, track, f0, f1, alpha, rotation, translation, scale);
+            locals[track.jointIndex] = compose(translation, rotation, scale);
+        }
+        return;
+    }
+
+    const float t = std::min(std::max(time, 0.0f), clip.duration);
+    for (const AnimationChannel& channel : clip.channels) {
+        if (channel.jointIndex < 0 || channel.jointIndex >= jointCount) continue;
+        locals[channel.jointIndex] = compose(sampleTranslation(channel, t), sampleRotation(channel, t), sampleScale(channel, t));
+    }
+}
+
+CompressedClip compressClip(const AnimationClip& clip, float skeletonSize, const AnimationCompression& settings,
+                            AnimationCompressionStats* stats) {
+    // Tracks in joint order, so a frame's keys are written in the order they are read
+    std::vector<const AnimationChannel*> channels;
+    for (const AnimationChannel& channel : clip.channels) {
+        if (channel.jointIndex >= 0) channels.push_back(&channel);
+    }
+    std::stable_sort(channels.begin(), channels.end(),
+                     [](const AnimationChannel* a, const AnimationChannel* b) { return a->jointIndex < b->jointIndex; });
+
+    const float translationTolerance = settings.translationTolerance * skeletonSize;
+    float rate = alignedRate(channels, clip.duration, std::max(settings.sampleRate, 1.0f));
+    CompressedClip out;
+    ClipError error;
+    for (;;) {
+        out = buildClip(channels, clip.duration, rate, settings, translationTolerance);
+        error = measureError(out, channels, clip.duration);
+        bool withinTolerance = error.rotation <= settings.rotationTolerance &&
+                               error.translation <= translationTolerance && error.scale <= settings.scaleTolerance;
+        if (withinTolerance || clip.duration <= 0.0f || rate * 2.0f > settings.maxSampleRate) break;
+        rate *= 2.0f;
+    }
+
+    if (stats) {
+        stats->sourceBytes += sourceBytes(clip);
+        stats->compressedBytes += out.tracks.size() * sizeof(CompressedTrack) +
+                                  (out.rotationKeys.size() + out.translationKeys.size() + out.scaleKeys.size()) * sizeof(uint16_t);
+        stats->maxRotationError = std::max(stats->maxRotationError, error.rotation);
+        stats->maxTranslationError = std::max(stats->maxTranslationError, error.translation);
+        stats->maxSampleRate = std::max(stats->maxSampleRate, out.sampleRate);
+    }
+    return out;
+}
+
+AnimationCompressionStats compressAnimationClips(std::vector<AnimationClip>& clips, const SkeletonDef* skeleton,
+                                                 const AnimationCompression& settings) {
+    AnimationCompressionStats stats;
+    const float size = skeletonSize(skeleton);
+    for (AnimationClip& clip : clips) {
+        if (clip.isCompressed()) continue;
+        clip.compressed = compressClip(clip, size, settings, &stats);
+        clip.channels = {};
+    }
+    return stats;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "../ecs/components/Animation.h"
+#include "../ecs/components/Skeleton.h"
+#include <cstddef>
+#include <vector>
+
+// Clip compilation (no GL, used by the asset cooker and the .glb fallback):
+// every channel is resampled at one uniform rate, components that stay within
+// tolerance of a single value become constants, and the rest are quantized
+// into the frame-major SoA key arrays of CompressedClip. A clip whose
+// compressed form strays past a tolerance from the source (checked at every
+// source key and between frames) is redone at twice the rate, up to
+// maxSampleRate.
+struct AnimationCompression {
+    float sampleRate = 30.0f;             // Starting resample rate (frames per second)
+    float maxSampleRate = 120.0f;         // Highest rate tried before accepting the error
+    float rotationTolerance = 0.001f;     // Radians
+    float translationTolerance = 0.0001f; // Fraction of the skeleton size (largest bind-pose joint offset)
+    float scaleTolerance = 0.0001f;
+};
+
+struct AnimationCompressionStats {
+    size_t sourceBytes = 0;        // Key times + values of the source channels
+    size_t compressedBytes = 0;    // Tracks + quantized keys
+    float maxRotationError = 0.0f;     // Radians
+    float maxTranslationError = 0.0f;  // Joint-local units
+    float maxSampleRate = 0.0f;        // Highest rate any clip needed
+};
+
+// `skeletonSize` scales translationTolerance (see skeletonSize())
+CompressedClip compressClip(const AnimationClip& clip, float skeletonSize, const AnimationCompression& settings,
+                            AnimationCompressionStats* stats = nullptr);
+
+// Largest bind-pose joint offset from its parent (1 without a skeleton)
+float skeletonSize(const SkeletonDef* skeleton);
+
+// Local joint transforms at `time` (clamped to the clip), as AnimationSystem
+// poses an instance: joints without a track keep their bind pose. Reads
+// compressed clips or source channels.
+void sampleClipLocalPose(const AnimationClip& clip, float time, const SkeletonDef& skeleton,
+                         std::vector<glm::mat4>& locals);
+
+// Compresses every clip in place, dropping its source channels
+AnimationCompressionStats compressAnimationClips(std::vector<AnimationClip>& clips, const SkeletonDef* skeleton,
+                                                 const AnimationCompression& settings);
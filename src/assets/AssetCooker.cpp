@@ -0,0 +1,523 @@
+#include "AssetCooker.h"
+#include "AnimationCompressor.h"
+#include "AssetPack.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "ModelDecoder.h"
+#include "TextureCompressor.h"
+#include "VertexAnimationBaker.h"
+
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// LOD targets as fractions of the full mesh's triangles; meshes below
+// LOD_MIN_TRIANGLES get none (their model's levels reuse the full mesh)
+const std::vector<float> LOD_TRIANGLE_RATIOS = {0.5f, 0.25f, 0.125f};
+constexpr uint32_t LOD_MIN_TRIANGLES = 256;
+
+// Sequential writer; every block starts on an ASSET_PACK_ALIGNMENT boundary
+class PackWriter {
+public:
+    bool open(const std::string& path) {
+        m_out.open(path, std::ios::binary | std::ios::trunc);
+        m_pos = 0;
+        return m_out.good();
+    }
+
+    uint64_t write(const void* data, size_t bytes) {
+        static const char zeros[ASSET_PACK_ALIGNMENT] = {};
+        uint64_t pad = (ASSET_PACK_ALIGNMENT - m_pos % ASSET_PACK_ALIGNMENT) % ASSET_PACK_ALIGNMENT;
+        m_out.write(zeros, static_cast<std::streamsize>(pad));
+        m_pos += pad;
+
+        uint64_t offset = m_pos;
+        if (bytes) m_out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        m_pos += bytes;
+        return offset;
+    }
+
+    template <typename T>
+    uint64_t writeArray(const std::vector<T>& v) { return write(v.data(), v.size() * sizeof(T)); }
+
+    void patch(uint64_t offset, const void* data, size_t bytes) {
+        m_out.seekp(static_cast<std::streamoff>(offset));
+        m_out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        m_out.seekp(static_cast<std::streamoff>(m_pos));
+    }
+
+    uint64_t position() const { return m_pos; }
+    bool close() { m_out.close(); return !m_out.fail(); }
+
+private:
+    std::ofstream m_out;
+    uint64_t m_pos = 0;
+};
+
+void copyName(char* dst, size_t capacity, const std::string& src) {
+    std::memset(dst, 0, capacity);
+    std::memcpy(dst, src.data(), std::min(src.size(), capacity - 1));
+}
+
+struct MipLevel {
+    uint32_t width;
+    uint32_t height;
+    std::vector<unsigned char> pixels;
+};
+
+// Moves tangent-space normals (xyz in RGB) back to unit length after filtering
+void renormalize(std::vector<unsigned char>& pixels, uint32_t comps) {
+    for (size_t i = 0; i + 2 < pixels.size(); i += comps) {
+        glm::vec3 n(pixels[i], pixels[i + 1], pixels[i + 2]);
+        n = n / 127.5f - 1.0f;
+        float len = glm::length(n);
+        if (len < 1e-4f) continue;
+        n = (n / len * 0.5f + 0.5f) * 255.0f + 0.5f;
+        for (int c = 0; c < 3; ++c) {
+            pixels[i + c] = static_cast<unsigned char>(std::min(std::max(n[c], 0.0f), 255.0f));
+        }
+    }
+}
+
+// Full mip chain with a 2x2 box filter (matches glGenerateMipmap on linear
+// formats), in `comps` channels (RGB is widened to opaque RGBA when comps = 4)
+std::vector<MipLevel> buildMipChain(const DecodedTexture& image, uint32_t comps, bool normalMap) {
+    std::vector<MipLevel> levels(1);
+    levels[0].width = image.width;
+    levels[0].height = image.height;
+    if (comps == image.components) {
+        levels[0].pixels = image.pixels;
+    } else {
+        const size_t texels = size_t(image.width) * image.height;
+        levels[0].pixels.resize(texels * comps, 255);
+        for (size_t t = 0; t < texels; ++t) {
+            for (uint32_t c = 0; c < std::min(comps, image.components); ++c) {
+                levels[0].pixels[t * comps + c] = image.pixels[t * image.components + c];
+            }
+        }
+    }
+
+    while (levels.back().width > 1 || levels.back().height > 1) {
+        const MipLevel& prev = levels.back();
+        const uint32_t w = prev.width, h = prev.height;
+        MipLevel next{std::max(w / 2, 1u), std::max(h / 2, 1u), {}};
+        next.pixels.resize(size_t(next.width) * next.height * comps);
+
+        const unsigned char* src = prev.pixels.data();
+        unsigned char* dst = next.pixels.data();
+        for (uint32_t y = 0; y < next.height; ++y) {
+            uint32_t y0 = std::min(y * 2, h - 1), y1 = std::min(y * 2 + 1, h - 1);
+            for (uint32_t x = 0; x < next.width; ++x) {
+                uint32_t x0 = std::min(x * 2, w - 1), x1 = std::min(x * 2 + 1, w - 1);
+                for (uint32_t c = 0; c < comps; ++c) {
+                    uint32_t sum = src[(size_t(y0) * w + x0) * comps + c] + src[(size_t(y0) * w + x1) * comps + c] +
+                                   src[(size_t(y1) * w + x0) * comps + c] + src[(size_t(y1) * w + x1) * comps + c];
+                    dst[(size_t(y) * next.width + x) * comps + c] = static_cast<unsigned char>((sum + 2) / 4);
+                }
+            }
+        }
+        if (normalMap) renormalize(next.pixels, comps);
+        levels.push_back(std::move(next));
+    }
+    return levels;
+}
+
+bool hasTranslucency(const DecodedTexture& image) {
+    if (image.components != 4) return false;
+    for (size_t i = 3; i < image.pixels.size(); i += 4) {
+        if (image.pixels[i] != 255) return true;
+    }
+    return false;
+}
+
+uint32_t chooseFormat(const DecodedTexture& image, bool normalMap, const CookOptions& options) {
+    if (!options.compressTextures) return (image.components == 3) ? PACK_FORMAT_RGB8 : PACK_FORMAT_RGBA8;
+    if (normalMap) return PACK_FORMAT_BC5;
+    if (options.bc7) return PACK_FORMAT_BC7;
+    return hasTranslucency(image) ? PACK_FORMAT_BC3 : PACK_FORMAT_BC1;
+}
+
+// Mip chain, compressed level by level unless options say otherwise
+PackTexture cookTexture(const DecodedTexture& image, bool normalMap, const CookOptions& options, PackWriter& writer) {
+    PackTexture tex{};
+    tex.width = image.width;
+    tex.height = image.height;
+    tex.format = chooseFormat(image, normalMap, options);
+
+    const bool compressed = packFormatCompressed(tex.format);
+    std::vector<MipLevel> levels = buildMipChain(image, compressed ? 4 : image.components, normalMap);
+    std::vector<unsigned char> data;
+    for (const MipLevel& level : levels) {
+        if (compressed) {
+            std::vector<unsigned char> blocks = compressTexture(level.pixels.data(), level.width, level.height, tex.format);
+            data.insert(data.end(), blocks.begin(), blocks.end());
+        } else {
+            data.insert(data.end(), level.pixels.begin(), level.pixels.end());
+        }
+    }
+    tex.mipCount = static_cast<uint32_t>(levels.size());
+    tex.dataSize = data.size();
+    tex.dataOffset = writer.writeArray(data);
+    return tex;
+}
+
+// Reports the triangle-weighted ACMR over all meshes, before and after
+void optimizeModelMeshes(const std::string& name, DecodedModel& model) {
+    double before = 0.0, after = 0.0;
+    uint64_t triangles = 0;
+    for (DecodedMesh& mesh : model.meshes) {
+        MeshOptimizeStats stats = optimizeMesh(mesh);
+        before += double(stats.before.acmr) * stats.triangles;
+        after += double(stats.after.acmr) * stats.triangles;
+        triangles += stats.triangles;
+    }
+    if (triangles == 0) return;
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(3) << before / double(triangles) << " -> " << after / double(triangles);
+    std::cout << "AssetCooker: " << name << " ACMR " << line.str() << " (" << triangles << " triangles, "
+              << VERTEX_CACHE_ANALYZE_SIZE << "-entry FIFO)" << std::endl;
+}
+
+// Builds the LOD index buffers and reports triangles and error per level.
+// Errors of skinned meshes are moved from bind space to the space the
+// skeleton renders them in, so they compare with the model's transform.
+void generateModelLods(const std::string& name, DecodedModel& model) {
+    const float skinScale = model.skeleton ? bindPoseSkinScale(*model.skeleton) : 1.0f;
+    size_t levels = 0;
+    for (DecodedMesh& mesh : model.meshes) {
+        if (mesh.indexCount / 3 < LOD_MIN_TRIANGLES) continue;
+        buildMeshLods(mesh, LOD_TRIANGLE_RATIOS);
+        if (mesh.skinned) {
+            for (DecodedMeshLod& lod : mesh.lods) lod.error *= skinScale;
+        }
+        levels = std::max(levels, mesh.lods.size());
+    }
+    if (levels == 0) return;
+
+    std::ostringstream line;
+    uint64_t full = 0;
+    for (const DecodedMesh& mesh : model.meshes) full += mesh.indexCount / 3;
+    line << full;
+    for (size_t level = 0; level < levels; ++level) {
+        uint64_t triangles = 0;
+        float error = 0.0f;
+        for (const DecodedMesh& mesh : model.meshes) {
+            if (mesh.lods.empty()) {
+                triangles += mesh.indexCount / 3;
+                continue;
+            }
+            const DecodedMeshLod& lod = mesh.lods[std::min(level, mesh.lods.size() - 1)];
+            triangles += lod.indexCount / 3;
+            error = std::max(error, lod.error);
+        }
+        line << " -> " << triangles << " (" << std::setprecision(3) << error << ")";
+    }
+    std::cout << "AssetCooker: " << name << " LODs " << line.str() << " triangles (error)" << std::endl;
+}
+
+// Replaces the source channels by compressed clips and reports the key data
+// size and worst error against the source
+void compressModelAnimations(const std::string& name, DecodedModel& model, const AnimationCompression& settings) {
+    if (model.clips.empty()) return;
+    AnimationCompressionStats stats = compressAnimationClips(model.clips, model.skeleton ? &*model.skeleton : nullptr, settings);
+    std::cout << "AssetCooker: " << name << " clips " << stats.sourceBytes / 1024 << " KB -> "
+              << stats.compressedBytes / 1024 << " KB (" << std::setprecision(3) << stats.maxSampleRate << " Hz, max error "
+              << stats.maxRotationError << " rad, " << stats.maxTranslationError << " units)" << std::endl;
+}
+
+// Samples the (already compressed) clips into per-vertex frames and reports
+// their size and position quantization step
+void bakeModelVertexAnimation(const std::string& name, DecodedModel& model, float frameRate) {
+    VertexAnimationBakeStats stats;
+    if (!bakeVertexAnimation(model, frameRate, &stats)) {
+        std::cerr << "AssetCooker: " << name << " has no skinned clips to bake" << std::endl;
+        return;
+    }
+    std::cout << "AssetCooker: " << name << " vertex animation " << stats.frameCount << " frames ("
+              << std::setprecision(3) << frameRate << " Hz), " << stats.bytes / 1024 << " KB, step "
+              << stats.maxPositionStep << " units" << std::endl;
+}
+
+PackClip writeCompressedClip(const AnimationClip& anim, PackWriter& writer) {
+    const CompressedClip& src = anim.compressed;
+    std::vector<PackCompressedTrack> tracks;
+    for (const CompressedTrack& track : src.tracks) {
+        PackCompressedTrack dst{};
+        dst.jointIndex = track.jointIndex;
+        dst.rotationColumn = track.rotationColumn;
+        dst.translationColumn = track.translationColumn;
+        dst.scaleColumn = track.scaleColumn;
+        const glm::quat& q = track.constantRotation;
+        const float rotation[4] = {q.x, q.y, q.z, q.w};
+        std::memcpy(dst.constantRotation, rotation, sizeof(rotation));
+        std::memcpy(dst.constantTranslation, glm::value_ptr(track.constantTranslation), sizeof(dst.constantTranslation));
+        std::memcpy(dst.constantScale, glm::value_ptr(track.constantScale), sizeof(dst.constantScale));
+        std::memcpy(dst.translationMin, glm::value_ptr(track.translationMin), sizeof(dst.translationMin));
+        std::memcpy(dst.translationExtent, glm::value_ptr(track.translationExtent), sizeof(dst.translationExtent));
+        std::memcpy(dst.scaleMin, glm::value_ptr(track.scaleMin), sizeof(dst.scaleMin));
+        std::memcpy(dst.scaleExtent, glm::value_ptr(track.scaleExtent), sizeof(dst.scaleExtent));
+        tracks.push_back(dst);
+    }
+
+    PackClip clip{};
+    copyName(clip.name, sizeof(clip.name), anim.name);
+    clip.duration = anim.duration;
+    clip.sampleRate = src.sampleRate;
+    clip.frameCount = src.frameCount;
+    clip.trackCount = static_cast<uint32_t>(tracks.size());
+    clip.rotationColumns = src.rotationColumns;
+    clip.translationColumns = src.translationColumns;
+    clip.scaleColumns = src.scaleColumns;
+    clip.tracksOffset = writer.writeArray(tracks);
+    clip.rotationKeysOffset = writer.writeArray(src.rotationKeys);
+    clip.translationKeysOffset = writer.writeArray(src.translationKeys);
+    clip.scaleKeysOffset = writer.writeArray(src.scaleKeys);
+    return clip;
+}
+
+bool cookModel(const ModelSource& source, const CookOptions& options, PackWriter& writer, PackModel& record) {
+    DecodedModel model;
+    if (!decodeGLB(source.path, model)) {
+        std::cerr << "AssetCooker: Failed to load " << source.path << std::endl;
+        return false;
+    }
+    if (options.optimizeMeshes) optimizeModelMeshes(source.name, model);
+    if (options.generateLods) generateModelLods(source.name, model);
+    if (options.compressAnimations) compressModelAnimations(source.name, model, options.animation);
+    if (options.bakeVertexAnimation && source.vertexAnimation) {
+        bakeModelVertexAnimation(source.name, model, options.vertexAnimationRate);
+    }
+
+    std::memset(&record, 0, sizeof(record));
+    copyName(record.name, sizeof(record.name), source.name);
+    SourceStamp stamp;
+    statSourceFile(source.path, stamp);
+    record.sourceSize = stamp.size;
+    record.sourceMtime = stamp.mtime;
+
+    // === Textures (full mip chain) ===
+    std::vector<PackTexture> textures;
+    for (const DecodedTexture& image : model.textures) {
+        textures.push_back(cookTexture(image, image.normalMap, options, writer));
+    }
+
+    // === Skeleton ===
+    std::vector<PackJoint> joints;
+    if (model.skeleton) {
+        const SkeletonDef& skeleton = *model.skeleton;
+        joints.resize(skeleton.joints.size());
+        for (size_t i = 0; i < joints.size(); ++i) {
+            PackJoint& joint = joints[i];
+            std::memset(&joint, 0, sizeof(joint));
+            joint.parentIndex = skeleton.joints[i].parentIndex;
+            std::memcpy(joint.inverseBindMatrix, glm::value_ptr(skeleton.joints[i].inverseBindMatrix), sizeof(joint.inverseBindMatrix));
+            std::memcpy(joint.bindPose, glm::value_ptr(skeleton.joints[i].localTransform), sizeof(joint.bindPose));
+            copyName(joint.name, sizeof(joint.name), skeleton.jointNames[i]);
+        }
+    }
+
+    // === Animations (compressed, or key arrays; quaternions as x, y, z, w) ===
+    std::vector<PackClip> clips;
+    for (const AnimationClip& anim : model.clips) {
+        if (anim.isCompressed()) {
+            clips.push_back(writeCompressedClip(anim, writer));
+            continue;
+        }
+
+        std::vector<PackChannel> channels;
+        for (const AnimationChannel& src : anim.channels) {
+            std::vector<float> rotations;
+            rotations.reserve(src.rotations.size() * 4);
+            for (const glm::quat& q : src.rotations) {
+                rotations.insert(rotations.end(), {q.x, q.y, q.z, q.w});
+            }
+
+            PackChannel ch{};
+            ch.jointIndex = src.jointIndex;
+            ch.translationCount = static_cast<uint32_t>(src.translationTimes.size());
+            ch.rotationCount = static_cast<uint32_t>(src.rotationTimes.size());
+            ch.scaleCount = static_cast<uint32_t>(src.scaleTimes.size());
+            ch.translationTimesOffset = writer.writeArray(src.translationTimes);
+            ch.translationsOffset = writer.writeArray(src.translations);
+            ch.rotationTimesOffset = writer.writeArray(src.rotationTimes);
+            ch.rotationsOffset = writer.writeArray(rotations);
+            ch.scaleTimesOffset = writer.writeArray(src.scaleTimes);
+            ch.scalesOffset = writer.writeArray(src.scales);
+            channels.push_back(ch);
+        }
+
+        PackClip clip{};
+        copyName(clip.name, sizeof(clip.name), anim.name);
+        clip.duration = anim.duration;
+        clip.channelCount = static_cast<uint32_t>(channels.size());
+        clip.channelsOffset = writer.writeArray(channels);
+        clips.push_back(clip);
+    }
+
+    // === Meshes (every mesh gets the model's LOD count; meshes with fewer
+    // levels repeat their coarsest one) ===
+    size_t lodCount = 0;
+    for (const DecodedMesh& src : model.meshes) lodCount = std::max(lodCount, src.lods.size());
+
+    std::vector<PackMesh> meshes;
+    for (const DecodedMesh& src : model.meshes) {
+        PackMesh mesh{};
+        mesh.vertexCount = src.vertexCount();
+        mesh.vertexStride = src.vertexStride();
+        mesh.indexCount = src.indexCount;
+        mesh.indexType = src.indexType;
+        mesh.flags = src.skinned ? PACK_MESH_SKINNED : 0;
+        mesh.textureIndex = src.textureIndex;
+        mesh.verticesOffset = writer.writeArray(src.vertices);
+        mesh.indicesOffset = writer.writeArray(src.indexData);
+        for (int i = 0; i < 3; ++i) {
+            mesh.positionOffset[i] = src.positionOffset[i];
+            mesh.positionScale[i] = src.positionScale[i];
+        }
+        if (!model.vertexAnimation.empty()) {
+            const DecodedVertexAnimationMesh& baked = model.vertexAnimation.meshes[meshes.size()];
+            for (int i = 0; i < 3; ++i) {
+                mesh.animationPositionOffset[i] = baked.positionOffset[i];
+                mesh.animationPositionScale[i] = baked.positionScale[i];
+            }
+            mesh.animationTexelsOffset = writer.writeArray(baked.texels);
+        }
+
+        std::vector<PackMeshLod> lods;
+        for (size_t level = 0; level < lodCount; ++level) {
+            if (level < src.lods.size()) {
+                const DecodedMeshLod& lod = src.lods[level];
+                lods.push_back({writer.writeArray(lod.indexData), lod.indexCount, lod.error});
+            } else {
+                lods.push_back(lods.empty() ? PackMeshLod{mesh.indicesOffset, mesh.indexCount, 0.0f} : lods.back());
+            }
+        }
+        mesh.lodCount = static_cast<uint32_t>(lods.size());
+        mesh.lodsOffset = writer.writeArray(lods);
+        meshes.push_back(mesh);
+    }
+
+    record.meshCount = static_cast<uint32_t>(meshes.size());
+    record.textureCount = static_cast<uint32_t>(textures.size());
+    record.jointCount = static_cast<uint32_t>(joints.size());
+    record.clipCount = static_cast<uint32_t>(clips.size());
+    record.meshesOffset = writer.writeArray(meshes);
+    record.texturesOffset = writer.writeArray(textures);
+    record.jointsOffset = writer.writeArray(joints);
+    record.clipsOffset = writer.writeArray(clips);
+
+    // === Vertex animation: clip table over the meshes' baked frames ===
+    std::vector<PackVertexAnimationClip> bakedClips;
+    for (const VertexAnimationClip& clip : model.vertexAnimation.clips) {
+        bakedClips.push_back({clip.firstFrame, clip.frameCount, clip.duration, 0});
+    }
+    record.vertexAnimationClipCount = static_cast<uint32_t>(bakedClips.size());
+    record.vertexAnimationFrameCount = model.vertexAnimation.frameCount;
+    record.vertexAnimationClipsOffset = writer.writeArray(bakedClips);
+    for (int i = 0; i < 3; ++i) {
+        record.boundsMin[i] = model.boundsMin[i];
+        record.boundsMax[i] = model.boundsMax[i];
+    }
+
+    std::cout << "AssetCooker: " << source.name << " <- " << source.path << " ("
+              << meshes.size() << " meshes, " << textures.size() << " textures, "
+              << joints.size() << " joints, " << clips.size() << " clips)" << std::endl;
+    return true;
+}
+
+bool cookNamedTexture(const TextureSource& source, const CookOptions& options, PackWriter& writer, PackNamedTexture& record) {
+    DecodedTexture image;
+    if (!decodeImageFile(source.path, image)) {
+        std::cerr << "AssetCooker: Failed to load " << source.path << std::endl;
+        return false;
+    }
+
+    std::memset(&record, 0, sizeof(record));
+    copyName(record.name, sizeof(record.name), source.name);
+    SourceStamp stamp;
+    statSourceFile(source.path, stamp);
+    record.sourceSize = stamp.size;
+    record.sourceMtime = stamp.mtime;
+    record.texture = cookTexture(image, source.normalMap, options, writer);
+
+    std::cout << "AssetCooker: " << source.name << " <- " << source.path << " (" << image.width << "x"
+              << image.height << ", " << record.texture.mipCount << " mips, "
+              << (record.texture.dataSize / 1024) << " KB)" << std::endl;
+    return true;
+}
+
+} // anonymous namespace
+
+bool cookAssetPack(const std::vector<ModelSource>& models, const std::vector<TextureSource>& textures,
+                   const std::string& outPath, const CookOptions& options) {
+    const std::string tmpPath = outPath + ".tmp";
+    PackWriter writer;
+    if (!writer.open(tmpPath)) {
+        std::cerr << "AssetCooker: Cannot write " << tmpPath << std::endl;
+        return false;
+    }
+
+    PackHeader header{};
+    writer.write(&header, sizeof(header));  // Patched once the tables are known
+
+    bool ok = true;
+    std::vector<PackModel> records;
+    for (const ModelSource& source : models) {
+        PackModel record;
+        if (cookModel(source, options, writer, record)) {
+            records.push_back(record);
+        } else {
+            ok = false;
+        }
+    }
+
+    std::vector<PackNamedTexture> textureRecords;
+    for (const TextureSource& source : textures) {
+        PackNamedTexture record;
+        if (cookNamedTexture(source, options, writer, record)) {
+            textureRecords.push_back(record);
+        } else {
+            ok = false;
+        }
+    }
+
+    std::memcpy(header.magic, ASSET_PACK_MAGIC, sizeof(header.magic));
+    header.version = ASSET_PACK_VERSION;
+    header.modelCount = static_cast<uint32_t>(records.size());
+    header.modelsOffset = writer.writeArray(records);
+    header.textureCount = static_cast<uint32_t>(textureRecords.size());
+    header.texturesOffset = writer.writeArray(textureRecords);
+    header.fileSize = writer.position();
+    writer.patch(0, &header, sizeof(header));
+    if (!writer.close()) {
+        std::cerr << "AssetCooker: Write to " << tmpPath << " failed" << std::endl;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    {
+        AssetPack check;
+        if (!check.open(tmpPath)) {
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    std::remove(outPath.c_str());
+    if (std::rename(tmpPath.c_str(), outPath.c_str()) != 0) {
+        std::cerr << "AssetCooker: Cannot move " << tmpPath << " to " << outPath << std::endl;
+        return false;
+    }
+    std::cout << "AssetCooker: Wrote " << outPath << " (" << records.size() << "/" << models.size()
+              << " models, " << textureRecords.size() << "/" << textures.size() << " textures, "
+              << (options.compressTextures ? (options.bc7 ? "BC5/BC7" : "BC1/BC3/BC5") : "uncompressed") << ", "
+              << (header.fileSize / (1024 * 1024)) << " MB)" << std::endl;
+    return ok;
+}
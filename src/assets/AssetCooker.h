@@ -0,0 +1,30 @@
+#pragma once
+#include "AnimationCompressor.h"
+#include "ModelManifest.h"
+#include "TextureManifest.h"
+#include <string>
+#include <vector>
+
+struct CookOptions {
+    bool compressTextures = true;  // BC1 (opaque) / BC3 (alpha) colour, BC5 normal maps; false = RGB8/RGBA8
+    bool bc7 = false;              // BC7 instead of BC1/BC3 for colour textures (twice the size of BC1)
+    bool optimizeMeshes = true;    // Vertex cache / overdraw / vertex fetch reordering (MeshOptimizer)
+    bool generateLods = true;      // Simplified index buffers per mesh (MeshSimplifier)
+    bool compressAnimations = true;  // Resampled, quantized clips (AnimationCompressor); false = source keys
+    AnimationCompression animation;
+    bool bakeVertexAnimation = true;     // Per-vertex frames for ModelSource::vertexAnimation models (VertexAnimationBaker)
+    float vertexAnimationRate = 30.0f;   // Baked frames per second
+};
+
+// Offline cook step: decodes each .glb and standalone texture once
+// (ModelDecoder), reorders mesh triangles and vertices (MeshOptimizer),
+// builds LOD index buffers (MeshSimplifier), compresses animation clips
+// (AnimationCompressor), bakes crowd models' clips into vertex animation
+// frames (VertexAnimationBaker), bakes
+// and compresses their mip chains (TextureCompressor) and writes a versioned AssetPack (see AssetPack.h). Uses no GL/SDL, so it
+// runs headless from the game (--cook-assets) or the standalone
+// tools/cook_assets.cpp. The pack is written to a temporary file, re-opened
+// for validation and then moved over outPath. Returns false if any asset
+// failed to cook.
+bool cookAssetPack(const std::vector<ModelSource>& models, const std::vector<TextureSource>& textures,
+                   const std::string& outPath, const CookOptions& options = {});
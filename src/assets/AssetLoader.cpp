@@ -1,471 +1,484 @@
-#define TINYGLTF_IMPLEMENTATION
-#define STB_IMAGE_IMPLEMENTATION
-#define TINYGLTF_NO_STB_IMAGE_WRITE
-#include <tiny_gltf.h>
-
 #include "AssetLoader.h"
-#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include <glm/gtx/quaternion.hpp>
 #include <iostream>
 #include <algorithm>
-#include <map>
+#include <cstddef>
+#include <cstring>
 #include <utility>
 
 namespace {
 
-size_t getComponentByteSize(int componentType) {
-    switch (componentType) {
-        case TINYGLTF_COMPONENT_TYPE_BYTE:
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: return 1;
-        case TINYGLTF_COMPONENT_TYPE_SHORT:
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: return 2;
-        case TINYGLTF_COMPONENT_TYPE_INT:
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
-        case TINYGLTF_COMPONENT_TYPE_FLOAT: return 4;
-        case TINYGLTF_COMPONENT_TYPE_DOUBLE: return 8;
-        default: return 0;
+// Uploads `levels` mip levels (PACK_FORMAT_* layout) stored back to back; a
+// single level gets glGenerateMipmap. With an upload queue only the storage is
+// allocated here and the pixels are streamed.
+GLuint uploadTexture(const unsigned char* data, uint32_t width, uint32_t height, uint32_t format, uint32_t levels,
+                     GpuUploadQueue* uploads) {
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+
+    const bool compressed = packFormatCompressed(format);
+    const GLenum pixelFormat = (format == PACK_FORMAT_RGB8) ? GL_RGB : GL_RGBA;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (uint32_t i = 0; i < levels; ++i) {
+        GLsizei w = std::max<GLsizei>(width >> i, 1);
+        GLsizei h = std::max<GLsizei>(height >> i, 1);
+        uint64_t size = packMipSize(format, width, height, i);
+        if (compressed) {
+            glCompressedTexImage2D(GL_TEXTURE_2D, i, format, w, h, 0, static_cast<GLsizei>(size), uploads ? nullptr : data);
+            if (uploads) uploads->uploadCompressedTexture(textureID, i, w, h, format, data, packRowSize(format, w));
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, i, format, w, h, 0, pixelFormat, GL_UNSIGNED_BYTE, uploads ? nullptr : data);
+            if (uploads) uploads->uploadTexture(textureID, i, w, h, pixelFormat, data, packFormatUnitBytes(format));
+        }
+        data += size;
     }
-}
-
-int getNumComponents(int type) {
-    switch (type) {
-        case TINYGLTF_TYPE_SCALAR: return 1;
-        case TINYGLTF_TYPE_VEC2:   return 2;
-        case TINYGLTF_TYPE_VEC3:   return 3;
-        case TINYGLTF_TYPE_VEC4:   return 4;
-        case TINYGLTF_TYPE_MAT2:   return 4;
-        case TINYGLTF_TYPE_MAT3:   return 9;
-        case TINYGLTF_TYPE_MAT4:   return 16;
-        default: return 0;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    if (levels > 1) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels - 1));
+    } else if (uploads) {
+        uploads->onComplete([textureID] {
+            glBindTexture(GL_TEXTURE_2D, textureID);
+            glGenerateMipmap(GL_TEXTURE_2D);
+        });
+    } else {
+        glGenerateMipmap(GL_TEXTURE_2D);
     }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return textureID;
 }
 
-const unsigned char* getAccessorData(const tinygltf::Model& model, int accessorIndex, size_t& outCount, size_t& outStride) {
-    const auto& accessor = model.accessors[accessorIndex];
-    const auto& bufferView = model.bufferViews[accessor.bufferView];
-    const auto& buffer = model.buffers[bufferView.buffer];
-
-    outCount = accessor.count;
-    outStride = bufferView.byteStride;
-    if (outStride == 0)
-        outStride = getNumComponents(accessor.type) * getComponentByteSize(accessor.componentType);
-
-    return &buffer.data[bufferView.byteOffset + accessor.byteOffset];
+GLuint uploadIndexBuffer(const void* indices, uint32_t indexCount, uint32_t indexType, GpuUploadQueue* uploads) {
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+    GLsizeiptr indexBytes = indexCount * GLsizeiptr((indexType == PACK_INDEX_UINT32) ? 4 : 2);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, uploads ? nullptr : indices, GL_STATIC_DRAW);
+    if (uploads) uploads->uploadBuffer(buffer, indices, indexBytes);
+    return buffer;
 }
 
-glm::mat4 getNodeTransform(const tinygltf::Node& node) {
-    if (!node.matrix.empty()) {
-        return glm::make_mat4(node.matrix.data());
+void printSummary(const LoadedModel& model) {
+    std::cout << "  Total meshes loaded: " << model.meshGroup.meshes.size() << std::endl;
+    if (model.skeleton) {
+        std::cout << "  Loaded skeleton with " << model.skeleton->joints.size() << " joints" << std::endl;
     }
-
-    glm::mat4 T = glm::mat4(1.0f);
-    glm::mat4 R = glm::mat4(1.0f);
-    glm::mat4 S = glm::mat4(1.0f);
-
-    if (!node.translation.empty()) {
-        T = glm::translate(glm::mat4(1.0f), glm::vec3(
-            (float)node.translation[0], (float)node.translation[1], (float)node.translation[2]));
+    if (size_t cpuBytes = cpuGeometryBytes(model)) {
+        std::cout << "  CPU geometry kept: " << cpuBytes / 1024 << " KB" << std::endl;
+    }
+    if (model.vertexAnimation) {
+        std::cout << "  Vertex animation: " << model.vertexAnimation->frameCount << " frames" << std::endl;
     }
-    if (!node.rotation.empty()) {
-        glm::quat q((float)node.rotation[3], (float)node.rotation[0],
-                    (float)node.rotation[1], (float)node.rotation[2]);
-        R = glm::toMat4(q);
+    if (!model.lods.empty()) {
+        std::cout << "  LOD levels: " << model.lods.size() << " (max error " << model.lods.back().error << ")" << std::endl;
     }
-    if (!node.scale.empty()) {
-        S = glm::scale(glm::mat4(1.0f), glm::vec3(
-            (float)node.scale[0], (float)node.scale[1], (float)node.scale[2]));
+    for (const auto& clip : model.clips->clips) {
+        std::cout << "  Animation '" << clip.name << "' duration: " << clip.duration << "s";
+        if (clip.isCompressed()) std::cout << " (" << clip.compressed.frameCount << " frames, compressed)";
+        std::cout << std::endl;
+    }
+    if (model.bounds.isValid()) {
+        const ModelBounds& b = model.bounds;
+        std::cout << "  Bounds: min(" << b.min.x << ", " << b.min.y << ", " << b.min.z << ")"
+                  << " max(" << b.max.x << ", " << b.max.y << ", " << b.max.z << ")" << std::endl;
     }
-    return T * R * S;
 }
 
-std::vector<GLuint> loadTextures(const tinygltf::Model& gltfModel) {
-    std::vector<GLuint> textures;
-    for (const auto& image : gltfModel.images) {
-        GLuint textureID;
-        glGenTextures(1, &textureID);
-        glBindTexture(GL_TEXTURE_2D, textureID);
+CompressedClip loadCompressedClip(const AssetPack& pack, const PackClip& src) {
+    CompressedClip clip;
+    clip.sampleRate = src.sampleRate;
+    clip.frameCount = src.frameCount;
+    clip.rotationColumns = src.rotationColumns;
+    clip.translationColumns = src.translationColumns;
+    clip.scaleColumns = src.scaleColumns;
+
+    const PackCompressedTrack* tracks = pack.at<PackCompressedTrack>(src.tracksOffset);
+    clip.tracks.resize(src.trackCount);
+    for (uint32_t i = 0; i < src.trackCount; ++i) {
+        const PackCompressedTrack& t = tracks[i];
+        CompressedTrack& dst = clip.tracks[i];
+        dst.jointIndex = t.jointIndex;
+        dst.rotationColumn = t.rotationColumn;
+        dst.translationColumn = t.translationColumn;
+        dst.scaleColumn = t.scaleColumn;
+        dst.constantRotation = glm::quat(t.constantRotation[3], t.constantRotation[0], t.constantRotation[1], t.constantRotation[2]);
+        dst.constantTranslation = glm::make_vec3(t.constantTranslation);
+        dst.constantScale = glm::make_vec3(t.constantScale);
+        dst.translationMin = glm::make_vec3(t.translationMin);
+        dst.translationExtent = glm::make_vec3(t.translationExtent);
+        dst.scaleMin = glm::make_vec3(t.scaleMin);
+        dst.scaleExtent = glm::make_vec3(t.scaleExtent);
+    }
 
-        GLenum format = (image.component == 3) ? GL_RGB : GL_RGBA;
-        glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, image.image.data());
-        glGenerateMipmap(GL_TEXTURE_2D);
+    auto keys = [&](uint64_t offset, uint32_t columns) {
+        const uint16_t* begin = pack.at<uint16_t>(offset);
+        return std::vector<uint16_t>(begin, begin + size_t(src.frameCount) * columns * 3);
+    };
+    clip.rotationKeys = keys(src.rotationKeysOffset, src.rotationColumns);
+    clip.translationKeys = keys(src.translationKeysOffset, src.translationColumns);
+    clip.scaleKeys = keys(src.scaleKeysOffset, src.scaleColumns);
+    return clip;
+}
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+} // anonymous namespace
 
-        textures.push_back(textureID);
+void setPackedVertexAttributes(bool skinned) {
+    const GLsizei stride = skinned ? sizeof(PackedSkinnedVertex) : sizeof(PackedVertex);
+    glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(PackedVertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_BYTE, GL_TRUE, stride, (void*)offsetof(PackedVertex, normal));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(PackedVertex, uv));
+    glEnableVertexAttribArray(2);
+    if (skinned) {
+        glVertexAttribIPointer(3, 4, GL_UNSIGNED_BYTE, stride, (void*)offsetof(PackedSkinnedVertex, joints));
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(PackedSkinnedVertex, weights));
+        glEnableVertexAttribArray(4);
     }
-    return textures;
 }
 
-Skeleton loadSkeleton(const tinygltf::Model& gltfModel, std::map<int, int>& nodeToJoint) {
-    Skeleton skeleton;
-    if (gltfModel.skins.empty()) return skeleton;
+Mesh uploadMesh(const void* vertices, uint32_t vertexCount, bool skinned,
+                const glm::vec3& positionOffset, const glm::vec3& positionScale,
+                const void* indices, uint32_t indexCount, uint32_t indexType, GpuUploadQueue* uploads) {
+    const size_t stride = skinned ? sizeof(PackedSkinnedVertex) : sizeof(PackedVertex);
+
+    Mesh mesh;
+    mesh.hasSkinning = skinned;
+    mesh.indexCount = static_cast<GLsizei>(indexCount);
+    mesh.indexType = static_cast<GLenum>(indexType);
+    mesh.positionOffset = positionOffset;
+    mesh.positionScale = positionScale;
+
+    glGenVertexArrays(1, &mesh.vao);
+    glBindVertexArray(mesh.vao);
+
+    glGenBuffers(1, &mesh.vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBuffer);
+    GLsizeiptr vertexBytes = GLsizeiptr(vertexCount * stride);
+    glBufferData(GL_ARRAY_BUFFER, vertexBytes, uploads ? nullptr : vertices, GL_STATIC_DRAW);
+    if (uploads) uploads->uploadBuffer(mesh.vertexBuffer, vertices, vertexBytes);
+    setPackedVertexAttributes(skinned);
+
+    if (indexCount > 0) mesh.indexBuffer = uploadIndexBuffer(indices, indexCount, indexType, uploads);
+    glBindVertexArray(0);
+    return mesh;
+}
 
-    const auto& skin = gltfModel.skins[0];
-    skeleton.resize(skin.joints.size());
+Mesh uploadMeshLod(const Mesh& base, const void* indices, uint32_t indexCount, GpuUploadQueue* uploads) {
+    Mesh mesh;
+    mesh.hasSkinning = base.hasSkinning;
+    mesh.indexCount = static_cast<GLsizei>(indexCount);
+    mesh.indexType = base.indexType;
+    mesh.texture = base.texture;
+    mesh.normalMap = base.normalMap;
+    mesh.vertexBuffer = base.vertexBuffer;
+    mesh.positionOffset = base.positionOffset;
+    mesh.positionScale = base.positionScale;
+
+    glGenVertexArrays(1, &mesh.vao);
+    glBindVertexArray(mesh.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, base.vertexBuffer);
+    setPackedVertexAttributes(base.hasSkinning);
+    mesh.indexBuffer = uploadIndexBuffer(indices, indexCount, base.indexType, uploads);
+    glBindVertexArray(0);
+    return mesh;
+}
 
-    for (size_t i = 0; i < skin.joints.size(); ++i) {
-        nodeToJoint[skin.joints[i]] = static_cast<int>(i);
-    }
+VertexAnimationTexture uploadVertexAnimationTexture(const uint16_t* texels, uint32_t frameCount, uint32_t vertexCount,
+                                                    const glm::vec3& positionOffset, const glm::vec3& positionScale,
+                                                    GpuUploadQueue* uploads) {
+    VertexAnimationTexture result;
+    result.vertexCount = vertexCount;
+    result.positionOffset = positionOffset;
+    result.positionScale = positionScale;
+
+    glGenBuffers(1, &result.buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, result.buffer);
+    GLsizeiptr bytes = GLsizeiptr(frameCount) * vertexCount * 4 * sizeof(uint16_t);
+    glBufferData(GL_TEXTURE_BUFFER, bytes, uploads ? nullptr : texels, GL_STATIC_DRAW);
+    if (uploads) uploads->uploadBuffer(result.buffer, texels, bytes);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glGenTextures(1, &result.texture);
+    glBindTexture(GL_TEXTURE_BUFFER, result.texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA16UI, result.buffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    return result;
+}
 
-    if (skin.inverseBindMatrices >= 0) {
-        size_t count, stride;
-        const unsigned char* data = getAccessorData(gltfModel, skin.inverseBindMatrices, count, stride);
-        for (size_t i = 0; i < count && i < skeleton.joints.size(); ++i) {
-            const float* matData = reinterpret_cast<const float*>(data + i * stride);
-            skeleton.joints[i].inverseBindMatrix = glm::make_mat4(matData);
-        }
-    }
+Mesh uploadStaticMesh(const std::vector<float>& vertices, const std::vector<uint16_t>& indices) {
+    PackedVertices packed = packVertices(vertices.data(), vertices.size() / STATIC_VERTEX_FLOATS, false);
+    return uploadMesh(packed.data.data(), static_cast<uint32_t>(vertices.size() / STATIC_VERTEX_FLOATS), false,
+                      packed.positionOffset, packed.positionScale,
+                      indices.data(), static_cast<uint32_t>(indices.size()), PACK_INDEX_UINT16);
+}
 
-    for (size_t i = 0; i < skin.joints.size(); ++i) {
-        int nodeIndex = skin.joints[i];
-        const auto& node = gltfModel.nodes[nodeIndex];
-        glm::mat4 nodeTransform = getNodeTransform(node);
-        skeleton.joints[i].localTransform = nodeTransform;
-        skeleton.bindPoseTransforms[i] = nodeTransform;  // Store bind pose
-        skeleton.jointNames[i] = node.name;              // Store joint name
-        skeleton.joints[i].parentIndex = -1;
-
-        for (size_t j = 0; j < skin.joints.size(); ++j) {
-            int parentNodeIndex = skin.joints[j];
-            const auto& parentNode = gltfModel.nodes[parentNodeIndex];
-            for (int childIdx : parentNode.children) {
-                if (childIdx == nodeIndex) {
-                    skeleton.joints[i].parentIndex = static_cast<int>(j);
-                    break;
-                }
-            }
+JointMask footJointMask(const SkeletonDef& skeleton) {
+    JointMask mask;
+    for (FootSide side : {FootSide::Left, FootSide::Right}) {
+        for (int joint : findFootJoints(skeleton, side)) {
+            if (joint < static_cast<int>(mask.size())) mask.set(joint);
         }
     }
-
-    std::cout << "  Loaded skeleton with " << skeleton.joints.size() << " joints" << std::endl;
-    return skeleton;
+    return mask;
 }
 
-std::vector<AnimationClip> loadAnimations(const tinygltf::Model& gltfModel, const std::map<int, int>& nodeToJoint) {
-    std::vector<AnimationClip> clips;
-
-    for (const auto& gltfAnim : gltfModel.animations) {
-        AnimationClip clip;
-        clip.name = gltfAnim.name;
+CpuGeometry retainCpuGeometry(const void* vertices, uint32_t vertexCount, bool skinned,
+                              GeometryRetention retention, const JointMask& footJoints) {
+    CpuGeometry geometry;
+    if (retention == GeometryRetention::None) return geometry;
+    if (retention == GeometryRetention::FootVertices && !skinned) return geometry;
 
-        for (const auto& channel : gltfAnim.channels) {
-            int targetNode = channel.target_node;
-            auto it = nodeToJoint.find(targetNode);
-            if (it == nodeToJoint.end()) continue;
+    const size_t stride = skinned ? sizeof(PackedSkinnedVertex) : sizeof(PackedVertex);
+    const bool keepSkin = skinned && retention != GeometryRetention::Positions;
+    const bool subset = (retention == GeometryRetention::FootVertices);
+    const unsigned char* bytes = static_cast<const unsigned char*>(vertices);
 
-            int jointIndex = it->second;
-
-            AnimationChannel* animChannel = nullptr;
-            for (auto& ch : clip.channels) {
-                if (ch.jointIndex == jointIndex) {
-                    animChannel = &ch;
-                    break;
-                }
-            }
-            if (!animChannel) {
-                clip.channels.push_back({});
-                animChannel = &clip.channels.back();
-                animChannel->jointIndex = jointIndex;
-            }
-
-            const auto& sampler = gltfAnim.samplers[channel.sampler];
-
-            size_t timeCount, timeStride;
-            const unsigned char* timeData = getAccessorData(gltfModel, sampler.input, timeCount, timeStride);
-            std::vector<float> times(timeCount);
-            for (size_t i = 0; i < timeCount; ++i) {
-                times[i] = *reinterpret_cast<const float*>(timeData + i * timeStride);
-                clip.duration = std::max(clip.duration, times[i]);
-            }
-
-            size_t count, stride;
-            const unsigned char* data = getAccessorData(gltfModel, sampler.output, count, stride);
-
-            if (channel.target_path == "translation") {
-                animChannel->translationTimes = times;
-                animChannel->translations.resize(count);
-                for (size_t i = 0; i < count; ++i) {
-                    const float* v = reinterpret_cast<const float*>(data + i * stride);
-                    animChannel->translations[i] = glm::vec3(v[0], v[1], v[2]);
-                }
-            } else if (channel.target_path == "rotation") {
-                animChannel->rotationTimes = times;
-                animChannel->rotations.resize(count);
-                for (size_t i = 0; i < count; ++i) {
-                    const float* v = reinterpret_cast<const float*>(data + i * stride);
-                    animChannel->rotations[i] = glm::quat(v[3], v[0], v[1], v[2]);
-                }
-            } else if (channel.target_path == "scale") {
-                animChannel->scaleTimes = times;
-                animChannel->scales.resize(count);
-                for (size_t i = 0; i < count; ++i) {
-                    const float* v = reinterpret_cast<const float*>(data + i * stride);
-                    animChannel->scales[i] = glm::vec3(v[0], v[1], v[2]);
-                }
-            }
+    if (!subset) {
+        geometry.positions.reserve(size_t(vertexCount) * 3);
+        if (keepSkin) geometry.skin.reserve(size_t(vertexCount) * 8);
+    }
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        PackedSkinnedVertex v{};
+        std::memcpy(&v, bytes + i * stride, stride);
+        if (subset) {
+            bool onFoot = false;
+            for (int k = 0; k < 4; ++k) onFoot |= (v.weights[k] > 0 && footJoints.test(v.joints[k]));
+            if (!onFoot) continue;
+            geometry.sourceIndices.push_back(i);
+        }
+        geometry.positions.insert(geometry.positions.end(), v.base.position, v.base.position + 3);
+        if (keepSkin) {
+            geometry.skin.insert(geometry.skin.end(), v.joints, v.joints + 4);
+            geometry.skin.insert(geometry.skin.end(), v.weights, v.weights + 4);
         }
-
-        std::cout << "  Animation '" << clip.name << "' duration: " << clip.duration << "s" << std::endl;
-        clips.push_back(std::move(clip));
     }
-    return clips;
+    geometry.positions.shrink_to_fit();
+    geometry.skin.shrink_to_fit();
+    geometry.sourceIndices.shrink_to_fit();
+    return geometry;
 }
 
-std::pair<MeshGroup, ModelBounds> loadMeshes(const tinygltf::Model& gltfModel, const std::vector<GLuint>& textures) {
-    MeshGroup group;
-    ModelBounds bounds;
-
-    for (const auto& gltfMesh : gltfModel.meshes) {
-        for (const auto& primitive : gltfMesh.primitives) {
-            if (primitive.mode != TINYGLTF_MODE_TRIANGLES) continue;
-
-            Mesh mesh;
-            glGenVertexArrays(1, &mesh.vao);
-            glBindVertexArray(mesh.vao);
-
-            size_t vertexCount = 0;
-
-            // Positions
-            {
-                auto it = primitive.attributes.find("POSITION");
-                if (it == primitive.attributes.end()) continue;
-
-                const auto& accessor = gltfModel.accessors[it->second];
-                const auto& bufferView = gltfModel.bufferViews[accessor.bufferView];
-                const auto& buffer = gltfModel.buffers[bufferView.buffer];
-
-                const unsigned char* dataPtr = &buffer.data[bufferView.byteOffset + accessor.byteOffset];
-                size_t dataSize = bufferView.byteLength;
-                int stride = bufferView.byteStride;
-                if (stride == 0) stride = getNumComponents(accessor.type) * getComponentByteSize(accessor.componentType);
-
-                // Store CPU-side positions and compute bounds
-                vertexCount = accessor.count;
-                mesh.skinnedVertices.resize(vertexCount);
-                for (size_t i = 0; i < vertexCount; ++i) {
-                    const float* v = reinterpret_cast<const float*>(dataPtr + i * stride);
-                    glm::vec3 pos(v[0], v[1], v[2]);
-                    mesh.skinnedVertices[i].position = pos;
-
-                    // Update global bounds
-                    bounds.min = glm::min(bounds.min, pos);
-                    bounds.max = glm::max(bounds.max, pos);
-                }
-
-                GLuint vbo;
-                glGenBuffers(1, &vbo);
-                glBindBuffer(GL_ARRAY_BUFFER, vbo);
-                glBufferData(GL_ARRAY_BUFFER, dataSize, dataPtr, GL_STATIC_DRAW);
-                glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-                glEnableVertexAttribArray(0);
-            }
+CpuGeometry readBackCpuGeometry(const Mesh& mesh, GeometryRetention retention, const JointMask& footJoints) {
+    if (mesh.vertexBuffer == 0 || retention == GeometryRetention::None) return {};
 
-            // Normals
-            {
-                auto it = primitive.attributes.find("NORMAL");
-                if (it != primitive.attributes.end()) {
-                    const auto& accessor = gltfModel.accessors[it->second];
-                    const auto& bufferView = gltfModel.bufferViews[accessor.bufferView];
-                    const auto& buffer = gltfModel.buffers[bufferView.buffer];
-
-                    const unsigned char* dataPtr = &buffer.data[bufferView.byteOffset + accessor.byteOffset];
-                    size_t dataSize = bufferView.byteLength;
-                    int stride = bufferView.byteStride;
-                    if (stride == 0) stride = getNumComponents(accessor.type) * getComponentByteSize(accessor.componentType);
-
-                    GLuint vbo;
-                    glGenBuffers(1, &vbo);
-                    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-                    glBufferData(GL_ARRAY_BUFFER, dataSize, dataPtr, GL_STATIC_DRAW);
-                    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-                    glEnableVertexAttribArray(1);
-                }
-            }
+    GLint64 size = 0;
+    glGetNamedBufferParameteri64v(mesh.vertexBuffer, GL_BUFFER_SIZE, &size);
+    std::vector<unsigned char> vertices(static_cast<size_t>(size));
+    if (size > 0) glGetNamedBufferSubData(mesh.vertexBuffer, 0, static_cast<GLsizeiptr>(size), vertices.data());
 
-            // Texture coordinates
-            {
-                auto it = primitive.attributes.find("TEXCOORD_0");
-                if (it != primitive.attributes.end()) {
-                    const auto& accessor = gltfModel.accessors[it->second];
-                    const auto& bufferView = gltfModel.bufferViews[accessor.bufferView];
-                    const auto& buffer = gltfModel.buffers[bufferView.buffer];
-
-                    const unsigned char* dataPtr = &buffer.data[bufferView.byteOffset + accessor.byteOffset];
-                    size_t dataSize = bufferView.byteLength;
-                    int stride = bufferView.byteStride;
-                    if (stride == 0) stride = getNumComponents(accessor.type) * getComponentByteSize(accessor.componentType);
-
-                    GLuint vbo;
-                    glGenBuffers(1, &vbo);
-                    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-                    glBufferData(GL_ARRAY_BUFFER, dataSize, dataPtr, GL_STATIC_DRAW);
-                    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)0);
-                    glEnableVertexAttribArray(2);
-                }
-            }
+    const size_t stride = mesh.hasSkinning ? sizeof(PackedSkinnedVertex) : sizeof(PackedVertex);
+    return retainCpuGeometry(vertices.data(), static_cast<uint32_t>(vertices.size() / stride), mesh.hasSkinning,
+                             retention, footJoints);
+}
 
-            // Joint indices
-            {
-                auto it = primitive.attributes.find("JOINTS_0");
-                if (it != primitive.attributes.end()) {
-                    const auto& accessor = gltfModel.accessors[it->second];
-                    const auto& bufferView = gltfModel.bufferViews[accessor.bufferView];
-                    const auto& buffer = gltfModel.buffers[bufferView.buffer];
-
-                    const unsigned char* dataPtr = &buffer.data[bufferView.byteOffset + accessor.byteOffset];
-                    int stride = bufferView.byteStride;
-                    size_t elemSize = getComponentByteSize(accessor.componentType);
-                    if (stride == 0) stride = 4 * elemSize;
-
-                    std::vector<float> jointData(accessor.count * 4);
-                    for (size_t i = 0; i < accessor.count; ++i) {
-                        const unsigned char* ptr = dataPtr + i * stride;
-                        for (int j = 0; j < 4; ++j) {
-                            if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
-                                jointData[i * 4 + j] = static_cast<float>(ptr[j]);
-                            else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
-                                jointData[i * 4 + j] = static_cast<float>(reinterpret_cast<const unsigned short*>(ptr)[j]);
-                        }
-                        // Store CPU-side joint indices
-                        if (i < mesh.skinnedVertices.size()) {
-                            mesh.skinnedVertices[i].jointIndices = glm::ivec4(
-                                static_cast<int>(jointData[i * 4 + 0]),
-                                static_cast<int>(jointData[i * 4 + 1]),
-                                static_cast<int>(jointData[i * 4 + 2]),
-                                static_cast<int>(jointData[i * 4 + 3])
-                            );
-                        }
-                    }
-
-                    GLuint vbo;
-                    glGenBuffers(1, &vbo);
-                    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-                    glBufferData(GL_ARRAY_BUFFER, jointData.size() * sizeof(float), jointData.data(), GL_STATIC_DRAW);
-                    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, 0, (void*)0);
-                    glEnableVertexAttribArray(3);
-
-                    mesh.hasSkinning = true;
-                }
-            }
+SkinnedVertex unpackCpuVertex(const Mesh& mesh, const CpuGeometry& geometry, size_t i) {
+    PackedVertex packed{};
+    std::memcpy(packed.position, &geometry.positions[i * 3], sizeof(packed.position));
+
+    SkinnedVertex v{};
+    v.position = unpackPosition(packed, mesh.positionOffset, mesh.positionScale);
+    v.jointIndices = glm::ivec4(0);
+    v.weights = glm::vec4(0.0f);
+    if (!geometry.skin.empty()) {
+        const uint8_t* skin = &geometry.skin[i * 8];
+        v.jointIndices = glm::ivec4(skin[0], skin[1], skin[2], skin[3]);
+        v.weights = glm::vec4(skin[4], skin[5], skin[6], skin[7]) * (1.0f / 255.0f);
+    }
+    return v;
+}
 
-            // Joint weights
-            {
-                auto it = primitive.attributes.find("WEIGHTS_0");
-                if (it != primitive.attributes.end()) {
-                    const auto& accessor = gltfModel.accessors[it->second];
-                    const auto& bufferView = gltfModel.bufferViews[accessor.bufferView];
-                    const auto& buffer = gltfModel.buffers[bufferView.buffer];
-
-                    const unsigned char* dataPtr = &buffer.data[bufferView.byteOffset + accessor.byteOffset];
-                    size_t dataSize = bufferView.byteLength;
-                    int stride = bufferView.byteStride;
-                    if (stride == 0) stride = getNumComponents(accessor.type) * getComponentByteSize(accessor.componentType);
-
-                    // Store CPU-side weights
-                    for (size_t i = 0; i < accessor.count && i < mesh.skinnedVertices.size(); ++i) {
-                        const float* w = reinterpret_cast<const float*>(dataPtr + i * stride);
-                        mesh.skinnedVertices[i].weights = glm::vec4(w[0], w[1], w[2], w[3]);
-                    }
-
-                    GLuint vbo;
-                    glGenBuffers(1, &vbo);
-                    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-                    glBufferData(GL_ARRAY_BUFFER, dataSize, dataPtr, GL_STATIC_DRAW);
-                    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (void*)0);
-                    glEnableVertexAttribArray(4);
-                }
-            }
+size_t cpuGeometryBytes(const LoadedModel& model) {
+    size_t bytes = 0;
+    for (const Mesh& mesh : model.meshGroup.meshes) bytes += mesh.cpuGeometry.memoryBytes();
+    return bytes;
+}
 
-            // Indices
-            if (primitive.indices >= 0) {
-                const auto& accessor = gltfModel.accessors[primitive.indices];
-                const auto& bufferView = gltfModel.bufferViews[accessor.bufferView];
-                const auto& buffer = gltfModel.buffers[bufferView.buffer];
-
-                mesh.indexCount = static_cast<GLsizei>(accessor.count);
-                const unsigned char* dataPtr = &buffer.data[bufferView.byteOffset + accessor.byteOffset];
-                size_t elementSize = getComponentByteSize(accessor.componentType);
-                size_t dataSize = accessor.count * elementSize;
-
-                GLuint ebo;
-                glGenBuffers(1, &ebo);
-                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-                glBufferData(GL_ELEMENT_ARRAY_BUFFER, dataSize, dataPtr, GL_STATIC_DRAW);
-
-                if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)
-                    mesh.indexType = GL_UNSIGNED_INT;
-                else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
-                    mesh.indexType = GL_UNSIGNED_SHORT;
-                else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
-                    mesh.indexType = GL_UNSIGNED_BYTE;
-            }
+LoadedModel uploadDecodedModel(DecodedModel& decoded, GpuUploadQueue* uploads, GeometryRetention retention) {
+    LoadedModel result;
 
-            // Texture
-            if (primitive.material >= 0) {
-                const auto& material = gltfModel.materials[primitive.material];
-                int texIndex = material.pbrMetallicRoughness.baseColorTexture.index;
-                if (texIndex >= 0 && texIndex < static_cast<int>(gltfModel.textures.size())) {
-                    int imageIndex = gltfModel.textures[texIndex].source;
-                    if (imageIndex >= 0 && imageIndex < static_cast<int>(textures.size())) {
-                        mesh.texture = textures[imageIndex];
-                    }
-                }
-            }
+    for (const DecodedTexture& tex : decoded.textures) {
+        uint32_t format = (tex.components == 3) ? PACK_FORMAT_RGB8 : PACK_FORMAT_RGBA8;
+        result.textures.push_back(uploadTexture(tex.pixels.data(), tex.width, tex.height, format, 1, uploads));
+    }
 
-            glBindVertexArray(0);
-            group.meshes.push_back(mesh);
+    if (decoded.skeleton) {
+        decoded.skeleton->markLeafJoints();
+        result.skeleton = std::make_shared<const SkeletonDef>(std::move(*decoded.skeleton));
+    }
+    const JointMask footJoints = result.skeleton ? footJointMask(*result.skeleton) : JointMask{};
+
+    for (const DecodedMesh& src : decoded.meshes) {
+        Mesh mesh = uploadMesh(src.vertices.data(), src.vertexCount(), src.skinned, src.positionOffset, src.positionScale,
+                               src.indexData.data(), src.indexCount, src.indexType, uploads);
+        mesh.cpuGeometry = retainCpuGeometry(src.vertices.data(), src.vertexCount(), src.skinned, retention, footJoints);
+        if (src.textureIndex >= 0) mesh.texture = result.textures[src.textureIndex];
+        result.meshGroup.meshes.push_back(std::move(mesh));
+    }
+
+    const DecodedVertexAnimation& baked = decoded.vertexAnimation;
+    if (!baked.empty()) {
+        auto set = std::make_shared<VertexAnimationSet>();
+        set->frameCount = baked.frameCount;
+        set->clips = baked.clips;
+        for (size_t m = 0; m < baked.meshes.size(); ++m) {
+            const DecodedVertexAnimationMesh& src = baked.meshes[m];
+            set->meshes.push_back(uploadVertexAnimationTexture(src.texels.data(), baked.frameCount, decoded.meshes[m].vertexCount(),
+                                                               src.positionOffset, src.positionScale, uploads));
         }
+        result.vertexAnimation = std::move(set);
     }
 
-    std::cout << "  Total meshes loaded: " << group.meshes.size() << std::endl;
-    if (bounds.isValid()) {
-        std::cout << "  Bounds: min(" << bounds.min.x << ", " << bounds.min.y << ", " << bounds.min.z << ")"
-                  << " max(" << bounds.max.x << ", " << bounds.max.y << ", " << bounds.max.z << ")" << std::endl;
+    result.clips = std::make_shared<const ClipSet>(ClipSet{std::move(decoded.clips)});
+    result.bounds.min = decoded.boundsMin;
+    result.bounds.max = decoded.boundsMax;
+    return result;
+}
+
+LoadedModel loadGLB(const std::string& path, GeometryRetention retention) {
+    DecodedModel decoded;
+    if (!decodeGLB(path, decoded)) {
+        return {};
     }
-    return {group, bounds};
+
+    LoadedModel result = uploadDecodedModel(decoded, nullptr, retention);
+    std::cout << "Loaded GLB: " << path << std::endl;
+    printSummary(result);
+    return result;
 }
 
-} // anonymous namespace
+GLuint loadPackedTexture(const AssetPack& pack, const PackTexture& texture, GpuUploadQueue* uploads) {
+    return uploadTexture(pack.at<unsigned char>(texture.dataOffset), texture.width, texture.height,
+                         texture.format, texture.mipCount, uploads);
+}
 
-LoadedModel loadGLB(const std::string& path) {
+LoadedModel loadPackedModel(const AssetPack& pack, const PackModel& model, GpuUploadQueue* uploads,
+                            GeometryRetention retention) {
     LoadedModel result;
 
-    tinygltf::Model gltfModel;
-    tinygltf::TinyGLTF loader;
-    std::string err, warn;
-
-    bool success = loader.LoadBinaryFromFile(&gltfModel, &err, &warn, path);
+    // === Textures: every mip level is already baked ===
+    const PackTexture* textures = pack.at<PackTexture>(model.texturesOffset);
+    for (uint32_t t = 0; t < model.textureCount; ++t) {
+        result.textures.push_back(loadPackedTexture(pack, textures[t], uploads));
+    }
 
-    if (!warn.empty()) std::cerr << "GLTF Warning: " << warn << std::endl;
-    if (!err.empty()) std::cerr << "GLTF Error: " << err << std::endl;
-    if (!success) {
-        std::cerr << "Failed to load GLB: " << path << std::endl;
-        return result;
+    // === Skeleton: parents already resolved ===
+    if (model.jointCount > 0) {
+        const PackJoint* joints = pack.at<PackJoint>(model.jointsOffset);
+        SkeletonDef skeleton;
+        skeleton.resize(model.jointCount);
+        for (uint32_t i = 0; i < model.jointCount; ++i) {
+            skeleton.joints[i].parentIndex = joints[i].parentIndex;
+            skeleton.joints[i].inverseBindMatrix = glm::make_mat4(joints[i].inverseBindMatrix);
+            skeleton.joints[i].localTransform = glm::make_mat4(joints[i].bindPose);
+            skeleton.jointNames[i].assign(joints[i].name, strnlen(joints[i].name, sizeof(joints[i].name)));
+        }
+        skeleton.markLeafJoints();
+        result.skeleton = std::make_shared<const SkeletonDef>(std::move(skeleton));
     }
 
-    std::cout << "Loaded GLB: " << path << std::endl;
-    std::cout << "  Meshes: " << gltfModel.meshes.size() << std::endl;
-    std::cout << "  Textures: " << gltfModel.textures.size() << std::endl;
-    std::cout << "  Animations: " << gltfModel.animations.size() << std::endl;
-    std::cout << "  Skins: " << gltfModel.skins.size() << std::endl;
+    // === Animation clips: compressed tracks or key arrays, copied as-is ===
+    static_assert(sizeof(glm::vec3) == 12 && sizeof(glm::quat) == 16, "Unexpected glm layout");
+    const PackClip* clips = pack.at<PackClip>(model.clipsOffset);
+    ClipSet clipSet;
+    for (uint32_t c = 0; c < model.clipCount; ++c) {
+        AnimationClip clip;
+        clip.name.assign(clips[c].name, strnlen(clips[c].name, sizeof(clips[c].name)));
+        clip.duration = clips[c].duration;
+        if (clips[c].frameCount > 0) {
+            clip.compressed = loadCompressedClip(pack, clips[c]);
+            clipSet.clips.push_back(std::move(clip));
+            continue;
+        }
 
-    result.textures = loadTextures(gltfModel);
+        const PackChannel* channels = pack.at<PackChannel>(clips[c].channelsOffset);
+        clip.channels.resize(clips[c].channelCount);
+        for (uint32_t i = 0; i < clips[c].channelCount; ++i) {
+            const PackChannel& src = channels[i];
+            AnimationChannel& dst = clip.channels[i];
+            dst.jointIndex = src.jointIndex;
+
+            const float* tt = pack.at<float>(src.translationTimesOffset);
+            const float* rt = pack.at<float>(src.rotationTimesOffset);
+            const float* st = pack.at<float>(src.scaleTimesOffset);
+            dst.translationTimes.assign(tt, tt + src.translationCount);
+            dst.rotationTimes.assign(rt, rt + src.rotationCount);
+            dst.scaleTimes.assign(st, st + src.scaleCount);
+
+            const glm::vec3* t = pack.at<glm::vec3>(src.translationsOffset);
+            const glm::vec3* s = pack.at<glm::vec3>(src.scalesOffset);
+            dst.translations.assign(t, t + src.translationCount);
+            dst.scales.assign(s, s + src.scaleCount);
+#ifdef GLM_FORCE_QUAT_DATA_WXYZ
+            const float* r = pack.at<float>(src.rotationsOffset);
+            dst.rotations.resize(src.rotationCount);
+            for (uint32_t k = 0; k < src.rotationCount; ++k) {
+                dst.rotations[k] = glm::quat(r[k * 4 + 3], r[k * 4 + 0], r[k * 4 + 1], r[k * 4 + 2]);
+            }
+#else
+            const glm::quat* r = pack.at<glm::quat>(src.rotationsOffset);
+            dst.rotations.assign(r, r + src.rotationCount);
+#endif
+        }
+        clipSet.clips.push_back(std::move(clip));
+    }
+    result.clips = std::make_shared<const ClipSet>(std::move(clipSet));
+
+    // === Meshes: uploaded straight from the mapping, CPU copy per retention ===
+    const JointMask footJoints = result.skeleton ? footJointMask(*result.skeleton) : JointMask{};
+    const PackMesh* meshes = pack.at<PackMesh>(model.meshesOffset);
+    for (uint32_t m = 0; m < model.meshCount; ++m) {
+        const PackMesh& src = meshes[m];
+        const bool skinned = (src.flags & PACK_MESH_SKINNED) != 0;
+        const unsigned char* vertices = pack.at<unsigned char>(src.verticesOffset);
+        Mesh mesh = uploadMesh(vertices, src.vertexCount, skinned,
+                               glm::make_vec3(src.positionOffset), glm::make_vec3(src.positionScale),
+                               pack.at<unsigned char>(src.indicesOffset), src.indexCount, src.indexType, uploads);
+        mesh.cpuGeometry = retainCpuGeometry(vertices, src.vertexCount, skinned, retention, footJoints);
+        if (src.textureIndex >= 0) mesh.texture = result.textures[src.textureIndex];
+        result.meshGroup.meshes.push_back(std::move(mesh));
+    }
 
-    std::map<int, int> nodeToJoint;
-    Skeleton skeleton = loadSkeleton(gltfModel, nodeToJoint);
-    if (!skeleton.joints.empty()) {
-        result.skeleton = std::move(skeleton);
+    // === LODs: level l of every mesh, over the meshes' vertex buffers ===
+    const uint32_t lodCount = (model.meshCount > 0) ? meshes[0].lodCount : 0;
+    for (uint32_t l = 0; l < lodCount; ++l) {
+        ModelLod lod;
+        for (uint32_t m = 0; m < model.meshCount; ++m) {
+            const PackMeshLod& src = pack.at<PackMeshLod>(meshes[m].lodsOffset)[l];
+            lod.meshGroup.meshes.push_back(uploadMeshLod(result.meshGroup.meshes[m], pack.at<unsigned char>(src.indicesOffset),
+                                                         src.indexCount, uploads));
+            lod.error = std::max(lod.error, src.error);
+        }
+        result.lods.push_back(std::move(lod));
     }
 
-    result.clips = loadAnimations(gltfModel, nodeToJoint);
+    // === Vertex animation: one buffer texture per mesh, shared by its LODs ===
+    if (model.vertexAnimationClipCount > 0) {
+        auto set = std::make_shared<VertexAnimationSet>();
+        set->frameCount = model.vertexAnimationFrameCount;
+        const PackVertexAnimationClip* bakedClips = pack.at<PackVertexAnimationClip>(model.vertexAnimationClipsOffset);
+        for (uint32_t c = 0; c < model.vertexAnimationClipCount; ++c) {
+            set->clips.push_back({bakedClips[c].firstFrame, bakedClips[c].frameCount, bakedClips[c].duration});
+        }
+        for (uint32_t m = 0; m < model.meshCount; ++m) {
+            set->meshes.push_back(uploadVertexAnimationTexture(pack.at<uint16_t>(meshes[m].animationTexelsOffset),
+                                                               model.vertexAnimationFrameCount, meshes[m].vertexCount,
+                                                               glm::make_vec3(meshes[m].animationPositionOffset),
+                                                               glm::make_vec3(meshes[m].animationPositionScale), uploads));
+        }
+        result.vertexAnimation = std::move(set);
+    }
 
-    auto [meshGroup, bounds] = loadMeshes(gltfModel, result.textures);
-    result.meshGroup = std::move(meshGroup);
-    result.bounds = bounds;
+    result.bounds.min = glm::make_vec3(model.boundsMin);
+    result.bounds.max = glm::make_vec3(model.boundsMax);
 
+    std::cout << (uploads ? "Streaming packed model: " : "Loaded packed model: ")
+              << std::string(model.name, strnlen(model.name, sizeof(model.name))) << std::endl;
+    printSummary(result);
     return result;
 }
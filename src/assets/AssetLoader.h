@@ -2,11 +2,19 @@
 #include "../ecs/components/Mesh.h"
 #include "../ecs/components/Skeleton.h"
 #include "../ecs/components/Animation.h"
+#include "../ecs/components/VertexAnimation.h"
+#include "AssetPack.h"
+#include "GpuUploadQueue.h"
+#include "ModelDecoder.h"
+#include "ModelManifest.h"
+#include "VertexFormat.h"
 #include <glm/glm.hpp>
+#include <bitset>
 #include <string>
 #include <vector>
-#include <optional>
+#include <memory>
 #include <cfloat>
+#include <cstdint>
 
 // Axis-aligned bounding box computed from model vertices
 struct ModelBounds {
@@ -19,12 +27,84 @@ struct ModelBounds {
     glm::vec3 halfExtents() const { return size() * 0.5f; }
 };
 
+// Simplified version of a model (cooked by MeshSimplifier). Each mesh has its
+// own VAO and index buffer but draws from the full mesh's vertex buffer.
+struct ModelLod {
+    MeshGroup meshGroup;
+    float error = 0.0f;  // Largest model-space deviation from the full meshes
+};
+
 struct LoadedModel {
     MeshGroup meshGroup;
-    std::optional<Skeleton> skeleton;
-    std::vector<AnimationClip> clips;
+    std::vector<ModelLod> lods;  // Coarsest last; only models loaded from an AssetPack have them
+    // Immutable and shared: entities hold these handles plus their own pose/playback state
+    std::shared_ptr<const SkeletonDef> skeleton;
+    std::shared_ptr<const ClipSet> clips;
+    std::shared_ptr<const VertexAnimationSet> vertexAnimation;  // Baked clips, null unless the source asks for them
     std::vector<GLuint> textures;
     ModelBounds bounds;  // AABB computed from all mesh vertices
 };
 
-LoadedModel loadGLB(const std::string& path);
+// Joints selected by GeometryRetention::FootVertices (packed joint indices are 8-bit)
+using JointMask = std::bitset<256>;
+JointMask footJointMask(const SkeletonDef& skeleton);
+
+// Decode + upload on the calling (GL) thread
+LoadedModel loadGLB(const std::string& path, GeometryRetention retention = GeometryRetention::None);
+
+// With an upload queue, the loaders below create every GL object (with storage)
+// right away but leave the vertex/index/pixel contents to the queue, so the
+// source memory must stay valid until the queue has processed them.
+
+// GL half of loadGLB: uploads a model decoded on a worker thread with decodeGLB.
+// The skeleton and clips are moved out of `decoded`; the mesh/texture arrays and
+// baked vertex animation stay.
+LoadedModel uploadDecodedModel(DecodedModel& decoded, GpuUploadQueue* uploads = nullptr,
+                               GeometryRetention retention = GeometryRetention::None);
+
+// Upload a cooked texture (every mip level, compressed or not) from a mapped AssetPack
+GLuint loadPackedTexture(const AssetPack& pack, const PackTexture& texture, GpuUploadQueue* uploads = nullptr);
+
+// Upload a cooked model straight from a mapped AssetPack (no glTF decoding)
+LoadedModel loadPackedModel(const AssetPack& pack, const PackModel& model, GpuUploadQueue* uploads = nullptr,
+                            GeometryRetention retention = GeometryRetention::None);
+
+// Attribute pointers 0..4 for the quantized PackedVertex/PackedSkinnedVertex
+// layout, on the currently bound VAO and GL_ARRAY_BUFFER
+void setPackedVertexAttributes(bool skinned);
+
+// One interleaved VBO of packed vertices (vertexCount * stride bytes) + optional
+// EBO. Keeps no CPU-side vertices (see retainCpuGeometry).
+Mesh uploadMesh(const void* vertices, uint32_t vertexCount, bool skinned,
+                const glm::vec3& positionOffset, const glm::vec3& positionScale,
+                const void* indices, uint32_t indexCount, uint32_t indexType, GpuUploadQueue* uploads = nullptr);
+
+// Another index buffer over `base`'s vertex buffer (new VAO, same material and
+// dequantization; no CPU-side vertices)
+Mesh uploadMeshLod(const Mesh& base, const void* indices, uint32_t indexCount, GpuUploadQueue* uploads = nullptr);
+
+// Baked frames of one mesh (frameCount * vertexCount RGBA16UI texels) as a
+// buffer texture
+VertexAnimationTexture uploadVertexAnimationTexture(const uint16_t* texels, uint32_t frameCount, uint32_t vertexCount,
+                                                    const glm::vec3& positionOffset, const glm::vec3& positionScale,
+                                                    GpuUploadQueue* uploads = nullptr);
+
+// Procedural geometry: STATIC_VERTEX_FLOATS per vertex, quantized then uploaded
+Mesh uploadStaticMesh(const std::vector<float>& vertices, const std::vector<uint16_t>& indices);
+
+// The part of `vertexCount` packed vertices that `retention` keeps. `footJoints`
+// is only read for GeometryRetention::FootVertices.
+CpuGeometry retainCpuGeometry(const void* vertices, uint32_t vertexCount, bool skinned,
+                              GeometryRetention retention, const JointMask& footJoints = {});
+
+// Same selection, read back from the mesh's vertex buffer for meshes that were
+// loaded keeping less. Only valid once the model is resident (its queued
+// uploads have run); stalls on the GPU, so use it for one-off queries only.
+CpuGeometry readBackCpuGeometry(const Mesh& mesh, GeometryRetention retention, const JointMask& footJoints = {});
+
+// Kept vertex i of `geometry` (which belongs to `mesh`) in model space; joints
+// and weights are zero if the skin was not kept
+SkinnedVertex unpackCpuVertex(const Mesh& mesh, const CpuGeometry& geometry, size_t i);
+
+// RAM held by every mesh's CpuGeometry
+size_t cpuGeometryBytes(const LoadedModel& model);
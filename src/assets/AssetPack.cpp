@@ -0,0 +1,297 @@
+#include "AssetPack.h"
+#include <cstring>
+#include <iostream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+bool statSourceFile(const std::string& path, SourceStamp& out) {
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_stat64(path.c_str(), &st) != 0) return false;
+#else
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
+#endif
+    out.size = static_cast<uint64_t>(st.st_size);
+    out.mtime = static_cast<int64_t>(st.st_mtime);
+    return true;
+}
+
+// === MappedFile ===
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The view keeps the mapping alive, so both handles can be closed right away
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) return false;
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) return false;
+
+    m_data = static_cast<const unsigned char*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+
+    // Loading walks the file front to back once
+    madvise(view, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+    m_data = static_cast<const unsigned char*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::close() {
+    if (!m_data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+// === AssetPack ===
+
+bool AssetPack::open(const std::string& path) {
+    close();
+    if (!m_file.open(path)) return false;
+
+    const PackHeader* header = reinterpret_cast<const PackHeader*>(m_file.data());
+    if (m_file.size() < sizeof(PackHeader) ||
+        std::memcmp(header->magic, ASSET_PACK_MAGIC, sizeof(ASSET_PACK_MAGIC)) != 0) {
+        std::cerr << "AssetPack: " << path << " is not an asset pack" << std::endl;
+        m_file.close();
+        return false;
+    }
+    if (header->version != ASSET_PACK_VERSION) {
+        std::cerr << "AssetPack: " << path << " has version " << header->version
+                  << " (expected " << ASSET_PACK_VERSION << "), re-run the cooker" << std::endl;
+        m_file.close();
+        return false;
+    }
+    if (header->fileSize != m_file.size() ||
+        !inRange(header->modelsOffset, uint64_t(header->modelCount) * sizeof(PackModel)) ||
+        !inRange(header->texturesOffset, uint64_t(header->textureCount) * sizeof(PackNamedTexture))) {
+        std::cerr << "AssetPack: " << path << " is truncated" << std::endl;
+        m_file.close();
+        return false;
+    }
+
+    m_header = header;
+    for (uint32_t i = 0; i < header->modelCount; ++i) {
+        if (!validateModel(model(i))) {
+            std::cerr << "AssetPack: " << path << " has a corrupt model table" << std::endl;
+            close();
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header->textureCount; ++i) {
+        if (!validateTexture(texture(i).texture)) {
+            std::cerr << "AssetPack: " << path << " has a corrupt texture table" << std::endl;
+            close();
+            return false;
+        }
+    }
+
+    std::cout << "AssetPack: Mapped " << path << " (" << header->modelCount << " models, "
+              << header->textureCount << " textures, "
+              << (m_file.size() / (1024 * 1024)) << " MB)" << std::endl;
+    return true;
+}
+
+const PackModel* AssetPack::findModel(const std::string& name) const {
+    for (uint32_t i = 0; i < modelCount(); ++i) {
+        const PackModel& m = model(i);
+        if (std::string(m.name, strnlen(m.name, sizeof(m.name))) == name) return &m;
+    }
+    return nullptr;
+}
+
+const PackNamedTexture* AssetPack::findTexture(const std::string& name) const {
+    for (uint32_t i = 0; i < textureCount(); ++i) {
+        const PackNamedTexture& t = texture(i);
+        if (std::string(t.name, strnlen(t.name, sizeof(t.name))) == name) return &t;
+    }
+    return nullptr;
+}
+
+namespace {
+
+bool sourceUnchanged(const std::string& sourcePath, uint64_t size, int64_t mtime) {
+    SourceStamp stamp;
+    if (!statSourceFile(sourcePath, stamp)) return true;  // Shipped without sources
+    return stamp.size == size && stamp.mtime == mtime;
+}
+
+} // anonymous namespace
+
+bool AssetPack::isCurrent(const PackModel& model, const std::string& sourcePath) const {
+    return sourceUnchanged(sourcePath, model.sourceSize, model.sourceMtime);
+}
+
+bool AssetPack::isCurrent(const PackNamedTexture& texture, const std::string& sourcePath) const {
+    return sourceUnchanged(sourcePath, texture.sourceSize, texture.sourceMtime);
+}
+
+void AssetPack::prefetch(const PackModel& model) const {
+    const PackTexture* textures = at<PackTexture>(model.texturesOffset);
+    for (uint32_t i = 0; i < model.textureCount; ++i) {
+        prefetch(textures[i]);
+    }
+    const PackMesh* meshes = at<PackMesh>(model.meshesOffset);
+    for (uint32_t i = 0; i < model.meshCount; ++i) {
+        touch(meshes[i].verticesOffset, uint64_t(meshes[i].vertexCount) * meshes[i].vertexStride);
+        const uint64_t indexSize = (meshes[i].indexType == PACK_INDEX_UINT32) ? 4 : 2;
+        touch(meshes[i].indicesOffset, uint64_t(meshes[i].indexCount) * indexSize);
+        const PackMeshLod* lods = at<PackMeshLod>(meshes[i].lodsOffset);
+        for (uint32_t l = 0; l < meshes[i].lodCount; ++l) {
+            touch(lods[l].indicesOffset, uint64_t(lods[l].indexCount) * indexSize);
+        }
+        touch(meshes[i].animationTexelsOffset, uint64_t(model.vertexAnimationFrameCount) * meshes[i].vertexCount * 8);
+    }
+}
+
+void AssetPack::touch(uint64_t offset, uint64_t bytes) const {
+    constexpr uint64_t PAGE = 4096;
+    volatile unsigned char sink = 0;
+    for (uint64_t p = 0; p < bytes; p += PAGE) {
+        sink = sink + m_file.data()[offset + p];
+    }
+    (void)sink;
+}
+
+bool AssetPack::inRange(uint64_t offset, uint64_t bytes) const {
+    return offset <= m_file.size() && bytes <= m_file.size() - offset;
+}
+
+bool AssetPack::validateModel(const PackModel& m) const {
+    if (!inRange(m.meshesOffset, uint64_t(m.meshCount) * sizeof(PackMesh)) ||
+        !inRange(m.texturesOffset, uint64_t(m.textureCount) * sizeof(PackTexture)) ||
+        !inRange(m.jointsOffset, uint64_t(m.jointCount) * sizeof(PackJoint)) ||
+        !inRange(m.clipsOffset, uint64_t(m.clipCount) * sizeof(PackClip)) ||
+        (m.vertexAnimationClipCount != 0 && m.vertexAnimationClipCount != m.clipCount) ||
+        !inRange(m.vertexAnimationClipsOffset, uint64_t(m.vertexAnimationClipCount) * sizeof(PackVertexAnimationClip))) {
+        return false;
+    }
+    const PackVertexAnimationClip* bakedClips = at<PackVertexAnimationClip>(m.vertexAnimationClipsOffset);
+    for (uint32_t c = 0; c < m.vertexAnimationClipCount; ++c) {
+        if (bakedClips[c].frameCount == 0 ||
+            uint64_t(bakedClips[c].firstFrame) + bakedClips[c].frameCount > m.vertexAnimationFrameCount) {
+            return false;
+        }
+    }
+
+    const PackMesh* meshes = at<PackMesh>(m.meshesOffset);
+    for (uint32_t i = 0; i < m.meshCount; ++i) {
+        const PackMesh& mesh = meshes[i];
+        uint64_t indexSize = (mesh.indexType == PACK_INDEX_UINT32) ? 4 : 2;
+        uint32_t stride = (mesh.flags & PACK_MESH_SKINNED) ? sizeof(PackedSkinnedVertex) : sizeof(PackedVertex);
+        if (mesh.vertexStride != stride ||
+            !inRange(mesh.verticesOffset, uint64_t(mesh.vertexCount) * mesh.vertexStride) ||
+            !inRange(mesh.indicesOffset, uint64_t(mesh.indexCount) * indexSize) ||
+            mesh.textureIndex >= static_cast<int32_t>(m.textureCount) ||
+            mesh.lodCount != meshes[0].lodCount ||
+            !inRange(mesh.lodsOffset, uint64_t(mesh.lodCount) * sizeof(PackMeshLod)) ||
+            !inRange(mesh.animationTexelsOffset, uint64_t(m.vertexAnimationFrameCount) * mesh.vertexCount * 8)) {
+            return false;
+        }
+        const PackMeshLod* lods = at<PackMeshLod>(mesh.lodsOffset);
+        for (uint32_t l = 0; l < mesh.lodCount; ++l) {
+            if (!inRange(lods[l].indicesOffset, uint64_t(lods[l].indexCount) * indexSize)) return false;
+        }
+    }
+
+    const PackTexture* textures = at<PackTexture>(m.texturesOffset);
+    for (uint32_t i = 0; i < m.textureCount; ++i) {
+        if (!validateTexture(textures[i])) return false;
+    }
+
+    const PackJoint* joints = at<PackJoint>(m.jointsOffset);
+    for (uint32_t i = 0; i < m.jointCount; ++i) {
+        if (joints[i].parentIndex >= static_cast<int32_t>(m.jointCount)) return false;
+    }
+
+    const PackClip* clips = at<PackClip>(m.clipsOffset);
+    for (uint32_t c = 0; c < m.clipCount; ++c) {
+        const PackClip& clip = clips[c];
+        if (clip.frameCount > 0) {
+            if (!inRange(clip.tracksOffset, uint64_t(clip.trackCount) * sizeof(PackCompressedTrack)) ||
+                !inRange(clip.rotationKeysOffset, uint64_t(clip.frameCount) * clip.rotationColumns * 6) ||
+                !inRange(clip.translationKeysOffset, uint64_t(clip.frameCount) * clip.translationColumns * 6) ||
+                !inRange(clip.scaleKeysOffset, uint64_t(clip.frameCount) * clip.scaleColumns * 6)) {
+                return false;
+            }
+            const PackCompressedTrack* tracks = at<PackCompressedTrack>(clip.tracksOffset);
+            for (uint32_t i = 0; i < clip.trackCount; ++i) {
+                const PackCompressedTrack& track = tracks[i];
+                if (track.jointIndex < 0 || track.jointIndex >= static_cast<int32_t>(m.jointCount) ||
+                    track.rotationColumn >= static_cast<int32_t>(clip.rotationColumns) ||
+                    track.translationColumn >= static_cast<int32_t>(clip.translationColumns) ||
+                    track.scaleColumn >= static_cast<int32_t>(clip.scaleColumns)) {
+                    return false;
+                }
+            }
+        }
+        if (!inRange(clips[c].channelsOffset, uint64_t(clips[c].channelCount) * sizeof(PackChannel))) {
+            return false;
+        }
+        const PackChannel* channels = at<PackChannel>(clips[c].channelsOffset);
+        for (uint32_t i = 0; i < clips[c].channelCount; ++i) {
+            const PackChannel& ch = channels[i];
+            if (ch.jointIndex < 0 || ch.jointIndex >= static_cast<int32_t>(m.jointCount) ||
+                !inRange(ch.translationTimesOffset, uint64_t(ch.translationCount) * 4) ||
+                !inRange(ch.translationsOffset, uint64_t(ch.translationCount) * 12) ||
+                !inRange(ch.rotationTimesOffset, uint64_t(ch.rotationCount) * 4) ||
+                !inRange(ch.rotationsOffset, uint64_t(ch.rotationCount) * 16) ||
+                !inRange(ch.scaleTimesOffset, uint64_t(ch.scaleCount) * 4) ||
+                !inRange(ch.scalesOffset, uint64_t(ch.scaleCount) * 12)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool AssetPack::validateTexture(const PackTexture& tex) const {
+    if (tex.mipCount == 0 || tex.mipCount > 32 || packFormatUnitBytes(tex.format) == 0) return false;
+    uint64_t expected = 0;
+    for (uint32_t level = 0; level < tex.mipCount; ++level) {
+        expected += packMipSize(tex.format, tex.width, tex.height, level);
+    }
+    return expected == tex.dataSize && inRange(tex.dataOffset, tex.dataSize);
+}
@@ -0,0 +1,320 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Baked asset pack (written by AssetCooker, read here via a memory mapping).
+//
+// Layout (little-endian, every section 16-byte aligned, offsets absolute):
+//   PackHeader
+//   per model: texture mip chains, vertex/index blobs (plus LOD index blobs),
+//              animation keys, vertex animation texels, then its PackTexture/
+//              PackMesh/PackMeshLod/PackJoint/PackClip/PackChannel/
+//              PackCompressedTrack/PackVertexAnimationClip tables
+//   standalone texture mip chains (TextureManifest.h)
+//   PackModel table (header.modelsOffset)
+//   PackNamedTexture table (header.texturesOffset)
+//
+// Everything is stored in the layout the runtime consumes: vertex blobs are
+// interleaved and quantized (PackedVertex) and go straight to glBufferData, textures carry their full mip
+// chain (block-compressed by default, for glCompressedTexImage2D), joint
+// parents are resolved and animation clips are resampled and quantized
+// (AnimationCompressor.h; decoded float keys when cooked without it), and
+// crowd models carry their clips baked into per-vertex frames
+// (VertexAnimationBaker.h).
+// Bump ASSET_PACK_VERSION whenever any of these structs or blob layouts change.
+
+constexpr char ASSET_PACK_MAGIC[8] = {'F', 'I', 'N', 'G', 'P', 'A', 'K', '\0'};
+constexpr uint32_t ASSET_PACK_VERSION = 7;
+constexpr uint64_t ASSET_PACK_ALIGNMENT = 16;
+
+// GL enum values, so the cooker does not need GL headers
+constexpr uint32_t PACK_INDEX_UINT16 = 0x1403;  // GL_UNSIGNED_SHORT
+constexpr uint32_t PACK_INDEX_UINT32 = 0x1405;  // GL_UNSIGNED_INT
+
+// Texture formats (GL internal formats). BC formats store 4x4 texel blocks.
+constexpr uint32_t PACK_FORMAT_RGB8 = 0x8051;   // GL_RGB8
+constexpr uint32_t PACK_FORMAT_RGBA8 = 0x8058;  // GL_RGBA8
+constexpr uint32_t PACK_FORMAT_BC1 = 0x83F0;    // GL_COMPRESSED_RGB_S3TC_DXT1_EXT, 8 bytes/block
+constexpr uint32_t PACK_FORMAT_BC3 = 0x83F3;    // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, 16 bytes/block
+constexpr uint32_t PACK_FORMAT_BC5 = 0x8DBD;    // GL_COMPRESSED_RG_RGTC2, 16 bytes/block (normal map XY)
+constexpr uint32_t PACK_FORMAT_BC7 = 0x8E8C;    // GL_COMPRESSED_RGBA_BPTC_UNORM, 16 bytes/block
+
+// Interleaved, quantized vertex layouts (attribute locations 0..4 of the mesh
+// shaders; VertexFormat.h packs and unpacks them):
+//   position  3 x unorm16 relative to PackMesh::positionOffset/Scale
+//   normal    2 x snorm8, octahedral
+//   uv        2 x half
+//   joints    4 x uint8 (skinned only, integer attribute)
+//   weights   4 x unorm8 (skinned only, sum to 255)
+// = 12 bytes static / 20 bytes skinned (vs 32 / 64 as floats)
+struct PackedVertex {
+    uint16_t position[3];
+    int8_t normal[2];
+    uint16_t uv[2];
+};
+
+struct PackedSkinnedVertex {
+    PackedVertex base;
+    uint8_t joints[4];
+    uint8_t weights[4];
+};
+
+constexpr uint32_t PACK_MESH_SKINNED = 1u << 0;
+
+struct PackHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t modelCount;
+    uint64_t modelsOffset;
+    uint64_t fileSize;
+    uint32_t textureCount;  // Standalone textures
+    uint32_t reserved;
+    uint64_t texturesOffset;
+};
+
+struct PackModel {
+    char name[48];
+    uint64_t sourceSize;    // .glb size/mtime at cook time (stale check)
+    int64_t sourceMtime;
+    float boundsMin[3];
+    float boundsMax[3];
+    uint32_t meshCount;
+    uint32_t textureCount;
+    uint32_t jointCount;
+    uint32_t clipCount;
+    uint64_t meshesOffset;
+    uint64_t texturesOffset;
+    uint64_t jointsOffset;
+    uint64_t clipsOffset;
+    uint32_t vertexAnimationClipCount;   // 0 = not baked, else clipCount
+    uint32_t vertexAnimationFrameCount;  // Frames of every baked clip, back to back
+    uint64_t vertexAnimationClipsOffset; // PackVertexAnimationClip[vertexAnimationClipCount]
+};
+
+struct PackMesh {
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t indexType;     // PACK_INDEX_UINT16 / PACK_INDEX_UINT32
+    uint32_t flags;         // PACK_MESH_*
+    int32_t textureIndex;   // Into the model's textures (-1 = none)
+    uint32_t vertexStride;  // sizeof(PackedVertex) or sizeof(PackedSkinnedVertex)
+    uint64_t verticesOffset;
+    uint64_t indicesOffset;
+    float positionOffset[3];  // position = offset + unorm16 * scale
+    float positionScale[3];
+    uint32_t lodCount;      // Same for every mesh of a model
+    uint32_t reserved;
+    uint64_t lodsOffset;    // PackMeshLod[lodCount], coarsest last
+    float animationPositionOffset[3];  // Baked frames: position = offset + unorm16 * scale
+    float animationPositionScale[3];
+    uint64_t animationTexelsOffset;    // uint16[vertexAnimationFrameCount * vertexCount * 4] (RGBA16UI)
+};
+
+// Simplified level of a PackMesh (MeshSimplifier.h): an index buffer of the
+// mesh's index type over the same vertex blob
+struct PackMeshLod {
+    uint64_t indicesOffset;
+    uint32_t indexCount;
+    float error;            // Model-space deviation from the full mesh
+};
+
+// VertexAnimationClip: frames of the model's baked frame table
+struct PackVertexAnimationClip {
+    uint32_t firstFrame;
+    uint32_t frameCount;
+    float duration;
+    uint32_t reserved;
+};
+
+// Mip levels are stored back to back: RGB8/RGBA8 rows tightly packed (unpack
+// alignment 1), BC formats as rows of 4x4 blocks (see packMipSize)
+struct PackTexture {
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;        // PACK_FORMAT_*
+    uint32_t mipCount;
+    uint64_t dataOffset;
+    uint64_t dataSize;
+};
+
+// Texture that does not belong to a model (TextureManifest.h)
+struct PackNamedTexture {
+    char name[48];
+    uint64_t sourceSize;    // Image file size/mtime at cook time (stale check)
+    int64_t sourceMtime;
+    PackTexture texture;
+};
+
+struct PackJoint {
+    int32_t parentIndex;
+    uint32_t reserved;
+    float inverseBindMatrix[16];  // Column-major
+    float bindPose[16];           // Local bind transform, column-major
+    char name[64];
+};
+
+// A clip is either compressed (frameCount > 0, CompressedClip layout: key
+// arrays are uint16 triples, frame-major) or source channels
+struct PackClip {
+    char name[64];
+    float duration;
+    uint32_t channelCount;
+    uint64_t channelsOffset;
+    float sampleRate;
+    uint32_t frameCount;
+    uint32_t trackCount;
+    uint32_t rotationColumns;
+    uint32_t translationColumns;
+    uint32_t scaleColumns;
+    uint64_t tracksOffset;            // PackCompressedTrack[trackCount]
+    uint64_t rotationKeysOffset;      // uint16[frameCount * rotationColumns * 3]
+    uint64_t translationKeysOffset;   // uint16[frameCount * translationColumns * 3]
+    uint64_t scaleKeysOffset;         // uint16[frameCount * scaleColumns * 3]
+};
+
+// CompressedTrack; the rotation is x, y, z, w
+struct PackCompressedTrack {
+    int32_t jointIndex;
+    int32_t rotationColumn;
+    int32_t translationColumn;
+    int32_t scaleColumn;
+    float constantRotation[4];
+    float constantTranslation[3];
+    float constantScale[3];
+    float translationMin[3];
+    float translationExtent[3];
+    float scaleMin[3];
+    float scaleExtent[3];
+};
+
+// Key arrays: times are floats, translations/scales are vec3, rotations are quat (x, y, z, w)
+struct PackChannel {
+    int32_t jointIndex;
+    uint32_t translationCount;
+    uint32_t rotationCount;
+    uint32_t scaleCount;
+    uint64_t translationTimesOffset;
+    uint64_t translationsOffset;
+    uint64_t rotationTimesOffset;
+    uint64_t rotationsOffset;
+    uint64_t scaleTimesOffset;
+    uint64_t scalesOffset;
+};
+
+static_assert(sizeof(PackedVertex) == 12, "PackedVertex layout changed");
+static_assert(sizeof(PackedSkinnedVertex) == 20, "PackedSkinnedVertex layout changed");
+static_assert(sizeof(PackHeader) == 48, "PackHeader layout changed");
+static_assert(sizeof(PackModel) == 152, "PackModel layout changed");
+static_assert(sizeof(PackMesh) == 112, "PackMesh layout changed");
+static_assert(sizeof(PackMeshLod) == 16, "PackMeshLod layout changed");
+static_assert(sizeof(PackVertexAnimationClip) == 16, "PackVertexAnimationClip layout changed");
+static_assert(sizeof(PackTexture) == 32, "PackTexture layout changed");
+static_assert(sizeof(PackNamedTexture) == 96, "PackNamedTexture layout changed");
+static_assert(sizeof(PackJoint) == 200, "PackJoint layout changed");
+static_assert(sizeof(PackClip) == 136, "PackClip layout changed");
+static_assert(sizeof(PackCompressedTrack) == 104, "PackCompressedTrack layout changed");
+static_assert(sizeof(PackChannel) == 64, "PackChannel layout changed");
+
+inline bool packFormatCompressed(uint32_t format) {
+    return format == PACK_FORMAT_BC1 || format == PACK_FORMAT_BC3 ||
+           format == PACK_FORMAT_BC5 || format == PACK_FORMAT_BC7;
+}
+
+// Bytes per texel (RGB8/RGBA8) or per 4x4 block (BC formats); 0 = unknown format
+inline uint32_t packFormatUnitBytes(uint32_t format) {
+    switch (format) {
+        case PACK_FORMAT_RGB8: return 3;
+        case PACK_FORMAT_RGBA8: return 4;
+        case PACK_FORMAT_BC1: return 8;
+        case PACK_FORMAT_BC3:
+        case PACK_FORMAT_BC5:
+        case PACK_FORMAT_BC7: return 16;
+        default: return 0;
+    }
+}
+
+// Byte size of one row of texels, or of 4x4 blocks for BC formats
+inline uint64_t packRowSize(uint32_t format, uint32_t width) {
+    uint64_t units = packFormatCompressed(format) ? (uint64_t(width) + 3) / 4 : width;
+    return units * packFormatUnitBytes(format);
+}
+
+// Texel rows (uncompressed) or block rows (BC) in a mip level of the given height
+inline uint32_t packRowCount(uint32_t format, uint32_t height) {
+    return packFormatCompressed(format) ? (height + 3) / 4 : height;
+}
+
+// Byte size of a stored mip level
+inline uint64_t packMipSize(uint32_t format, uint32_t width, uint32_t height, uint32_t level) {
+    uint32_t w = std::max(width >> level, 1u);
+    uint32_t h = std::max(height >> level, 1u);
+    return packRowSize(format, w) * packRowCount(format, h);
+}
+
+// Source file size and modification time (seconds since the Unix epoch)
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+};
+bool statSourceFile(const std::string& path, SourceStamp& out);
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const unsigned char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+// Validated view over a mapped pack. Table offsets/counts are range-checked on
+// open, so accessors can index without further checks.
+class AssetPack {
+public:
+    bool open(const std::string& path);
+    void close() { m_file.close(); m_header = nullptr; }
+
+    bool isOpen() const { return m_header != nullptr; }
+    uint32_t modelCount() const { return m_header ? m_header->modelCount : 0; }
+    const PackModel& model(uint32_t index) const { return at<PackModel>(m_header->modelsOffset)[index]; }
+    const PackModel* findModel(const std::string& name) const;
+
+    uint32_t textureCount() const { return m_header ? m_header->textureCount : 0; }
+    const PackNamedTexture& texture(uint32_t index) const { return at<PackNamedTexture>(m_header->texturesOffset)[index]; }
+    const PackNamedTexture* findTexture(const std::string& name) const;
+
+    // True when the source file is unchanged since cooking (or absent)
+    bool isCurrent(const PackModel& model, const std::string& sourcePath) const;
+    bool isCurrent(const PackNamedTexture& texture, const std::string& sourcePath) const;
+
+    // Faults the model's vertex/index/texture blobs into memory (run on a worker
+    // so the GL thread's uploads do not wait on disk reads)
+    void prefetch(const PackModel& model) const;
+    void prefetch(const PackTexture& texture) const { touch(texture.dataOffset, texture.dataSize); }
+
+    template <typename T>
+    const T* at(uint64_t offset) const { return reinterpret_cast<const T*>(m_file.data() + offset); }
+
+private:
+    bool inRange(uint64_t offset, uint64_t bytes) const;
+    void touch(uint64_t offset, uint64_t bytes) const;
+    bool validateModel(const PackModel& model) const;
+    bool validateTexture(const PackTexture& texture) const;
+
+    MappedFile m_file;
+    const PackHeader* m_header = nullptr;
+};
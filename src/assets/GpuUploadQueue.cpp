@@ -0,0 +1,208 @@
+#include "GpuUploadQueue.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+constexpr GLbitfield STAGING_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+constexpr GLuint64 FENCE_WAIT_NS = 1000000000ull;
+
+} // anonymous namespace
+
+bool GpuUploadQueue::init(size_t segmentBytes) {
+    shutdown();
+
+    const size_t totalBytes = segmentBytes * SEGMENT_COUNT;
+    glCreateBuffers(1, &m_staging);
+    glNamedBufferStorage(m_staging, static_cast<GLsizeiptr>(totalBytes), nullptr, STAGING_FLAGS);
+    m_mapped = static_cast<unsigned char*>(glMapNamedBufferRange(m_staging, 0, static_cast<GLsizeiptr>(totalBytes), STAGING_FLAGS));
+    if (!m_mapped) {
+        std::cerr << "GpuUploadQueue: Failed to map " << totalBytes << " byte staging buffer" << std::endl;
+        glDeleteBuffers(1, &m_staging);
+        m_staging = 0;
+        return false;
+    }
+
+    m_segmentBytes = segmentBytes;
+    for (size_t i = 0; i < SEGMENT_COUNT; ++i) {
+        m_segments[i] = {i * segmentBytes, nullptr};
+    }
+    m_current = 0;
+    m_used = 0;
+    m_acquired = false;
+    return true;
+}
+
+void GpuUploadQueue::shutdown() {
+    if (!m_staging) return;
+    for (Segment& seg : m_segments) {
+        if (seg.fence) glDeleteSync(seg.fence);
+        seg.fence = nullptr;
+    }
+    glUnmapNamedBuffer(m_staging);
+    glDeleteBuffers(1, &m_staging);
+    m_staging = 0;
+    m_mapped = nullptr;
+    m_jobs.clear();
+}
+
+void GpuUploadQueue::uploadBuffer(GLuint buffer, const void* data, size_t size) {
+    if (size == 0) return;
+    Job job{Job::Buffer};
+    job.target = buffer;
+    job.data = static_cast<const unsigned char*>(data);
+    job.size = size;
+    m_jobs.push_back(std::move(job));
+    m_queuedBytes += size;
+}
+
+void GpuUploadQueue::uploadTexture(GLuint texture, GLint level, GLsizei width, GLsizei height, GLenum format,
+                                   const void* pixels, uint32_t bytesPerPixel) {
+    Job job{Job::Texture};
+    job.target = texture;
+    job.level = level;
+    job.width = width;
+    job.height = height;
+    job.format = format;
+    job.rowBytes = size_t(width) * bytesPerPixel;
+    job.data = static_cast<const unsigned char*>(pixels);
+    job.size = job.rowBytes * size_t(height);
+    if (job.size == 0) return;
+    m_queuedBytes += job.size;
+    m_jobs.push_back(std::move(job));
+}
+
+void GpuUploadQueue::uploadCompressedTexture(GLuint texture, GLint level, GLsizei width, GLsizei height, GLenum format,
+                                             const void* blocks, size_t blockRowBytes) {
+    Job job{Job::Texture};
+    job.target = texture;
+    job.level = level;
+    job.width = width;
+    job.height = height;
+    job.format = format;
+    job.compressed = true;
+    job.rowBytes = blockRowBytes;
+    job.data = static_cast<const unsigned char*>(blocks);
+    job.size = blockRowBytes * ((size_t(height) + 3) / 4);
+    if (job.size == 0) return;
+    m_queuedBytes += job.size;
+    m_jobs.push_back(std::move(job));
+}
+
+void GpuUploadQueue::onComplete(std::function<void()> fn) {
+    Job job{Job::Callback};
+    job.callback = std::move(fn);
+    m_jobs.push_back(std::move(job));
+}
+
+bool GpuUploadQueue::process(double budgetMs) {
+    const bool drain = budgetMs < 0.0;
+    auto start = std::chrono::steady_clock::now();
+
+    while (!m_jobs.empty()) {
+        Job& job = m_jobs.front();
+        if (job.kind == Job::Callback) {
+            auto fn = std::move(job.callback);
+            m_jobs.pop_front();
+            fn();
+            continue;
+        }
+
+        if (!m_acquired && !acquireSegment(drain)) break;  // GPU still reading every segment
+
+        size_t issued = issue(job);
+        if (issued == 0) {
+            if (m_used == 0) {
+                // A single texture row larger than a whole segment can never be staged
+                std::cerr << "GpuUploadQueue: " << job.rowBytes << " byte row exceeds the "
+                          << m_segmentBytes << " byte staging segment, skipping upload" << std::endl;
+                m_uploadedBytes += job.size - job.done;
+                m_jobs.pop_front();
+                continue;
+            }
+            releaseSegment();  // Current segment is full
+            continue;
+        }
+
+        m_used += issued;
+        job.done += issued;
+        m_uploadedBytes += issued;
+        if (job.done == job.size) m_jobs.pop_front();
+
+        if (!drain && std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() >= budgetMs) {
+            break;
+        }
+    }
+
+    releaseSegment();
+    return m_jobs.empty();
+}
+
+// Copies the next slice of `job` into the current segment and issues its GL copy.
+// Returns the bytes issued (0 = not enough room left in the segment).
+size_t GpuUploadQueue::issue(Job& job) {
+    const size_t space = m_segmentBytes - m_used;
+    const size_t srcOffset = m_segments[m_current].offset + m_used;
+
+    if (job.kind == Job::Buffer) {
+        size_t bytes = std::min(space, job.size - job.done);
+        std::memcpy(m_mapped + srcOffset, job.data + job.done, bytes);
+        glCopyNamedBufferSubData(m_staging, job.target, static_cast<GLintptr>(srcOffset),
+                                 static_cast<GLintptr>(job.done), static_cast<GLsizeiptr>(bytes));
+        return bytes;
+    }
+
+    size_t rows = std::min(space / job.rowBytes, (job.size - job.done) / job.rowBytes);
+    if (rows == 0) return 0;
+    size_t bytes = rows * job.rowBytes;
+    std::memcpy(m_mapped + srcOffset, job.data + job.done, bytes);
+
+    const GLint firstRow = static_cast<GLint>(job.done / job.rowBytes);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_staging);
+    if (job.compressed) {
+        // Block rows are 4 texels tall; the last one may cover fewer
+        GLint y = firstRow * 4;
+        GLsizei height = std::min(static_cast<GLsizei>(rows * 4), job.height - y);
+        glCompressedTextureSubImage2D(job.target, job.level, 0, y, job.width, height, job.format,
+                                      static_cast<GLsizei>(bytes), reinterpret_cast<const void*>(srcOffset));
+    } else {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTextureSubImage2D(job.target, job.level, 0, firstRow, job.width, static_cast<GLsizei>(rows),
+                            job.format, GL_UNSIGNED_BYTE, reinterpret_cast<const void*>(srcOffset));
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return bytes;
+}
+
+// Waits for the GPU to finish reading the current segment's previous contents
+bool GpuUploadQueue::acquireSegment(bool wait) {
+    Segment& seg = m_segments[m_current];
+    if (seg.fence) {
+        for (;;) {
+            GLenum status = glClientWaitSync(seg.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? FENCE_WAIT_NS : 0);
+            if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) break;
+            if (status == GL_WAIT_FAILED) {
+                std::cerr << "GpuUploadQueue: glClientWaitSync failed" << std::endl;
+                break;
+            }
+            if (!wait) return false;
+        }
+        glDeleteSync(seg.fence);
+        seg.fence = nullptr;
+    }
+    m_acquired = true;
+    return true;
+}
+
+// Fences the copies issued from the current segment and moves on to the next one
+void GpuUploadQueue::releaseSegment() {
+    if (m_used == 0) return;
+    m_segments[m_current].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_current = (m_current + 1) % SEGMENT_COUNT;
+    m_used = 0;
+    m_acquired = false;
+}
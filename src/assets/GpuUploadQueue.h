@@ -0,0 +1,94 @@
+#pragma once
+#include <glad/glad.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+// Streams buffer and texture contents to the GPU a slice at a time.
+//
+// Data is copied into a persistently mapped staging buffer, which then serves
+// as the copy source for buffers (glCopyNamedBufferSubData) and as the pixel
+// unpack buffer for textures (glTextureSubImage2D, whole rows per slice, or
+// glCompressedTextureSubImage2D, whole rows of 4x4 blocks per slice). The
+// staging buffer is split into SEGMENT_COUNT segments; each process() call fills
+// at most the current segment and fences it, and a segment is only refilled once
+// the GPU has consumed it, so streaming never waits on the driver mid-frame.
+//
+// Destination objects must already have storage (glBufferData / glTexImage2D /
+// glCompressedTexImage2D with null data). Source memory must stay valid until its upload has been
+// processed; onComplete() callbacks run in queue order, so a callback queued
+// after an object's uploads marks the point where that object is complete.
+class GpuUploadQueue {
+public:
+    static constexpr size_t SEGMENT_COUNT = 3;
+
+    GpuUploadQueue() = default;
+    ~GpuUploadQueue() { shutdown(); }
+
+    GpuUploadQueue(const GpuUploadQueue&) = delete;
+    GpuUploadQueue& operator=(const GpuUploadQueue&) = delete;
+
+    bool init(size_t segmentBytes);
+    void shutdown();
+    bool isInitialized() const { return m_staging != 0; }
+
+    void uploadBuffer(GLuint buffer, const void* data, size_t size);
+    // Tightly packed GL_UNSIGNED_BYTE rows (uploaded with unpack alignment 1)
+    void uploadTexture(GLuint texture, GLint level, GLsizei width, GLsizei height, GLenum format,
+                       const void* pixels, uint32_t bytesPerPixel);
+    // BC-compressed level: ceil(height / 4) rows of blockRowBytes each
+    void uploadCompressedTexture(GLuint texture, GLint level, GLsizei width, GLsizei height, GLenum format,
+                                 const void* blocks, size_t blockRowBytes);
+    void onComplete(std::function<void()> fn);
+
+    // Issues uploads until budgetMs elapsed or the ready staging space is used up.
+    // budgetMs < 0 drains the queue, waiting on the GPU for staging space.
+    // Returns true once the queue is empty.
+    bool process(double budgetMs);
+
+    bool empty() const { return m_jobs.empty(); }
+
+    // Running byte totals (uploads are FIFO, so a snapshot of queuedBytes()
+    // taken before queueing marks where that batch starts in uploadedBytes())
+    uint64_t queuedBytes() const { return m_queuedBytes; }
+    uint64_t uploadedBytes() const { return m_uploadedBytes; }
+
+private:
+    struct Job {
+        enum Kind { Buffer, Texture, Callback } kind;
+        GLuint target = 0;
+        GLint level = 0;
+        GLsizei width = 0;
+        GLsizei height = 0;
+        GLenum format = 0;
+        bool compressed = false;
+        size_t rowBytes = 0;        // One texel row, or one row of 4x4 blocks
+        const unsigned char* data = nullptr;
+        size_t size = 0;
+        size_t done = 0;  // Bytes issued so far
+        std::function<void()> callback;
+    };
+
+    struct Segment {
+        size_t offset = 0;
+        GLsync fence = nullptr;
+    };
+
+    bool acquireSegment(bool wait);
+    void releaseSegment();
+    size_t issue(Job& job);
+
+    std::deque<Job> m_jobs;
+    GLuint m_staging = 0;
+    unsigned char* m_mapped = nullptr;
+    std::array<Segment, SEGMENT_COUNT> m_segments{};
+    size_t m_segmentBytes = 0;
+    size_t m_current = 0;      // Segment being filled
+    size_t m_used = 0;         // Bytes written into it
+    bool m_acquired = false;   // Its previous fence has been waited on
+
+    uint64_t m_queuedBytes = 0;
+    uint64_t m_uploadedBytes = 0;
+};
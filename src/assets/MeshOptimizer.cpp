@@ -0,0 +1,411 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t INVALID_INDEX = ~0u;
+
+// FIFO cache simulation: a vertex is resident while fewer than cacheSize
+// misses happened since it was loaded. Bumping `time` past cacheSize empties it.
+struct FifoCache {
+    std::vector<uint32_t> loadTime;
+    uint32_t time;
+    uint32_t size;
+
+    FifoCache(size_t vertexCount, uint32_t cacheSize)
+        : loadTime(vertexCount, 0), time(cacheSize + 1), size(cacheSize) {}
+
+    uint32_t access(uint32_t v) {
+        if (time - loadTime[v] > size) {
+            loadTime[v] = time++;
+            return 1;
+        }
+        return 0;
+    }
+    uint32_t triangle(const uint32_t* tri) { return access(tri[0]) + access(tri[1]) + access(tri[2]); }
+    void flush() { time += size + 1; }
+};
+
+// Every triangle of `mesh` as the bytes of its three vertex records, rotated
+// so the smallest record comes first (same triangle, same winding), sorted
+std::vector<std::string> triangleRecords(const DecodedMesh& mesh) {
+    const size_t stride = mesh.vertexStride();
+    std::vector<uint32_t> indices = readIndices(mesh.indexData, mesh.indexCount, mesh.indexType);
+    std::vector<std::string> triangles(indices.size() / 3);
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        std::string corners[3];
+        for (int k = 0; k < 3; ++k) {
+            corners[k].assign(reinterpret_cast<const char*>(&mesh.vertices[size_t(indices[t * 3 + k]) * stride]), stride);
+        }
+        int first = 0;
+        if (corners[1] < corners[first]) first = 1;
+        if (corners[2] < corners[first]) first = 2;
+        for (int k = 0; k < 3; ++k) triangles[t] += corners[(first + k) % 3];
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// === Forsyth scoring ===
+constexpr int FORSYTH_CACHE_SIZE = 32;
+constexpr int FORSYTH_MAX_VALENCE = 32;
+
+struct ForsythTables {
+    float cache[FORSYTH_CACHE_SIZE + 1];      // [0..size-1] by position, [size] = not cached
+    float valence[FORSYTH_MAX_VALENCE + 1];
+
+    ForsythTables() {
+        for (int i = 0; i < FORSYTH_CACHE_SIZE; ++i) {
+            // The last triangle's vertices get a fixed score so the next
+            // triangle does not simply reuse the same edge every time
+            cache[i] = (i < 3) ? 0.75f
+                               : std::pow(1.0f - float(i - 3) / float(FORSYTH_CACHE_SIZE - 3), 1.5f);
+        }
+        cache[FORSYTH_CACHE_SIZE] = 0.0f;
+        valence[0] = 0.0f;
+        for (int i = 1; i <= FORSYTH_MAX_VALENCE; ++i) {
+            valence[i] = 2.0f / std::sqrt(float(i));  // Favour finishing off nearly-done vertices
+        }
+    }
+
+    float score(int cachePosition, uint32_t remaining) const {
+        if (remaining == 0) return -1.0f;
+        int c = (cachePosition < 0) ? FORSYTH_CACHE_SIZE : cachePosition;
+        return cache[c] + valence[std::min<uint32_t>(remaining, FORSYTH_MAX_VALENCE)];
+    }
+};
+
+} // anonymous namespace
+
+VertexCacheStats analyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize) {
+    VertexCacheStats stats;
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return stats;
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<bool> used(vertexCount, false);
+    size_t misses = 0, unique = 0;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        misses += cache.triangle(&indices[t * 3]);
+        for (int k = 0; k < 3; ++k) {
+            if (!used[indices[t * 3 + k]]) {
+                used[indices[t * 3 + k]] = true;
+                ++unique;
+            }
+        }
+    }
+    stats.acmr = float(misses) / float(triangleCount);
+    stats.atvr = float(misses) / float(unique);
+    return stats;
+}
+
+std::vector<uint32_t> optimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount) {
+    static const ForsythTables tables;
+    const size_t triangleCount = indices.size() / 3;
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+    if (triangleCount == 0) return result;
+
+    // Vertex -> triangle adjacency (CSR); each vertex's live triangles are
+    // kept at the front of its range
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (uint32_t index : indices) ++remaining[index];
+    std::vector<uint32_t> firstTriangle(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) firstTriangle[v + 1] = firstTriangle[v] + remaining[v];
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> fill(firstTriangle.begin(), firstTriangle.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) vertexScore[v] = tables.score(-1, remaining[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    uint32_t best = 0;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t* tri = &indices[t * 3];
+        triangleScore[t] = vertexScore[tri[0]] + vertexScore[tri[1]] + vertexScore[tri[2]];
+        if (triangleScore[t] > triangleScore[best]) best = static_cast<uint32_t>(t);
+    }
+
+    std::vector<uint32_t> cache, nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+    size_t cursor = 0;  // Fallback when nothing in the cache has live triangles
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (best == INVALID_INDEX) {
+            while (emitted[cursor]) ++cursor;
+            best = static_cast<uint32_t>(cursor);
+        }
+
+        const uint32_t* tri = &indices[size_t(best) * 3];
+        result.insert(result.end(), tri, tri + 3);
+        emitted[best] = true;
+
+        // Retire the triangle from its vertices' live lists
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = tri[k];
+            uint32_t begin = firstTriangle[v];
+            uint32_t end = begin + remaining[v];
+            uint32_t* slot = std::find(adjacency.data() + begin, adjacency.data() + end, best);
+            std::swap(*slot, adjacency[end - 1]);
+            --remaining[v];
+        }
+
+        // New LRU order: the emitted triangle in front, then the old cache
+        nextCache.clear();
+        for (int k = 0; k < 3; ++k) {
+            if (std::find(nextCache.begin(), nextCache.end(), tri[k]) == nextCache.end()) nextCache.push_back(tri[k]);
+        }
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) nextCache.push_back(v);
+        }
+        std::swap(cache, nextCache);
+
+        // Rescore every vertex whose position (or live count) changed,
+        // including the ones that just fell out of the cache
+        for (size_t i = 0; i < cache.size(); ++i) {
+            uint32_t v = cache[i];
+            int position = (i < FORSYTH_CACHE_SIZE) ? static_cast<int>(i) : -1;
+            float score = tables.score(position, remaining[v]);
+            float delta = score - vertexScore[v];
+            vertexScore[v] = score;
+            for (uint32_t a = firstTriangle[v], e = a + remaining[v]; a < e; ++a) triangleScore[adjacency[a]] += delta;
+        }
+        if (cache.size() > FORSYTH_CACHE_SIZE) cache.resize(FORSYTH_CACHE_SIZE);
+
+        // Next triangle: the best live one touching the cache
+        best = INVALID_INDEX;
+        float bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            for (uint32_t a = firstTriangle[v], e = a + remaining[v]; a < e; ++a) {
+                uint32_t t = adjacency[a];
+                if (triangleScore[t] > bestScore || (triangleScore[t] == bestScore && t < best)) {
+                    bestScore = triangleScore[t];
+                    best = t;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<uint32_t> optimizeOverdraw(const std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions,
+                                       float threshold) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) return indices;
+    const uint32_t cacheSize = VERTEX_CACHE_ANALYZE_SIZE;
+
+    // Hard boundaries: triangles that miss on all three vertices start over
+    // anyway, so reordering clusters there costs nothing
+    std::vector<size_t> hard;
+    {
+        FifoCache cache(positions.size(), cacheSize);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            if (cache.triangle(&indices[t * 3]) == 3 || t == 0) hard.push_back(t);
+        }
+    }
+
+    // Soft boundaries: inside each hard cluster, cut as soon as the running
+    // ACMR (from an empty cache) is within threshold of the cluster's
+    std::vector<size_t> starts;
+    FifoCache cache(positions.size(), cacheSize);
+    for (size_t c = 0; c < hard.size(); ++c) {
+        size_t begin = hard[c];
+        size_t end = (c + 1 < hard.size()) ? hard[c + 1] : triangleCount;
+
+        cache.flush();
+        uint32_t clusterMisses = 0;
+        for (size_t t = begin; t < end; ++t) clusterMisses += cache.triangle(&indices[t * 3]);
+        float target = threshold * float(clusterMisses) / float(end - begin);
+
+        starts.push_back(begin);
+        cache.flush();
+        uint32_t misses = 0, count = 0;
+        for (size_t t = begin; t < end; ++t) {
+            misses += cache.triangle(&indices[t * 3]);
+            ++count;
+            if (float(misses) / float(count) <= target) {
+                starts.push_back(t + 1);
+                cache.flush();
+                misses = count = 0;
+            }
+        }
+        // The trailing partial cluster has the worst ACMR: merge it into the
+        // previous one (this also drops a boundary that landed on `end`)
+        if (starts.back() != begin) starts.pop_back();
+    }
+
+    // Area-weighted centroid and average normal per cluster
+    struct Cluster {
+        size_t begin, end;
+        glm::vec3 centroid;
+        glm::vec3 normal;
+        float sortKey;
+    };
+    std::vector<Cluster> clusters(starts.size());
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < starts.size(); ++c) {
+        Cluster& cluster = clusters[c];
+        cluster.begin = starts[c];
+        cluster.end = (c + 1 < starts.size()) ? starts[c + 1] : triangleCount;
+        glm::vec3 weighted(0.0f), normal(0.0f);
+        float area = 0.0f;
+        for (size_t t = cluster.begin; t < cluster.end; ++t) {
+            const glm::vec3& a = positions[indices[t * 3 + 0]];
+            const glm::vec3& b = positions[indices[t * 3 + 1]];
+            const glm::vec3& d = positions[indices[t * 3 + 2]];
+            glm::vec3 n = glm::cross(b - a, d - a);
+            float twiceArea = glm::length(n);
+            weighted += (a + b + d) * (twiceArea / 3.0f);
+            normal += n;
+            area += twiceArea;
+        }
+        cluster.centroid = (area > 0.0f) ? weighted / area : positions[indices[cluster.begin * 3]];
+        float normalLength = glm::length(normal);
+        cluster.normal = (normalLength > 0.0f) ? normal / normalLength : glm::vec3(0.0f);
+        meshCentroid += weighted;
+        meshArea += area;
+    }
+    if (meshArea > 0.0f) meshCentroid /= meshArea;
+    for (Cluster& cluster : clusters) {
+        cluster.sortKey = glm::dot(cluster.centroid - meshCentroid, cluster.normal);
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (const Cluster& cluster : clusters) {
+        result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+    }
+    return result;
+}
+
+std::vector<uint32_t> optimizeVertexFetch(std::vector<uint32_t>& indices, size_t vertexCount) {
+    std::vector<uint32_t> oldToNew(vertexCount, INVALID_INDEX);
+    std::vector<uint32_t> newToOld;
+    newToOld.reserve(vertexCount);
+    for (uint32_t& index : indices) {
+        if (oldToNew[index] == INVALID_INDEX) {
+            oldToNew[index] = static_cast<uint32_t>(newToOld.size());
+            newToOld.push_back(index);
+        }
+        index = oldToNew[index];
+    }
+    return newToOld;
+}
+
+std::vector<uint32_t> readIndices(const std::vector<unsigned char>& data, uint32_t count, uint32_t indexType) {
+    std::vector<uint32_t> indices(count);
+    if (indexType == PACK_INDEX_UINT32) {
+        std::memcpy(indices.data(), data.data(), indices.size() * sizeof(uint32_t));
+    } else {
+        const uint16_t* narrow = reinterpret_cast<const uint16_t*>(data.data());
+        std::copy(narrow, narrow + indices.size(), indices.begin());
+    }
+    return indices;
+}
+
+std::vector<unsigned char> writeIndices(const std::vector<uint32_t>& indices, uint32_t indexType) {
+    std::vector<unsigned char> data;
+    if (indexType == PACK_INDEX_UINT32) {
+        data.resize(indices.size() * sizeof(uint32_t));
+        std::memcpy(data.data(), indices.data(), data.size());
+    } else {
+        std::vector<uint16_t> narrow(indices.begin(), indices.end());
+        data.resize(narrow.size() * sizeof(uint16_t));
+        std::memcpy(data.data(), narrow.data(), data.size());
+    }
+    return data;
+}
+
+std::vector<glm::vec3> meshPositions(const DecodedMesh& mesh) {
+    const size_t stride = mesh.vertexStride();
+    std::vector<glm::vec3> positions(mesh.vertexCount());
+    for (size_t v = 0; v < positions.size(); ++v) {
+        PackedVertex packed;
+        std::memcpy(&packed, &mesh.vertices[v * stride], sizeof(packed));
+        positions[v] = unpackPosition(packed, mesh.positionOffset, mesh.positionScale);
+    }
+    return positions;
+}
+
+MeshOptimizeStats optimizeMesh(DecodedMesh& mesh) {
+    MeshOptimizeStats stats;
+    const size_t vertexCount = mesh.vertexCount();
+    if (mesh.indexCount < 3 || vertexCount == 0) return stats;
+
+    std::vector<uint32_t> indices = readIndices(mesh.indexData, mesh.indexCount, mesh.indexType);
+    indices.resize(indices.size() / 3 * 3);
+    for (uint32_t index : indices) {
+        if (index >= vertexCount) return stats;  // Leave malformed meshes untouched
+    }
+
+    const size_t stride = mesh.vertexStride();
+    std::vector<glm::vec3> positions = meshPositions(mesh);
+
+    stats.triangles = static_cast<uint32_t>(indices.size() / 3);
+    stats.before = analyzeVertexCache(indices, vertexCount);
+    indices = optimizeVertexCache(indices, vertexCount);
+    indices = optimizeOverdraw(indices, positions);
+    std::vector<uint32_t> newToOld = optimizeVertexFetch(indices, vertexCount);
+    stats.after = analyzeVertexCache(indices, newToOld.size());
+
+    std::vector<unsigned char> vertices(newToOld.size() * stride);
+    for (size_t v = 0; v < newToOld.size(); ++v) {
+        std::memcpy(&vertices[v * stride], &mesh.vertices[size_t(newToOld[v]) * stride], stride);
+    }
+    mesh.vertices = std::move(vertices);
+
+    mesh.indexCount = static_cast<uint32_t>(indices.size());
+    mesh.indexData = writeIndices(indices, mesh.indexType);
+    return stats;
+}
+
+bool verifyOptimizeMesh(const DecodedMesh& mesh, std::string& error) {
+    const size_t vertexCount = mesh.vertexCount();
+    std::vector<uint32_t> indices = readIndices(mesh.indexData, mesh.indexCount, mesh.indexType);
+    for (uint32_t index : indices) {
+        if (index >= vertexCount) {
+            error = "index out of range in the input";
+            return false;
+        }
+    }
+
+    DecodedMesh first = mesh;
+    DecodedMesh second = mesh;
+    MeshOptimizeStats stats = optimizeMesh(first);
+    optimizeMesh(second);
+
+    if (first.indexCount != mesh.indexCount / 3 * 3) {
+        error = "index count changed";
+        return false;
+    }
+    if (first.vertexCount() > vertexCount) {
+        error = "vertex count grew";
+        return false;
+    }
+    if (triangleRecords(first) != triangleRecords(mesh)) {
+        error = "triangles are not a permutation of the input";
+        return false;
+    }
+    if (stats.after.acmr > stats.before.acmr) {
+        error = "ACMR increased from " + std::to_string(stats.before.acmr) + " to " + std::to_string(stats.after.acmr);
+        return false;
+    }
+    if (first.vertices != second.vertices || first.indexData != second.indexData) {
+        error = "two runs differ";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,530 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <tuple>
+
+namespace {
+
+constexpr uint32_t INVALID_INDEX = ~0u;
+
+// Open edges add a plane quadric perpendicular to their triangle, weighted by
+// squared edge length (face quadrics are weighted by area)
+constexpr double BORDER_EDGE_WEIGHT = 10.0;
+constexpr double SEAM_EDGE_WEIGHT = 1.0;
+
+// A skinned collapse costs as if the vertex moved this many edge lengths for
+// a complete change of joint binding (scaled by how much the weights differ)
+constexpr double SKIN_PENALTY = 2.0;
+
+// A pass accepts collapses up to this factor of the cost of the one that
+// would reach the target, so one pass cannot run far past cheaper collapses
+constexpr double PASS_ERROR_SLACK = 1.5;
+constexpr int MAX_PASSES_PER_LEVEL = 256;
+
+// Manifold: closed fan, collapses anywhere. Border: on an open edge, only
+// collapses along it. Seam: two vertices at one position with different
+// attributes, collapses along the seam (both sides at once). Locked: corners,
+// seam ends, non-manifold and everything else.
+enum class VertexKind : uint8_t { Manifold, Border, Seam, Locked };
+
+struct Quadric {
+    double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0, c = 0.0;
+    double weight = 0.0;
+
+    // Squared distance to the plane dot(n, p) + d = 0 (n unit length)
+    static Quadric plane(const glm::dvec3& n, double d, double w) {
+        Quadric q;
+        q.a00 = w * n.x * n.x;
+        q.a11 = w * n.y * n.y;
+        q.a22 = w * n.z * n.z;
+        q.a01 = w * n.x * n.y;
+        q.a02 = w * n.x * n.z;
+        q.a12 = w * n.y * n.z;
+        q.b0 = w * n.x * d;
+        q.b1 = w * n.y * d;
+        q.b2 = w * n.z * d;
+        q.c = w * d * d;
+        q.weight = w;
+        return q;
+    }
+
+    void add(const Quadric& q) {
+        a00 += q.a00; a11 += q.a11; a22 += q.a22;
+        a01 += q.a01; a02 += q.a02; a12 += q.a12;
+        b0 += q.b0; b1 += q.b1; b2 += q.b2;
+        c += q.c;
+        weight += q.weight;
+    }
+
+    // Weighted mean squared distance from `p` to the accumulated planes
+    double error(const glm::vec3& p) const {
+        if (weight <= 0.0) return 0.0;
+        const double x = p.x, y = p.y, z = p.z;
+        double r = a00 * x * x + a11 * y * y + a22 * z * z +
+                   2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                   2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        return std::max(r, 0.0) / weight;
+    }
+};
+
+// Outgoing half-edges per vertex (CSR) of the input triangles
+struct HalfEdges {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> targets;
+
+    HalfEdges(const std::vector<uint32_t>& indices, size_t vertexCount)
+        : offsets(vertexCount + 1, 0), targets(indices.size()) {
+        for (uint32_t index : indices) ++offsets[index + 1];
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < indices.size() / 3; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                targets[fill[indices[t * 3 + k]]++] = indices[t * 3 + (k + 1) % 3];
+            }
+        }
+    }
+
+    bool has(uint32_t a, uint32_t b) const {
+        for (uint32_t e = offsets[a]; e < offsets[a + 1]; ++e) {
+            if (targets[e] == b) return true;
+        }
+        return false;
+    }
+};
+
+class Simplifier {
+public:
+    Simplifier(const std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions,
+               const std::vector<VertexSkin>* skin)
+        : m_indices(indices), m_positions(positions), m_skin(skin) {
+        buildWedges();
+        HalfEdges edges(m_indices, m_positions.size());
+        classify(edges);
+        buildQuadrics(edges);
+    }
+
+    size_t triangleCount() const { return m_indices.size() / 3; }
+    const std::vector<uint32_t>& indices() const { return m_indices; }
+    double maxCost() const { return m_maxCost; }
+
+    // One round of non-overlapping collapses, cheapest first, towards
+    // `target` triangles. Returns false if nothing could collapse.
+    bool pass(size_t target);
+
+private:
+    void buildWedges();
+    void classify(const HalfEdges& edges);
+    void buildQuadrics(const HalfEdges& edges);
+
+    // Any half-edge between the positions of a and b, in that direction
+    bool hasPositionEdge(const HalfEdges& edges, uint32_t a, uint32_t b) const;
+
+    bool canCollapse(uint32_t u, uint32_t v) const;
+    uint32_t seamPartner(uint32_t u, uint32_t v) const;
+    double collapseCost(uint32_t u, uint32_t v) const;
+    double skinDistance(uint32_t u, uint32_t v) const;
+    bool flipsTriangles(uint32_t ru, uint32_t rv, const glm::vec3& target) const;
+    uint32_t sharedTriangles(uint32_t ru, uint32_t rv) const;
+    void collapseLoop(uint32_t u, uint32_t v);
+
+    std::vector<uint32_t> m_indices;
+    const std::vector<glm::vec3>& m_positions;
+    const std::vector<VertexSkin>* m_skin;
+
+    std::vector<uint32_t> m_remap;     // Vertex -> first vertex at the same position
+    std::vector<uint32_t> m_wedge;     // Next vertex at the same position (ring)
+    std::vector<VertexKind> m_kind;
+    std::vector<uint32_t> m_openNext;  // Open half-edge v -> openNext[v]
+    std::vector<uint32_t> m_openPrev;  // Open half-edge openPrev[v] -> v
+    std::vector<Quadric> m_quadrics;   // By m_remap vertex
+    double m_maxCost = 0.0;
+
+    // Per pass
+    std::vector<uint32_t> m_triangleOffsets;  // Triangles around each m_remap vertex (CSR)
+    std::vector<uint32_t> m_triangles;
+    std::vector<uint32_t> m_collapseRemap;
+};
+
+void Simplifier::buildWedges() {
+    const size_t vertexCount = m_positions.size();
+    std::vector<uint32_t> order(vertexCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        const glm::vec3& pa = m_positions[a];
+        const glm::vec3& pb = m_positions[b];
+        return std::tie(pa.x, pa.y, pa.z) < std::tie(pb.x, pb.y, pb.z);
+    });
+
+    m_remap.resize(vertexCount);
+    m_wedge.resize(vertexCount);
+    for (size_t begin = 0; begin < vertexCount;) {
+        size_t end = begin + 1;
+        while (end < vertexCount && m_positions[order[end]] == m_positions[order[begin]]) ++end;
+        for (size_t i = begin; i < end; ++i) {
+            m_remap[order[i]] = order[begin];
+            m_wedge[order[i]] = order[(i + 1 < end) ? i + 1 : begin];
+        }
+        begin = end;
+    }
+}
+
+bool Simplifier::hasPositionEdge(const HalfEdges& edges, uint32_t a, uint32_t b) const {
+    uint32_t wa = a;
+    do {
+        uint32_t wb = b;
+        do {
+            if (edges.has(wa, wb)) return true;
+            wb = m_wedge[wb];
+        } while (wb != b);
+        wa = m_wedge[wa];
+    } while (wa != a);
+    return false;
+}
+
+void Simplifier::classify(const HalfEdges& edges) {
+    const size_t vertexCount = m_positions.size();
+    std::vector<uint32_t> openOut(vertexCount, 0), openIn(vertexCount, 0);
+    m_openNext.assign(vertexCount, INVALID_INDEX);
+    m_openPrev.assign(vertexCount, INVALID_INDEX);
+    for (uint32_t a = 0; a < vertexCount; ++a) {
+        for (uint32_t e = edges.offsets[a]; e < edges.offsets[a + 1]; ++e) {
+            uint32_t b = edges.targets[e];
+            if (edges.has(b, a)) continue;
+            ++openOut[a];
+            ++openIn[b];
+            m_openNext[a] = b;
+            m_openPrev[b] = a;
+        }
+    }
+
+    m_kind.assign(vertexCount, VertexKind::Locked);
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        const uint32_t w = m_wedge[v];
+        if (w == v) {
+            if (openOut[v] == 0 && openIn[v] == 0) {
+                m_kind[v] = VertexKind::Manifold;
+            } else if (openOut[v] == 1 && openIn[v] == 1 &&
+                       !hasPositionEdge(edges, m_openNext[v], v) && !hasPositionEdge(edges, v, m_openPrev[v])) {
+                m_kind[v] = VertexKind::Border;  // Open in position space too (not a seam end)
+            }
+        } else if (m_wedge[w] == v) {
+            // The open edges of both sides must run along the same positions
+            if (openOut[v] == 1 && openIn[v] == 1 && openOut[w] == 1 && openIn[w] == 1 &&
+                m_remap[m_openNext[v]] == m_remap[m_openPrev[w]] &&
+                m_remap[m_openPrev[v]] == m_remap[m_openNext[w]]) {
+                m_kind[v] = VertexKind::Seam;
+            }
+        }
+    }
+}
+
+void Simplifier::buildQuadrics(const HalfEdges& edges) {
+    m_quadrics.assign(m_positions.size(), Quadric{});
+    for (size_t t = 0; t < triangleCount(); ++t) {
+        const uint32_t* tri = &m_indices[t * 3];
+        const glm::dvec3 p[3] = {glm::dvec3(m_positions[tri[0]]), glm::dvec3(m_positions[tri[1]]),
+                                 glm::dvec3(m_positions[tri[2]])};
+        glm::dvec3 normal = glm::cross(p[1] - p[0], p[2] - p[0]);
+        double length = glm::length(normal);
+        if (length <= 0.0) continue;
+        normal /= length;
+
+        Quadric face = Quadric::plane(normal, -glm::dot(normal, p[0]), length * 0.5);
+        for (int k = 0; k < 3; ++k) m_quadrics[m_remap[tri[k]]].add(face);
+
+        for (int k = 0; k < 3; ++k) {
+            uint32_t a = tri[k], b = tri[(k + 1) % 3];
+            if (edges.has(b, a)) continue;
+            double weight = hasPositionEdge(edges, b, a) ? SEAM_EDGE_WEIGHT : BORDER_EDGE_WEIGHT;
+            glm::dvec3 edge = p[(k + 1) % 3] - p[k];
+            glm::dvec3 edgeNormal = glm::cross(edge, normal);
+            double edgeLength = glm::length(edgeNormal);
+            if (edgeLength <= 0.0) continue;
+            edgeNormal /= edgeLength;
+            Quadric q = Quadric::plane(edgeNormal, -glm::dot(edgeNormal, p[k]), glm::dot(edge, edge) * weight);
+            m_quadrics[m_remap[a]].add(q);
+            m_quadrics[m_remap[b]].add(q);
+        }
+    }
+}
+
+uint32_t Simplifier::seamPartner(uint32_t u, uint32_t v) const {
+    uint32_t w = m_wedge[u];
+    uint32_t partner = (m_openNext[u] == v) ? m_openPrev[w] : m_openNext[w];
+    if (partner == INVALID_INDEX || m_remap[partner] != m_remap[v]) return INVALID_INDEX;
+    return partner;
+}
+
+bool Simplifier::canCollapse(uint32_t u, uint32_t v) const {
+    const bool alongOpenEdge = (m_openNext[u] == v || m_openPrev[u] == v);
+    switch (m_kind[u]) {
+        case VertexKind::Manifold:
+            return true;
+        case VertexKind::Border:
+            return alongOpenEdge && (m_kind[v] == VertexKind::Border || m_kind[v] == VertexKind::Locked);
+        case VertexKind::Seam:
+            return alongOpenEdge && (m_kind[v] == VertexKind::Seam || m_kind[v] == VertexKind::Locked) &&
+                   seamPartner(u, v) != INVALID_INDEX;
+        default:
+            return false;
+    }
+}
+
+// 0 = same joints and weights, 1 = no influence in common
+double Simplifier::skinDistance(uint32_t u, uint32_t v) const {
+    const VertexSkin& su = (*m_skin)[u];
+    const VertexSkin& sv = (*m_skin)[v];
+    uint8_t joints[8];
+    int weights[8];
+    int count = 0;
+    auto accumulate = [&](uint8_t joint, int weight) {
+        for (int i = 0; i < count; ++i) {
+            if (joints[i] == joint) {
+                weights[i] += weight;
+                return;
+            }
+        }
+        joints[count] = joint;
+        weights[count++] = weight;
+    };
+    for (int k = 0; k < 4; ++k) {
+        if (su.weights[k]) accumulate(su.joints[k], su.weights[k]);
+        if (sv.weights[k]) accumulate(sv.joints[k], -int(sv.weights[k]));
+    }
+    int difference = 0;
+    for (int i = 0; i < count; ++i) difference += std::abs(weights[i]);
+    return double(difference) / (2.0 * 255.0);
+}
+
+double Simplifier::collapseCost(uint32_t u, uint32_t v) const {
+    Quadric q = m_quadrics[m_remap[u]];
+    q.add(m_quadrics[m_remap[v]]);
+    double cost = q.error(m_positions[v]);
+    if (m_skin) {
+        double displacement = SKIN_PENALTY * skinDistance(u, v) * glm::distance(m_positions[u], m_positions[v]);
+        cost += displacement * displacement;
+    }
+    return cost;
+}
+
+bool Simplifier::flipsTriangles(uint32_t ru, uint32_t rv, const glm::vec3& target) const {
+    for (uint32_t a = m_triangleOffsets[ru]; a < m_triangleOffsets[ru + 1]; ++a) {
+        const uint32_t t = m_triangles[a];
+        uint32_t corners[3], canonical[3];
+        int moved = -1;
+        for (int k = 0; k < 3; ++k) {
+            corners[k] = m_collapseRemap[m_indices[t * 3 + k]];
+            canonical[k] = m_remap[corners[k]];
+            if (canonical[k] == ru) moved = k;
+        }
+        if (moved < 0 || canonical[0] == rv || canonical[1] == rv || canonical[2] == rv) continue;  // Removed by the collapse
+        if (canonical[0] == canonical[1] || canonical[1] == canonical[2] || canonical[0] == canonical[2]) continue;
+
+        glm::vec3 p[3] = {m_positions[corners[0]], m_positions[corners[1]], m_positions[corners[2]]};
+        glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+        if (glm::dot(before, before) == 0.0f) continue;
+        p[moved] = target;
+        glm::vec3 after = glm::cross(p[1] - p[0], p[2] - p[0]);
+        if (glm::dot(before, after) <= 0.0f) return true;
+    }
+    return false;
+}
+
+uint32_t Simplifier::sharedTriangles(uint32_t ru, uint32_t rv) const {
+    uint32_t shared = 0;
+    for (uint32_t a = m_triangleOffsets[ru]; a < m_triangleOffsets[ru + 1]; ++a) {
+        const uint32_t t = m_triangles[a];
+        for (int k = 0; k < 3; ++k) {
+            if (m_remap[m_collapseRemap[m_indices[t * 3 + k]]] == rv) {
+                ++shared;
+                break;
+            }
+        }
+    }
+    return shared;
+}
+
+// Keeps the open edge loop linked when u (on it) collapses into its neighbour v
+void Simplifier::collapseLoop(uint32_t u, uint32_t v) {
+    if (m_openNext[u] == v) {
+        uint32_t prev = m_openPrev[u];
+        m_openPrev[v] = prev;
+        if (prev != INVALID_INDEX) m_openNext[prev] = v;
+    } else if (m_openPrev[u] == v) {
+        uint32_t next = m_openNext[u];
+        m_openNext[v] = next;
+        if (next != INVALID_INDEX) m_openPrev[next] = v;
+    }
+}
+
+bool Simplifier::pass(size_t target) {
+    const size_t triangles = triangleCount();
+    if (triangles <= target) return false;
+    const size_t vertexCount = m_positions.size();
+
+    // Triangles around each position
+    m_triangleOffsets.assign(vertexCount + 1, 0);
+    for (uint32_t index : m_indices) ++m_triangleOffsets[m_remap[index] + 1];
+    std::partial_sum(m_triangleOffsets.begin(), m_triangleOffsets.end(), m_triangleOffsets.begin());
+    m_triangles.resize(m_indices.size());
+    {
+        std::vector<uint32_t> fill(m_triangleOffsets.begin(), m_triangleOffsets.end() - 1);
+        for (size_t i = 0; i < m_indices.size(); ++i) m_triangles[fill[m_remap[m_indices[i]]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    // One candidate per pair of positions, from the first half-edge joining them
+    struct Edge {
+        uint32_t lo, hi, a, b;
+    };
+    std::vector<Edge> edges;
+    edges.reserve(m_indices.size());
+    for (size_t t = 0; t < triangles; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            uint32_t a = m_indices[t * 3 + k], b = m_indices[t * 3 + (k + 1) % 3];
+            uint32_t ra = m_remap[a], rb = m_remap[b];
+            if (ra != rb) edges.push_back({std::min(ra, rb), std::max(ra, rb), a, b});
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](const Edge& x, const Edge& y) {
+        return std::tie(x.lo, x.hi, x.a, x.b) < std::tie(y.lo, y.hi, y.a, y.b);
+    });
+    edges.erase(std::unique(edges.begin(), edges.end(),
+                            [](const Edge& x, const Edge& y) { return x.lo == y.lo && x.hi == y.hi; }),
+                edges.end());
+
+    struct Collapse {
+        uint32_t u, v;
+        double cost;
+    };
+    std::vector<Collapse> collapses;
+    collapses.reserve(edges.size());
+    for (const Edge& e : edges) {
+        const bool ab = canCollapse(e.a, e.b), ba = canCollapse(e.b, e.a);
+        if (!ab && !ba) continue;
+        double costAB = ab ? collapseCost(e.a, e.b) : 0.0;
+        double costBA = ba ? collapseCost(e.b, e.a) : 0.0;
+        if (ab && (!ba || costAB <= costBA)) {
+            collapses.push_back({e.a, e.b, costAB});
+        } else {
+            collapses.push_back({e.b, e.a, costBA});
+        }
+    }
+    if (collapses.empty()) return false;
+
+    std::vector<uint32_t> order(collapses.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t x, uint32_t y) { return collapses[x].cost < collapses[y].cost; });
+
+    // Each manifold collapse removes two triangles
+    const size_t goal = std::min(std::max<size_t>((triangles - target) / 2, 1), collapses.size());
+    const double limit = collapses[order[goal - 1]].cost * PASS_ERROR_SLACK;
+
+    m_collapseRemap.resize(vertexCount);
+    std::iota(m_collapseRemap.begin(), m_collapseRemap.end(), 0u);
+    std::vector<bool> locked(vertexCount, false);
+    size_t removed = 0, applied = 0;
+    for (uint32_t i : order) {
+        const Collapse& c = collapses[i];
+        if (c.cost > limit) break;
+        const uint32_t ru = m_remap[c.u], rv = m_remap[c.v];
+        if (locked[ru] || locked[rv]) continue;
+        if (flipsTriangles(ru, rv, m_positions[c.v])) continue;
+
+        removed += sharedTriangles(ru, rv);
+        m_collapseRemap[c.u] = c.v;
+        if (m_kind[c.u] == VertexKind::Seam) {
+            uint32_t w = m_wedge[c.u];
+            uint32_t partner = seamPartner(c.u, c.v);
+            m_collapseRemap[w] = partner;
+            collapseLoop(c.u, c.v);
+            collapseLoop(w, partner);
+        } else if (m_kind[c.u] == VertexKind::Border) {
+            collapseLoop(c.u, c.v);
+        }
+        m_quadrics[rv].add(m_quadrics[ru]);
+        m_maxCost = std::max(m_maxCost, c.cost);
+        locked[ru] = locked[rv] = true;
+        ++applied;
+        if (removed >= triangles - target) break;
+    }
+    if (applied == 0) return false;
+
+    // Remap and drop triangles that lost an edge
+    size_t write = 0;
+    for (size_t t = 0; t < triangles; ++t) {
+        uint32_t a = m_collapseRemap[m_indices[t * 3 + 0]];
+        uint32_t b = m_collapseRemap[m_indices[t * 3 + 1]];
+        uint32_t d = m_collapseRemap[m_indices[t * 3 + 2]];
+        if (m_remap[a] == m_remap[b] || m_remap[b] == m_remap[d] || m_remap[a] == m_remap[d]) continue;
+        m_indices[write++] = a;
+        m_indices[write++] = b;
+        m_indices[write++] = d;
+    }
+    m_indices.resize(write);
+    return true;
+}
+
+} // anonymous namespace
+
+std::vector<SimplifiedLevel> simplifyProgressive(const std::vector<uint32_t>& indices,
+                                                 const std::vector<glm::vec3>& positions,
+                                                 const std::vector<VertexSkin>* skin,
+                                                 const std::vector<float>& targetRatios) {
+    std::vector<SimplifiedLevel> levels;
+    if (indices.size() < 3) return levels;
+
+    Simplifier simplifier(indices, positions, skin);
+    const size_t original = simplifier.triangleCount();
+    size_t previous = original;
+    for (float ratio : targetRatios) {
+        const size_t target = static_cast<size_t>(double(original) * ratio);
+        for (int pass = 0; pass < MAX_PASSES_PER_LEVEL && simplifier.triangleCount() > target; ++pass) {
+            if (!simplifier.pass(target)) break;
+        }
+        const size_t count = simplifier.triangleCount();
+        if (count == 0 || double(count) > double(previous) * LOD_MIN_REDUCTION) break;
+
+        levels.push_back({simplifier.indices(), static_cast<float>(std::sqrt(simplifier.maxCost()))});
+        previous = count;
+    }
+    return levels;
+}
+
+uint32_t buildMeshLods(DecodedMesh& mesh, const std::vector<float>& targetRatios) {
+    mesh.lods.clear();
+    const size_t vertexCount = mesh.vertexCount();
+    if (mesh.indexCount < 3 || vertexCount == 0) return 0;
+
+    std::vector<uint32_t> indices = readIndices(mesh.indexData, mesh.indexCount, mesh.indexType);
+    indices.resize(indices.size() / 3 * 3);
+    for (uint32_t index : indices) {
+        if (index >= vertexCount) return 0;
+    }
+
+    std::vector<VertexSkin> skin;
+    if (mesh.skinned) {
+        skin.resize(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            PackedSkinnedVertex packed;
+            std::memcpy(&packed, &mesh.vertices[v * sizeof(PackedSkinnedVertex)], sizeof(packed));
+            std::memcpy(skin[v].joints, packed.joints, sizeof(skin[v].joints));
+            std::memcpy(skin[v].weights, packed.weights, sizeof(skin[v].weights));
+        }
+    }
+
+    std::vector<SimplifiedLevel> levels =
+        simplifyProgressive(indices, meshPositions(mesh), mesh.skinned ? &skin : nullptr, targetRatios);
+    for (const SimplifiedLevel& level : levels) {
+        DecodedMeshLod lod;
+        lod.indexData = writeIndices(optimizeVertexCache(level.indices, vertexCount), mesh.indexType);
+        lod.indexCount = static_cast<uint32_t>(level.indices.size());
+        lod.error = level.error;
+        mesh.lods.push_back(std::move(lod));
+    }
+    return static_cast<uint32_t>(mesh.lods.size());
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "ModelDecoder.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Cook-time LOD generation: quadric error metric simplification (Garland &
+// Heckbert) by half-edge collapse. Vertices are only ever removed, never
+// moved or created, so every level is a new index buffer over the original
+// vertex buffer. UV/normal seams (vertices split at the same position) only
+// collapse along the seam, open borders only along the border, and skinned
+// vertices are penalised for collapsing onto vertices bound to other joints.
+// Deterministic: the same input always produces the same levels.
+
+// A level is only kept if it has at most this fraction of the previous
+// level's triangles (otherwise the mesh has stopped simplifying)
+constexpr float LOD_MIN_REDUCTION = 0.75f;
+
+struct VertexSkin {
+    uint8_t joints[4];
+    uint8_t weights[4];  // unorm8, as in PackedSkinnedVertex
+};
+
+struct SimplifiedLevel {
+    std::vector<uint32_t> indices;
+    float error = 0.0f;  // Largest collapse error so far, in model units
+};
+
+// Simplifies progressively, recording a level each time the triangle count
+// reaches targetRatios[k] * the input's (ratios descending). `skin` is
+// optional (one entry per vertex). Returns fewer levels if the mesh stalls.
+std::vector<SimplifiedLevel> simplifyProgressive(const std::vector<uint32_t>& indices,
+                                                 const std::vector<glm::vec3>& positions,
+                                                 const std::vector<VertexSkin>* skin,
+                                                 const std::vector<float>& targetRatios);
+
+// Fills mesh.lods (vertex cache ordered, in the mesh's index type). Returns
+// the number of levels built.
+uint32_t buildMeshLods(DecodedMesh& mesh, const std::vector<float>& targetRatios);
@@ -0,0 +1,322 @@
+#define TINYGLTF_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#define TINYGLTF_NO_STB_IMAGE_WRITE
+#include <tiny_gltf.h>
+
+#include "ModelDecoder.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <map>
+
+namespace {
+
+// Reads any accessor as floats (normalized integer types are mapped to [0,1] / [-1,1])
+std::vector<float> readAccessor(const tinygltf::Model& model, int accessorIndex, int components) {
+    const auto& accessor = model.accessors[accessorIndex];
+    std::vector<float> out(accessor.count * components, 0.0f);
+    if (accessor.bufferView < 0) return out;
+
+    const auto& view = model.bufferViews[accessor.bufferView];
+    const auto& buffer = model.buffers[view.buffer];
+    size_t elemSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+    int stored = tinygltf::GetNumComponentsInType(accessor.type);
+    size_t stride = view.byteStride ? view.byteStride : elemSize * stored;
+    const unsigned char* base = &buffer.data[view.byteOffset + accessor.byteOffset];
+    int n = std::min(components, stored);
+
+    for (size_t i = 0; i < accessor.count; ++i) {
+        const unsigned char* p = base + i * stride;
+        for (int c = 0; c < n; ++c) {
+            const unsigned char* e = p + c * elemSize;
+            float v = 0.0f;
+            switch (accessor.componentType) {
+                case TINYGLTF_COMPONENT_TYPE_FLOAT: std::memcpy(&v, e, 4); break;
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+                    v = accessor.normalized ? *e / 255.0f : float(*e); break;
+                case TINYGLTF_COMPONENT_TYPE_BYTE:
+                    v = accessor.normalized ? std::max(*reinterpret_cast<const int8_t*>(e) / 127.0f, -1.0f)
+                                            : float(*reinterpret_cast<const int8_t*>(e)); break;
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+                    uint16_t s; std::memcpy(&s, e, 2);
+                    v = accessor.normalized ? s / 65535.0f : float(s); break;
+                }
+                case TINYGLTF_COMPONENT_TYPE_SHORT: {
+                    int16_t s; std::memcpy(&s, e, 2);
+                    v = accessor.normalized ? std::max(s / 32767.0f, -1.0f) : float(s); break;
+                }
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: {
+                    uint32_t u; std::memcpy(&u, e, 4);
+                    v = float(u); break;
+                }
+                default: break;
+            }
+            out[i * components + c] = v;
+        }
+    }
+    return out;
+}
+
+std::vector<uint32_t> readIndices(const tinygltf::Model& model, int accessorIndex) {
+    const auto& accessor = model.accessors[accessorIndex];
+    const auto& view = model.bufferViews[accessor.bufferView];
+    const auto& buffer = model.buffers[view.buffer];
+    size_t elemSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+    size_t stride = view.byteStride ? view.byteStride : elemSize;
+    const unsigned char* base = &buffer.data[view.byteOffset + accessor.byteOffset];
+
+    std::vector<uint32_t> out(accessor.count);
+    for (size_t i = 0; i < accessor.count; ++i) {
+        const unsigned char* p = base + i * stride;
+        if (elemSize == 1) {
+            out[i] = *p;
+        } else if (elemSize == 2) {
+            uint16_t s; std::memcpy(&s, p, 2); out[i] = s;
+        } else {
+            std::memcpy(&out[i], p, 4);
+        }
+    }
+    return out;
+}
+
+glm::mat4 nodeTransform(const tinygltf::Node& node) {
+    if (!node.matrix.empty()) {
+        return glm::make_mat4(node.matrix.data());
+    }
+    glm::mat4 m(1.0f);
+    if (!node.translation.empty()) {
+        m = glm::translate(m, glm::vec3((float)node.translation[0], (float)node.translation[1], (float)node.translation[2]));
+    }
+    if (!node.rotation.empty()) {
+        m *= glm::toMat4(glm::quat((float)node.rotation[3], (float)node.rotation[0],
+                                   (float)node.rotation[1], (float)node.rotation[2]));
+    }
+    if (!node.scale.empty()) {
+        m = glm::scale(m, glm::vec3((float)node.scale[0], (float)node.scale[1], (float)node.scale[2]));
+    }
+    return m;
+}
+
+void decodeTextures(tinygltf::Model& gltf, const std::string& path, DecodedModel& out) {
+    for (auto& image : gltf.images) {
+        DecodedTexture tex;
+        tex.width = static_cast<uint32_t>(image.width);
+        tex.height = static_cast<uint32_t>(image.height);
+        tex.components = static_cast<uint32_t>(image.component);
+        if (image.bits != 8 || (tex.components != 3 && tex.components != 4) ||
+            image.image.size() != size_t(tex.width) * tex.height * tex.components) {
+            // Keep indices stable: a 1x1 white texel stands in for unsupported images
+            std::cerr << "ModelDecoder: Unsupported image '" << image.name << "' in " << path << std::endl;
+            tex.width = tex.height = 1;
+            tex.components = 4;
+            tex.pixels.assign(4, 255);
+        } else {
+            tex.pixels = std::move(image.image);
+        }
+        out.textures.push_back(std::move(tex));
+    }
+
+    for (const auto& material : gltf.materials) {
+        int texIndex = material.normalTexture.index;
+        if (texIndex < 0 || texIndex >= static_cast<int>(gltf.textures.size())) continue;
+        int imageIndex = gltf.textures[texIndex].source;
+        if (imageIndex >= 0 && imageIndex < static_cast<int>(out.textures.size())) {
+            out.textures[imageIndex].normalMap = true;
+        }
+    }
+}
+
+// First skin only; parents resolved from the node hierarchy in one pass
+void decodeSkeleton(const tinygltf::Model& gltf, std::map<int, int>& nodeToJoint, DecodedModel& out) {
+    if (gltf.skins.empty()) return;
+
+    const auto& skin = gltf.skins[0];
+    for (size_t i = 0; i < skin.joints.size(); ++i) {
+        nodeToJoint[skin.joints[i]] = static_cast<int>(i);
+    }
+
+    std::vector<float> inverseBind;
+    if (skin.inverseBindMatrices >= 0) inverseBind = readAccessor(gltf, skin.inverseBindMatrices, 16);
+
+    SkeletonDef skeleton;
+    skeleton.resize(skin.joints.size());
+    for (size_t i = 0; i < skin.joints.size(); ++i) {
+        const auto& node = gltf.nodes[skin.joints[i]];
+        if ((i + 1) * 16 <= inverseBind.size()) {
+            skeleton.joints[i].inverseBindMatrix = glm::make_mat4(&inverseBind[i * 16]);
+        }
+        skeleton.joints[i].localTransform = nodeTransform(node);
+        skeleton.jointNames[i] = node.name;
+        skeleton.joints[i].parentIndex = -1;
+    }
+    for (size_t i = 0; i < skin.joints.size(); ++i) {
+        for (int child : gltf.nodes[skin.joints[i]].children) {
+            auto it = nodeToJoint.find(child);
+            if (it != nodeToJoint.end()) skeleton.joints[it->second].parentIndex = static_cast<int>(i);
+        }
+    }
+    if (!skeleton.joints.empty()) out.skeleton = std::move(skeleton);
+}
+
+// Channels targeting the same joint are merged into one AnimationChannel
+void decodeAnimations(const tinygltf::Model& gltf, const std::map<int, int>& nodeToJoint, DecodedModel& out) {
+    for (const auto& anim : gltf.animations) {
+        AnimationClip clip;
+        clip.name = anim.name;
+        std::map<int, size_t> jointToChannel;
+
+        for (const auto& channel : anim.channels) {
+            auto it = nodeToJoint.find(channel.target_node);
+            if (it == nodeToJoint.end()) continue;
+
+            auto [slot, inserted] = jointToChannel.try_emplace(it->second, clip.channels.size());
+            if (inserted) {
+                clip.channels.push_back({});
+                clip.channels.back().jointIndex = it->second;
+            }
+            AnimationChannel& dst = clip.channels[slot->second];
+
+            const auto& sampler = anim.samplers[channel.sampler];
+            std::vector<float> times = readAccessor(gltf, sampler.input, 1);
+            for (float t : times) clip.duration = std::max(clip.duration, t);
+
+            if (channel.target_path == "translation") {
+                std::vector<float> v = readAccessor(gltf, sampler.output, 3);
+                dst.translationTimes = std::move(times);
+                dst.translations.resize(v.size() / 3);
+                for (size_t i = 0; i < dst.translations.size(); ++i) dst.translations[i] = glm::make_vec3(&v[i * 3]);
+            } else if (channel.target_path == "rotation") {
+                std::vector<float> v = readAccessor(gltf, sampler.output, 4);
+                dst.rotationTimes = std::move(times);
+                dst.rotations.resize(v.size() / 4);
+                for (size_t i = 0; i < dst.rotations.size(); ++i) {
+                    dst.rotations[i] = glm::quat(v[i * 4 + 3], v[i * 4 + 0], v[i * 4 + 1], v[i * 4 + 2]);
+                }
+            } else if (channel.target_path == "scale") {
+                std::vector<float> v = readAccessor(gltf, sampler.output, 3);
+                dst.scaleTimes = std::move(times);
+                dst.scales.resize(v.size() / 3);
+                for (size_t i = 0; i < dst.scales.size(); ++i) dst.scales[i] = glm::make_vec3(&v[i * 3]);
+            }
+        }
+        out.clips.push_back(std::move(clip));
+    }
+}
+
+// One interleaved, quantized mesh per triangle primitive
+void decodeMeshes(const tinygltf::Model& gltf, DecodedModel& out) {
+    for (const auto& gltfMesh : gltf.meshes) {
+        for (const auto& primitive : gltfMesh.primitives) {
+            if (primitive.mode != TINYGLTF_MODE_TRIANGLES) continue;
+            auto posIt = primitive.attributes.find("POSITION");
+            if (posIt == primitive.attributes.end()) continue;
+
+            auto attribute = [&](const char* name, int components) {
+                auto it = primitive.attributes.find(name);
+                return (it != primitive.attributes.end()) ? readAccessor(gltf, it->second, components)
+                                                          : std::vector<float>();
+            };
+            std::vector<float> positions = readAccessor(gltf, posIt->second, 3);
+            std::vector<float> normals = attribute("NORMAL", 3);
+            std::vector<float> uvs = attribute("TEXCOORD_0", 2);
+            std::vector<float> jointIds = attribute("JOINTS_0", 4);
+            std::vector<float> weights = attribute("WEIGHTS_0", 4);
+
+            DecodedMesh mesh;
+            mesh.skinned = !jointIds.empty();
+            const size_t vertexCount = positions.size() / 3;
+            const uint32_t floatsPerVertex = mesh.skinned ? SKINNED_VERTEX_FLOATS : STATIC_VERTEX_FLOATS;
+
+            std::vector<float> vertices(vertexCount * floatsPerVertex, 0.0f);
+            for (size_t i = 0; i < vertexCount; ++i) {
+                float* v = &vertices[i * floatsPerVertex];
+                std::memcpy(v, &positions[i * 3], 3 * sizeof(float));
+                if (i * 3 < normals.size()) std::memcpy(v + 3, &normals[i * 3], 3 * sizeof(float));
+                if (i * 2 < uvs.size()) std::memcpy(v + 6, &uvs[i * 2], 2 * sizeof(float));
+                if (mesh.skinned) {
+                    if (i * 4 < jointIds.size()) std::memcpy(v + 8, &jointIds[i * 4], 4 * sizeof(float));
+                    if (i * 4 < weights.size()) std::memcpy(v + 12, &weights[i * 4], 4 * sizeof(float));
+                }
+                glm::vec3 p(v[0], v[1], v[2]);
+                out.boundsMin = glm::min(out.boundsMin, p);
+                out.boundsMax = glm::max(out.boundsMax, p);
+            }
+            PackedVertices packed = packVertices(vertices.data(), vertexCount, mesh.skinned);
+            mesh.vertices = std::move(packed.data);
+            mesh.positionOffset = packed.positionOffset;
+            mesh.positionScale = packed.positionScale;
+
+            // 8-bit indices are widened; 16-bit is kept whenever it fits
+            if (primitive.indices >= 0) {
+                std::vector<uint32_t> indices = readIndices(gltf, primitive.indices);
+                mesh.indexCount = static_cast<uint32_t>(indices.size());
+                if (vertexCount > 0xFFFF) {
+                    mesh.indexType = PACK_INDEX_UINT32;
+                    mesh.indexData.resize(indices.size() * sizeof(uint32_t));
+                    std::memcpy(mesh.indexData.data(), indices.data(), mesh.indexData.size());
+                } else {
+                    std::vector<uint16_t> narrow(indices.begin(), indices.end());
+                    mesh.indexData.resize(narrow.size() * sizeof(uint16_t));
+                    std::memcpy(mesh.indexData.data(), narrow.data(), mesh.indexData.size());
+                }
+            }
+
+            if (primitive.material >= 0) {
+                int texIndex = gltf.materials[primitive.material].pbrMetallicRoughness.baseColorTexture.index;
+                if (texIndex >= 0 && texIndex < static_cast<int>(gltf.textures.size())) {
+                    int imageIndex = gltf.textures[texIndex].source;
+                    if (imageIndex >= 0 && imageIndex < static_cast<int>(out.textures.size())) {
+                        mesh.textureIndex = imageIndex;
+                    }
+                }
+            }
+            out.meshes.push_back(std::move(mesh));
+        }
+    }
+}
+
+} // anonymous namespace
+
+bool decodeGLB(const std::string& path, DecodedModel& out) {
+    tinygltf::Model gltf;
+    tinygltf::TinyGLTF loader;
+    std::string err, warn;
+    bool ok = loader.LoadBinaryFromFile(&gltf, &err, &warn, path);
+    if (!warn.empty()) std::cerr << "GLTF Warning: " << warn << std::endl;
+    if (!err.empty()) std::cerr << "GLTF Error: " << err << std::endl;
+    if (!ok) {
+        std::cerr << "Failed to load GLB: " << path << std::endl;
+        return false;
+    }
+
+    std::map<int, int> nodeToJoint;
+    decodeTextures(gltf, path, out);
+    decodeSkeleton(gltf, nodeToJoint, out);
+    decodeAnimations(gltf, nodeToJoint, out);
+    decodeMeshes(gltf, out);
+    return true;
+}
+
+bool decodeImageFile(const std::string& path, DecodedTexture& out) {
+    int width = 0, height = 0, channels = 0;
+    stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+    if (data && channels != 3 && channels != 4) {
+        stbi_image_free(data);
+        data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+        channels = 4;
+    }
+    if (!data) {
+        std::cerr << "ModelDecoder: Failed to load image " << path << std::endl;
+        return false;
+    }
+
+    out.width = static_cast<uint32_t>(width);
+    out.height = static_cast<uint32_t>(height);
+    out.components = static_cast<uint32_t>(channels);
+    out.pixels.assign(data, data + size_t(width) * height * channels);
+    stbi_image_free(data);
+    return true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "../ecs/components/Skeleton.h"
+#include "../ecs/components/Animation.h"
+#include "AssetPack.h"
+#include "VertexFormat.h"
+#include <glm/glm.hpp>
+#include <cfloat>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// CPU-side result of decoding a .glb: everything a GL upload needs, already in
+// the AssetPack layouts. Uses no GL, so it is safe to build on worker threads
+// and is shared by the runtime loader and the cooker.
+
+// Simplified index buffer over the same vertices as its DecodedMesh
+struct DecodedMeshLod {
+    std::vector<unsigned char> indexData;   // Same index type as the mesh
+    uint32_t indexCount = 0;
+    float error = 0.0f;                     // Model-space deviation from the full mesh
+};
+
+struct DecodedMesh {
+    std::vector<unsigned char> vertices;    // PackedVertex / PackedSkinnedVertex array
+    glm::vec3 positionOffset{0.0f};         // Dequantization, see packVertices()
+    glm::vec3 positionScale{1.0f};
+    std::vector<unsigned char> indexData;   // PACK_INDEX_UINT16 or PACK_INDEX_UINT32
+    uint32_t indexType = PACK_INDEX_UINT16;
+    uint32_t indexCount = 0;
+    bool skinned = false;
+    int textureIndex = -1;                  // Into DecodedModel::textures
+    std::vector<DecodedMeshLod> lods;       // Coarser levels, filled by the cooker (MeshSimplifier)
+
+    uint32_t vertexStride() const { return skinned ? sizeof(PackedSkinnedVertex) : sizeof(PackedVertex); }
+    uint32_t vertexCount() const { return static_cast<uint32_t>(vertices.size() / vertexStride()); }
+};
+
+// Base level only; mips are generated at upload (or baked by the cooker)
+struct DecodedTexture {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t components = 4;
+    bool normalMap = false;                 // Referenced as a material normalTexture
+    std::vector<unsigned char> pixels;
+};
+
+// Skinned positions and normals of one mesh per baked frame (VertexAnimationBaker.h)
+struct DecodedVertexAnimationMesh {
+    glm::vec3 positionOffset{0.0f};         // Animated bounds over every frame
+    glm::vec3 positionScale{1.0f};
+    std::vector<uint16_t> texels;           // RGBA16UI, frameCount * vertexCount texels
+};
+
+struct DecodedVertexAnimation {
+    uint32_t frameCount = 0;                        // All clips, back to back
+    std::vector<VertexAnimationClip> clips;         // Parallel to DecodedModel::clips
+    std::vector<DecodedVertexAnimationMesh> meshes; // Parallel to DecodedModel::meshes
+
+    bool empty() const { return frameCount == 0; }
+};
+
+struct DecodedModel {
+    std::vector<DecodedMesh> meshes;
+    std::vector<DecodedTexture> textures;
+    std::optional<SkeletonDef> skeleton;
+    std::vector<AnimationClip> clips;
+    DecodedVertexAnimation vertexAnimation; // Baked clips (bakeVertexAnimation), empty unless requested
+    glm::vec3 boundsMin{FLT_MAX, FLT_MAX, FLT_MAX};
+    glm::vec3 boundsMax{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+};
+
+// File read, tinygltf parse, image decode and vertex conversion. Thread-safe.
+bool decodeGLB(const std::string& path, DecodedModel& out);
+
+// Standalone image file (stb_image, 3 or 4 components). Thread-safe.
+bool decodeImageFile(const std::string& path, DecodedTexture& out);
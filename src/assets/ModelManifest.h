@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// What the loaders keep of a model's vertices in RAM once they are uploaded
+// (Mesh::cpuGeometry). Whatever is dropped can still be read back from the
+// vertex buffer on demand (readBackCpuGeometry).
+enum class GeometryRetention : uint8_t {
+    None,          // GPU only
+    Positions,     // Quantized positions
+    Skinning,      // Quantized positions + joints/weights
+    FootVertices,  // Skinning, only for vertices weighted to foot/toe joints (TerrainSystem footprints)
+};
+
+// Models loaded at startup, keyed by the name AssetManager::getModel() uses.
+// Shared by the runtime loader and the asset cooker so the pack always
+// covers exactly what the game loads. Listed in streaming priority order:
+// what the main menu backdrop shows first, the close-up FING model last.
+struct ModelSource {
+    std::string name;
+    std::string path;
+    GeometryRetention retention = GeometryRetention::None;
+    bool vertexAnimation = false;  // Bake clips into per-vertex frames for distant crowd instances
+};
+
+inline const std::vector<ModelSource>& modelManifest() {
+    static const std::vector<ModelSource> manifest = {
+        {"fingLowDetail", "assets/fing_lod.glb"},
+        {"comet", "assets/comet.glb"},
+        {"protagonist", "assets/protagonist.glb", GeometryRetention::FootVertices},
+        {"military", "assets/military.glb"},
+        {"scientist", "assets/scientist.glb"},
+        {"monster", "assets/monster.glb", GeometryRetention::None, true},
+        {"fingHighDetail", "assets/modelo_fing.glb"},
+    };
+    return manifest;
+}
@@ -0,0 +1,384 @@
+#include "TextureCompressor.h"
+#include "AssetPack.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+namespace {
+
+struct Block {
+    float texels[16][4];  // RGBA, 0..255, row-major
+};
+
+void fetchBlock(const unsigned char* rgba, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, Block& block) {
+    for (uint32_t y = 0; y < 4; ++y) {
+        uint32_t sy = std::min(by * 4 + y, height - 1);
+        for (uint32_t x = 0; x < 4; ++x) {
+            uint32_t sx = std::min(bx * 4 + x, width - 1);
+            const unsigned char* p = rgba + (size_t(sy) * width + sx) * 4;
+            for (int c = 0; c < 4; ++c) block.texels[y * 4 + x][c] = p[c];
+        }
+    }
+}
+
+float clamp255(float v) { return std::min(std::max(v, 0.0f), 255.0f); }
+
+// Endpoints spanning the block's first N channels along their principal axis
+template <int N>
+void principalEndpoints(const Block& block, float lo[N], float hi[N]) {
+    float mean[N] = {};
+    for (const auto& t : block.texels) {
+        for (int c = 0; c < N; ++c) mean[c] += t[c];
+    }
+    for (int c = 0; c < N; ++c) mean[c] /= 16.0f;
+
+    float cov[N][N] = {};
+    for (const auto& t : block.texels) {
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) cov[i][j] += (t[i] - mean[i]) * (t[j] - mean[j]);
+        }
+    }
+
+    // Power iteration, seeded with the covariance row of the widest channel
+    int widest = 0;
+    for (int c = 1; c < N; ++c) {
+        if (cov[c][c] > cov[widest][widest]) widest = c;
+    }
+    if (cov[widest][widest] <= 0.0f) {  // Solid block
+        for (int c = 0; c < N; ++c) lo[c] = hi[c] = mean[c];
+        return;
+    }
+    float axis[N];
+    for (int c = 0; c < N; ++c) axis[c] = cov[widest][c];
+    for (int iter = 0; iter < 8; ++iter) {
+        float next[N] = {};
+        float len = 0.0f;
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) next[i] += cov[i][j] * axis[j];
+            len += next[i] * next[i];
+        }
+        if (len <= 0.0f) break;
+        len = std::sqrt(len);
+        for (int c = 0; c < N; ++c) axis[c] = next[c] / len;
+    }
+
+    float minT = 0.0f, maxT = 0.0f;
+    for (const auto& t : block.texels) {
+        float d = 0.0f;
+        for (int c = 0; c < N; ++c) d += (t[c] - mean[c]) * axis[c];
+        minT = std::min(minT, d);
+        maxT = std::max(maxT, d);
+    }
+    for (int c = 0; c < N; ++c) {
+        lo[c] = clamp255(mean[c] + axis[c] * minT);
+        hi[c] = clamp255(mean[c] + axis[c] * maxT);
+    }
+}
+
+// Least-squares endpoints for fixed per-texel weights (0 = a, 1 = b).
+// Returns false when every texel has the same weight.
+template <int N>
+bool refineEndpoints(const Block& block, const float weights[16], float a[N], float b[N]) {
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+    float ax[N] = {}, bx[N] = {};
+    for (int i = 0; i < 16; ++i) {
+        float wb = weights[i];
+        float wa = 1.0f - wb;
+        aa += wa * wa;
+        bb += wb * wb;
+        ab += wa * wb;
+        for (int c = 0; c < N; ++c) {
+            ax[c] += wa * block.texels[i][c];
+            bx[c] += wb * block.texels[i][c];
+        }
+    }
+    float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) return false;
+    for (int c = 0; c < N; ++c) {
+        a[c] = clamp255((ax[c] * bb - bx[c] * ab) / det);
+        b[c] = clamp255((bx[c] * aa - ax[c] * ab) / det);
+    }
+    return true;
+}
+
+// === BC1 (and the colour half of BC3) ===
+
+// Weight toward c1 of each four-colour index
+constexpr float BC1_WEIGHTS[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+
+uint16_t to565(const float c[3]) {
+    int r = std::min(std::max(static_cast<int>(c[0] * 31.0f / 255.0f + 0.5f), 0), 31);
+    int g = std::min(std::max(static_cast<int>(c[1] * 63.0f / 255.0f + 0.5f), 0), 63);
+    int b = std::min(std::max(static_cast<int>(c[2] * 31.0f / 255.0f + 0.5f), 0), 31);
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void from565(uint16_t v, int out[3]) {
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+// Nearest four-colour palette entry per texel; returns the summed squared error
+float bc1Indices(const Block& block, uint16_t c0, uint16_t c1, uint32_t& indices) {
+    int palette[4][3];
+    from565(c0, palette[0]);
+    from565(c1, palette[1]);
+    for (int c = 0; c < 3; ++c) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    indices = 0;
+    float total = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float best = 1e30f;
+        uint32_t bestIndex = 0;
+        for (uint32_t p = 0; p < 4; ++p) {
+            float err = 0.0f;
+            for (int c = 0; c < 3; ++c) {
+                float d = block.texels[i][c] - palette[p][c];
+                err += d * d;
+            }
+            if (err < best) {
+                best = err;
+                bestIndex = p;
+            }
+        }
+        indices |= bestIndex << (2 * i);
+        total += best;
+    }
+    return total;
+}
+
+void encodeBC1(const Block& block, unsigned char* out) {
+    float lo[3], hi[3];
+    principalEndpoints<3>(block, lo, hi);
+    uint16_t c0 = to565(hi), c1 = to565(lo);
+    uint32_t indices;
+    float err = bc1Indices(block, c0, c1, indices);
+
+    float weights[16];
+    for (int i = 0; i < 16; ++i) weights[i] = BC1_WEIGHTS[(indices >> (2 * i)) & 3];
+    float a[3], b[3];
+    if (refineEndpoints<3>(block, weights, a, b)) {
+        uint16_t r0 = to565(a), r1 = to565(b);
+        uint32_t refined;
+        if (bc1Indices(block, r0, r1, refined) < err) {
+            c0 = r0;
+            c1 = r1;
+            indices = refined;
+        }
+    }
+
+    // c0 > c1 selects four-colour mode; swapping the endpoints flips 0<->1 and 2<->3
+    if (c0 < c1) {
+        std::swap(c0, c1);
+        indices ^= 0x55555555u;
+    } else if (c0 == c1) {
+        indices = 0;
+    }
+    out[0] = static_cast<unsigned char>(c0);
+    out[1] = static_cast<unsigned char>(c0 >> 8);
+    out[2] = static_cast<unsigned char>(c1);
+    out[3] = static_cast<unsigned char>(c1 >> 8);
+    for (int k = 0; k < 4; ++k) out[4 + k] = static_cast<unsigned char>(indices >> (8 * k));
+}
+
+// === BC4 (BC3 alpha, both halves of BC5) ===
+
+void encodeBC4(const Block& block, int channel, unsigned char* out) {
+    float lo = 255.0f, hi = 0.0f;
+    for (const auto& t : block.texels) {
+        lo = std::min(lo, t[channel]);
+        hi = std::max(hi, t[channel]);
+    }
+    int a0 = static_cast<int>(hi + 0.5f);
+    int a1 = static_cast<int>(lo + 0.5f);
+    out[0] = static_cast<unsigned char>(a0);
+    out[1] = static_cast<unsigned char>(a1);
+
+    // a0 > a1 selects the eight-value mode (a0, a1, then six steps from a0 to a1)
+    uint64_t bits = 0;
+    if (a0 > a1) {
+        int palette[8] = {a0, a1};
+        for (int i = 1; i < 7; ++i) palette[i + 1] = ((7 - i) * a0 + i * a1 + 3) / 7;
+        for (int i = 0; i < 16; ++i) {
+            float best = 1e30f;
+            uint64_t bestIndex = 0;
+            for (uint64_t p = 0; p < 8; ++p) {
+                float d = std::fabs(block.texels[i][channel] - palette[p]);
+                if (d < best) {
+                    best = d;
+                    bestIndex = p;
+                }
+            }
+            bits |= bestIndex << (3 * i);
+        }
+    }
+    for (int k = 0; k < 6; ++k) out[2 + k] = static_cast<unsigned char>(bits >> (8 * k));
+}
+
+// === BC7 mode 6 ===
+
+constexpr int BC7_WEIGHTS[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// 7-bit RGBA endpoint plus a p-bit shared as every channel's least significant bit
+struct Bc7Endpoint {
+    int q[4];
+    int p;
+    int value(int c) const { return (q[c] << 1) | p; }
+};
+
+Bc7Endpoint quantizeBC7(const float e[4]) {
+    Bc7Endpoint best{};
+    float bestErr = 1e30f;
+    for (int p = 0; p < 2; ++p) {
+        Bc7Endpoint candidate{};
+        candidate.p = p;
+        float err = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            candidate.q[c] = std::min(std::max(static_cast<int>(std::lround((e[c] - p) * 0.5f)), 0), 127);
+            float d = candidate.value(c) - e[c];
+            err += d * d;
+        }
+        if (err < bestErr) {
+            bestErr = err;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+float bc7Indices(const Block& block, const Bc7Endpoint& e0, const Bc7Endpoint& e1, int indices[16]) {
+    int palette[16][4];
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            palette[i][c] = ((64 - BC7_WEIGHTS[i]) * e0.value(c) + BC7_WEIGHTS[i] * e1.value(c) + 32) >> 6;
+        }
+    }
+
+    float total = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float best = 1e30f;
+        for (int p = 0; p < 16; ++p) {
+            float err = 0.0f;
+            for (int c = 0; c < 4; ++c) {
+                float d = block.texels[i][c] - palette[p][c];
+                err += d * d;
+            }
+            if (err < best) {
+                best = err;
+                indices[i] = p;
+            }
+        }
+        total += best;
+    }
+    return total;
+}
+
+// Writes fields least significant bit first, as BC7 blocks are laid out
+class BitWriter {
+public:
+    explicit BitWriter(unsigned char* out) : m_out(out) { std::fill(out, out + 16, static_cast<unsigned char>(0)); }
+
+    void put(uint32_t value, uint32_t bits) {
+        for (uint32_t b = 0; b < bits; ++b, ++m_bit) {
+            if ((value >> b) & 1u) m_out[m_bit >> 3] |= static_cast<unsigned char>(1u << (m_bit & 7));
+        }
+    }
+
+private:
+    unsigned char* m_out;
+    uint32_t m_bit = 0;
+};
+
+void encodeBC7(const Block& block, unsigned char* out) {
+    float lo[4], hi[4];
+    principalEndpoints<4>(block, lo, hi);
+    Bc7Endpoint e0 = quantizeBC7(lo), e1 = quantizeBC7(hi);
+    int indices[16];
+    float err = bc7Indices(block, e0, e1, indices);
+
+    float weights[16];
+    for (int i = 0; i < 16; ++i) weights[i] = BC7_WEIGHTS[indices[i]] / 64.0f;
+    float a[4], b[4];
+    if (refineEndpoints<4>(block, weights, a, b)) {
+        Bc7Endpoint r0 = quantizeBC7(a), r1 = quantizeBC7(b);
+        int refined[16];
+        if (bc7Indices(block, r0, r1, refined) < err) {
+            e0 = r0;
+            e1 = r1;
+            std::copy(refined, refined + 16, indices);
+        }
+    }
+
+    // The anchor (first) index is stored without its top bit, so it must be < 8
+    if (indices[0] & 8) {
+        std::swap(e0, e1);
+        for (int& index : indices) index = 15 - index;
+    }
+
+    BitWriter bits(out);
+    bits.put(1u << 6, 7);  // Mode 6
+    for (int c = 0; c < 4; ++c) {
+        bits.put(static_cast<uint32_t>(e0.q[c]), 7);
+        bits.put(static_cast<uint32_t>(e1.q[c]), 7);
+    }
+    bits.put(static_cast<uint32_t>(e0.p), 1);
+    bits.put(static_cast<uint32_t>(e1.p), 1);
+    bits.put(static_cast<uint32_t>(indices[0]), 3);
+    for (int i = 1; i < 16; ++i) bits.put(static_cast<uint32_t>(indices[i]), 4);
+}
+
+void encodeBlockRows(const unsigned char* rgba, uint32_t width, uint32_t height, uint32_t format,
+                     uint32_t firstRow, uint32_t endRow, unsigned char* out) {
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blockBytes = packFormatUnitBytes(format);
+    Block block;
+    for (uint32_t by = firstRow; by < endRow; ++by) {
+        for (uint32_t bx = 0; bx < blocksX; ++bx) {
+            fetchBlock(rgba, width, height, bx, by, block);
+            unsigned char* dst = out + (size_t(by) * blocksX + bx) * blockBytes;
+            switch (format) {
+                case PACK_FORMAT_BC1:
+                    encodeBC1(block, dst);
+                    break;
+                case PACK_FORMAT_BC3:
+                    encodeBC4(block, 3, dst);
+                    encodeBC1(block, dst + 8);
+                    break;
+                case PACK_FORMAT_BC5:
+                    encodeBC4(block, 0, dst);
+                    encodeBC4(block, 1, dst + 8);
+                    break;
+                case PACK_FORMAT_BC7:
+                    encodeBC7(block, dst);
+                    break;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+std::vector<unsigned char> compressTexture(const unsigned char* rgba, uint32_t width, uint32_t height, uint32_t format) {
+    if (!packFormatCompressed(format) || width == 0 || height == 0) return {};
+
+    const uint32_t blockRows = packRowCount(format, height);
+    std::vector<unsigned char> out(packRowSize(format, width) * blockRows);
+
+    // Block rows are independent; large images are split across hardware threads
+    unsigned threads = std::min<unsigned>(std::max(std::thread::hardware_concurrency(), 1u), blockRows);
+    if (size_t(width) * height < (256u * 256u)) threads = 1;
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t) {
+        workers.emplace_back(encodeBlockRows, rgba, width, height, format,
+                             blockRows * t / threads, blockRows * (t + 1) / threads, out.data());
+    }
+    encodeBlockRows(rgba, width, height, format, 0, blockRows / threads, out.data());
+    for (std::thread& worker : workers) worker.join();
+    return out;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Offline BCn block encoders for the asset cooker (no GL). Input is an RGBA8
+// image (width * height * 4 bytes); output is rows of 4x4 blocks in the layout
+// glCompressedTexImage2D expects, sized per packMipSize(). Partial edge blocks
+// repeat the last texel row/column.
+//
+//   PACK_FORMAT_BC1  RGB, 4 bpp (alpha ignored)
+//   PACK_FORMAT_BC3  RGB + interpolated alpha, 8 bpp
+//   PACK_FORMAT_BC5  R and G as two independent channels, 8 bpp (normal map XY)
+//   PACK_FORMAT_BC7  RGBA, 8 bpp (mode 6 only: one subset, 16 interpolation steps)
+//
+// Endpoints come from the principal axis of each block's colours, refined by
+// one least-squares pass; this trades a little quality against reference
+// encoders for a cooker that needs no dependencies.
+std::vector<unsigned char> compressTexture(const unsigned char* rgba, uint32_t width, uint32_t height, uint32_t format);
@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Standalone textures (not part of a model), keyed by the name
+// AssetManager::getTexture() uses. Shared by the runtime loader and the asset
+// cooker like ModelManifest.h. Normal maps are cooked to two-channel BC5.
+struct TextureSource {
+    std::string name;
+    std::string path;
+    bool normalMap = false;
+};
+
+inline const std::vector<TextureSource>& textureManifest() {
+    static const std::vector<TextureSource> manifest = {
+        {"brick", "assets/textures/brick/brick_wall_006_diff_1k.jpg"},
+        {"brickNormal", "assets/textures/brick/brick_wall_006_nor_gl_1k.jpg", true},
+        {"snow", "assets/textures/snow.jpg"},
+    };
+    return manifest;
+}
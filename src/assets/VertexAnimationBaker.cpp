@@ -0,0 +1,119 @@
+#include "VertexAnimationBaker.h"
+#include "AnimationCompressor.h"
+#include "VertexFormat.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Skinning matrices of every baked frame, clips back to back
+std::vector<std::vector<glm::mat4>> sampleFrames(const DecodedModel& model, float frameRate,
+                                                 std::vector<VertexAnimationClip>& clips) {
+    const SkeletonDef& skeleton = *model.skeleton;
+    std::vector<std::vector<glm::mat4>> frames;
+    std::vector<glm::mat4> locals;
+    std::vector<glm::mat4> world(skeleton.joints.size());
+
+    for (const AnimationClip& clip : model.clips) {
+        VertexAnimationClip baked;
+        baked.firstFrame = static_cast<uint32_t>(frames.size());
+        baked.duration = clip.duration;
+        baked.frameCount = (clip.duration > 0.0f)
+            ? static_cast<uint32_t>(std::ceil(clip.duration * frameRate - 1e-3f)) + 1
+            : 1;
+
+        for (uint32_t f = 0; f < baked.frameCount; ++f) {
+            const float time = (baked.frameCount > 1) ? clip.duration * float(f) / float(baked.frameCount - 1) : 0.0f;
+            sampleClipLocalPose(clip, time, skeleton, locals);
+
+            std::vector<glm::mat4> bones(skeleton.joints.size());
+            for (size_t j = 0; j < skeleton.joints.size(); ++j) {
+                const Joint& joint = skeleton.joints[j];
+                world[j] = (joint.parentIndex >= 0) ? world[joint.parentIndex] * locals[j] : locals[j];
+                bones[j] = world[j] * joint.inverseBindMatrix;
+            }
+            frames.push_back(std::move(bones));
+        }
+        clips.push_back(baked);
+    }
+    return frames;
+}
+
+} // anonymous namespace
+
+bool bakeVertexAnimation(DecodedModel& model, float frameRate, VertexAnimationBakeStats* stats) {
+    model.vertexAnimation = {};
+    if (!model.skeleton || model.skeleton->joints.empty() || model.clips.empty()) return false;
+
+    DecodedVertexAnimation baked;
+    const std::vector<std::vector<glm::mat4>> frames = sampleFrames(model, std::max(frameRate, 1.0f), baked.clips);
+    baked.frameCount = static_cast<uint32_t>(frames.size());
+    const size_t jointCount = model.skeleton->joints.size();
+
+    for (const DecodedMesh& mesh : model.meshes) {
+        const uint32_t vertexCount = mesh.vertexCount();
+        const uint32_t stride = mesh.vertexStride();
+
+        // Skinned positions and normals of every frame, then quantized over their bounds
+        std::vector<glm::vec3> positions(size_t(baked.frameCount) * vertexCount);
+        std::vector<glm::vec3> normals(positions.size());
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            PackedSkinnedVertex packed{};
+            std::memcpy(&packed, &mesh.vertices[size_t(v) * stride], stride);
+            const glm::vec3 position = unpackPosition(packed.base, mesh.positionOffset, mesh.positionScale);
+            const glm::vec3 normal = octDecode(glm::vec2(packed.base.normal[0], packed.base.normal[1]) / 127.0f);
+
+            for (uint32_t f = 0; f < baked.frameCount; ++f) {
+                glm::mat4 skin(1.0f);
+                if (mesh.skinned) {
+                    skin = glm::mat4(0.0f);
+                    for (int k = 0; k < 4; ++k) {
+                        if (packed.weights[k] == 0 || packed.joints[k] >= jointCount) continue;
+                        skin += frames[f][packed.joints[k]] * (packed.weights[k] / 255.0f);
+                    }
+                }
+                const size_t i = size_t(f) * vertexCount + v;
+                positions[i] = glm::vec3(skin * glm::vec4(position, 1.0f));
+                normals[i] = glm::mat3(skin) * normal;
+            }
+        }
+
+        DecodedVertexAnimationMesh out;
+        glm::vec3 boundsMin(0.0f), boundsMax(0.0f);
+        if (!positions.empty()) {
+            boundsMin = boundsMax = positions[0];
+            for (const glm::vec3& p : positions) {
+                boundsMin = glm::min(boundsMin, p);
+                boundsMax = glm::max(boundsMax, p);
+            }
+        }
+        out.positionOffset = boundsMin;
+        out.positionScale = boundsMax - boundsMin;
+        glm::vec3 invScale(0.0f);
+        for (int a = 0; a < 3; ++a) {
+            if (out.positionScale[a] > 0.0f) invScale[a] = 1.0f / out.positionScale[a];
+        }
+
+        out.texels.resize(positions.size() * 4);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            const glm::vec3 normalized = (positions[i] - boundsMin) * invScale;
+            int8_t normal[2];
+            octEncodeSnorm8(normals[i], normal);
+            uint16_t* texel = &out.texels[i * 4];
+            for (int a = 0; a < 3; ++a) texel[a] = packUnorm16(normalized[a]);
+            texel[3] = static_cast<uint16_t>(uint8_t(normal[0]) | (uint16_t(uint8_t(normal[1])) << 8));
+        }
+
+        if (stats) {
+            stats->bytes += out.texels.size() * sizeof(uint16_t);
+            const glm::vec3 step = out.positionScale / 65535.0f;
+            stats->maxPositionStep = std::max({stats->maxPositionStep, step.x, step.y, step.z});
+        }
+        baked.meshes.push_back(std::move(out));
+    }
+
+    if (stats) stats->frameCount = baked.frameCount;
+    model.vertexAnimation = std::move(baked);
+    return true;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "ModelDecoder.h"
+#include <cstddef>
+#include <cstdint>
+
+// Vertex animation baking (no GL, used by the asset cooker and the .glb
+// fallback): every clip of a skinned model is sampled at a uniform rate, each
+// frame's pose is skinned on the CPU exactly as skinned.vert does, and the
+// results are stored per mesh as one RGBA16UI texel per vertex and frame,
+// frame-major (texel frame * vertexCount + vertex):
+//   xyz  unorm16 position relative to the mesh's animated bounds
+//   w    octahedral normal, two snorm8 (x in the low byte)
+// Far-away instances then play a clip from these frames with only a clip
+// index and a time (vertex_animation.vert), no skeleton.
+// Meshes without skinning repeat their bind positions in every frame.
+
+struct VertexAnimationBakeStats {
+    uint32_t frameCount = 0;
+    size_t bytes = 0;             // Texels of every mesh
+    float maxPositionStep = 0.0f; // Largest quantization step, in model units
+};
+
+// Fills model.vertexAnimation from model.clips (compressed or not). Returns
+// false (and leaves it empty) for models without a skeleton or clips.
+bool bakeVertexAnimation(DecodedModel& model, float frameRate, VertexAnimationBakeStats* stats = nullptr);
@@ -0,0 +1,169 @@
+#pragma once
+#include "AssetPack.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Conversion between the float vertices decoders and procedural meshes build
+// and the quantized PackedVertex/PackedSkinnedVertex layouts that are
+// uploaded (see AssetPack.h). No GL, so the cooker and workers can use it.
+
+// Unpacked input: position(3f) normal(3f) uv(2f) [joints(4f) weights(4f)]
+constexpr uint32_t STATIC_VERTEX_FLOATS = 8;
+constexpr uint32_t SKINNED_VERTEX_FLOATS = 16;
+
+// IEEE 754 binary16, round to nearest even; overflow saturates to infinity
+inline uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t absBits = bits & 0x7FFFFFFFu;
+
+    if (absBits >= 0x7F800000u) {  // Inf / NaN
+        return static_cast<uint16_t>(sign | 0x7C00u | ((absBits > 0x7F800000u) ? 0x200u : 0u));
+    }
+    if (absBits >= 0x477FF000u) return static_cast<uint16_t>(sign | 0x7C00u);  // Rounds past 65504
+    if (absBits < 0x38800000u) {                                               // Subnormal half (or zero)
+        if (absBits < 0x33000000u) return static_cast<uint16_t>(sign);
+        const uint32_t mantissa = (absBits & 0x007FFFFFu) | 0x00800000u;
+        const uint32_t shift = 126u - (absBits >> 23);
+        uint32_t half = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1u);
+        if (rest > halfway || (rest == halfway && (half & 1u))) ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+    uint32_t half = ((absBits - 0x38000000u) >> 13);
+    const uint32_t rest = absBits & 0x1FFFu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) ++half;
+    return static_cast<uint16_t>(sign | half);
+}
+
+inline float halfToFloat(uint16_t half) {
+    const uint32_t sign = uint32_t(half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1Fu;
+    const uint32_t mantissa = half & 0x3FFu;
+    uint32_t bits;
+    if (exponent == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    } else if (mantissa != 0) {
+        float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -value : value;
+    } else {
+        bits = sign;
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Octahedral normal mapping: the unit sphere folded onto [-1, 1]^2. A zero
+// normal maps to +Z. Decoded in the shaders by octDecode().
+inline glm::vec2 octEncode(const glm::vec3& n) {
+    float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    if (l1 <= 0.0f) return glm::vec2(0.0f);
+    glm::vec2 p = glm::vec2(n.x, n.y) / l1;
+    if (n.z < 0.0f) {
+        p = glm::vec2((1.0f - std::abs(p.y)) * (p.x >= 0.0f ? 1.0f : -1.0f),
+                      (1.0f - std::abs(p.x)) * (p.y >= 0.0f ? 1.0f : -1.0f));
+    }
+    return p;
+}
+
+inline glm::vec3 octDecode(glm::vec2 e) {
+    glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+    float t = std::max(-n.z, 0.0f);
+    n.x += (n.x >= 0.0f) ? -t : t;
+    n.y += (n.y >= 0.0f) ? -t : t;
+    return glm::normalize(n);
+}
+
+// Two snorm8 components: of the four neighbouring grid points, keeps the one
+// that decodes closest to `n` (max error ~0.6 degrees vs ~0.9 rounding)
+inline void octEncodeSnorm8(const glm::vec3& n, int8_t out[2]) {
+    glm::vec2 e = octEncode(n) * 127.0f;
+    glm::vec3 target = (glm::dot(n, n) > 0.0f) ? glm::normalize(n) : glm::vec3(0.0f, 0.0f, 1.0f);
+    float best = -2.0f;
+    for (int i = 0; i < 4; ++i) {
+        float x = std::clamp(std::floor(e.x) + float(i & 1), -127.0f, 127.0f);
+        float y = std::clamp(std::floor(e.y) + float(i >> 1), -127.0f, 127.0f);
+        float d = glm::dot(octDecode(glm::vec2(x, y) / 127.0f), target);
+        if (d > best) {
+            best = d;
+            out[0] = static_cast<int8_t>(x);
+            out[1] = static_cast<int8_t>(y);
+        }
+    }
+}
+
+inline uint16_t packUnorm16(float v) {
+    return static_cast<uint16_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 65535.0f));
+}
+
+struct PackedVertices {
+    std::vector<unsigned char> data;     // PackedVertex or PackedSkinnedVertex array
+    glm::vec3 positionOffset{0.0f};      // Bounds minimum
+    glm::vec3 positionScale{1.0f};       // Bounds extent (0 on flat axes)
+};
+
+// Quantize `count` unpacked vertices (STATIC_/SKINNED_VERTEX_FLOATS each).
+// Positions are stored relative to the vertex bounds; weights are rounded so
+// they still sum to exactly 255, with the error folded into the largest one.
+inline PackedVertices packVertices(const float* vertices, size_t count, bool skinned) {
+    const uint32_t floatsPerVertex = skinned ? SKINNED_VERTEX_FLOATS : STATIC_VERTEX_FLOATS;
+    const size_t stride = skinned ? sizeof(PackedSkinnedVertex) : sizeof(PackedVertex);
+
+    PackedVertices out;
+    if (count == 0) return out;
+
+    glm::vec3 boundsMin(vertices[0], vertices[1], vertices[2]);
+    glm::vec3 boundsMax = boundsMin;
+    for (size_t i = 1; i < count; ++i) {
+        const float* v = vertices + i * floatsPerVertex;
+        boundsMin = glm::min(boundsMin, glm::vec3(v[0], v[1], v[2]));
+        boundsMax = glm::max(boundsMax, glm::vec3(v[0], v[1], v[2]));
+    }
+    out.positionOffset = boundsMin;
+    out.positionScale = boundsMax - boundsMin;
+    glm::vec3 invScale(0.0f);
+    for (int a = 0; a < 3; ++a) {
+        if (out.positionScale[a] > 0.0f) invScale[a] = 1.0f / out.positionScale[a];
+    }
+
+    out.data.assign(count * stride, 0);
+    for (size_t i = 0; i < count; ++i) {
+        const float* v = vertices + i * floatsPerVertex;
+        PackedSkinnedVertex packed{};
+        PackedVertex& base = packed.base;
+
+        glm::vec3 normalized = (glm::vec3(v[0], v[1], v[2]) - boundsMin) * invScale;
+        for (int a = 0; a < 3; ++a) base.position[a] = packUnorm16(normalized[a]);
+        octEncodeSnorm8(glm::vec3(v[3], v[4], v[5]), base.normal);
+        base.uv[0] = floatToHalf(v[6]);
+        base.uv[1] = floatToHalf(v[7]);
+
+        if (skinned) {
+            int sum = 0, largest = 0;
+            for (int k = 0; k < 4; ++k) {
+                packed.joints[k] = static_cast<uint8_t>(std::clamp(v[8 + k], 0.0f, 255.0f));
+                packed.weights[k] = static_cast<uint8_t>(std::lround(std::clamp(v[12 + k], 0.0f, 1.0f) * 255.0f));
+                sum += packed.weights[k];
+                if (packed.weights[k] > packed.weights[largest]) largest = k;
+            }
+            if (sum > 0) {
+                packed.weights[largest] = static_cast<uint8_t>(std::clamp(packed.weights[largest] + 255 - sum, 0, 255));
+            }
+        }
+        std::memcpy(&out.data[i * stride], &packed, stride);
+    }
+    return out;
+}
+
+inline glm::vec3 unpackPosition(const PackedVertex& v, const glm::vec3& offset, const glm::vec3& scale) {
+    return offset + glm::vec3(v.position[0], v.position[1], v.position[2]) * (1.0f / 65535.0f) * scale;
+}
@@ -1,19 +1,45 @@
 #pragma once
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
 #include <stb_image.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
 #include <unordered_map>
 #include <string>
 #include <iostream>
 
 #include "../Shader.h"
+#include "../assets/AnimationCompressor.h"
 #include "../assets/AssetLoader.h"
+#include "../assets/AssetPack.h"
+#include "../assets/GpuUploadQueue.h"
+#include "../assets/ModelManifest.h"
+#include "../assets/TextureManifest.h"
+#include "../assets/VertexAnimationBaker.h"
 #include "../ecs/components/Mesh.h"
 #include "GameConfig.h"
+#include "CpuProfiler.h"
+#include "TaskGraph.h"
 
 // Forward declarations
 struct SceneContext;
 
+// Clip compression settings from config.xml (<Animation>), for the cooker and .glb fallbacks
+inline AnimationCompression configuredAnimationCompression() {
+    AnimationCompression settings;
+    settings.sampleRate = GameConfig::ANIMATION_SAMPLE_RATE;
+    settings.rotationTolerance = GameConfig::ANIMATION_ROTATION_TOLERANCE;
+    settings.translationTolerance = GameConfig::ANIMATION_TRANSLATION_TOLERANCE;
+    return settings;
+}
+
+// Streamed model handle: index into modelManifest()
+using ModelHandle = uint32_t;
+constexpr ModelHandle INVALID_MODEL_HANDLE = ~0u;
+
 // Shader identifiers for non-RenderSystem shaders
 enum class AssetShader {
     Ground,
@@ -25,13 +51,15 @@ enum class AssetShader {
     Snow,
     Depth,
     SkinnedDepth,
-    MotionBlur,
-    ToonPost,
+    VertexAnimationDepth,
+    PostProcess,
     Blit,
     Overlay,
     SolidOverlay,
     DangerZone,
-    RadialBlur
+    VelocityTileMax,
+    VelocityNeighborMax,
+    FrozenFrame
 };
 
 // Render target collection (FBOs + attachments)
@@ -40,7 +68,7 @@ struct RenderTargets {
     GLuint shadowFBO = 0;
     GLuint shadowDepthTexture = 0;
 
-    // Motion blur
+    // Cinematic resolve target (color + depth for motion blur)
     GLuint motionBlurFBO = 0;
     GLuint motionBlurColorTex = 0;
     GLuint motionBlurDepthTex = 0;
@@ -49,11 +77,16 @@ struct RenderTargets {
     GLuint cinematicMsaaFBO = 0;
     GLuint cinematicMsaaColorRBO = 0;
     GLuint cinematicMsaaDepthRBO = 0;
+    GLuint cinematicMsaaVelocityRBO = 0;  // Attachment 1: object motion (RG16F)
 
-    // Toon post-processing
-    GLuint toonFBO = 0;
-    GLuint toonColorTex = 0;
-    GLuint toonDepthRBO = 0;
+    // Velocity resolve + tile-max / neighbor-max downsample (motion blur)
+    static constexpr int VELOCITY_TILE_SIZE = 20;
+    GLuint velocityFBO = 0;
+    GLuint velocityTex = 0;
+    GLuint tileMaxFBO = 0;
+    GLuint tileMaxTex = 0;
+    GLuint neighborMaxFBO = 0;
+    GLuint neighborMaxTex = 0;
 
     // Main MSAA + resolve
     GLuint msaaFBO = 0;
@@ -61,13 +94,21 @@ struct RenderTargets {
     GLuint msaaDepthRBO = 0;
     GLuint resolveFBO = 0;
     GLuint resolveColorTex = 0;
+
+    // Captured presented frame (raw copy, then blurred/darkened once) for still backgrounds
+    GLuint frozenCaptureFBO = 0;
+    GLuint frozenCaptureTex = 0;
+    GLuint frozenFrameFBO = 0;
+    GLuint frozenFrameTex = 0;
+
+    // Current internal render size of the screen-sized targets
+    int width = 0;
+    int height = 0;
 };
 
 // Primitive VAO collection
 struct PrimitiveVAOs {
-    GLuint planeVAO = 0;
-    GLuint planeVBO = 0;
-    GLuint planeEBO = 0;
+    Mesh plane;  // Ground plane, packed like model meshes (model.vert)
 
     GLuint sunVAO = 0;
     GLuint sunVBO = 0;
@@ -89,22 +130,41 @@ public:
     AssetManager& operator=(const AssetManager&) = delete;
 
     // === Main initialization ===
+    // Textures, shaders, primitive VAOs and render targets are ready when init()
+    // returns (file reads and decodes on worker threads, GL work here). Models
+    // stream in afterwards: workers decode or prefetch them while
+    // updateStreaming() feeds their uploads to the GPU within a per-frame budget.
+    // With streaming disabled, init() waits for every model instead.
     bool init() {
         if (m_initialized) return true;
+        CPU_PROFILE_ZONE("AssetManager::init");
 
-        loadAllTextures();
-        loadAllShaders();
-        loadAllModels();
-        createPrimitiveVAOs();
-        createRenderTargets();
+        startModelStreaming();
+
+        TaskGraph graph;
+        queueTextureLoads(graph);
+        graph.add("Load shaders", TaskGraph::MainThread, [this] { loadAllShaders(); });
+        graph.add("Create primitive VAOs", TaskGraph::MainThread, [this] { createPrimitiveVAOs(); });
+        graph.add("Create render targets", TaskGraph::MainThread, [this] { createRenderTargets(); });
+        graph.run();
+        m_pendingTextures.clear();
 
         m_initialized = true;
+        if (!GameConfig::STREAM_ASSETS) {
+            finishStreaming();
+        }
         return true;
     }
 
     void cleanup() {
         if (!m_initialized) return;
 
+        m_streamGraph.reset();  // Joins the workers before their targets go away
+        m_uploads.shutdown();
+        m_pack.close();
+        m_streamedModels.clear();
+        m_modelHandles.clear();
+
         // Delete textures
         for (auto& [name, tex] : m_textures) {
             if (tex) glDeleteTextures(1, &tex);
@@ -118,9 +178,9 @@ public:
         m_models.clear();
 
         // Primitive VAOs
-        if (m_primitiveVAOs.planeVAO) glDeleteVertexArrays(1, &m_primitiveVAOs.planeVAO);
-        if (m_primitiveVAOs.planeVBO) glDeleteBuffers(1, &m_primitiveVAOs.planeVBO);
-        if (m_primitiveVAOs.planeEBO) glDeleteBuffers(1, &m_primitiveVAOs.planeEBO);
+        if (m_primitiveVAOs.plane.vao) glDeleteVertexArrays(1, &m_primitiveVAOs.plane.vao);
+        if (m_primitiveVAOs.plane.vertexBuffer) glDeleteBuffers(1, &m_primitiveVAOs.plane.vertexBuffer);
+        if (m_primitiveVAOs.plane.indexBuffer) glDeleteBuffers(1, &m_primitiveVAOs.plane.indexBuffer);
         if (m_primitiveVAOs.sunVAO) glDeleteVertexArrays(1, &m_primitiveVAOs.sunVAO);
         if (m_primitiveVAOs.sunVBO) glDeleteBuffers(1, &m_primitiveVAOs.sunVBO);
         if (m_primitiveVAOs.overlayVAO) glDeleteVertexArrays(1, &m_primitiveVAOs.overlayVAO);
@@ -140,16 +200,25 @@ public:
         if (m_renderTargets.cinematicMsaaFBO) glDeleteFramebuffers(1, &m_renderTargets.cinematicMsaaFBO);
         if (m_renderTargets.cinematicMsaaColorRBO) glDeleteRenderbuffers(1, &m_renderTargets.cinematicMsaaColorRBO);
         if (m_renderTargets.cinematicMsaaDepthRBO) glDeleteRenderbuffers(1, &m_renderTargets.cinematicMsaaDepthRBO);
+        if (m_renderTargets.cinematicMsaaVelocityRBO) glDeleteRenderbuffers(1, &m_renderTargets.cinematicMsaaVelocityRBO);
 
-        if (m_renderTargets.toonFBO) glDeleteFramebuffers(1, &m_renderTargets.toonFBO);
-        if (m_renderTargets.toonColorTex) glDeleteTextures(1, &m_renderTargets.toonColorTex);
-        if (m_renderTargets.toonDepthRBO) glDeleteRenderbuffers(1, &m_renderTargets.toonDepthRBO);
+        if (m_renderTargets.velocityFBO) glDeleteFramebuffers(1, &m_renderTargets.velocityFBO);
+        if (m_renderTargets.velocityTex) glDeleteTextures(1, &m_renderTargets.velocityTex);
+        if (m_renderTargets.tileMaxFBO) glDeleteFramebuffers(1, &m_renderTargets.tileMaxFBO);
+        if (m_renderTargets.tileMaxTex) glDeleteTextures(1, &m_renderTargets.tileMaxTex);
+        if (m_renderTargets.neighborMaxFBO) glDeleteFramebuffers(1, &m_renderTargets.neighborMaxFBO);
+        if (m_renderTargets.neighborMaxTex) glDeleteTextures(1, &m_renderTargets.neighborMaxTex);
 
         if (m_renderTargets.msaaFBO) glDeleteFramebuffers(1, &m_renderTargets.msaaFBO);
         if (m_renderTargets.msaaColorRBO) glDeleteRenderbuffers(1, &m_renderTargets.msaaColorRBO);
         if (m_renderTargets.msaaDepthRBO) glDeleteRenderbuffers(1, &m_renderTargets.msaaDepthRBO);
         if (m_renderTargets.resolveFBO) glDeleteFramebuffers(1, &m_renderTargets.resolveFBO);
         if (m_renderTargets.resolveColorTex) glDeleteTextures(1, &m_renderTargets.resolveColorTex);
+
+        if (m_renderTargets.frozenCaptureFBO) glDeleteFramebuffers(1, &m_renderTargets.frozenCaptureFBO);
+        if (m_renderTargets.frozenCaptureTex) glDeleteTextures(1, &m_renderTargets.frozenCaptureTex);
+        if (m_renderTargets.frozenFrameFBO) glDeleteFramebuffers(1, &m_renderTargets.frozenFrameFBO);
+        if (m_renderTargets.frozenFrameTex) glDeleteTextures(1, &m_renderTargets.frozenFrameTex);
         m_renderTargets = {};
 
         m_initialized = false;
@@ -176,16 +245,226 @@ public:
         return (it != m_models.end()) ? &it->second.meshGroup : nullptr;
     }
 
+    // === Model streaming ===
+    // getModel() references are stable from init() on, but stay empty until the
+    // model is resident; whenModelResident() is the hook for filling in entities.
+
+    ModelHandle modelHandle(const std::string& name) const {
+        auto it = m_modelHandles.find(name);
+        return (it != m_modelHandles.end()) ? it->second : INVALID_MODEL_HANDLE;
+    }
+
+    bool isModelResident(ModelHandle handle) const {
+        return handle < m_streamedModels.size() && m_streamedModels[handle].resident;
+    }
+
+    // Runs fn on the GL thread once the model is resident (right away if it already is)
+    void whenModelResident(const std::string& name, std::function<void(LoadedModel&)> fn) {
+        ModelHandle handle = modelHandle(name);
+        if (handle == INVALID_MODEL_HANDLE) {
+            std::cerr << "AssetManager: Unknown model " << name << std::endl;
+            return;
+        }
+        StreamedModel& entry = m_streamedModels[handle];
+        if (entry.resident) {
+            fn(*entry.model);
+        } else {
+            entry.onResident.push_back(std::move(fn));
+        }
+    }
+
+    // Model-space bounds, read from the asset pack before the model is resident;
+    // models loaded from .glb are waited for
+    ModelBounds modelBounds(const std::string& name) {
+        ModelHandle handle = modelHandle(name);
+        if (handle == INVALID_MODEL_HANDLE) return {};
+        const StreamedModel& entry = m_streamedModels[handle];
+        if (!entry.resident && entry.packed) {
+            ModelBounds bounds;
+            bounds.min = glm::make_vec3(entry.packed->boundsMin);
+            bounds.max = glm::make_vec3(entry.packed->boundsMax);
+            return bounds;
+        }
+        waitForStreaming([&entry] { return entry.resident; });
+        return entry.model->bounds;
+    }
+
+    // Call once per frame on the GL thread: runs ready staging tasks and issues
+    // uploads for roughly budgetMs
+    void updateStreaming(double budgetMs) {
+        if (!m_streamGraph) return;
+        CPU_PROFILE_ZONE("Asset streaming");
+        auto start = std::chrono::steady_clock::now();
+        m_streamGraph->pump(budgetMs);
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        m_uploads.process(std::max(budgetMs - elapsedMs, 0.0));  // At least one slice per frame
+        if (m_streamGraph->finished() && m_uploads.empty()) {
+            endStreaming();
+        }
+    }
+
+    // Blocks until every model is resident (benchmark runs, streaming disabled)
+    void finishStreaming() {
+        waitForStreaming([] { return false; });
+    }
+
+    bool streamingFinished() const { return !m_streamGraph; }
+
+    // Fraction of model data resident on the GPU, 0..1
+    float streamingProgress() const {
+        if (!m_streamGraph || m_streamedModels.empty()) return 1.0f;
+        double sum = 0.0;
+        for (const StreamedModel& entry : m_streamedModels) {
+            if (entry.resident) {
+                sum += 1.0;
+            } else if (entry.staged && entry.uploadEnd > entry.uploadStart) {
+                double uploaded = double(m_uploads.uploadedBytes()) - double(entry.uploadStart);
+                sum += std::clamp(uploaded / double(entry.uploadEnd - entry.uploadStart), 0.0, 1.0);
+            }
+        }
+        return float(sum / m_streamedModels.size());
+    }
+
+    // Bumped whenever a model becomes resident (lets cached views refresh)
+    uint32_t residentGeneration() const { return m_residentGeneration; }
+
     const RenderTargets& renderTargets() const { return m_renderTargets; }
     const PrimitiveVAOs& primitiveVAOs() const { return m_primitiveVAOs; }
 
+    // === Render target resizing ===
+    // (Re)allocate storage for all screen-sized targets at the internal render size.
+    // No-op when the size is unchanged, so it can be called every frame.
+    bool resizeRenderTargets(int w, int h) {
+        if (w <= 0 || h <= 0) return false;
+        if (w == m_renderTargets.width && h == m_renderTargets.height) return false;
+
+        m_renderTargets.width = w;
+        m_renderTargets.height = h;
+
+        // === Motion Blur FBO (cinematic resolve target) ===
+        glBindTexture(GL_TEXTURE_2D, m_renderTargets.motionBlurColorTex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, w, h, 0, GL_RGB, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindTexture(GL_TEXTURE_2D, m_renderTargets.motionBlurDepthTex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, w, h, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_renderTargets.motionBlurFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_renderTargets.motionBlurColorTex, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_renderTargets.motionBlurDepthTex, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "Motion blur FBO is not complete!" << std::endl;
+        }
+
+        // === Cinematic MSAA FBO ===
+        glBindRenderbuffer(GL_RENDERBUFFER, m_renderTargets.cinematicMsaaColorRBO);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, MSAA_SAMPLES, GL_RGB16F, w, h);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, m_renderTargets.cinematicMsaaDepthRBO);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, MSAA_SAMPLES, GL_DEPTH_COMPONENT32F, w, h);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, m_renderTargets.cinematicMsaaVelocityRBO);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, MSAA_SAMPLES, GL_RG16F, w, h);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_renderTargets.cinematicMsaaFBO);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_renderTargets.cinematicMsaaColorRBO);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_RENDERBUFFER, m_renderTargets.cinematicMsaaVelocityRBO);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_renderTargets.cinematicMsaaDepthRBO);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "Cinematic MSAA FBO is not complete!" << std::endl;
+        }
+
+        // === Velocity resolve + tile buffers ===
+        const int tilesX = (w + RenderTargets::VELOCITY_TILE_SIZE - 1) / RenderTargets::VELOCITY_TILE_SIZE;
+        const int tilesY = (h + RenderTargets::VELOCITY_TILE_SIZE - 1) / RenderTargets::VELOCITY_TILE_SIZE;
+        allocateColorTarget(m_renderTargets.velocityFBO, m_renderTargets.velocityTex, w, h, GL_RG16F, GL_NEAREST, "Velocity");
+        allocateColorTarget(m_renderTargets.tileMaxFBO, m_renderTargets.tileMaxTex, tilesX, tilesY, GL_RG16F, GL_NEAREST, "Tile-max");
+        allocateColorTarget(m_renderTargets.neighborMaxFBO, m_renderTargets.neighborMaxTex, tilesX, tilesY, GL_RG16F, GL_NEAREST, "Neighbor-max");
+
+        // === Main MSAA FBO ===
+        glBindRenderbuffer(GL_RENDERBUFFER, m_renderTargets.msaaColorRBO);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, MSAA_SAMPLES, GL_RGB16F, w, h);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, m_renderTargets.msaaDepthRBO);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, MSAA_SAMPLES, GL_DEPTH24_STENCIL8, w, h);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_renderTargets.msaaFBO);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_renderTargets.msaaColorRBO);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_renderTargets.msaaDepthRBO);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "MSAA FBO is not complete!" << std::endl;
+        }
+
+        // === Resolve FBO ===
+        glBindTexture(GL_TEXTURE_2D, m_renderTargets.resolveColorTex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, w, h, 0, GL_RGB, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_renderTargets.resolveFBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_renderTargets.resolveColorTex, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "Resolve FBO is not complete!" << std::endl;
+        }
+
+        // === Frozen frame (still backgrounds) ===
+        allocateColorTarget(m_renderTargets.frozenCaptureFBO, m_renderTargets.frozenCaptureTex, w, h, GL_RGBA8, GL_LINEAR, "Frozen capture");
+        allocateColorTarget(m_renderTargets.frozenFrameFBO, m_renderTargets.frozenFrameTex, w, h, GL_RGBA8, GL_LINEAR, "Frozen frame");
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        std::cout << "Render targets: " << w << "x" << h << std::endl;
+        return true;
+    }
+
 private:
+    static constexpr int MSAA_SAMPLES = 4;
+
+    // Single-sample color target (velocity tiles use nearest filtering so lookups stay exact)
+    void allocateColorTarget(GLuint fbo, GLuint tex, int w, int h, GLenum internalFormat, GLint filter, const char* name) {
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, w, h, 0, GL_RGBA, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << name << " FBO is not complete!" << std::endl;
+        }
+    }
+
     // === Texture loading ===
-    GLuint loadTextureFromFile(const std::string& path) {
-        int width, height, channels;
-        unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-        if (!data) {
-            std::cerr << "Failed to load texture: " << path << std::endl;
+    struct PendingTexture {
+        const TextureSource* source = nullptr;
+        const PackNamedTexture* packed = nullptr;  // Cooked mip chain; null = decode the source file
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        unsigned char* data = nullptr;  // stbi_load result, freed after upload
+    };
+
+    GLuint uploadTexture(PendingTexture& tex) {
+        if (tex.packed) {
+            const PackTexture& packed = tex.packed->texture;
+            std::cout << "Loaded packed texture: " << tex.source->name << " (" << packed.width << "x" << packed.height
+                      << ", " << packed.mipCount << " mips)" << std::endl;
+            return loadPackedTexture(m_pack, packed);
+        }
+        if (!tex.data) {
+            std::cerr << "Failed to load texture: " << tex.source->path << std::endl;
             return 0;
         }
 
@@ -197,20 +476,47 @@ private:
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-        GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        GLenum format = (tex.channels == 4) ? GL_RGBA : GL_RGB;
+        glTexImage2D(GL_TEXTURE_2D, 0, format, tex.width, tex.height, 0, format, GL_UNSIGNED_BYTE, tex.data);
         glGenerateMipmap(GL_TEXTURE_2D);
 
-        stbi_image_free(data);
-        std::cout << "Loaded texture: " << path << " (" << width << "x" << height << ")" << std::endl;
+        stbi_image_free(tex.data);
+        tex.data = nullptr;
+        std::cout << "Loaded texture: " << tex.source->path << " (" << tex.width << "x" << tex.height << ")" << std::endl;
 
         return texture;
     }
 
-    void loadAllTextures() {
-        m_textures["brick"] = loadTextureFromFile("assets/textures/brick/brick_wall_006_diff_1k.jpg");
-        m_textures["brickNormal"] = loadTextureFromFile("assets/textures/brick/brick_wall_006_nor_gl_1k.jpg");
-        m_textures["snow"] = loadTextureFromFile("assets/textures/snow.jpg");
+    // Cooked textures (pre-compressed, mips baked) are prefetched from the pack
+    // on a worker; missing or stale ones are decoded with stb_image instead.
+    // Uploads run on the main thread. The pack is opened by startModelStreaming().
+    void queueTextureLoads(TaskGraph& graph) {
+        const auto& manifest = textureManifest();
+        m_pendingTextures.assign(manifest.size(), PendingTexture{});
+        for (size_t i = 0; i < manifest.size(); ++i) {
+            PendingTexture& tex = m_pendingTextures[i];
+            tex.source = &manifest[i];
+            if (m_pack.isOpen()) {
+                const PackNamedTexture* packed = m_pack.findTexture(tex.source->name);
+                if (packed && m_pack.isCurrent(*packed, tex.source->path)) {
+                    tex.packed = packed;
+                } else {
+                    std::cerr << "AssetPack: " << tex.source->name << " missing or stale, loading "
+                              << tex.source->path << std::endl;
+                }
+            }
+
+            auto decode = graph.add("Decode texture", TaskGraph::Worker, [this, &tex] {
+                if (tex.packed) {
+                    m_pack.prefetch(tex.packed->texture);
+                } else {
+                    tex.data = stbi_load(tex.source->path.c_str(), &tex.width, &tex.height, &tex.channels, 0);
+                }
+            });
+            graph.add("Upload texture", TaskGraph::MainThread, [this, &tex] {
+                m_textures[tex.source->name] = uploadTexture(tex);
+            }, {decode});
+        }
     }
 
     // === Shader loading ===
@@ -224,63 +530,174 @@ private:
         m_shaders[AssetShader::Snow].loadFromFiles("shaders/snow.vert", "shaders/snow.frag");
         m_shaders[AssetShader::Depth].loadFromFiles("shaders/depth.vert", "shaders/depth.frag");
         m_shaders[AssetShader::SkinnedDepth].loadFromFiles("shaders/skinned_depth.vert", "shaders/depth.frag");
-        m_shaders[AssetShader::MotionBlur].loadFromFiles("shaders/motion_blur.vert", "shaders/motion_blur.frag");
-        m_shaders[AssetShader::ToonPost].loadFromFiles("shaders/toon_post.vert", "shaders/toon_post.frag");
+        m_shaders[AssetShader::VertexAnimationDepth].loadFromFiles("shaders/vertex_animation_depth.vert", "shaders/depth.frag");
+        m_shaders[AssetShader::PostProcess].loadFromFiles("shaders/fullscreen.vert", "shaders/post_process.frag");
         m_shaders[AssetShader::Blit].loadFromFiles("shaders/fullscreen.vert", "shaders/blit.frag");
         m_shaders[AssetShader::Overlay].loadFromFiles("shaders/shadertoy_overlay.vert", "shaders/shadertoy_overlay.frag");
         m_shaders[AssetShader::SolidOverlay].loadFromFiles("shaders/solid_overlay.vert", "shaders/solid_overlay.frag");
         m_shaders[AssetShader::DangerZone].loadFromFiles("shaders/danger_zone.vert", "shaders/danger_zone.frag");
-        m_shaders[AssetShader::RadialBlur].loadFromFiles("shaders/fullscreen.vert", "shaders/radial_blur.frag");
+        m_shaders[AssetShader::VelocityTileMax].loadFromFiles("shaders/fullscreen.vert", "shaders/velocity_tilemax.frag");
+        m_shaders[AssetShader::VelocityNeighborMax].loadFromFiles("shaders/fullscreen.vert", "shaders/velocity_neighbormax.frag");
+        m_shaders[AssetShader::FrozenFrame].loadFromFiles("shaders/fullscreen.vert", "shaders/frozen_frame.frag");
+    }
+
+    // === Model streaming ===
+    struct StreamedModel {
+        const ModelSource* source = nullptr;
+        LoadedModel* model = nullptr;          // Entry in m_models
+        const PackModel* packed = nullptr;     // Set while streaming from the pack
+        DecodedModel decoded;                  // Worker output (.glb path), kept until resident
+        uint64_t uploadStart = 0;              // Queue byte range of this model's uploads
+        uint64_t uploadEnd = 0;
+        bool staged = false;
+        bool resident = false;
+        std::vector<std::function<void(LoadedModel&)>> onResident;
+    };
+
+    void startModelStreaming() {
+        m_streamStart = std::chrono::steady_clock::now();
+
+        const auto& manifest = modelManifest();
+        m_streamedModels.resize(manifest.size());
+        for (size_t i = 0; i < manifest.size(); ++i) {
+            m_streamedModels[i].source = &manifest[i];
+            m_streamedModels[i].model = &m_models[manifest[i].name];
+            m_modelHandles[manifest[i].name] = static_cast<ModelHandle>(i);
+        }
+
+        size_t segmentBytes = size_t(std::max(GameConfig::STREAM_STAGING_MB, 1)) << 20;
+        if (!m_uploads.init(segmentBytes)) {
+            std::cerr << "AssetManager: No staging buffer, models upload in one go" << std::endl;
+        }
+
+        m_streamGraph = std::make_unique<TaskGraph>();
+        queueModelLoads(*m_streamGraph);
+        m_streamGraph->start();
+    }
+
+    GpuUploadQueue* uploadQueue() { return m_uploads.isInitialized() ? &m_uploads : nullptr; }
+
+    // Packed models are prefetched into the page cache by a worker and staged
+    // from the mapping; the rest are decoded from their .glb on a worker. Staging
+    // only creates GL objects; the upload queue fills them over the next frames.
+    void queueModelLoads(TaskGraph& graph) {
+        const bool havePack = GameConfig::USE_ASSET_PACK && m_pack.open(GameConfig::ASSET_PACK);
+
+        for (ModelHandle handle = 0; handle < m_streamedModels.size(); ++handle) {
+            StreamedModel& entry = m_streamedModels[handle];
+            const ModelSource& source = *entry.source;
+
+            const PackModel* packed = havePack ? m_pack.findModel(source.name) : nullptr;
+            if (packed && m_pack.isCurrent(*packed, source.path)) {
+                entry.packed = packed;
+                auto prefetch = graph.add("Prefetch packed model", TaskGraph::Worker, [this, packed] {
+                    m_pack.prefetch(*packed);
+                });
+                graph.add("Stage packed model", TaskGraph::MainThread, [this, handle, packed] {
+                    beginStaging(handle);
+                    *m_streamedModels[handle].model = loadPackedModel(m_pack, *packed, uploadQueue(),
+                                                                      m_streamedModels[handle].source->retention);
+                    endStaging(handle);
+                }, {prefetch});
+                continue;
+            }
+
+            if (havePack) {
+                std::cerr << "AssetPack: " << source.name << " missing or stale, loading " << source.path << std::endl;
+            }
+            auto decode = graph.add("Decode GLB", TaskGraph::Worker, [&entry] {
+                if (!decodeGLB(entry.source->path, entry.decoded)) {
+                    entry.decoded = {};
+                    return;
+                }
+                if (GameConfig::COMPRESS_ANIMATIONS) {
+                    const SkeletonDef* skeleton = entry.decoded.skeleton ? &*entry.decoded.skeleton : nullptr;
+                    compressAnimationClips(entry.decoded.clips, skeleton, configuredAnimationCompression());
+                }
+                if (GameConfig::VERTEX_ANIMATION && entry.source->vertexAnimation) {
+                    bakeVertexAnimation(entry.decoded, GameConfig::VERTEX_ANIMATION_RATE);
+                }
+            });
+            graph.add("Stage model", TaskGraph::MainThread, [this, handle] {
+                StreamedModel& model = m_streamedModels[handle];
+                beginStaging(handle);
+                *model.model = uploadDecodedModel(model.decoded, uploadQueue(), model.source->retention);
+                endStaging(handle);
+                std::cout << "Loaded GLB: " << model.source->path << " (" << model.model->meshGroup.meshes.size()
+                          << " meshes)" << std::endl;
+            }, {decode});
+        }
+    }
+
+    void beginStaging(ModelHandle handle) {
+        m_streamedModels[handle].uploadStart = m_uploads.queuedBytes();
     }
 
-    // === Model loading ===
-    void loadAllModels() {
-        m_models["protagonist"] = loadGLB("assets/protagonist.glb");
-        m_models["fingHighDetail"] = loadGLB("assets/modelo_fing.glb");
-        m_models["fingLowDetail"] = loadGLB("assets/fing_lod.glb");
-        m_models["comet"] = loadGLB("assets/comet.glb");
-        m_models["military"] = loadGLB("assets/military.glb");
-        m_models["scientist"] = loadGLB("assets/scientist.glb");
-        m_models["monster"] = loadGLB("assets/monster.glb");
+    void endStaging(ModelHandle handle) {
+        StreamedModel& entry = m_streamedModels[handle];
+        entry.uploadEnd = m_uploads.queuedBytes();
+        entry.staged = true;
+        if (uploadQueue()) {
+            m_uploads.onComplete([this, handle] { markResident(handle); });
+        } else {
+            markResident(handle);
+        }
+    }
+
+    void markResident(ModelHandle handle) {
+        StreamedModel& entry = m_streamedModels[handle];
+        entry.resident = true;
+        entry.decoded = {};  // GPU copy is complete
+        ++m_residentGeneration;
+
+        auto callbacks = std::move(entry.onResident);
+        entry.onResident.clear();
+        for (auto& fn : callbacks) {
+            fn(*entry.model);
+        }
+    }
+
+    // Streams without a budget until done() or everything is resident
+    template <typename Done>
+    void waitForStreaming(Done done) {
+        while (m_streamGraph && !done()) {
+            m_streamGraph->pump();
+            m_uploads.process(-1.0);
+            if (m_streamGraph->finished() && m_uploads.empty()) {
+                endStreaming();
+                return;
+            }
+            if (!done()) m_streamGraph->waitForMainThreadWork();
+        }
+    }
+
+    void endStreaming() {
+        m_streamGraph.reset();
+        m_uploads.shutdown();
+        m_pack.close();
+        for (StreamedModel& entry : m_streamedModels) {
+            entry.packed = nullptr;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_streamStart).count();
+        std::cout << "AssetManager: " << m_streamedModels.size() << " models resident after " << ms << " ms" << std::endl;
     }
 
     // === Primitive VAO creation ===
     void createPrimitiveVAOs() {
-        // Ground plane VAO
+        // Ground plane
         const float planeSize = GameConfig::GROUND_SIZE;
         const float texScale = GameConfig::GROUND_TEXTURE_SCALE;
         const float uvScale = planeSize * texScale;
 
-        float planeVertices[] = {
+        std::vector<float> planeVertices = {
             // Position              // Normal       // UV
             -planeSize, 0.0f, -planeSize,  0.0f, 1.0f, 0.0f,  -uvScale, -uvScale,
              planeSize, 0.0f, -planeSize,  0.0f, 1.0f, 0.0f,   uvScale, -uvScale,
              planeSize, 0.0f,  planeSize,  0.0f, 1.0f, 0.0f,   uvScale,  uvScale,
             -planeSize, 0.0f,  planeSize,  0.0f, 1.0f, 0.0f,  -uvScale,  uvScale,
         };
-        unsigned short planeIndices[] = { 0, 3, 2, 0, 2, 1 };
-
-        glGenVertexArrays(1, &m_primitiveVAOs.planeVAO);
-        glGenBuffers(1, &m_primitiveVAOs.planeVBO);
-        glGenBuffers(1, &m_primitiveVAOs.planeEBO);
-
-        glBindVertexArray(m_primitiveVAOs.planeVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_primitiveVAOs.planeVBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(planeVertices), planeVertices, GL_STATIC_DRAW);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_primitiveVAOs.planeEBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(planeIndices), planeIndices, GL_STATIC_DRAW);
-
-        // Position (location 0)
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        // Normal (location 1)
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        // UV (location 2)
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-        glEnableVertexAttribArray(2);
-
-        glBindVertexArray(0);
+        std::vector<uint16_t> planeIndices = { 0, 3, 2, 0, 2, 1 };
+        m_primitiveVAOs.plane = uploadStaticMesh(planeVertices, planeIndices);
 
         // Sun billboard VAO
         float sunQuad[] = {
@@ -333,11 +750,10 @@ private:
     }
 
     // === Render target creation ===
+    // Object names are created once; screen-sized storage is (re)allocated by
+    // resizeRenderTargets so FBO ids held elsewhere stay valid across resizes.
     void createRenderTargets() {
-        const int w = GameConfig::WINDOW_WIDTH;
-        const int h = GameConfig::WINDOW_HEIGHT;
         const int shadowSize = GameConfig::SHADOW_MAP_SIZE;
-        const int msaaSamples = 4;
 
         // === Shadow FBO ===
         glGenFramebuffers(1, &m_renderTargets.shadowFBO);
@@ -358,111 +774,37 @@ private:
         glReadBuffer(GL_NONE);
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-        // === Motion Blur FBO ===
+        // === Screen-sized targets (names only) ===
         glGenFramebuffers(1, &m_renderTargets.motionBlurFBO);
         glGenTextures(1, &m_renderTargets.motionBlurColorTex);
         glGenTextures(1, &m_renderTargets.motionBlurDepthTex);
 
-        // Color texture
-        glBindTexture(GL_TEXTURE_2D, m_renderTargets.motionBlurColorTex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, w, h, 0, GL_RGB, GL_FLOAT, NULL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-        // Depth texture
-        glBindTexture(GL_TEXTURE_2D, m_renderTargets.motionBlurDepthTex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, w, h, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-        glBindFramebuffer(GL_FRAMEBUFFER, m_renderTargets.motionBlurFBO);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_renderTargets.motionBlurColorTex, 0);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_renderTargets.motionBlurDepthTex, 0);
-        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-            std::cerr << "Motion blur FBO is not complete!" << std::endl;
-        }
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-        // === Cinematic MSAA FBO ===
         glGenFramebuffers(1, &m_renderTargets.cinematicMsaaFBO);
         glGenRenderbuffers(1, &m_renderTargets.cinematicMsaaColorRBO);
         glGenRenderbuffers(1, &m_renderTargets.cinematicMsaaDepthRBO);
+        glGenRenderbuffers(1, &m_renderTargets.cinematicMsaaVelocityRBO);
 
-        glBindRenderbuffer(GL_RENDERBUFFER, m_renderTargets.cinematicMsaaColorRBO);
-        glRenderbufferStorageMultisample(GL_RENDERBUFFER, msaaSamples, GL_RGB16F, w, h);
-
-        glBindRenderbuffer(GL_RENDERBUFFER, m_renderTargets.cinematicMsaaDepthRBO);
-        glRenderbufferStorageMultisample(GL_RENDERBUFFER, msaaSamples, GL_DEPTH_COMPONENT32F, w, h);
-
-        glBindFramebuffer(GL_FRAMEBUFFER, m_renderTargets.cinematicMsaaFBO);
-        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_renderTargets.cinematicMsaaColorRBO);
-        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_renderTargets.cinematicMsaaDepthRBO);
-        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-            std::cerr << "Cinematic MSAA FBO is not complete!" << std::endl;
-        }
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-        // === Toon FBO ===
-        glGenFramebuffers(1, &m_renderTargets.toonFBO);
-        glGenTextures(1, &m_renderTargets.toonColorTex);
-        glGenRenderbuffers(1, &m_renderTargets.toonDepthRBO);
+        glGenFramebuffers(1, &m_renderTargets.velocityFBO);
+        glGenTextures(1, &m_renderTargets.velocityTex);
+        glGenFramebuffers(1, &m_renderTargets.tileMaxFBO);
+        glGenTextures(1, &m_renderTargets.tileMaxTex);
+        glGenFramebuffers(1, &m_renderTargets.neighborMaxFBO);
+        glGenTextures(1, &m_renderTargets.neighborMaxTex);
 
-        glBindTexture(GL_TEXTURE_2D, m_renderTargets.toonColorTex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, w, h, 0, GL_RGB, GL_FLOAT, NULL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-        glBindRenderbuffer(GL_RENDERBUFFER, m_renderTargets.toonDepthRBO);
-        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, w, h);
-
-        glBindFramebuffer(GL_FRAMEBUFFER, m_renderTargets.toonFBO);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_renderTargets.toonColorTex, 0);
-        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_renderTargets.toonDepthRBO);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-        // === Main MSAA FBO ===
         glGenFramebuffers(1, &m_renderTargets.msaaFBO);
         glGenRenderbuffers(1, &m_renderTargets.msaaColorRBO);
         glGenRenderbuffers(1, &m_renderTargets.msaaDepthRBO);
 
-        glBindRenderbuffer(GL_RENDERBUFFER, m_renderTargets.msaaColorRBO);
-        glRenderbufferStorageMultisample(GL_RENDERBUFFER, msaaSamples, GL_RGB16F, w, h);
-
-        glBindRenderbuffer(GL_RENDERBUFFER, m_renderTargets.msaaDepthRBO);
-        glRenderbufferStorageMultisample(GL_RENDERBUFFER, msaaSamples, GL_DEPTH24_STENCIL8, w, h);
-
-        glBindFramebuffer(GL_FRAMEBUFFER, m_renderTargets.msaaFBO);
-        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_renderTargets.msaaColorRBO);
-        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_renderTargets.msaaDepthRBO);
-        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-            std::cerr << "MSAA FBO is not complete!" << std::endl;
-        }
-
-        // === Resolve FBO ===
         glGenFramebuffers(1, &m_renderTargets.resolveFBO);
         glGenTextures(1, &m_renderTargets.resolveColorTex);
 
-        glBindTexture(GL_TEXTURE_2D, m_renderTargets.resolveColorTex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, w, h, 0, GL_RGB, GL_FLOAT, NULL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-        glBindFramebuffer(GL_FRAMEBUFFER, m_renderTargets.resolveFBO);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_renderTargets.resolveColorTex, 0);
-        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-            std::cerr << "Resolve FBO is not complete!" << std::endl;
-        }
+        glGenFramebuffers(1, &m_renderTargets.frozenCaptureFBO);
+        glGenTextures(1, &m_renderTargets.frozenCaptureTex);
+        glGenFramebuffers(1, &m_renderTargets.frozenFrameFBO);
+        glGenTextures(1, &m_renderTargets.frozenFrameTex);
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        std::cout << "MSAA " << msaaSamples << "x enabled" << std::endl;
+        resizeRenderTargets(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+        std::cout << "MSAA " << MSAA_SAMPLES << "x enabled" << std::endl;
     }
 
     // === Storage ===
@@ -470,6 +812,16 @@ private:
     std::unordered_map<std::string, GLuint> m_textures;
     std::unordered_map<std::string, LoadedModel> m_models;
 
+    // Load-time state, released at the end of init() (textures) or once streaming ends
+    std::vector<PendingTexture> m_pendingTextures;
+    AssetPack m_pack;
+    GpuUploadQueue m_uploads;
+    std::unique_ptr<TaskGraph> m_streamGraph;
+    std::vector<StreamedModel> m_streamedModels;
+    std::unordered_map<std::string, ModelHandle> m_modelHandles;
+    std::chrono::steady_clock::time_point m_streamStart;
+    uint32_t m_residentGeneration = 0;
+
     RenderTargets m_renderTargets;
     PrimitiveVAOs m_primitiveVAOs;
 
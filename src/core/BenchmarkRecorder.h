@@ -0,0 +1,210 @@
+#pragma once
+
+// Per-frame timings for the benchmark mode (see BenchmarkScene).
+// CPU time covers update + render submission, frame time is the whole loop
+// iteration including present. GPU time comes from a GL_TIMESTAMP pair around
+// the frame's commands, read back a few frames later so the CPU doesn't wait.
+//
+// Main loop: beginFrame() -> update/render -> endSubmit() -> present -> endFrame()
+// Scene:     beginRun() / endRun() around each path x density combination
+
+#include <glad/glad.h>
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class BenchmarkRecorder {
+public:
+    static constexpr int QUERY_LATENCY = 8;  // Frames of timestamp pairs in flight
+
+    void init() {
+        for (QuerySlot& slot : m_slots) {
+            glGenQueries(2, slot.queries);
+        }
+        m_frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+        m_initialized = true;
+    }
+
+    void cleanup() {
+        if (!m_initialized) return;
+        for (QuerySlot& slot : m_slots) {
+            glDeleteQueries(2, slot.queries);
+        }
+        m_initialized = false;
+    }
+
+    // Starts recording a run; the first `warmupFrames` frames are not recorded
+    void beginRun(const std::string& path, float density, int warmupFrames) {
+        Run run;
+        run.path = path;
+        run.density = density;
+        run.firstSample = m_samples.size();
+        m_runs.push_back(run);
+        m_runActive = true;
+        m_warmupLeft = warmupFrames;
+    }
+
+    void endRun() {
+        m_runActive = false;
+    }
+
+    void beginFrame() {
+        if (!m_initialized) return;
+        m_frameStart = SDL_GetPerformanceCounter();
+
+        // Slot reuse: resolve what it held (only blocks if the GPU is 8 frames behind)
+        QuerySlot& slot = m_slots[m_frameIndex % QUERY_LATENCY];
+        if (slot.sample >= 0) resolve(slot, true);
+        glQueryCounter(slot.queries[0], GL_TIMESTAMP);
+    }
+
+    // After the frame's GL commands, before present
+    void endSubmit() {
+        if (!m_initialized) return;
+        m_submitEnd = SDL_GetPerformanceCounter();
+        glQueryCounter(m_slots[m_frameIndex % QUERY_LATENCY].queries[1], GL_TIMESTAMP);
+    }
+
+    // After present
+    void endFrame() {
+        if (!m_initialized) return;
+        uint64_t frameEnd = SDL_GetPerformanceCounter();
+        QuerySlot& slot = m_slots[m_frameIndex % QUERY_LATENCY];
+        ++m_frameIndex;
+
+        if (!m_runActive) return;
+        if (m_warmupLeft > 0) {
+            --m_warmupLeft;
+            return;
+        }
+
+        Sample sample;
+        sample.cpuMs = toMs(m_submitEnd - m_frameStart);
+        sample.frameMs = toMs(frameEnd - m_frameStart);
+        slot.sample = static_cast<long long>(m_samples.size());
+        m_samples.push_back(sample);
+
+        // Pick up whatever older frames the GPU has finished
+        for (QuerySlot& pending : m_slots) {
+            if (pending.sample >= 0 && &pending != &slot) resolve(pending, false);
+        }
+    }
+
+    // Waits for outstanding GPU timings, prints the summary and writes
+    // <basePath>_summary.csv and <basePath>_frames.csv
+    bool writeReport(const std::string& basePath) {
+        for (QuerySlot& slot : m_slots) {
+            if (slot.sample >= 0) resolve(slot, true);
+        }
+
+        std::ofstream summary(basePath + "_summary.csv", std::ios::out | std::ios::trunc);
+        std::ofstream frames(basePath + "_frames.csv", std::ios::out | std::ios::trunc);
+        if (!summary || !frames) {
+            std::cerr << "BenchmarkRecorder: Failed to open " << basePath << "_*.csv for writing" << std::endl;
+            return false;
+        }
+
+        summary << "path,density,frames,metric,min_ms,avg_ms,p50_ms,p95_ms,p99_ms,max_ms\n";
+        frames << "path,density,frame,cpu_ms,gpu_ms,frame_ms\n";
+
+        std::cout << "Benchmark results (ms):" << std::endl;
+        for (size_t r = 0; r < m_runs.size(); ++r) {
+            const Run& run = m_runs[r];
+            size_t end = (r + 1 < m_runs.size()) ? m_runs[r + 1].firstSample : m_samples.size();
+            if (end <= run.firstSample) continue;
+
+            std::vector<double> cpu, gpu, frame;
+            for (size_t i = run.firstSample; i < end; ++i) {
+                const Sample& s = m_samples[i];
+                cpu.push_back(s.cpuMs);
+                gpu.push_back(s.gpuMs);
+                frame.push_back(s.frameMs);
+                frames << run.path << ',' << run.density << ',' << (i - run.firstSample) << ','
+                       << s.cpuMs << ',' << s.gpuMs << ',' << s.frameMs << '\n';
+            }
+
+            std::cout << "  " << run.path << " @ density " << run.density
+                      << " (" << (end - run.firstSample) << " frames)" << std::endl;
+            writeStats(summary, run, "cpu", cpu);
+            writeStats(summary, run, "gpu", gpu);
+            writeStats(summary, run, "frame", frame);
+        }
+
+        std::cout << "Benchmark: wrote " << basePath << "_summary.csv and " << basePath << "_frames.csv" << std::endl;
+        return true;
+    }
+
+private:
+    struct Sample {
+        double cpuMs = 0.0;
+        double gpuMs = 0.0;
+        double frameMs = 0.0;
+    };
+
+    struct Run {
+        std::string path;
+        float density = 0.0f;
+        size_t firstSample = 0;
+    };
+
+    struct QuerySlot {
+        GLuint queries[2] = {0, 0};
+        long long sample = -1;  // Sample waiting for this slot's result
+    };
+
+    double toMs(uint64_t ticks) const {
+        return static_cast<double>(ticks) * 1000.0 / m_frequency;
+    }
+
+    void resolve(QuerySlot& slot, bool wait) {
+        if (!wait) {
+            GLint available = 0;
+            glGetQueryObjectiv(slot.queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) return;
+        }
+        GLuint64 start = 0, end = 0;
+        glGetQueryObjectui64v(slot.queries[0], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(slot.queries[1], GL_QUERY_RESULT, &end);
+        m_samples[static_cast<size_t>(slot.sample)].gpuMs = static_cast<double>(end - start) * 1e-6;
+        slot.sample = -1;
+    }
+
+    static void writeStats(std::ostream& csv, const Run& run, const char* metric, std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        double sum = 0.0;
+        for (double v : values) sum += v;
+        auto percentile = [&values](double p) {
+            return values[static_cast<size_t>(p * (values.size() - 1) + 0.5)];
+        };
+        double avg = sum / values.size();
+
+        csv << run.path << ',' << run.density << ',' << values.size() << ',' << metric << ','
+            << values.front() << ',' << avg << ',' << percentile(0.5) << ','
+            << percentile(0.95) << ',' << percentile(0.99) << ',' << values.back() << '\n';
+
+        std::cout << "    " << std::left << std::setw(6) << metric << std::right << std::fixed << std::setprecision(3)
+                  << " min " << std::setw(7) << values.front()
+                  << "  avg " << std::setw(7) << avg
+                  << "  p50 " << std::setw(7) << percentile(0.5)
+                  << "  p95 " << std::setw(7) << percentile(0.95)
+                  << "  p99 " << std::setw(7) << percentile(0.99)
+                  << "  max " << std::setw(7) << values.back() << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+    }
+
+    std::array<QuerySlot, QUERY_LATENCY> m_slots;
+    std::vector<Sample> m_samples;
+    std::vector<Run> m_runs;
+    uint64_t m_frameIndex = 0;
+    uint64_t m_frameStart = 0;
+    uint64_t m_submitEnd = 0;
+    double m_frequency = 1.0;
+    int m_warmupLeft = 0;
+    bool m_runActive = false;
+    bool m_initialized = false;
+};
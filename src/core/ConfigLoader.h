@@ -1,10 +1,21 @@
 #pragma once
 #include <string>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
+#include <vector>
 #include <glm/glm.hpp>
 #include "tinyxml.h"
 
+// Camera path flown by the benchmark (Catmull-Rom through the points)
+struct BenchmarkPath {
+    std::string name;
+    float duration = 20.0f;          // Seconds of simulated time
+    std::vector<glm::vec3> points;
+    bool hasLookAt = false;          // Otherwise the camera looks along the path
+    glm::vec3 lookAt = glm::vec3(0.0f);
+};
+
 // Runtime-configurable game settings loaded from config.xml
 // Values are initialized with defaults matching the original GameConfig constants
 struct GameSettings {
@@ -12,14 +23,58 @@ struct GameSettings {
     int windowWidth = 1280;
     int windowHeight = 720;
     bool windowFullscreen = false;
+    bool windowResizable = true;
     std::string windowTitle = "fing-eternauta";
 
+    // Headless (offscreen EGL context, no presentation) for CI / profiling
+    bool headless = false;
+    int headlessFrames = 600;         // Frames to run before quitting (0 = until quit)
+    std::string frameDumpDir;         // PNG dump directory (empty = no dumps)
+    int frameDumpInterval = 60;       // Dump every N frames
+
+    // CPU profiler (Chrome trace capture)
+    int profileCaptureFrames = 0;     // Capture from startup for N frames (0 = off)
+    int profileHotkeyFrames = 120;    // Frames captured when F9 is pressed
+    std::string profileOutput = "trace.json";
+
+    // Benchmark (camera paths x monster densities, fixed timestep)
+    bool benchmark = false;
+    unsigned int benchmarkSeed = 54321;     // Monster spawn seed
+    float benchmarkTimestep = 1.0f / 60.0f; // Simulated seconds per frame
+    int benchmarkWarmupFrames = 60;         // Unrecorded frames at the start of each run
+    std::vector<float> benchmarkDensities = {0.12f};
+    std::string benchmarkOutput = "benchmark";  // Writes <output>_summary.csv and <output>_frames.csv
+    std::vector<BenchmarkPath> benchmarkPaths;
+
+    // Baked model pack (see AssetPack.h); falls back to the .glb files when missing/stale
+    bool useAssetPack = true;
+    std::string assetPack = "assets/models.pack";
+    bool cookAssets = false;          // Write the pack and exit (no window/context)
+    std::string textureCompression = "bc";  // Cooked textures: "bc" (BC1/BC3/BC5), "bc7" (BC7/BC5) or "none"
+    bool streamAssets = true;         // Models finish loading behind the menu instead of before the first frame
+    float streamBudgetMs = 2.0f;      // GL-thread time per frame spent on streamed uploads
+    int streamStagingMB = 8;          // Staging memory per upload segment (three segments in flight)
+
+    // GL dispatch layer (see GLDispatch.h)
+    std::string glBackend = "native"; // "native" or "null" (no context, implies headless)
+    std::string glRecordFile;         // Empty = off, "-" = count calls only, else command stream file
+
     // Graphics
     int shadowMapSize = 2048;
     float shadowOrthoSize = 100.0f;
     float shadowNear = 1.0f;
     float shadowFar = 200.0f;
     float shadowDistance = 80.0f;
+    float renderScale = 1.0f;   // Internal 3D resolution relative to the drawable size
+
+    // Main menu
+    float menuBackdropFps = 15.0f;  // Backdrop refresh rate (0 = render once and cache)
+    float menuIdleFps = 10.0f;      // Frame cap on idle-capable scenes (0 = uncapped)
+    float menuIdleTimeout = 5.0f;   // Seconds without input before throttling
+
+    // Pause menu (frozen gameplay frame behind the UI)
+    float pauseBackgroundBlur = 2.0f;  // Blur tap spacing in pixels (0 = sharp)
+    float pauseBackgroundDim = 0.6f;   // 0 = unchanged, 1 = black
 
     // Fog
     float fogDensity = 0.02f;
@@ -54,6 +109,28 @@ struct GameSettings {
 
     // LOD
     float lodSwitchDistance = 210.0f;
+    float lodErrorPixels = 1.0f;            // Max on-screen error of a simplified model LOD
+    float lodHysteresis = 0.1f;             // Band around each LOD threshold (fraction of it)
+    float lodCrossFadeTime = 0.25f;         // Seconds of dithered cross-fade per LOD switch (0 = pop)
+
+    // Animation clip compression (AnimationCompressor.h), when cooking and for .glb fallbacks
+    bool compressAnimations = true;
+    float animationSampleRate = 30.0f;              // Starting resample rate (doubled while over tolerance)
+    float animationRotationTolerance = 0.001f;      // Radians
+    float animationTranslationTolerance = 0.0001f;  // Fraction of the skeleton size
+
+    // Animation LOD (AnimationSystem): pose update rate by projected size in pixels
+    bool animationLod = true;
+    float animationHalfRateSize = 160.0f;    // Below: every 2nd frame
+    float animationQuarterRateSize = 64.0f;  // Below: every 4th frame
+    float animationFrozenSize = 8.0f;        // Below: not re-evaluated
+    float animationLeafJointSize = 100.0f;   // Below: leaf joints (fingers, face, toes) skipped
+    int animationSharedPosePhases = 32;      // Per-clip phases crowd monsters share poses at (0 = own pose each)
+
+    // Vertex animation (VertexAnimationSystem): baked clips for distant crowd monsters
+    bool vertexAnimation = true;
+    float vertexAnimationDistance = 20.0f;   // Camera distance past which the skeleton is dropped
+    float vertexAnimationRate = 30.0f;       // Baked frames per second (cook and .glb fallback)
 
     // Ground
     float groundSize = 500.0f;
@@ -126,11 +203,18 @@ public:
         // Parse each section
         parseWindow(root->FirstChildElement("Window"), s);
         parseGraphics(root->FirstChildElement("Graphics"), s);
+        parseHeadless(root->FirstChildElement("Headless"), s);
+        parseAssets(root->FirstChildElement("Assets"), s);
+        parseProfiler(root->FirstChildElement("Profiler"), s);
+        parseBenchmark(root->FirstChildElement("Benchmark"), s);
+        parseMenu(root->FirstChildElement("Menu"), s);
+        parsePause(root->FirstChildElement("Pause"), s);
         parseFog(root->FirstChildElement("Fog"), s);
         parsePlayer(root->FirstChildElement("Player"), s);
         parseCamera(root->FirstChildElement("Camera"), s);
         parseBuildings(root->FirstChildElement("Buildings"), s);
         parseLOD(root->FirstChildElement("LOD"), s);
+        parseAnimation(root->FirstChildElement("Animation"), s);
         parseGround(root->FirstChildElement("Ground"), s);
         parseSnow(root->FirstChildElement("Snow"), s);
         parseCinematic(root->FirstChildElement("Cinematic"), s);
@@ -143,6 +227,69 @@ public:
         return true;
     }
 
+    // Command-line overrides (applied after load):
+    //   --headless  --frames N  --dump-frames DIR  --dump-interval N
+    //   --gl-backend native|null  --gl-record FILE|-
+    //   --profile-frames N  --profile-out FILE
+    //   --cook-assets  --texture-compression bc|bc7|none  --no-anim-compression  --no-anim-lod
+    //   --asset-pack FILE  --no-asset-pack  --no-stream-assets
+    //   --benchmark  --benchmark-out PATH  --benchmark-densities "0.05, 0.12"
+    //   --lod-error-pixels PX  --lod-cross-fade SECONDS  --shared-pose-phases N  --no-vertex-animation
+    static void applyCommandLine(int argc, char* argv[]) {
+        GameSettings& s = get();
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = (i + 1 < argc);
+            if (arg == "--headless") {
+                s.headless = true;
+            } else if (arg == "--frames" && hasValue) {
+                s.headlessFrames = std::atoi(argv[++i]);
+            } else if (arg == "--dump-frames" && hasValue) {
+                s.frameDumpDir = argv[++i];
+            } else if (arg == "--dump-interval" && hasValue) {
+                s.frameDumpInterval = std::atoi(argv[++i]);
+            } else if (arg == "--profile-frames" && hasValue) {
+                s.profileCaptureFrames = std::atoi(argv[++i]);
+            } else if (arg == "--profile-out" && hasValue) {
+                s.profileOutput = argv[++i];
+            } else if (arg == "--cook-assets") {
+                s.cookAssets = true;
+            } else if (arg == "--texture-compression" && hasValue) {
+                s.textureCompression = argv[++i];
+            } else if (arg == "--no-anim-compression") {
+                s.compressAnimations = false;
+            } else if (arg == "--no-anim-lod") {
+                s.animationLod = false;
+            } else if (arg == "--asset-pack" && hasValue) {
+                s.assetPack = argv[++i];
+            } else if (arg == "--no-asset-pack") {
+                s.useAssetPack = false;
+            } else if (arg == "--no-stream-assets") {
+                s.streamAssets = false;
+            } else if (arg == "--benchmark") {
+                s.benchmark = true;
+            } else if (arg == "--benchmark-out" && hasValue) {
+                s.benchmarkOutput = argv[++i];
+            } else if (arg == "--benchmark-densities" && hasValue) {
+                s.benchmarkDensities = parseFloatList(argv[++i], s.benchmarkDensities);
+            } else if (arg == "--lod-error-pixels" && hasValue) {
+                s.lodErrorPixels = static_cast<float>(std::atof(argv[++i]));
+            } else if (arg == "--lod-cross-fade" && hasValue) {
+                s.lodCrossFadeTime = static_cast<float>(std::atof(argv[++i]));
+            } else if (arg == "--shared-pose-phases" && hasValue) {
+                s.animationSharedPosePhases = std::atoi(argv[++i]);
+            } else if (arg == "--no-vertex-animation") {
+                s.vertexAnimation = false;
+            } else if (arg == "--gl-backend" && hasValue) {
+                s.glBackend = argv[++i];
+            } else if (arg == "--gl-record" && hasValue) {
+                s.glRecordFile = argv[++i];
+            } else {
+                std::cerr << "ConfigLoader: Ignoring unknown argument " << arg << std::endl;
+            }
+        }
+    }
+
 private:
     // Helper to get float attribute
     static float getFloatAttr(TiXmlElement* elem, const char* name, float defaultVal) {
@@ -186,6 +333,21 @@ private:
         return defaultVal;
     }
 
+    // Helper to parse a comma-separated float list "a, b, c" (defaultVal if empty/invalid)
+    static std::vector<float> parseFloatList(const char* val, const std::vector<float>& defaultVal) {
+        if (!val) return defaultVal;
+        std::vector<float> result;
+        std::stringstream ss(val);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            std::stringstream itemStream(item);
+            float f;
+            if (!(itemStream >> f)) return defaultVal;
+            result.push_back(f);
+        }
+        return result.empty() ? defaultVal : result;
+    }
+
     // Helper to get bool attribute ("true"/"false")
     static bool getBoolAttr(TiXmlElement* elem, const char* name, bool defaultVal) {
         if (!elem) return defaultVal;
@@ -200,6 +362,7 @@ private:
         s.windowWidth = getIntAttr(elem, "width", s.windowWidth);
         s.windowHeight = getIntAttr(elem, "height", s.windowHeight);
         s.windowFullscreen = getBoolAttr(elem, "fullscreen", s.windowFullscreen);
+        s.windowResizable = getBoolAttr(elem, "resizable", s.windowResizable);
         s.windowTitle = getStringAttr(elem, "title", s.windowTitle);
     }
 
@@ -210,6 +373,72 @@ private:
         s.shadowNear = getFloatAttr(elem, "shadowNear", s.shadowNear);
         s.shadowFar = getFloatAttr(elem, "shadowFar", s.shadowFar);
         s.shadowDistance = getFloatAttr(elem, "shadowDistance", s.shadowDistance);
+        s.renderScale = getFloatAttr(elem, "renderScale", s.renderScale);
+    }
+
+    static void parseHeadless(TiXmlElement* elem, GameSettings& s) {
+        if (!elem) return;
+        s.headless = getBoolAttr(elem, "enabled", s.headless);
+        s.headlessFrames = getIntAttr(elem, "frames", s.headlessFrames);
+        s.frameDumpDir = getStringAttr(elem, "dumpDir", s.frameDumpDir);
+        s.frameDumpInterval = getIntAttr(elem, "dumpInterval", s.frameDumpInterval);
+    }
+
+    static void parseAssets(TiXmlElement* elem, GameSettings& s) {
+        if (!elem) return;
+        s.useAssetPack = getBoolAttr(elem, "usePack", s.useAssetPack);
+        s.assetPack = getStringAttr(elem, "pack", s.assetPack);
+        s.textureCompression = getStringAttr(elem, "textureCompression", s.textureCompression);
+        s.streamAssets = getBoolAttr(elem, "stream", s.streamAssets);
+        s.streamBudgetMs = getFloatAttr(elem, "streamBudgetMs", s.streamBudgetMs);
+        s.streamStagingMB = getIntAttr(elem, "stagingMB", s.streamStagingMB);
+    }
+
+    static void parseProfiler(TiXmlElement* elem, GameSettings& s) {
+        if (!elem) return;
+        s.profileCaptureFrames = getIntAttr(elem, "captureFrames", s.profileCaptureFrames);
+        s.profileHotkeyFrames = getIntAttr(elem, "hotkeyFrames", s.profileHotkeyFrames);
+        s.profileOutput = getStringAttr(elem, "output", s.profileOutput);
+    }
+
+    static void parseBenchmark(TiXmlElement* elem, GameSettings& s) {
+        if (!elem) return;
+        s.benchmark = getBoolAttr(elem, "enabled", s.benchmark);
+        s.benchmarkSeed = static_cast<unsigned int>(getIntAttr(elem, "seed", static_cast<int>(s.benchmarkSeed)));
+        s.benchmarkTimestep = getFloatAttr(elem, "timestep", s.benchmarkTimestep);
+        s.benchmarkWarmupFrames = getIntAttr(elem, "warmupFrames", s.benchmarkWarmupFrames);
+        s.benchmarkDensities = parseFloatList(elem->Attribute("densities"), s.benchmarkDensities);
+        s.benchmarkOutput = getStringAttr(elem, "output", s.benchmarkOutput);
+
+        // <Path name="" duration="" [lookAt="x, y, z"]> <Point pos="x, y, z"/>... </Path>
+        for (TiXmlElement* p = elem->FirstChildElement("Path"); p; p = p->NextSiblingElement("Path")) {
+            BenchmarkPath path;
+            path.name = getStringAttr(p, "name", "path" + std::to_string(s.benchmarkPaths.size()));
+            path.duration = getFloatAttr(p, "duration", path.duration);
+            path.hasLookAt = p->Attribute("lookAt") != nullptr;
+            path.lookAt = getVec3Attr(p, "lookAt", path.lookAt);
+            for (TiXmlElement* pt = p->FirstChildElement("Point"); pt; pt = pt->NextSiblingElement("Point")) {
+                path.points.push_back(getVec3Attr(pt, "pos", glm::vec3(0.0f)));
+            }
+            if (path.points.size() < 2) {
+                std::cerr << "ConfigLoader: Benchmark path '" << path.name << "' needs at least 2 points" << std::endl;
+                continue;
+            }
+            s.benchmarkPaths.push_back(path);
+        }
+    }
+
+    static void parseMenu(TiXmlElement* elem, GameSettings& s) {
+        if (!elem) return;
+        s.menuBackdropFps = getFloatAttr(elem, "backdropFps", s.menuBackdropFps);
+        s.menuIdleFps = getFloatAttr(elem, "idleFps", s.menuIdleFps);
+        s.menuIdleTimeout = getFloatAttr(elem, "idleTimeout", s.menuIdleTimeout);
+    }
+
+    static void parsePause(TiXmlElement* elem, GameSettings& s) {
+        if (!elem) return;
+        s.pauseBackgroundBlur = getFloatAttr(elem, "backgroundBlur", s.pauseBackgroundBlur);
+        s.pauseBackgroundDim = getFloatAttr(elem, "backgroundDim", s.pauseBackgroundDim);
     }
 
     static void parseFog(TiXmlElement* elem, GameSettings& s) {
@@ -254,6 +483,26 @@ private:
     static void parseLOD(TiXmlElement* elem, GameSettings& s) {
         if (!elem) return;
         s.lodSwitchDistance = getFloatAttr(elem, "switchDistance", s.lodSwitchDistance);
+        s.lodErrorPixels = getFloatAttr(elem, "errorPixels", s.lodErrorPixels);
+        s.lodHysteresis = getFloatAttr(elem, "hysteresis", s.lodHysteresis);
+        s.lodCrossFadeTime = getFloatAttr(elem, "crossFadeTime", s.lodCrossFadeTime);
+    }
+
+    static void parseAnimation(TiXmlElement* elem, GameSettings& s) {
+        if (!elem) return;
+        s.compressAnimations = getBoolAttr(elem, "compress", s.compressAnimations);
+        s.animationSampleRate = getFloatAttr(elem, "sampleRate", s.animationSampleRate);
+        s.animationRotationTolerance = getFloatAttr(elem, "rotationTolerance", s.animationRotationTolerance);
+        s.animationTranslationTolerance = getFloatAttr(elem, "translationTolerance", s.animationTranslationTolerance);
+        s.animationLod = getBoolAttr(elem, "lod", s.animationLod);
+        s.animationHalfRateSize = getFloatAttr(elem, "halfRateSize", s.animationHalfRateSize);
+        s.animationQuarterRateSize = getFloatAttr(elem, "quarterRateSize", s.animationQuarterRateSize);
+        s.animationFrozenSize = getFloatAttr(elem, "frozenSize", s.animationFrozenSize);
+        s.animationLeafJointSize = getFloatAttr(elem, "leafJointSize", s.animationLeafJointSize);
+        s.animationSharedPosePhases = getIntAttr(elem, "sharedPosePhases", s.animationSharedPosePhases);
+        s.vertexAnimation = getBoolAttr(elem, "vertexAnimation", s.vertexAnimation);
+        s.vertexAnimationDistance = getFloatAttr(elem, "vertexAnimationDistance", s.vertexAnimationDistance);
+        s.vertexAnimationRate = getFloatAttr(elem, "vertexAnimationRate", s.vertexAnimationRate);
     }
 
     static void parseGround(TiXmlElement* elem, GameSettings& s) {
@@ -307,6 +556,8 @@ private:
         if (!elem) return;
         s.showAxes = getBoolAttr(elem, "showAxes", s.showAxes);
         s.showShadowMap = getBoolAttr(elem, "showShadowMap", s.showShadowMap);
+        s.glBackend = getStringAttr(elem, "glBackend", s.glBackend);
+        s.glRecordFile = getStringAttr(elem, "glRecord", s.glRecordFile);
     }
 };
 
@@ -0,0 +1,205 @@
+#pragma once
+
+// Scoped CPU zones exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+// Zones are only recorded while a capture is running; outside a capture a zone
+// costs one relaxed atomic load. Each thread appends to its own fixed-size
+// buffer (single writer, published with a release store), so recording takes
+// no locks. Only the first zone or setThreadName on a thread registers its
+// buffer (under a mutex); the event array is allocated by the thread's first
+// zone recorded during a capture, so threads that never record stay small.
+//
+//   CPU_PROFILE_ZONE("Physics");          // times the enclosing block
+//   CpuProfiler::instance().requestCapture(120, "trace.json");
+//
+// Define DISABLE_CPU_PROFILER to compile the zones out entirely.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class CpuProfiler {
+public:
+    static constexpr size_t EVENTS_PER_THREAD = 1 << 18;
+
+    struct Event {
+        const char* name;
+        uint64_t startNs;
+        uint64_t endNs;
+    };
+
+    static CpuProfiler& instance() {
+        static CpuProfiler profiler;
+        return profiler;
+    }
+
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    bool capturing() const { return m_capturing.load(std::memory_order_relaxed); }
+
+    // Capture a zone opening now belongs to, 0 outside a capture
+    uint32_t activeGeneration() const {
+        return capturing() ? m_generation.load(std::memory_order_acquire) : 0;
+    }
+
+    // Starts recording now and writes the trace after `frames` more endFrame calls.
+    // Buffers are not touched here: each thread drops its previous capture's
+    // events itself on its first zone of the new generation.
+    void requestCapture(int frames, const std::string& outputPath) {
+        if (capturing() || frames <= 0) return;
+
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        m_generation.fetch_add(1, std::memory_order_acq_rel);
+        m_framesLeft = frames;
+        m_outputPath = outputPath;
+        m_captureStartNs = nowNs();
+        m_capturing.store(true, std::memory_order_release);
+        std::cout << "CpuProfiler: capturing " << frames << " frames" << std::endl;
+    }
+
+    // Main thread, once per frame
+    void endFrame() {
+        if (!capturing()) return;
+        if (--m_framesLeft > 0) return;
+
+        m_capturing.store(false, std::memory_order_release);
+        writeTrace();
+    }
+
+    // Writes a capture that is still running (e.g. on quit)
+    void finishCapture() {
+        if (!capturing()) return;
+        m_capturing.store(false, std::memory_order_release);
+        writeTrace();
+    }
+
+    // Label for the calling thread in the trace
+    void setThreadName(const char* name) {
+        ThreadBuffer& buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(m_threadsMutex);  // writeTrace reads it
+        buffer.name = name;
+    }
+
+    // `generation`: activeGeneration() when the zone opened. Zones of an
+    // earlier capture, or closing after the capture ended, are dropped.
+    void record(const char* name, uint64_t startNs, uint64_t endNs, uint32_t generation) {
+        if (!capturing() || generation != m_generation.load(std::memory_order_acquire)) return;
+
+        ThreadBuffer& buffer = threadBuffer();
+        if (buffer.generation.load(std::memory_order_relaxed) != generation) {
+            if (!buffer.events) buffer.events.reset(new Event[EVENTS_PER_THREAD]);
+            buffer.count.store(0, std::memory_order_relaxed);
+            buffer.generation.store(generation, std::memory_order_release);
+        }
+        size_t index = buffer.count.load(std::memory_order_relaxed);
+        if (index >= EVENTS_PER_THREAD) return;  // Full: drop
+        buffer.events[index] = {name, startNs, endNs};
+        buffer.count.store(index + 1, std::memory_order_release);
+    }
+
+private:
+    struct ThreadBuffer {
+        std::unique_ptr<Event[]> events;       // Allocated on the thread's first recorded zone
+        std::atomic<size_t> count{0};
+        std::atomic<uint32_t> generation{0};   // Capture `events` holds (0 = none)
+        std::string name;
+        int id = 0;
+    };
+
+    CpuProfiler() = default;
+
+    ThreadBuffer& threadBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(m_threadsMutex);
+            m_threads.push_back(std::make_unique<ThreadBuffer>());
+            buffer = m_threads.back().get();
+            buffer->id = static_cast<int>(m_threads.size());
+            buffer->name = "Thread " + std::to_string(buffer->id);
+        }
+        return *buffer;
+    }
+
+    void writeTrace() {
+        std::ofstream out(m_outputPath, std::ios::out | std::ios::trunc);
+        if (!out) {
+            std::cerr << "CpuProfiler: Failed to open " << m_outputPath << std::endl;
+            return;
+        }
+
+        size_t written = 0;
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        std::lock_guard<std::mutex> lock(m_threadsMutex);
+        const uint32_t generation = m_generation.load(std::memory_order_acquire);
+        for (const auto& buffer : m_threads) {
+            out << (written++ ? ",\n" : "")
+                << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+                << ",\"args\":{\"name\":\"" << buffer->name << "\"}}";
+
+            // Threads with no zone in this capture hold an older one (or none)
+            if (buffer->generation.load(std::memory_order_acquire) != generation) continue;
+            size_t count = buffer->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; ++i) {
+                const Event& e = buffer->events[i];
+                // Clamped to the capture start (zones open after it, but clocks may differ per core)
+                uint64_t start = (e.startNs > m_captureStartNs) ? e.startNs - m_captureStartNs : 0;
+                uint64_t end = (e.endNs > m_captureStartNs) ? e.endNs - m_captureStartNs : 0;
+                out << ",\n{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+                    << ",\"ts\":" << start / 1000 << '.' << pad3(start % 1000)
+                    << ",\"dur\":" << (end - start) / 1000 << '.' << pad3((end - start) % 1000) << "}";
+                ++written;
+            }
+        }
+        out << "\n]}\n";
+        std::cout << "CpuProfiler: wrote " << written << " events to " << m_outputPath << std::endl;
+    }
+
+    // Microsecond fraction with nanosecond precision
+    static std::string pad3(uint64_t v) {
+        std::string s = std::to_string(v);
+        return std::string(3 - s.size(), '0') + s;
+    }
+
+    std::atomic<bool> m_capturing{false};
+    std::atomic<uint32_t> m_generation{0};  // Incremented by each requestCapture
+    std::mutex m_threadsMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+    std::string m_outputPath;
+    uint64_t m_captureStartNs = 0;
+    int m_framesLeft = 0;
+};
+
+// RAII zone; records only if it opens and closes within the same capture
+class CpuProfileZone {
+public:
+    explicit CpuProfileZone(const char* name)
+        : m_name(name), m_generation(CpuProfiler::instance().activeGeneration()),
+          m_startNs(m_generation ? CpuProfiler::nowNs() : 0) {}
+    ~CpuProfileZone() {
+        if (m_generation) CpuProfiler::instance().record(m_name, m_startNs, CpuProfiler::nowNs(), m_generation);
+    }
+
+    CpuProfileZone(const CpuProfileZone&) = delete;
+    CpuProfileZone& operator=(const CpuProfileZone&) = delete;
+
+private:
+    const char* m_name;
+    uint32_t m_generation;
+    uint64_t m_startNs;
+};
+
+#ifndef DISABLE_CPU_PROFILER
+#define CPU_PROFILE_CONCAT_INNER(a, b) a##b
+#define CPU_PROFILE_CONCAT(a, b) CPU_PROFILE_CONCAT_INNER(a, b)
+#define CPU_PROFILE_ZONE(name) CpuProfileZone CPU_PROFILE_CONCAT(cpuProfileZone_, __LINE__)(name)
+#else
+#define CPU_PROFILE_ZONE(name) ((void)0)
+#endif
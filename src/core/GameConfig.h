@@ -12,14 +12,54 @@ namespace GameConfig {
 inline int& WINDOW_WIDTH = CONFIG.windowWidth;
 inline int& WINDOW_HEIGHT = CONFIG.windowHeight;
 inline bool& WINDOW_FULLSCREEN = CONFIG.windowFullscreen;
+inline bool& WINDOW_RESIZABLE = CONFIG.windowResizable;
 inline std::string& WINDOW_TITLE = CONFIG.windowTitle;
 
+// Headless
+inline bool& HEADLESS = CONFIG.headless;
+inline int& HEADLESS_FRAMES = CONFIG.headlessFrames;
+inline std::string& FRAME_DUMP_DIR = CONFIG.frameDumpDir;
+inline int& FRAME_DUMP_INTERVAL = CONFIG.frameDumpInterval;
+
+// Asset pack
+inline bool& USE_ASSET_PACK = CONFIG.useAssetPack;
+inline std::string& ASSET_PACK = CONFIG.assetPack;
+inline bool& COOK_ASSETS = CONFIG.cookAssets;
+inline std::string& TEXTURE_COMPRESSION = CONFIG.textureCompression;
+inline bool& STREAM_ASSETS = CONFIG.streamAssets;
+inline float& STREAM_BUDGET_MS = CONFIG.streamBudgetMs;
+inline int& STREAM_STAGING_MB = CONFIG.streamStagingMB;
+
 // Graphics
 inline int& SHADOW_MAP_SIZE = CONFIG.shadowMapSize;
 inline float& SHADOW_ORTHO_SIZE = CONFIG.shadowOrthoSize;
 inline float& SHADOW_NEAR = CONFIG.shadowNear;
 inline float& SHADOW_FAR = CONFIG.shadowFar;
 inline float& SHADOW_DISTANCE = CONFIG.shadowDistance;
+inline float& RENDER_SCALE = CONFIG.renderScale;
+
+// CPU profiler
+inline int& PROFILE_CAPTURE_FRAMES = CONFIG.profileCaptureFrames;
+inline int& PROFILE_HOTKEY_FRAMES = CONFIG.profileHotkeyFrames;
+inline std::string& PROFILE_OUTPUT = CONFIG.profileOutput;
+
+// Benchmark
+inline bool& BENCHMARK = CONFIG.benchmark;
+inline unsigned int& BENCHMARK_SEED = CONFIG.benchmarkSeed;
+inline float& BENCHMARK_TIMESTEP = CONFIG.benchmarkTimestep;
+inline int& BENCHMARK_WARMUP_FRAMES = CONFIG.benchmarkWarmupFrames;
+inline std::vector<float>& BENCHMARK_DENSITIES = CONFIG.benchmarkDensities;
+inline std::string& BENCHMARK_OUTPUT = CONFIG.benchmarkOutput;
+inline std::vector<BenchmarkPath>& BENCHMARK_PATHS = CONFIG.benchmarkPaths;
+
+// Main menu
+inline float& MENU_BACKDROP_FPS = CONFIG.menuBackdropFps;
+inline float& MENU_IDLE_FPS = CONFIG.menuIdleFps;
+inline float& MENU_IDLE_TIMEOUT = CONFIG.menuIdleTimeout;
+
+// Pause menu
+inline float& PAUSE_BACKGROUND_BLUR = CONFIG.pauseBackgroundBlur;
+inline float& PAUSE_BACKGROUND_DIM = CONFIG.pauseBackgroundDim;
 
 // Fog
 inline float& FOG_DENSITY = CONFIG.fogDensity;
@@ -54,6 +94,28 @@ inline float& BUILDING_TEXTURE_SCALE = CONFIG.buildingTextureScale;
 
 // LOD
 inline float& LOD_SWITCH_DISTANCE = CONFIG.lodSwitchDistance;
+inline float& LOD_ERROR_PIXELS = CONFIG.lodErrorPixels;
+inline float& LOD_HYSTERESIS = CONFIG.lodHysteresis;
+inline float& LOD_CROSS_FADE_TIME = CONFIG.lodCrossFadeTime;
+
+// Animation clip compression
+inline bool& COMPRESS_ANIMATIONS = CONFIG.compressAnimations;
+inline float& ANIMATION_SAMPLE_RATE = CONFIG.animationSampleRate;
+inline float& ANIMATION_ROTATION_TOLERANCE = CONFIG.animationRotationTolerance;
+inline float& ANIMATION_TRANSLATION_TOLERANCE = CONFIG.animationTranslationTolerance;
+
+// Animation LOD
+inline bool& ANIMATION_LOD = CONFIG.animationLod;
+inline float& ANIMATION_HALF_RATE_SIZE = CONFIG.animationHalfRateSize;
+inline float& ANIMATION_QUARTER_RATE_SIZE = CONFIG.animationQuarterRateSize;
+inline float& ANIMATION_FROZEN_SIZE = CONFIG.animationFrozenSize;
+inline float& ANIMATION_LEAF_JOINT_SIZE = CONFIG.animationLeafJointSize;
+inline int& ANIMATION_SHARED_POSE_PHASES = CONFIG.animationSharedPosePhases;
+
+// Vertex animation
+inline bool& VERTEX_ANIMATION = CONFIG.vertexAnimation;
+inline float& VERTEX_ANIMATION_DISTANCE = CONFIG.vertexAnimationDistance;
+inline float& VERTEX_ANIMATION_RATE = CONFIG.vertexAnimationRate;
 
 // Ground
 inline float& GROUND_SIZE = CONFIG.groundSize;
@@ -98,5 +160,7 @@ inline float& TYPEWRITER_LINE_DELAY = CONFIG.typewriterLineDelay;
 // Debug
 inline bool& SHOW_AXES = CONFIG.showAxes;
 inline bool& SHOW_SHADOW_MAP = CONFIG.showShadowMap;
+inline std::string& GL_BACKEND = CONFIG.glBackend;
+inline std::string& GL_RECORD_FILE = CONFIG.glRecordFile;
 
 }  // namespace GameConfig
@@ -36,9 +36,6 @@ struct GameState {
     int lastPlayerGridX = -9999;
     int lastPlayerGridZ = -9999;
 
-    // LOD state
-    bool fingUsingHighDetail = false;
-
     // Timing
     float gameTime = 0.0f;
 
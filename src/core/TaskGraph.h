@@ -0,0 +1,187 @@
+#pragma once
+
+// Dependency-ordered jobs for asset loading. Worker tasks run on a thread pool;
+// MainThread tasks (anything that touches GL) run inside pump() on the thread
+// that owns the context. A task becomes ready once every task it depends on
+// has finished, and ready tasks of each kind run in the order they were added.
+//
+//   TaskGraph graph;
+//   auto decode = graph.add("Decode", TaskGraph::Worker, [&] { ... });
+//   graph.add("Upload", TaskGraph::MainThread, [&] { ... }, {decode});
+//   graph.run();  // start() + pump() until everything finished
+//
+// Task names must outlive any CPU profiler capture (use string literals).
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CpuProfiler.h"
+
+class TaskGraph {
+public:
+    enum Affinity { Worker, MainThread };
+    using TaskId = size_t;
+
+    TaskGraph() = default;
+    ~TaskGraph() { stopWorkers(); }
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    // Only valid before start()
+    TaskId add(const char* name, Affinity affinity, std::function<void()> fn,
+               std::initializer_list<TaskId> dependsOn = {}) {
+        TaskId id = m_tasks.size();
+        m_tasks.push_back({name, affinity, std::move(fn), dependsOn.size(), {}});
+        for (TaskId dep : dependsOn) {
+            m_tasks[dep].dependents.push_back(id);
+        }
+        return id;
+    }
+
+    // Hardware threads minus the main thread, at least one
+    static unsigned defaultWorkerCount() {
+        unsigned hw = std::thread::hardware_concurrency();
+        return std::max(hw, 2u) - 1;
+    }
+
+    void start(unsigned workerCount = defaultWorkerCount()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (TaskId id = 0; id < m_tasks.size(); ++id) {
+                if (m_tasks[id].pendingDeps == 0) enqueueLocked(id);
+            }
+        }
+        workerCount = std::min<unsigned>(std::max(workerCount, 1u), static_cast<unsigned>(m_tasks.size()) + 1);
+        for (unsigned i = 0; i < workerCount; ++i) {
+            m_workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    // Runs ready main-thread tasks until none is ready or budgetMs elapsed
+    // (budgetMs < 0 = no limit). Returns true once every task has finished.
+    bool pump(double budgetMs = -1.0) {
+        auto start = std::chrono::steady_clock::now();
+        for (;;) {
+            TaskId id;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_mainQueue.empty()) break;
+                id = m_mainQueue.front();
+                m_mainQueue.pop_front();
+            }
+            execute(id);
+            if (budgetMs >= 0.0 &&
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() >= budgetMs) {
+                break;
+            }
+        }
+        return finished();
+    }
+
+    // Blocks until a main-thread task is ready or everything finished
+    void waitForMainThreadWork() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_mainReady.wait(lock, [this] { return !m_mainQueue.empty() || m_completed == m_tasks.size(); });
+    }
+
+    void run(unsigned workerCount = defaultWorkerCount()) {
+        start(workerCount);
+        while (!pump()) {
+            waitForMainThreadWork();
+        }
+        stopWorkers();
+    }
+
+    bool finished() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_completed == m_tasks.size();
+    }
+
+    size_t completedCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_completed;
+    }
+    size_t taskCount() const { return m_tasks.size(); }
+
+private:
+    struct Task {
+        const char* name;
+        Affinity affinity;
+        std::function<void()> fn;
+        size_t pendingDeps;
+        std::vector<TaskId> dependents;
+    };
+
+    void enqueueLocked(TaskId id) {
+        if (m_tasks[id].affinity == MainThread) {
+            m_mainQueue.push_back(id);
+            m_mainReady.notify_one();
+        } else {
+            m_workerQueue.push_back(id);
+            m_workerReady.notify_one();
+        }
+    }
+
+    void execute(TaskId id) {
+        {
+            CPU_PROFILE_ZONE(m_tasks[id].name);
+            m_tasks[id].fn();
+            m_tasks[id].fn = nullptr;  // Release captured state early
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_completed;
+        for (TaskId dependent : m_tasks[id].dependents) {
+            if (--m_tasks[dependent].pendingDeps == 0) enqueueLocked(dependent);
+        }
+        if (m_completed == m_tasks.size()) {
+            m_mainReady.notify_all();
+            m_workerReady.notify_all();
+        }
+    }
+
+    void workerLoop() {
+        CpuProfiler::instance().setThreadName("Asset worker");
+        for (;;) {
+            TaskId id;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_workerReady.wait(lock, [this] { return m_stop || !m_workerQueue.empty(); });
+                if (m_workerQueue.empty()) return;  // Stopping
+                id = m_workerQueue.front();
+                m_workerQueue.pop_front();
+            }
+            execute(id);
+        }
+    }
+
+    void stopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_workerReady.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+        m_workers.clear();
+    }
+
+    std::vector<Task> m_tasks;
+    std::deque<TaskId> m_mainQueue;
+    std::deque<TaskId> m_workerQueue;
+    std::vector<std::thread> m_workers;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_mainReady;
+    std::condition_variable m_workerReady;
+    size_t m_completed = 0;
+    bool m_stop = false;
+};
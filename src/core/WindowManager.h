@@ -3,7 +3,10 @@
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <iostream>
+#include <string>
+#include <vector>
 #include "GameConfig.h"
+#include "../rendering/GLDispatch.h"
 
 class WindowManager {
 public:
@@ -14,6 +17,20 @@ public:
     WindowManager& operator=(const WindowManager&) = delete;
 
     bool init() {
+        // The null GL backend has no context, so it can only run offscreen
+        const bool nullGL = (GameConfig::GL_BACKEND == "null");
+        if (nullGL) {
+            GameConfig::HEADLESS = true;
+        } else if (GameConfig::GL_BACKEND != "native") {
+            std::cerr << "Unknown GL backend '" << GameConfig::GL_BACKEND << "', using native" << std::endl;
+        }
+
+        // Headless: SDL's offscreen driver creates an EGL context without a display
+        // (GPU-less machines fall back to Mesa llvmpipe)
+        if (GameConfig::HEADLESS) {
+            SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+        }
+
         if (!SDL_Init(SDL_INIT_VIDEO)) {
             std::cerr << "SDL_Init failed: " << SDL_GetError() << std::endl;
             return false;
@@ -32,9 +49,20 @@ public:
         SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
         SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
 
-        Uint64 windowFlags = SDL_WINDOW_OPENGL;
-        if (GameConfig::WINDOW_FULLSCREEN) {
-            windowFlags |= SDL_WINDOW_FULLSCREEN;
+        // High pixel density so the drawable matches the real panel resolution
+        Uint64 windowFlags = SDL_WINDOW_HIGH_PIXEL_DENSITY;
+        if (!nullGL) {
+            windowFlags |= SDL_WINDOW_OPENGL;
+        }
+        if (GameConfig::HEADLESS) {
+            windowFlags |= SDL_WINDOW_HIDDEN;
+        } else {
+            if (GameConfig::WINDOW_FULLSCREEN) {
+                windowFlags |= SDL_WINDOW_FULLSCREEN;
+            }
+            if (GameConfig::WINDOW_RESIZABLE) {
+                windowFlags |= SDL_WINDOW_RESIZABLE;
+            }
         }
 
         m_window = SDL_CreateWindow(
@@ -49,6 +77,13 @@ public:
             return false;
         }
 
+        if (nullGL) {
+            GLDispatch::install(GLBackend::Null, GameConfig::GL_RECORD_FILE);
+            updateDrawableSize();
+            m_initialized = true;
+            return true;
+        }
+
         m_glContext = SDL_GL_CreateContext(m_window);
         if (!m_glContext) {
             std::cerr << "SDL_GL_CreateContext failed: " << SDL_GetError() << std::endl;
@@ -70,9 +105,21 @@ public:
             return false;
         }
 
-        std::cout << "OpenGL " << glGetString(GL_VERSION) << std::endl;
+        if (!GameConfig::GL_RECORD_FILE.empty() &&
+            !GLDispatch::install(GLBackend::Native, GameConfig::GL_RECORD_FILE)) {
+            std::cerr << "GL recording disabled" << std::endl;
+        }
+
+        std::cout << "OpenGL " << glGetString(GL_VERSION) << " (" << glGetString(GL_RENDERER) << ")" << std::endl;
+        if (GameConfig::HEADLESS) {
+            SDL_GL_SetSwapInterval(0);
+            std::cout << "Headless: offscreen video driver, frames are not presented" << std::endl;
+        } else if (GameConfig::BENCHMARK) {
+            SDL_GL_SetSwapInterval(0);  // Measure the frame, not the display refresh
+        }
 
-        glViewport(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+        updateDrawableSize();
+        glViewport(0, 0, m_drawableWidth, m_drawableHeight);
         glEnable(GL_DEPTH_TEST);
 
         m_initialized = true;
@@ -82,6 +129,7 @@ public:
     void shutdown() {
         if (!m_initialized) return;
 
+        GLDispatch::shutdown();
         if (m_glContext) {
             SDL_GL_DestroyContext(m_glContext);
             m_glContext = nullptr;
@@ -96,19 +144,74 @@ public:
         m_initialized = false;
     }
 
+    // Headless frames stay in the offscreen back buffer; only flush submitted work
     void swapBuffers() {
-        if (m_window) SDL_GL_SwapWindow(m_window);
+        if (GameConfig::HEADLESS) {
+            glFlush();
+        } else if (m_window) {
+            SDL_GL_SwapWindow(m_window);
+        }
+    }
+
+    // Read the current back buffer and write it as a PNG (call before swapBuffers)
+    bool saveFramePNG(const std::string& path) const {
+        const int w = m_drawableWidth;
+        const int h = m_drawableHeight;
+        std::vector<unsigned char> pixels(static_cast<size_t>(w) * h * 4);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        glReadBuffer(GL_BACK);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+        SDL_Surface* surface = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_RGBA32);
+        if (!surface) {
+            std::cerr << "saveFramePNG: SDL_CreateSurface failed: " << SDL_GetError() << std::endl;
+            return false;
+        }
+
+        // GL rows are bottom-up
+        const size_t rowBytes = static_cast<size_t>(w) * 4;
+        for (int y = 0; y < h; ++y) {
+            SDL_memcpy(static_cast<unsigned char*>(surface->pixels) + static_cast<size_t>(y) * surface->pitch,
+                       pixels.data() + static_cast<size_t>(h - 1 - y) * rowBytes, rowBytes);
+        }
+
+        bool ok = SDL_SavePNG(surface, path.c_str());
+        if (!ok) {
+            std::cerr << "saveFramePNG: " << path << ": " << SDL_GetError() << std::endl;
+        }
+        SDL_DestroySurface(surface);
+        return ok;
+    }
+
+    // Re-query the drawable size in pixels (resize, fullscreen toggle, display change)
+    // Returns true when it changed since the last call
+    bool updateDrawableSize() {
+        if (!m_window) return false;
+
+        int w = 0, h = 0;
+        if (!SDL_GetWindowSizeInPixels(m_window, &w, &h) || w <= 0 || h <= 0) {
+            return false;  // Minimized or query failed: keep last valid size
+        }
+        if (w == m_drawableWidth && h == m_drawableHeight) return false;
+
+        m_drawableWidth = w;
+        m_drawableHeight = h;
+        return true;
     }
 
     SDL_Window* window() const { return m_window; }
     SDL_GLContext glContext() const { return m_glContext; }
     bool isInitialized() const { return m_initialized; }
-    static int width() { return GameConfig::WINDOW_WIDTH; }
-    static int height() { return GameConfig::WINDOW_HEIGHT; }
-    static float aspectRatio() { return static_cast<float>(GameConfig::WINDOW_WIDTH) / GameConfig::WINDOW_HEIGHT; }
+    int width() const { return m_drawableWidth; }
+    int height() const { return m_drawableHeight; }
+    float aspectRatio() const { return static_cast<float>(m_drawableWidth) / m_drawableHeight; }
 
 private:
     SDL_Window* m_window = nullptr;
     SDL_GLContext m_glContext = nullptr;
     bool m_initialized = false;
+    int m_drawableWidth = GameConfig::WINDOW_WIDTH;
+    int m_drawableHeight = GameConfig::WINDOW_HEIGHT;
 };
@@ -9,6 +9,7 @@
 #include "Octree.h"
 #include "../procedural/BuildingGenerator.h"
 #include "../rendering/InstancedRenderer.h"
+#include "../core/CpuProfiler.h"
 
 // Render parameters for building main pass
 struct BuildingRenderParams {
@@ -66,6 +67,7 @@ public:
     // Call once per frame before rendering
     void update(const glm::mat4& view, const glm::mat4& projection,
                 const glm::vec3& cameraPos, float maxRenderDistance) {
+        CPU_PROFILE_ZONE("BuildingCuller::update");
         m_visibleCount = 0;
         m_instancedRenderer.beginFrame();
 
@@ -92,6 +94,7 @@ public:
 
     // Render all visible buildings (main pass) with full material setup
     void render(const Mesh& buildingMesh, Shader& shader, const BuildingRenderParams& params) {
+        CPU_PROFILE_ZONE("BuildingCuller::render");
         if (m_instancedRenderer.getInstanceCount() == 0) return;
 
         shader.use();
@@ -147,6 +150,7 @@ public:
     // This should be called before renderShadows() to populate shadow instances
     // Uses radius query (not camera frustum) so buildings behind camera still cast shadows
     void updateShadowCasters(const glm::mat4& /*lightSpaceMatrix*/, const glm::vec3& cameraPos, float shadowDistance) {
+        CPU_PROFILE_ZONE("BuildingCuller::updateShadowCasters");
         m_shadowInstancedRenderer.beginFrame();
         m_shadowVisibleCount = 0;
 
@@ -165,6 +169,7 @@ public:
     // Render shadow pass for shadow casters
     void renderShadows(const Mesh& buildingMesh, Shader& depthShader,
                        const glm::mat4& lightSpaceMatrix) {
+        CPU_PROFILE_ZONE("BuildingCuller::renderShadows");
         m_shadowInstancedRenderer.renderShadow(buildingMesh, depthShader, lightSpaceMatrix);
     }
 
@@ -13,6 +13,8 @@
 #include "components/FacingDirection.h"
 #include "components/UIText.h"
 #include "components/MonsterData.h"
+#include "components/LevelOfDetail.h"
+#include "components/VertexAnimation.h"
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -42,6 +44,8 @@ public:
         m_facingDirections.erase(e);
         m_uiTexts.erase(e);
         m_monsterDatas.erase(e);
+        m_levelsOfDetail.erase(e);
+        m_vertexAnimations.erase(e);
     }
 
     bool isAlive(Entity e) const {
@@ -63,6 +67,8 @@ public:
     bool hasFacingDirection(Entity e) const { return m_facingDirections.count(e) > 0; }
     bool hasUIText(Entity e) const { return m_uiTexts.count(e) > 0; }
     bool hasMonsterData(Entity e) const { return m_monsterDatas.count(e) > 0; }
+    bool hasLevelOfDetail(Entity e) const { return m_levelsOfDetail.count(e) > 0; }
+    bool hasVertexAnimation(Entity e) const { return m_vertexAnimations.count(e) > 0; }
 
     // Transform
     Transform& addTransform(Entity e, Transform t = {}) {
@@ -204,12 +210,40 @@ public:
         return it != m_monsterDatas.end() ? &it->second : nullptr;
     }
 
+    // LevelOfDetail
+    LevelOfDetail& addLevelOfDetail(Entity e, LevelOfDetail lod = {}) {
+        m_levelsOfDetail[e] = std::move(lod);
+        return m_levelsOfDetail[e];
+    }
+    LevelOfDetail* getLevelOfDetail(Entity e) {
+        auto it = m_levelsOfDetail.find(e);
+        return it != m_levelsOfDetail.end() ? &it->second : nullptr;
+    }
+
+    // VertexAnimation
+    VertexAnimation& addVertexAnimation(Entity e, VertexAnimation vat = {}) {
+        m_vertexAnimations[e] = std::move(vat);
+        return m_vertexAnimations[e];
+    }
+    VertexAnimation* getVertexAnimation(Entity e) {
+        auto it = m_vertexAnimations.find(e);
+        return it != m_vertexAnimations.end() ? &it->second : nullptr;
+    }
+
+    // Meshes to draw: the current LOD level if the entity has one, else its MeshGroup
+    const MeshGroup* getRenderMeshGroup(Entity e) {
+        if (auto* lod = getLevelOfDetail(e)) {
+            if (const MeshGroup* meshGroup = lod->currentMeshGroup()) return meshGroup;
+        }
+        return getMeshGroup(e);
+    }
+
     // Iteration helpers
     template<typename Func>
     void forEachRenderable(Func&& func) {
         for (auto& [entity, renderable] : m_renderables) {
             auto* transform = getTransform(entity);
-            auto* meshGroup = getMeshGroup(entity);
+            auto* meshGroup = getRenderMeshGroup(entity);
             if (transform && meshGroup) {
                 func(entity, *transform, *meshGroup, renderable);
             }
@@ -314,6 +348,27 @@ public:
         }
     }
 
+    template<typename Func>
+    void forEachLevelOfDetail(Func&& func) {
+        for (auto& [entity, lod] : m_levelsOfDetail) {
+            auto* transform = getTransform(entity);
+            if (transform) {
+                func(entity, *transform, lod);
+            }
+        }
+    }
+
+    template<typename Func>
+    void forEachVertexAnimation(Func&& func) {
+        for (auto& [entity, vat] : m_vertexAnimations) {
+            auto* transform = getTransform(entity);
+            auto* animation = getAnimation(entity);
+            if (transform && animation) {
+                func(entity, *transform, *animation, vat);
+            }
+        }
+    }
+
     template<typename Func>
     void forEachMonster(Func&& func) {
         for (auto& [entity, monsterData] : m_monsterDatas) {
@@ -342,4 +397,6 @@ private:
     std::unordered_map<Entity, FacingDirection> m_facingDirections;
     std::unordered_map<Entity, UIText> m_uiTexts;
     std::unordered_map<Entity, MonsterData> m_monsterDatas;
+    std::unordered_map<Entity, LevelOfDetail> m_levelsOfDetail;
+    std::unordered_map<Entity, VertexAnimation> m_vertexAnimations;
 };
@@ -1,6 +1,10 @@
 #pragma once
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -14,10 +18,143 @@ struct AnimationChannel {
     std::vector<glm::vec3> scales;
 };
 
+// One joint of a CompressedClip. Each TRS component is either constant over
+// the clip or a column of the matching key array.
+struct CompressedTrack {
+    int jointIndex = -1;
+    int rotationColumn = -1;     // -1 = constantRotation
+    int translationColumn = -1;  // -1 = constantTranslation
+    int scaleColumn = -1;        // -1 = constantScale
+    glm::quat constantRotation{1.0f, 0.0f, 0.0f, 0.0f};
+    glm::vec3 constantTranslation{0.0f};
+    glm::vec3 constantScale{1.0f};
+    glm::vec3 translationMin{0.0f};  // Animated translation = min + unorm16 * extent
+    glm::vec3 translationExtent{0.0f};
+    glm::vec3 scaleMin{1.0f};        // Animated scale = min + unorm16 * extent
+    glm::vec3 scaleExtent{0.0f};
+};
+
+// A clip resampled at a uniform rate and quantized (AnimationCompressor.h).
+// Key arrays are SoA, one per TRS component, and frame-major: frame f holds
+// one key per animated column, in joint order, so sampling any time reads two
+// adjacent rows. Rotations are smallest-three (three uint16 per key, see
+// decodeSmallestThree), translations and scales three unorm16 relative to
+// their track's range.
+struct CompressedClip {
+    float sampleRate = 0.0f;   // Frames per second; frame frameCount - 1 is at the clip's duration
+    uint32_t frameCount = 0;   // 0 = not compressed
+    uint32_t rotationColumns = 0;
+    uint32_t translationColumns = 0;
+    uint32_t scaleColumns = 0;
+    std::vector<CompressedTrack> tracks;
+    std::vector<uint16_t> rotationKeys;     // frameCount * rotationColumns * 3
+    std::vector<uint16_t> translationKeys;  // frameCount * translationColumns * 3
+    std::vector<uint16_t> scaleKeys;        // frameCount * scaleColumns * 3
+};
+
 struct AnimationClip {
     std::string name;
     float duration = 0.0f;
-    std::vector<AnimationChannel> channels;
+    std::vector<AnimationChannel> channels;  // Source keys (empty once compressed)
+    CompressedClip compressed;
+
+    bool isCompressed() const { return compressed.frameCount > 0; }
+};
+
+// Smallest-three quaternion: the largest component is dropped (and made
+// positive by flipping the sign of q), the other three are stored as 15-bit
+// values over [-1/sqrt(2), 1/sqrt(2)] and the dropped index goes into the top
+// bits of the first two words
+inline glm::quat decodeSmallestThree(const uint16_t* key) {
+    constexpr float RANGE = 0.70710678f;
+    const int largest = ((key[0] >> 15) << 1) | (key[1] >> 15);
+    float c[4];
+    float sum = 0.0f;
+    for (int i = 0, k = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        c[i] = (static_cast<float>(key[k++] & 0x7FFFu) * (2.0f / 32767.0f) - 1.0f) * RANGE;
+        sum += c[i] * c[i];
+    }
+    c[largest] = std::sqrt(std::max(1.0f - sum, 0.0f));
+    return glm::quat(c[3], c[0], c[1], c[2]);  // Components x, y, z, w
+}
+
+// Frames bracketing `time` (clamped to the clip) and the blend between them
+inline void compressedFrame(const CompressedClip& clip, float time, uint32_t& f0, uint32_t& f1, float& alpha) {
+    const float last = static_cast<float>(clip.frameCount - 1);
+    const float frame = std::min(std::max(time * clip.sampleRate, 0.0f), last);
+    f0 = static_cast<uint32_t>(frame);
+    f1 = std::min(f0 + 1, clip.frameCount - 1);
+    alpha = frame - static_cast<float>(f0);
+}
+
+// One track at the blend of frames f0 and f1. Rotations are nlerped with the
+// blend factor bent by a fitted polynomial in cos(angle), which keeps nlerp
+// within ~1e-4 rad of slerp over the angles a frame apart covers, without
+// slerp's acos/sin.
+inline void sampleCompressedTrack(const CompressedClip& clip, const CompressedTrack& track,
+                                  uint32_t f0, uint32_t f1, float alpha,
+                                  glm::quat& rotation, glm::vec3& translation, glm::vec3& scale) {
+    auto unorm16 = [](const uint16_t* key) {
+        return glm::vec3(key[0], key[1], key[2]) * (1.0f / 65535.0f);
+    };
+
+    if (track.rotationColumn >= 0) {
+        const size_t row = size_t(clip.rotationColumns) * 3;
+        glm::quat q0 = decodeSmallestThree(&clip.rotationKeys[f0 * row + track.rotationColumn * 3]);
+        glm::quat q1 = decodeSmallestThree(&clip.rotationKeys[f1 * row + track.rotationColumn * 3]);
+        float cosAngle = glm::dot(q0, q1);
+        if (cosAngle < 0.0f) {
+            q1 = -q1;
+            cosAngle = -cosAngle;
+        }
+        const float a = 1.0904f + cosAngle * (-3.2452f + cosAngle * (3.55645f - cosAngle * 1.43519f));
+        const float b = 0.848013f + cosAngle * (-1.06021f + cosAngle * 0.215638f);
+        const float k = a * (alpha - 0.5f) * (alpha - 0.5f) + b;
+        const float t = alpha + alpha * (alpha - 0.5f) * (alpha - 1.0f) * k;
+        rotation = glm::normalize(q0 * (1.0f - t) + q1 * t);
+    } else {
+        rotation = track.constantRotation;
+    }
+
+    if (track.translationColumn >= 0) {
+        const size_t row = size_t(clip.translationColumns) * 3;
+        glm::vec3 t0 = unorm16(&clip.translationKeys[f0 * row + track.translationColumn * 3]);
+        glm::vec3 t1 = unorm16(&clip.translationKeys[f1 * row + track.translationColumn * 3]);
+        translation = track.translationMin + glm::mix(t0, t1, alpha) * track.translationExtent;
+    } else {
+        translation = track.constantTranslation;
+    }
+
+    if (track.scaleColumn >= 0) {
+        const size_t row = size_t(clip.scaleColumns) * 3;
+        glm::vec3 s0 = unorm16(&clip.scaleKeys[f0 * row + track.scaleColumn * 3]);
+        glm::vec3 s1 = unorm16(&clip.scaleKeys[f1 * row + track.scaleColumn * 3]);
+        scale = track.scaleMin + glm::mix(s0, s1, alpha) * track.scaleExtent;
+    } else {
+        scale = track.constantScale;
+    }
+}
+
+// Immutable animation clips of a model, shared by every instance of it
+struct ClipSet {
+    std::vector<AnimationClip> clips;
+};
+
+// A clip baked into vertex animation frames (VertexAnimationBaker.h): frames
+// firstFrame .. firstFrame + frameCount - 1 of the model's frame table, evenly
+// spaced with the last one at the clip's duration
+struct VertexAnimationClip {
+    uint32_t firstFrame = 0;
+    uint32_t frameCount = 0;
+    float duration = 0.0f;
+};
+
+// Key index each track of a channel was last sampled at (AnimationSystem)
+struct KeyframeCursor {
+    uint32_t translation = 0;
+    uint32_t rotation = 0;
+    uint32_t scale = 0;
 };
 
 struct Animation {
@@ -25,5 +162,15 @@ struct Animation {
     float time = 0.0f;
     bool playing = true;
     float speedMultiplier = 1.0f;  // Animation playback speed multiplier
-    std::vector<AnimationClip> clips;  // Clips now live in the component
+    std::shared_ptr<const ClipSet> clipSet;
+    bool sharePose = false;  // Quantize to a shared per-phase pose (crowds, AnimationSystem::setSharedPosePhases)
+
+    // Playback cursors, one per channel of cursorClip (reset when the clip changes)
+    const AnimationClip* cursorClip = nullptr;
+    std::vector<KeyframeCursor> cursors;
+
+    const AnimationClip* currentClip() const {
+        if (!clipSet || clipIndex < 0 || clipIndex >= static_cast<int>(clipSet->clips.size())) return nullptr;
+        return &clipSet->clips[clipIndex];
+    }
 };
@@ -0,0 +1,37 @@
+#pragma once
+#include "Mesh.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+// One detail level. The mesh group is owned elsewhere (AssetManager models and
+// their cooked LODs) and only referenced, so switching levels never copies.
+struct LODLevel {
+    const MeshGroup* meshGroup = nullptr;
+    float screenSize = 0.0f;  // Projected diameter (pixels) below which this level replaces the previous one
+    float switchDistance = 0.0f;  // > 0: replaces the previous level from this camera distance on instead,
+                                  // whatever the viewport (screenSize is ignored)
+};
+
+// Distance-independent level selection for any renderable (see LODSystem).
+// While present, the current level is drawn instead of the entity's own
+// MeshGroup component (Registry::getRenderMeshGroup).
+struct LevelOfDetail {
+    std::vector<LODLevel> levels;  // Finest first, switching at decreasing sizes (or increasing distances)
+    glm::vec3 boundsCenter{0.0f};  // Bounding sphere in model space (before Renderable::meshOffset)
+    float boundsRadius = 1.0f;     // In transform units (skinned models: bind-pose skin scale applied)
+    float hysteresis = 0.1f;       // Band around each threshold, as a fraction of it
+    float crossFadeTime = 0.0f;    // Seconds of dithered cross-fade per switch (0 = pop)
+
+    // Selection state (written by LODSystem)
+    int current = 0;
+    int previous = -1;        // Level fading out, -1 when not cross-fading
+    float fade = 1.0f;        // Screen coverage of `current` while cross-fading
+    float screenSize = 0.0f;  // Last projected diameter in pixels (0 until the first update, which never fades)
+
+    const MeshGroup* currentMeshGroup() const {
+        return (current >= 0 && current < static_cast<int>(levels.size())) ? levels[current].meshGroup : nullptr;
+    }
+    const MeshGroup* fadingMeshGroup() const {
+        return (previous >= 0 && previous < static_cast<int>(levels.size())) ? levels[previous].meshGroup : nullptr;
+    }
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 // CPU-side skinning data for a single vertex
@@ -10,6 +12,21 @@ struct SkinnedVertex {
     glm::vec4 weights;       // How much each bone affects it
 };
 
+// Vertices kept in RAM after upload, as selected by the model's
+// GeometryRetention. Stays quantized like the vertex buffer (6 bytes per
+// position, 8 per skin entry); unpack with unpackCpuVertex (AssetLoader.h).
+struct CpuGeometry {
+    std::vector<uint16_t> positions;      // unorm16 xyz per kept vertex (Mesh::positionOffset/positionScale)
+    std::vector<uint8_t> skin;            // 4 joints + 4 unorm8 weights per kept vertex, empty if not kept
+    std::vector<uint32_t> sourceIndices;  // Vertex buffer index of each kept vertex, empty when all are kept
+
+    size_t vertexCount() const { return positions.size() / 3; }
+    bool empty() const { return positions.empty(); }
+    size_t memoryBytes() const {
+        return positions.size() * sizeof(uint16_t) + skin.size() + sourceIndices.size() * sizeof(uint32_t);
+    }
+};
+
 struct Mesh {
     GLuint vao = 0;
     GLsizei indexCount = 0;
@@ -17,9 +34,16 @@ struct Mesh {
     bool hasSkinning = false;
     GLuint texture = 0;
     GLuint normalMap = 0;  // Normal map texture
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+
+    // Positions are unorm16 relative to the mesh bounds (see VertexFormat.h):
+    // shaders rebuild them as uPositionOffset + aPos * uPositionScale
+    glm::vec3 positionOffset{0.0f};
+    glm::vec3 positionScale{1.0f};
 
-    // CPU-side vertex data for skinning calculations
-    std::vector<SkinnedVertex> skinnedVertices;
+    // CPU-side vertex data (empty unless the model's retention keeps some)
+    CpuGeometry cpuGeometry;
 };
 
 struct MeshGroup {
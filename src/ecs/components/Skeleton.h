@@ -1,32 +1,103 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 
 struct Joint {
     int parentIndex = -1;
     glm::mat4 inverseBindMatrix{1.0f};
-    glm::mat4 localTransform{1.0f};
+    glm::mat4 localTransform{1.0f};  // Bind pose
 };
 
-struct Skeleton {
+// Immutable joint hierarchy of a model, shared by every instance of it
+struct SkeletonDef {
     std::vector<Joint> joints;
-    std::vector<glm::mat4> boneMatrices;        // Skinning matrices (for GPU)
-    std::vector<glm::mat4> jointWorldTransforms; // Actual world position of each joint
-    std::vector<glm::mat4> bindPoseTransforms;  // Original pose to reset to
-    std::vector<std::string> jointNames;        // Names from GLTF nodes
+    std::vector<std::string> jointNames;  // Names from GLTF nodes
+    std::vector<uint8_t> leafJoints;      // 1 = no child joints (markLeafJoints; empty = unknown)
 
     void resize(size_t count) {
         joints.resize(count);
+        jointNames.resize(count);
+    }
+
+    // Fingertips, face and toe joints end the hierarchy; distant animation
+    // LOD leaves them at their last pose (AnimationSystem)
+    void markLeafJoints() {
+        leafJoints.assign(joints.size(), 1);
+        for (const Joint& joint : joints) {
+            if (joint.parentIndex >= 0 && joint.parentIndex < static_cast<int>(joints.size())) {
+                leafJoints[joint.parentIndex] = 0;
+            }
+        }
+    }
+};
+
+// Per-instance pose of a shared SkeletonDef
+struct Skeleton {
+    std::shared_ptr<const SkeletonDef> def;
+    std::vector<glm::mat4> localTransforms;      // Current (animated) local pose
+    std::vector<glm::mat4> boneMatrices;         // Skinning matrices (for GPU)
+    std::vector<glm::mat4> jointWorldTransforms; // Actual world position of each joint
+    bool poseChanged = true;  // localTransforms written since SkeletonSystem last rebuilt the matrices
+
+    // Crowd pose sharing: while set, this pose (evaluated once per clip phase
+    // by AnimationSystem) is skinned instead of the instance's own matrices
+    std::shared_ptr<const Skeleton> sharedPose;
+
+    Skeleton() = default;
+    explicit Skeleton(std::shared_ptr<const SkeletonDef> definition) : def(std::move(definition)) {
+        const size_t count = def ? def->joints.size() : 0;
+        localTransforms.resize(count);
         boneMatrices.resize(count, glm::mat4(1.0f));
         jointWorldTransforms.resize(count, glm::mat4(1.0f));
-        bindPoseTransforms.resize(count, glm::mat4(1.0f));
-        jointNames.resize(count);
+        resetToBindPose();
+    }
+
+    size_t jointCount() const { return localTransforms.size(); }
+
+    // Matrices to upload as uBones
+    const std::vector<glm::mat4>& skinningMatrices() const {
+        return sharedPose ? sharedPose->boneMatrices : boneMatrices;
     }
 
     void resetToBindPose() {
-        for (size_t i = 0; i < joints.size() && i < bindPoseTransforms.size(); ++i) {
-            joints[i].localTransform = bindPoseTransforms[i];
+        for (size_t i = 0; i < localTransforms.size(); ++i) {
+            localTransforms[i] = def->joints[i].localTransform;
         }
+        poseChanged = true;
     }
 };
+
+// Largest scale the bind pose skinning matrices apply to bind-space vertices
+// (armatures whose inverse bind matrices include a unit conversion)
+inline float bindPoseSkinScale(const SkeletonDef& skeleton) {
+    std::vector<glm::mat4> world(skeleton.joints.size());
+    float scale = 0.0f;
+    for (size_t i = 0; i < skeleton.joints.size(); ++i) {
+        const Joint& joint = skeleton.joints[i];
+        world[i] = (joint.parentIndex >= 0) ? world[joint.parentIndex] * joint.localTransform : joint.localTransform;
+        glm::mat3 skin = glm::mat3(world[i] * joint.inverseBindMatrix);
+        scale = std::max({scale, glm::length(skin[0]), glm::length(skin[1]), glm::length(skin[2])});
+    }
+    return (scale > 0.0f) ? scale : 1.0f;
+}
+
+enum class FootSide { Left, Right };
+
+// Foot and toe joints of one side, matched by name ("LeftFoot", "foot.L", "toe_l", ...)
+inline std::vector<int> findFootJoints(const SkeletonDef& skeleton, FootSide side) {
+    auto contains = [](const std::string& name, const char* part) { return name.find(part) != std::string::npos; };
+    std::vector<int> joints;
+    for (size_t i = 0; i < skeleton.jointNames.size(); ++i) {
+        const std::string& name = skeleton.jointNames[i];
+        bool sideMatches = (side == FootSide::Left)
+            ? contains(name, "Left") || contains(name, "left") || contains(name, "_l") || contains(name, ".L")
+            : contains(name, "Right") || contains(name, "right") || contains(name, "_r") || contains(name, ".R");
+        bool isFoot = contains(name, "Foot") || contains(name, "foot") || contains(name, "Toe") || contains(name, "toe");
+        if (sideMatches && isFoot) joints.push_back(static_cast<int>(i));
+    }
+    return joints;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "Animation.h"
+#include "Mesh.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Clips a VertexAnimationSet can play (size of the shaders' clip table)
+constexpr int MAX_VERTEX_ANIMATION_CLIPS = 16;
+
+// One mesh's baked frames on the GPU: an RGBA16UI buffer texture holding
+// texel frame * vertexCount + vertex (layout in VertexAnimationBaker.h). LOD
+// meshes draw from the same vertex buffer, so they read the same frames.
+struct VertexAnimationTexture {
+    GLuint buffer = 0;
+    GLuint texture = 0;
+    uint32_t vertexCount = 0;
+    glm::vec3 positionOffset{0.0f};  // position = offset + unorm16 * scale, over the animated bounds
+    glm::vec3 positionScale{1.0f};
+};
+
+// A model's baked clips, shared by every instance (LoadedModel::vertexAnimation)
+struct VertexAnimationSet {
+    uint32_t frameCount = 0;                      // All clips, back to back
+    std::vector<VertexAnimationClip> clips;       // Parallel to the model's ClipSet
+    std::vector<VertexAnimationTexture> meshes;   // Parallel to the model's meshes (and each LOD's)
+
+    // Whether every mesh of the group has baked frames
+    bool covers(const MeshGroup& meshGroup) const { return meshes.size() >= meshGroup.meshes.size(); }
+};
+
+// Far-away crowd playback: while active the entity is drawn from the baked
+// frames of its Animation's clip and time, and AnimationSystem only advances
+// that time, leaving the skeleton alone (VertexAnimationSystem switches it by
+// distance)
+struct VertexAnimation {
+    std::shared_ptr<const VertexAnimationSet> set;
+    bool active = false;
+    float prevTime = 0.0f;  // Animation::time before this frame's advance (velocity buffer)
+    bool poseStale = false; // Just switched back: the skeleton's pose predates the switch
+    bool rejected = false;  // The renderer could not batch it (MeshGroup batched with another set): stays skinned
+
+    // Whether the set has baked frames for the clip
+    bool canPlay(int clip) const {
+        return set && clip >= 0 && clip < static_cast<int>(set->clips.size()) &&
+               clip < MAX_VERTEX_ANIMATION_CLIPS && set->clips[clip].duration > 0.0f;
+    }
+
+    // The renderer fell back to skinning: back to skinned playback for good
+    void reject() {
+        active = false;
+        poseStale = true;
+        rejected = true;
+    }
+};
@@ -1,35 +1,228 @@
 #pragma once
 #include "../Registry.h"
 #include "../../assets/AssetLoader.h"
+#include "../../core/CpuProfiler.h"
+#include "SkeletonSystem.h"
 #include <glm/gtx/quaternion.hpp>
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+// Animation LOD tiers, by the projected diameter (pixels) LODSystem last
+// measured for the entity (LevelOfDetail::screenSize). Entities without a
+// LevelOfDetail, or before its first update, animate every frame.
+struct AnimationLODSettings {
+    bool enabled = true;
+    float halfRateSize = 160.0f;    // Below: pose evaluated every 2nd frame
+    float quarterRateSize = 64.0f;  // Below: every 4th frame
+    float frozenSize = 8.0f;        // Below, or culled (Renderable::visible): pose kept as is
+    float leafJointSize = 100.0f;   // Below: leaf joints (SkeletonDef::leafJoints) keep their last pose
+};
 
 class AnimationSystem {
 public:
+    void setLODSettings(const AnimationLODSettings& settings) { m_lod = settings; }
+    const AnimationLODSettings& lodSettings() const { return m_lod; }
+
+    // Phases per clip that Animation::sharePose instances are quantized to (0 = no sharing)
+    void setSharedPosePhases(uint32_t phases) {
+        if (phases != m_sharedPosePhases) m_sharedPoses.clear();
+        m_sharedPosePhases = phases;
+    }
+    uint32_t sharedPosePhases() const { return m_sharedPosePhases; }
+
+    // Poses evaluated / skipped by animation LOD in the last update
+    size_t evaluatedPoses() const { return m_evaluatedPoses; }
+    size_t skippedPoses() const { return m_skippedPoses; }
+    // Instances that referenced a shared pose in the last update, and distinct shared poses evaluated so far
+    size_t sharedPoseInstances() const { return m_sharedPoseInstances; }
+    size_t sharedPoseCount() const { return m_sharedPoses.size(); }
+
     void update(Registry& registry, float dt) {
+        CPU_PROFILE_ZONE("AnimationSystem");
+        ++m_frame;
+        m_evaluatedPoses = 0;
+        m_skippedPoses = 0;
+        m_sharedPoseInstances = 0;
         registry.forEachAnimated([&](Entity entity, Animation& anim, Skeleton& skeleton) {
             if (!anim.playing) return;
 
-            // Clips now live in the Animation component
-            if (anim.clipIndex < 0 || anim.clipIndex >= static_cast<int>(anim.clips.size())) return;
-
-            const AnimationClip& clip = anim.clips[anim.clipIndex];
+            // Clips are shared by every instance of the model
+            const AnimationClip* currentClip = anim.currentClip();
+            if (!currentClip) return;
+            const AnimationClip& clip = *currentClip;
 
             anim.time += dt * anim.speedMultiplier;
             if (clip.duration > 0.0f) {
                 anim.time = fmod(anim.time, clip.duration);
             }
 
-            for (const auto& channel : clip.channels) {
-                if (channel.jointIndex < 0 || channel.jointIndex >= static_cast<int>(skeleton.joints.size())) continue;
+            // Drawn from baked frames (VertexAnimationSystem): only the time advances
+            VertexAnimation* vertexAnimation = registry.getVertexAnimation(entity);
+            if (vertexAnimation && vertexAnimation->active) return;
+            const bool poseStale = vertexAnimation && vertexAnimation->poseStale;
+            if (poseStale) vertexAnimation->poseStale = false;
+
+            // Crowd instances reference the pose of their clip phase instead of owning one
+            if (anim.sharePose && m_sharedPosePhases > 0 && clip.duration > 0.0f) {
+                skeleton.sharedPose = sharedPose(anim, clip, skeleton);
+                ++m_sharedPoseInstances;
+                return;
+            }
+            if (skeleton.sharedPose) {
+                skeleton.sharedPose.reset();
+                skeleton.poseChanged = true;
+            }
+
+            // Playback time always advances; LOD only skips evaluating the pose.
+            // Entities of one interval are spread over its frames by id.
+            float screenSize = 0.0f;
+            const uint32_t interval = updateInterval(registry, entity, screenSize);
+            if (!poseStale && (interval == 0 || (m_frame + entity) % interval != 0)) {
+                ++m_skippedPoses;
+                return;
+            }
+            ++m_evaluatedPoses;
+            skeleton.poseChanged = true;
+
+            const uint8_t* skipJoints = nullptr;
+            if (m_lod.enabled && screenSize > 0.0f && screenSize < m_lod.leafJointSize &&
+                skeleton.def->leafJoints.size() == skeleton.jointCount()) {
+                skipJoints = skeleton.def->leafJoints.data();
+            }
+
+            if (clip.isCompressed()) {
+                sampleCompressed(clip.compressed, anim.time, skeleton, skipJoints);
+                return;
+            }
 
-                skeleton.joints[channel.jointIndex].localTransform = interpolateTransform(channel, anim.time);
+            // New clip (or clip set): cursors restart at the first key
+            if (anim.cursorClip != currentClip) {
+                anim.cursorClip = currentClip;
+                anim.cursors.assign(clip.channels.size(), KeyframeCursor{});
             }
+            sampleChannels(clip, anim.time, skeleton, skipJoints, anim.cursors);
         });
     }
 
 private:
-    static bool findKeyframes(const std::vector<float>& times, float t, size_t& i0, size_t& i1, float& factor) {
+    AnimationLODSettings m_lod;
+    uint32_t m_frame = 0;
+    size_t m_evaluatedPoses = 0;
+    size_t m_skippedPoses = 0;
+
+    // Shared poses by model, clip and phase. A phase always samples the same
+    // time, so its pose is evaluated on first use and stays valid; instances
+    // hold a reference, which keeps it alive across setSharedPosePhases.
+    struct SharedPoseKey {
+        const SkeletonDef* skeleton;
+        const AnimationClip* clip;
+        uint32_t phase;
+        bool operator==(const SharedPoseKey& other) const {
+            return skeleton == other.skeleton && clip == other.clip && phase == other.phase;
+        }
+    };
+    struct SharedPoseKeyHash {
+        size_t operator()(const SharedPoseKey& key) const {
+            size_t h = std::hash<const void*>()(key.skeleton);
+            h ^= std::hash<const void*>()(key.clip) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<uint32_t>()(key.phase) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+    struct SharedPoseEntry {
+        std::shared_ptr<const ClipSet> clipSet;  // Keeps the keyed clip alive
+        std::shared_ptr<const Skeleton> pose;
+    };
+    uint32_t m_sharedPosePhases = 0;
+    std::unordered_map<SharedPoseKey, SharedPoseEntry, SharedPoseKeyHash> m_sharedPoses;
+    size_t m_sharedPoseInstances = 0;
+
+    std::shared_ptr<const Skeleton> sharedPose(const Animation& anim, const AnimationClip& clip, const Skeleton& skeleton) {
+        const float phases = static_cast<float>(m_sharedPosePhases);
+        const uint32_t phase = static_cast<uint32_t>(anim.time / clip.duration * phases + 0.5f) % m_sharedPosePhases;
+
+        SharedPoseEntry& entry = m_sharedPoses[SharedPoseKey{skeleton.def.get(), &clip, phase}];
+        if (!entry.pose) {
+            auto pose = std::make_shared<Skeleton>(skeleton.def);
+            const float time = static_cast<float>(phase) * clip.duration / phases;
+            if (clip.isCompressed()) {
+                sampleCompressed(clip.compressed, time, *pose, nullptr);
+            } else {
+                std::vector<KeyframeCursor> cursors(clip.channels.size());
+                sampleChannels(clip, time, *pose, nullptr, cursors);
+            }
+            SkeletonSystem::updateMatrices(*pose);
+            entry.clipSet = anim.clipSet;
+            entry.pose = std::move(pose);
+        }
+        return entry.pose;
+    }
+
+    // Frames between pose evaluations: 1, 2, 4, or 0 (frozen)
+    uint32_t updateInterval(Registry& registry, Entity entity, float& screenSize) const {
+        if (!m_lod.enabled) return 1;
+        if (auto* renderable = registry.getRenderable(entity)) {
+            if (!renderable->visible) return 0;
+        }
+        auto* lod = registry.getLevelOfDetail(entity);
+        if (!lod || lod->screenSize <= 0.0f) return 1;
+
+        screenSize = lod->screenSize;
+        if (screenSize < m_lod.frozenSize) return 0;
+        if (screenSize < m_lod.quarterRateSize) return 4;
+        if (screenSize < m_lod.halfRateSize) return 2;
+        return 1;
+    }
+
+    // Uniformly sampled clip: one frame index and blend factor serve every
+    // track, and each joint's matrix is built straight from its TRS
+    static void sampleCompressed(const CompressedClip& clip, float time, Skeleton& skeleton, const uint8_t* skipJoints) {
+        uint32_t f0, f1;
+        float alpha;
+        compressedFrame(clip, time, f0, f1, alpha);
+
+        const int jointCount = static_cast<int>(skeleton.jointCount());
+        for (const CompressedTrack& track : clip.tracks) {
+            if (track.jointIndex < 0 || track.jointIndex >= jointCount) continue;
+            if (skipJoints && skipJoints[track.jointIndex]) continue;
+
+            glm::quat rotation;
+            glm::vec3 translation, scale;
+            sampleCompressedTrack(clip, track, f0, f1, alpha, rotation, translation, scale);
+
+            glm::mat4 local = glm::mat4_cast(rotation);  // T * R * S
+            local[0] *= scale.x;
+            local[1] *= scale.y;
+            local[2] *= scale.z;
+            local[3] = glm::vec4(translation, 1.0f);
+            skeleton.localTransforms[track.jointIndex] = local;
+        }
+    }
+
+    static void sampleChannels(const AnimationClip& clip, float time, Skeleton& skeleton, const uint8_t* skipJoints,
+                               std::vector<KeyframeCursor>& cursors) {
+        for (size_t c = 0; c < clip.channels.size(); ++c) {
+            const AnimationChannel& channel = clip.channels[c];
+            if (channel.jointIndex < 0 || channel.jointIndex >= static_cast<int>(skeleton.jointCount())) continue;
+            if (skipJoints && skipJoints[channel.jointIndex]) continue;
+
+            skeleton.localTransforms[channel.jointIndex] = interpolateTransform(channel, time, cursors[c]);
+        }
+    }
+
+    // Keys the cursor steps forward before giving up and binary searching
+    static constexpr uint32_t MAX_CURSOR_STEPS = 4;
+
+    // Finds the first key interval [i0, i1] containing t. `cursor` is the i0 of
+    // the previous lookup on this track: playing forward usually leaves t in the
+    // same or the next interval, so it is stepped forward a few keys; loops,
+    // seeks and long jumps binary search instead. Keys are strictly increasing
+    // (glTF), so both find the same interval a scan from key 0 would.
+    static bool findKeyframes(const std::vector<float>& times, float t, uint32_t& cursor,
+                              size_t& i0, size_t& i1, float& factor) {
         if (times.empty()) return false;
         if (times.size() == 1) {
             i0 = i1 = 0;
@@ -37,25 +230,37 @@ private:
             return true;
         }
         if (t <= times[0]) {
+            cursor = 0;
             i0 = i1 = 0;
             factor = 0.0f;
             return true;
         }
-        for (size_t i = 0; i < times.size() - 1; ++i) {
-            if (t >= times[i] && t <= times[i + 1]) {
-                i0 = i;
-                i1 = i + 1;
-                float dt = times[i1] - times[i0];
-                factor = (dt > 0.0f) ? (t - times[i0]) / dt : 0.0f;
-                return true;
-            }
+        const size_t last = times.size() - 1;
+        if (!(t <= times[last])) {
+            cursor = static_cast<uint32_t>(last);
+            i0 = i1 = last;
+            factor = 0.0f;
+            return true;
+        }
+
+        // times[0] < t <= times[last]: the interval is i with times[i] < t <= times[i + 1]
+        size_t i = std::min<size_t>(cursor, last - 1);
+        if (times[i] < t) {
+            for (uint32_t step = 0; step < MAX_CURSOR_STEPS && times[i + 1] < t; ++step) ++i;
         }
-        i0 = i1 = times.size() - 1;
-        factor = 0.0f;
+        if (!(times[i] < t && t <= times[i + 1])) {
+            i = static_cast<size_t>(std::lower_bound(times.begin() + 1, times.end(), t) - times.begin()) - 1;
+        }
+        cursor = static_cast<uint32_t>(i);
+
+        i0 = i;
+        i1 = i + 1;
+        float dt = times[i1] - times[i0];
+        factor = (dt > 0.0f) ? (t - times[i0]) / dt : 0.0f;
         return true;
     }
 
-    static glm::mat4 interpolateTransform(const AnimationChannel& channel, float time) {
+    static glm::mat4 interpolateTransform(const AnimationChannel& channel, float time, KeyframeCursor& cursor) {
         glm::vec3 translation(0.0f);
         glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
         glm::vec3 scale(1.0f);
@@ -64,7 +269,7 @@ private:
         float factor;
 
         if (!channel.translations.empty() && !channel.translationTimes.empty()) {
-            if (findKeyframes(channel.translationTimes, time, i0, i1, factor)) {
+            if (findKeyframes(channel.translationTimes, time, cursor.translation, i0, i1, factor)) {
                 if (i0 < channel.translations.size() && i1 < channel.translations.size()) {
                     translation = glm::mix(channel.translations[i0], channel.translations[i1], factor);
                 }
@@ -72,7 +277,7 @@ private:
         }
 
         if (!channel.rotations.empty() && !channel.rotationTimes.empty()) {
-            if (findKeyframes(channel.rotationTimes, time, i0, i1, factor)) {
+            if (findKeyframes(channel.rotationTimes, time, cursor.rotation, i0, i1, factor)) {
                 if (i0 < channel.rotations.size() && i1 < channel.rotations.size()) {
                     rotation = glm::slerp(channel.rotations[i0], channel.rotations[i1], factor);
                 }
@@ -80,7 +285,7 @@ private:
         }
 
         if (!channel.scales.empty() && !channel.scaleTimes.empty()) {
-            if (findKeyframes(channel.scaleTimes, time, i0, i1, factor)) {
+            if (findKeyframes(channel.scaleTimes, time, cursor.scale, i0, i1, factor)) {
                 if (i0 < channel.scales.size() && i1 < channel.scales.size()) {
                     scale = glm::mix(channel.scales[i0], channel.scales[i1], factor);
                 }
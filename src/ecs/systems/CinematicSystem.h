@@ -1,6 +1,7 @@
 #pragma once
 #include "../../NurbsCurve.h"
 #include "../Registry.h"
+#include "../../core/CpuProfiler.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -56,6 +57,7 @@ public:
     }
 
     bool update(Registry& registry, float dt) {
+        CPU_PROFILE_ZONE("CinematicSystem");
         if (!m_isPlaying) return false;
 
         m_progress += dt / m_duration;
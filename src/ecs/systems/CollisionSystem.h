@@ -1,9 +1,11 @@
 #pragma once
 #include "../Registry.h"
+#include "../../core/CpuProfiler.h"
 
 class CollisionSystem {
 public:
     void update(Registry& registry) {
+        CPU_PROFILE_ZONE("CollisionSystem");
         // Check each rigid body against all box colliders
         registry.forEachRigidBody([&](Entity rbEntity, Transform& rbTransform, RigidBody& rb) {
             if (rb.grounded) return;
@@ -1,6 +1,7 @@
 #pragma once
 #include "../Registry.h"
 #include "../../culling/BuildingCuller.h"
+#include "../../core/CpuProfiler.h"
 #include <glm/glm.hpp>
 
 class FollowCameraSystem {
@@ -9,6 +10,7 @@ public:
     static constexpr float COLLISION_OFFSET = 0.5f;
 
     void update(Registry& registry) {
+        CPU_PROFILE_ZONE("FollowCameraSystem");
         registry.forEachFollowTarget([&](Entity camEntity, Transform& camTransform, FollowTarget& ft) {
             if (ft.target == NULL_ENTITY) return;
 
@@ -22,6 +24,7 @@ public:
 
     // Update with camera collision against buildings
     void updateWithCollision(Registry& registry, const BuildingCuller& culler, const AABB* extraAABB = nullptr) {
+        CPU_PROFILE_ZONE("FollowCameraSystem");
         registry.forEachFollowTarget([&](Entity camEntity, Transform& camTransform, FollowTarget& ft) {
             if (ft.target == NULL_ENTITY) return;
 
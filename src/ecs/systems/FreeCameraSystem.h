@@ -1,5 +1,6 @@
 #pragma once
 #include "../Registry.h"
+#include "../../core/CpuProfiler.h"
 #include <SDL3/SDL.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -7,6 +8,7 @@
 class FreeCameraSystem {
 public:
     void update(Registry& registry, float dt, int mouseDeltaX, int mouseDeltaY) {
+        CPU_PROFILE_ZONE("FreeCameraSystem");
         const bool* keys = SDL_GetKeyboardState(nullptr);
 
         Entity camEntity = registry.getActiveCamera();
@@ -5,6 +5,7 @@ struct InputState {
     int mouseX = 0;
     int mouseY = 0;
     bool quit = false;
+    bool activity = false;  // Any user input this frame (keys, mouse, window)
 
     // Key press events (single frame)
     bool upPressed = false;
@@ -15,6 +16,7 @@ struct InputState {
     bool escapePressed = false;
     bool pPressed = false;
     bool fPressed = false;
+    bool profilePressed = false;  // F9: CPU profiler capture
 };
 
 class InputSystem {
@@ -31,6 +33,11 @@ public:
             if (event.type == SDL_EVENT_QUIT) {
                 state.quit = true;
             }
+            if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_MOUSE_MOTION ||
+                event.type == SDL_EVENT_MOUSE_BUTTON_DOWN ||
+                (event.type >= SDL_EVENT_WINDOW_FIRST && event.type <= SDL_EVENT_WINDOW_LAST)) {
+                state.activity = true;
+            }
             if (event.type == SDL_EVENT_KEY_DOWN) {
                 switch (event.key.key) {
                     case SDLK_ESCAPE:
@@ -57,6 +64,9 @@ public:
                     case SDLK_F:
                         state.fPressed = true;
                         break;
+                    case SDLK_F9:
+                        state.profilePressed = true;
+                        break;
                 }
             }
             if (event.type == SDL_EVENT_MOUSE_MOTION) {
@@ -0,0 +1,88 @@
+#pragma once
+#include "../Registry.h"
+#include "../../core/CpuProfiler.h"
+#include <glm/glm.hpp>
+#include <cfloat>
+
+// Picks the LevelOfDetail level of every entity in one pass over the LOD
+// components. Each level is chosen by the projected diameter of the entity's
+// bounding sphere; a switch only swaps which referenced MeshGroup is drawn.
+class LODSystem {
+public:
+    // pixelScale: pixels covered by one world unit at distance 1 (lodPixelScale)
+    void update(Registry& registry, const glm::vec3& viewPos, float pixelScale, float dt) {
+        CPU_PROFILE_ZONE("LODSystem");
+        registry.forEachLevelOfDetail([&](Entity entity, Transform& transform, LevelOfDetail& lod) {
+            if (lod.levels.empty()) return;
+
+            // Advance the cross-fade of the last switch
+            if (lod.previous >= 0) {
+                lod.fade = (lod.crossFadeTime > 0.0f) ? lod.fade + dt / lod.crossFadeTime : 1.0f;
+                if (lod.fade >= 1.0f) {
+                    lod.previous = -1;
+                    lod.fade = 1.0f;
+                }
+            }
+
+            bool firstSelection = (lod.screenSize == 0.0f);
+            glm::vec3 center = lod.boundsCenter;
+            if (auto* renderable = registry.getRenderable(entity)) center += renderable->meshOffset;
+            glm::vec3 worldCenter = glm::vec3(transform.matrix() * glm::vec4(center, 1.0f));
+            float scale = glm::max(transform.scale.x, glm::max(transform.scale.y, transform.scale.z));
+            float distance = glm::max(glm::length(worldCenter - viewPos), 1e-3f);
+            float sizePerDistance = 2.0f * lod.boundsRadius * scale * pixelScale;
+            lod.screenSize = sizePerDistance / distance;
+
+            int level = residentLevel(lod, selectLevel(lod, lod.screenSize, sizePerDistance));
+            if (level == lod.current) return;
+
+            if (lod.crossFadeTime <= 0.0f || firstSelection) {
+                lod.previous = -1;
+                lod.fade = 1.0f;
+            } else if (level == lod.previous) {
+                lod.fade = 1.0f - lod.fade;  // Switching back mid-fade: reverse it
+                lod.previous = lod.current;
+            } else {
+                lod.previous = lod.current;
+                lod.fade = 0.0f;
+            }
+            lod.current = level;
+        });
+    }
+
+private:
+    // Thresholds of levels at or above the current one are widened and those
+    // below narrowed by the hysteresis band, so a size hovering around a
+    // threshold does not flip levels every frame. A distance switch becomes a
+    // size at the current pixel scale (sizePerDistance = size at distance 1)
+    // and overtakes finer levels that would switch at a smaller size; the
+    // levels after it never switch at a larger size than it does.
+    static int selectLevel(const LevelOfDetail& lod, float screenSize, float sizePerDistance) {
+        int level = 0;
+        float threshold = FLT_MAX;
+        for (int i = 1; i < static_cast<int>(lod.levels.size()); ++i) {
+            const LODLevel& candidate = lod.levels[i];
+            threshold = (candidate.switchDistance > 0.0f) ? sizePerDistance / candidate.switchDistance
+                                                          : glm::min(threshold, candidate.screenSize);
+            float band = (i <= lod.current) ? 1.0f + lod.hysteresis : 1.0f - lod.hysteresis;
+            if (screenSize < threshold * band) level = i;
+        }
+        return level;
+    }
+
+    // Levels whose model is still streaming in have no meshes: fall back to
+    // the nearest coarser resident level, then the nearest finer one
+    static int residentLevel(const LevelOfDetail& lod, int level) {
+        auto isResident = [&](int i) {
+            const MeshGroup* meshGroup = lod.levels[i].meshGroup;
+            return meshGroup && !meshGroup->meshes.empty();
+        };
+        for (int i = level; i < static_cast<int>(lod.levels.size()); ++i) {
+            if (isResident(i)) return i;
+        }
+        for (int i = level - 1; i >= 0; --i) {
+            if (isResident(i)) return i;
+        }
+        return level;
+    }
+};
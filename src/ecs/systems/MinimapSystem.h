@@ -2,6 +2,8 @@
 #include "../../Shader.h"
 #include "../../ui/FontManager.h"
 #include "../../ui/TextCache.h"
+#include "../../rendering/GpuProfiler.h"
+#include "../../core/CpuProfiler.h"
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -24,6 +26,8 @@ public:
                 const glm::vec3& playerPos = glm::vec3(0.0f), const std::vector<glm::vec3>& markerPositions = {},
                 const std::vector<std::pair<glm::vec2, glm::vec2>>& buildingFootprints = {},
                 const std::vector<glm::vec3>& monsterPositions = {}) {
+        CPU_PROFILE_ZONE("MinimapSystem");
+        GPU_PROFILE_SCOPE("Minimap");
         glm::mat4 projection = glm::ortho(0.0f, (float)screenWidth, 0.0f, (float)screenHeight);
 
         float radius = 80.0f;
@@ -73,6 +77,8 @@ public:
 
     // Overload for backward compatibility (GodMode uses this)
     void render(int screenWidth, int screenHeight) {
+        CPU_PROFILE_ZONE("MinimapSystem");
+        GPU_PROFILE_SCOPE("Minimap");
         // Simplified render without cardinal text - just draw circle and player dot
         glm::mat4 projection = glm::ortho(0.0f, (float)screenWidth, 0.0f, (float)screenHeight);
 
@@ -1,9 +1,11 @@
 #pragma once
 #include "../Registry.h"
+#include "../../core/CpuProfiler.h"
 
 class PhysicsSystem {
 public:
     void update(Registry& registry, float dt) {
+        CPU_PROFILE_ZONE("PhysicsSystem");
         registry.forEachRigidBody([&](Entity entity, Transform& transform, RigidBody& rb) {
             if (rb.grounded) return;
 
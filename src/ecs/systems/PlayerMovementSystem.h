@@ -3,6 +3,7 @@
 #include "../../culling/BuildingCuller.h"
 #include "../../culling/Octree.h"
 #include "../../procedural/BuildingGenerator.h"
+#include "../../core/CpuProfiler.h"
 #include <SDL3/SDL.h>
 #include <glm/gtc/quaternion.hpp>
 
@@ -15,6 +16,7 @@ public:
     static constexpr float COLLISION_QUERY_RADIUS = 15.0f;
 
     void update(Registry& registry, float dt, const BuildingCuller* buildingCuller = nullptr, const AABB* extraAABB = nullptr) {
+        CPU_PROFILE_ZONE("PlayerMovementSystem");
         const bool* keys = SDL_GetKeyboardState(nullptr);
 
         registry.forEachPlayerController([&](Entity entity, Transform& transform, PlayerController& pc) {
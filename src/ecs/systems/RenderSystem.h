@@ -1,7 +1,16 @@
 #pragma once
 #include "../Registry.h"
 #include "../../Shader.h"
+#include "../../rendering/MeshUniforms.h"
+#include "../../rendering/VertexAnimationRenderer.h"
+#include "../../rendering/GpuProfiler.h"
+#include "../../core/CpuProfiler.h"
 #include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
 
 class RenderSystem {
 public:
@@ -9,6 +18,7 @@ public:
         m_colorShader.loadFromFiles("shaders/color.vert", "shaders/color.frag");
         m_modelShader.loadFromFiles("shaders/model.vert", "shaders/model.frag");
         m_skinnedShader.loadFromFiles("shaders/skinned.vert", "shaders/model.frag");
+        m_vertexAnimationShader.loadFromFiles("shaders/vertex_animation.vert", "shaders/model.frag");
         m_terrainShader.loadFromFiles("shaders/terrain.vert", "shaders/terrain.frag");
     }
 
@@ -19,6 +29,9 @@ public:
     void setShadowMap(GLuint texture) { m_shadowMap = texture; }
     void setLightSpaceMatrix(const glm::mat4& matrix) { m_lightSpaceMatrix = matrix; }
 
+    // Write per-object motion (model matrix + skinning deltas) to the velocity attachment
+    void setVelocityEnabled(bool enabled) { m_velocityEnabled = enabled; }
+
     void update(Registry& registry, float aspectRatio) {
         Entity camEntity = registry.getActiveCamera();
         if (camEntity == NULL_ENTITY) return;
@@ -46,109 +59,248 @@ public:
         }
 
         glm::mat4 projection = cam->projectionMatrix(aspectRatio);
-        glm::vec3 lightDir = glm::normalize(glm::vec3(0.5f, 1.0f, 0.3f));
+        renderEntities(registry, view, projection, camTransform->position);
+    }
 
-        registry.forEachRenderable([&](Entity entity, Transform& transform, MeshGroup& meshGroup, Renderable& renderable) {
-            if (!renderable.visible) return;  // Skip culled entities
+    void updateWithView(Registry& registry, float aspectRatio, const glm::mat4& view) {
+        Entity camEntity = registry.getActiveCamera();
+        if (camEntity == NULL_ENTITY) return;
 
-            Shader* shader = getShader(renderable.shader);
-            if (!shader) return;
+        auto* cam = registry.getCamera(camEntity);
+        auto* camTransform = registry.getTransform(camEntity);
+        if (!cam || !camTransform) return;
 
-            shader->use();
-            shader->setMat4("uView", view);
-            shader->setMat4("uProjection", projection);
+        glm::mat4 projection = cam->projectionMatrix(aspectRatio);
+        renderEntities(registry, view, projection, camTransform->position);
+    }
 
-            glm::mat4 model = transform.matrix();
-            if (renderable.meshOffset != glm::vec3(0.0f)) {
-                model = model * glm::translate(glm::mat4(1.0f), renderable.meshOffset);
-            }
-            shader->setMat4("uModel", model);
+private:
+    Shader m_colorShader;
+    Shader m_modelShader;
+    Shader m_skinnedShader;
+    Shader m_terrainShader;
+    Shader m_vertexAnimationShader;
+    VertexAnimationRenderer m_vertexAnimations;  // Skinned entities with an active VertexAnimation
+    bool m_fogEnabled = false;
+    float m_fogDensity = -1.0f;  // -1 means use shader default
+    glm::vec3 m_fogColor = glm::vec3(-1.0f);  // -1 means use shader default
+    bool m_shadowsEnabled = false;
+    GLuint m_shadowMap = 0;
+    glm::mat4 m_lightSpaceMatrix = glm::mat4(1.0f);
 
-            bool hasTexture = false;
-            for (const auto& mesh : meshGroup.meshes) {
-                if (mesh.texture) { hasTexture = true; break; }
-            }
+    // Previous-frame state per entity for the velocity buffer. Entities not
+    // drawn for a frame are dropped after the next one.
+    struct MotionHistory {
+        glm::mat4 model = glm::mat4(1.0f);
+        GLintptr bonesOffset = 0;  // This frame's skinning matrices in the bone ring
+        size_t boneCount = 0;      // 0 = none recorded
+        uint64_t frame = 0;
+    };
+    std::unordered_map<Entity, MotionHistory> m_motionHistory;
+    uint64_t m_frameIndex = 1;
+    bool m_velocityEnabled = false;
+
+    // Bone ring: every skinned draw writes its skinning matrices into one
+    // persistently mapped buffer, a segment per frame, and the next frame binds
+    // that range at SSBO binding 0 as its previous pose, so nothing is copied
+    // on the CPU and no draw waits on a shared buffer. A segment is rewritten
+    // once the GPU is done with the frame that read it (fenced); a segment
+    // that overflows grows the ring at the start of the next frame.
+    static constexpr size_t BONE_RING_SEGMENTS = 3;
+    static constexpr size_t BONE_RING_ALIGNMENT = 256;  // Largest GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT allowed
+    static constexpr size_t BONE_RING_MIN_SEGMENT_BYTES = 256 * 1024;
+    GLuint m_boneRing = 0;
+    unsigned char* m_boneRingMapped = nullptr;
+    size_t m_boneRingSegmentBytes = 0;
+    size_t m_boneRingSegment = 0;
+    size_t m_boneRingUsed = 0;
+    size_t m_boneRingRequested = 0;  // Bytes this frame asked for, including any that did not fit
+    GLsync m_boneRingFences[BONE_RING_SEGMENTS] = {};
+
+    void waitBoneRingFence(size_t segment) {
+        GLsync& fence = m_boneRingFences[segment];
+        if (!fence) return;
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
 
-            if (renderable.shader == ShaderType::Model || renderable.shader == ShaderType::Skinned) {
-                shader->setVec3("uLightDir", lightDir);
-                shader->setVec3("uViewPos", camTransform->position);
-                shader->setInt("uTexture", 0);
-                shader->setInt("uHasTexture", hasTexture ? 1 : 0);
-                shader->setInt("uFogEnabled", m_fogEnabled ? 1 : 0);
-                if (m_fogDensity >= 0.0f) shader->setFloat("uFogDensity", m_fogDensity);
-                if (m_fogColor.r >= 0.0f) shader->setVec3("uFogColor", m_fogColor);
-                shader->setInt("uShadowsEnabled", m_shadowsEnabled ? 1 : 0);
-                shader->setMat4("uLightSpaceMatrix", m_lightSpaceMatrix);
-                shader->setInt("uTriplanarMapping", renderable.triplanarMapping ? 1 : 0);
-                shader->setFloat("uTextureScale", renderable.textureScale);
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, m_shadowMap);
-                shader->setInt("uShadowMap", 1);
+    void beginBoneRing() {
+        if (!m_velocityEnabled) {
+            m_boneRingUsed = 0;
+            m_boneRingRequested = 0;
+            return;
+        }
+        if (!m_boneRing || m_boneRingRequested > m_boneRingSegmentBytes) {
+            const size_t segmentBytes = std::max(BONE_RING_MIN_SEGMENT_BYTES, m_boneRingRequested * 3 / 2);
+            for (size_t i = 0; i < BONE_RING_SEGMENTS; ++i) waitBoneRingFence(i);
+            if (m_boneRing) {
+                glUnmapNamedBuffer(m_boneRing);
+                glDeleteBuffers(1, &m_boneRing);
             }
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            const GLsizeiptr totalBytes = static_cast<GLsizeiptr>(segmentBytes * BONE_RING_SEGMENTS);
+            glCreateBuffers(1, &m_boneRing);
+            glNamedBufferStorage(m_boneRing, totalBytes, nullptr, flags);
+            m_boneRingMapped = static_cast<unsigned char*>(glMapNamedBufferRange(m_boneRing, 0, totalBytes, flags));
+            m_boneRingSegmentBytes = m_boneRingMapped ? segmentBytes : 0;
+            for (auto& [entity, history] : m_motionHistory) history.boneCount = 0;  // Old ranges are gone
+        }
 
-            if (renderable.shader == ShaderType::Skinned) {
-                auto* skeleton = registry.getSkeleton(entity);
-                shader->setInt("uUseSkinning", (skeleton && !skeleton->boneMatrices.empty()) ? 1 : 0);
-                if (skeleton && !skeleton->boneMatrices.empty()) {
-                    shader->setMat4Array("uBones", skeleton->boneMatrices);
-                }
-            }
+        // Segment k was last read by the frame that wrote k + 1
+        m_boneRingSegment = (m_boneRingSegment + 1) % BONE_RING_SEGMENTS;
+        waitBoneRingFence((m_boneRingSegment + 1) % BONE_RING_SEGMENTS);
+        waitBoneRingFence(m_boneRingSegment);
+        m_boneRingUsed = 0;
+        m_boneRingRequested = 0;
+    }
 
-            if (renderable.shader == ShaderType::Terrain) {
-                shader->setVec3("uLightDir", lightDir);
-                shader->setVec3("uViewPos", camTransform->position);
-            }
+    void endBoneRing() {
+        if (!m_velocityEnabled || m_boneRingUsed == 0) return;
+        GLsync& fence = m_boneRingFences[m_boneRingSegment];
+        if (fence) glDeleteSync(fence);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
 
-            for (const auto& mesh : meshGroup.meshes) {
-                if (mesh.texture) {
-                    glActiveTexture(GL_TEXTURE0);
-                    glBindTexture(GL_TEXTURE_2D, mesh.texture);
-                }
+    // Offset of the written matrices, or -1 if this frame's segment is full
+    GLintptr writeBoneRing(const std::vector<glm::mat4>& bones) {
+        const size_t size = bones.size() * sizeof(glm::mat4);
+        const size_t aligned = (size + BONE_RING_ALIGNMENT - 1) / BONE_RING_ALIGNMENT * BONE_RING_ALIGNMENT;
+        m_boneRingRequested += aligned;
+        if (!m_boneRingMapped || m_boneRingUsed + aligned > m_boneRingSegmentBytes) return -1;
+
+        const size_t offset = m_boneRingSegment * m_boneRingSegmentBytes + m_boneRingUsed;
+        std::memcpy(m_boneRingMapped + offset, bones.data(), size);
+        m_boneRingUsed += aligned;
+        return static_cast<GLintptr>(offset);
+    }
 
-                if (mesh.normalMap) {
-                    glActiveTexture(GL_TEXTURE2);
-                    glBindTexture(GL_TEXTURE_2D, mesh.normalMap);
-                    shader->setInt("uNormalMap", 2);
-                    shader->setInt("uHasNormalMap", 1);
-                } else {
-                    shader->setInt("uHasNormalMap", 0);
-                }
+    // Binds last frame's matrices (or this frame's when there are none) as
+    // uPrevBones and records this frame's for the next. False if neither is
+    // available, so the draw has no skinning motion.
+    bool bindPrevBones(MotionHistory& history, bool historyValid, const std::vector<glm::mat4>& bones) {
+        const GLintptr current = writeBoneRing(bones);
+        const GLsizeiptr size = static_cast<GLsizeiptr>(bones.size() * sizeof(glm::mat4));
+        bool bound = true;
+        if (historyValid && history.boneCount == bones.size()) {
+            glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, m_boneRing, history.bonesOffset, size);
+        } else if (current >= 0) {
+            glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, m_boneRing, current, size);
+        } else {
+            bound = false;
+        }
+        history.bonesOffset = current;
+        history.boneCount = (current >= 0) ? bones.size() : 0;
+        return bound;
+    }
 
-                glBindVertexArray(mesh.vao);
-                glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr);
+    void drawMeshes(Shader& shader, const MeshGroup& meshGroup) {
+        for (const auto& mesh : meshGroup.meshes) {
+            if (mesh.texture) {
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, mesh.texture);
             }
-        });
 
-        glBindVertexArray(0);
+            if (mesh.normalMap) {
+                glActiveTexture(GL_TEXTURE2);
+                glBindTexture(GL_TEXTURE_2D, mesh.normalMap);
+                shader.setInt("uNormalMap", 2);
+                shader.setInt("uHasNormalMap", 1);
+            } else {
+                shader.setInt("uHasNormalMap", 0);
+            }
+
+            setMeshPositionDequant(shader, mesh);
+            glBindVertexArray(mesh.vao);
+            glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr);
+        }
     }
 
-    void updateWithView(Registry& registry, float aspectRatio, const glm::mat4& view) {
-        Entity camEntity = registry.getActiveCamera();
-        if (camEntity == NULL_ENTITY) return;
+    // Queue a skinned entity whose VertexAnimation is active instead of drawing
+    // it; false if it has to be skinned after all
+    bool queueVertexAnimation(Registry& registry, Entity entity, const glm::mat4& model, const MeshGroup& meshGroup) {
+        auto* vertexAnimation = registry.getVertexAnimation(entity);
+        auto* anim = registry.getAnimation(entity);
+        if (!vertexAnimation || !vertexAnimation->active || !vertexAnimation->set || !anim) return false;
+
+        MotionHistory& history = m_motionHistory[entity];
+        bool historyValid = (history.frame + 1 == m_frameIndex);
+        if (!m_vertexAnimations.addInstance(meshGroup, *vertexAnimation->set, model,
+                                            historyValid ? history.model : model, anim->clipIndex, anim->time,
+                                            historyValid ? vertexAnimation->prevTime : anim->time)) {
+            // Drawn skinned after all (its MeshGroup is already batched with another set)
+            vertexAnimation->reject();
+            return false;
+        }
+        history.model = model;
+        history.frame = m_frameIndex;
+        history.boneCount = 0;  // Skinning restarts without a previous pose
+        return true;
+    }
 
-        auto* cam = registry.getCamera(camEntity);
-        auto* camTransform = registry.getTransform(camEntity);
-        if (!cam || !camTransform) return;
+    void drawVertexAnimations(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos,
+                              const glm::vec3& lightDir) {
+        if (m_vertexAnimations.getInstanceCount() == 0) return;
+
+        Shader& shader = m_vertexAnimationShader;
+        shader.use();
+        shader.setMat4("uView", view);
+        shader.setMat4("uProjection", projection);
+        shader.setInt("uVelocityEnabled", m_velocityEnabled ? 1 : 0);
+        shader.setVec3("uLightDir", lightDir);
+        shader.setVec3("uViewPos", viewPos);
+        shader.setInt("uTexture", 0);
+        shader.setInt("uFogEnabled", m_fogEnabled ? 1 : 0);
+        if (m_fogDensity >= 0.0f) shader.setFloat("uFogDensity", m_fogDensity);
+        if (m_fogColor.r >= 0.0f) shader.setVec3("uFogColor", m_fogColor);
+        shader.setInt("uShadowsEnabled", m_shadowsEnabled ? 1 : 0);
+        shader.setMat4("uLightSpaceMatrix", m_lightSpaceMatrix);
+        shader.setInt("uTriplanarMapping", 0);
+        shader.setFloat("uLodFade", 0.0f);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, m_shadowMap);
+        shader.setInt("uShadowMap", 1);
+
+        m_vertexAnimations.draw(shader, true);
+    }
 
-        glm::mat4 projection = cam->projectionMatrix(aspectRatio);
+    void renderEntities(Registry& registry, const glm::mat4& view, const glm::mat4& projection,
+                        const glm::vec3& viewPos) {
+        CPU_PROFILE_ZONE("RenderSystem");
+        GPU_PROFILE_SCOPE("Models");
         glm::vec3 lightDir = glm::normalize(glm::vec3(0.5f, 1.0f, 0.3f));
+        m_vertexAnimations.beginFrame();
+        beginBoneRing();
 
-        registry.forEachRenderable([&](Entity entity, Transform& transform, MeshGroup& meshGroup, Renderable& renderable) {
+        registry.forEachRenderable([&](Entity entity, Transform& transform, const MeshGroup& meshGroup, Renderable& renderable) {
             if (!renderable.visible) return;  // Skip culled entities
 
             Shader* shader = getShader(renderable.shader);
             if (!shader) return;
 
-            shader->use();
-            shader->setMat4("uView", view);
-            shader->setMat4("uProjection", projection);
-
             glm::mat4 model = transform.matrix();
             if (renderable.meshOffset != glm::vec3(0.0f)) {
                 model = model * glm::translate(glm::mat4(1.0f), renderable.meshOffset);
             }
+
+            // Distant crowd members are batched and drawn from their baked frames after the loop
+            if (renderable.shader == ShaderType::Skinned && queueVertexAnimation(registry, entity, model, meshGroup)) return;
+
+            shader->use();
+            shader->setMat4("uView", view);
+            shader->setMat4("uProjection", projection);
             shader->setMat4("uModel", model);
 
+            // History is only valid if it was recorded on the previous frame
+            MotionHistory& history = m_motionHistory[entity];
+            bool historyValid = (history.frame + 1 == m_frameIndex);
+            if (renderable.shader == ShaderType::Model || renderable.shader == ShaderType::Skinned) {
+                shader->setInt("uVelocityEnabled", m_velocityEnabled ? 1 : 0);
+                shader->setMat4("uPrevModel", historyValid ? history.model : model);
+            }
+            history.model = model;
+            history.frame = m_frameIndex;
+
             bool hasTexture = false;
             for (const auto& mesh : meshGroup.meshes) {
                 if (mesh.texture) { hasTexture = true; break; }
@@ -156,7 +308,7 @@ public:
 
             if (renderable.shader == ShaderType::Model || renderable.shader == ShaderType::Skinned) {
                 shader->setVec3("uLightDir", lightDir);
-                shader->setVec3("uViewPos", camTransform->position);
+                shader->setVec3("uViewPos", viewPos);
                 shader->setInt("uTexture", 0);
                 shader->setInt("uHasTexture", hasTexture ? 1 : 0);
                 shader->setInt("uFogEnabled", m_fogEnabled ? 1 : 0);
@@ -173,52 +325,51 @@ public:
 
             if (renderable.shader == ShaderType::Skinned) {
                 auto* skeleton = registry.getSkeleton(entity);
-                shader->setInt("uUseSkinning", (skeleton && !skeleton->boneMatrices.empty()) ? 1 : 0);
-                if (skeleton && !skeleton->boneMatrices.empty()) {
-                    shader->setMat4Array("uBones", skeleton->boneMatrices);
+                shader->setInt("uUseSkinning", (skeleton && !skeleton->skinningMatrices().empty()) ? 1 : 0);
+                if (skeleton && !skeleton->skinningMatrices().empty()) {
+                    const std::vector<glm::mat4>& bones = skeleton->skinningMatrices();
+                    shader->setMat4Array("uBones", bones);
+
+                    if (m_velocityEnabled) {
+                        if (!bindPrevBones(history, historyValid, bones)) shader->setInt("uVelocityEnabled", 0);
+                    } else {
+                        history.boneCount = 0;
+                    }
                 }
             }
 
             if (renderable.shader == ShaderType::Terrain) {
                 shader->setVec3("uLightDir", lightDir);
-                shader->setVec3("uViewPos", camTransform->position);
+                shader->setVec3("uViewPos", viewPos);
             }
 
-            for (const auto& mesh : meshGroup.meshes) {
-                if (mesh.texture) {
-                    glActiveTexture(GL_TEXTURE0);
-                    glBindTexture(GL_TEXTURE_2D, mesh.texture);
-                }
-
-                if (mesh.normalMap) {
-                    glActiveTexture(GL_TEXTURE2);
-                    glBindTexture(GL_TEXTURE_2D, mesh.normalMap);
-                    shader->setInt("uNormalMap", 2);
-                    shader->setInt("uHasNormalMap", 1);
-                } else {
-                    shader->setInt("uHasNormalMap", 0);
-                }
-
-                glBindVertexArray(mesh.vao);
-                glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr);
+            // Cross-fading LOD: the outgoing level fills the complement of the incoming one's dither
+            bool litShader = (renderable.shader == ShaderType::Model || renderable.shader == ShaderType::Skinned);
+            auto* lod = registry.getLevelOfDetail(entity);
+            const MeshGroup* fadingMeshGroup = lod ? lod->fadingMeshGroup() : nullptr;
+            if (litShader && fadingMeshGroup) {
+                shader->setFloat("uLodFade", lod->fade - 1.0f);
+                drawMeshes(*shader, *fadingMeshGroup);
+                shader->setFloat("uLodFade", glm::max(lod->fade, 1.0f / 32.0f));
+            } else if (litShader) {
+                shader->setFloat("uLodFade", 0.0f);
             }
+
+            drawMeshes(*shader, meshGroup);
         });
 
+        drawVertexAnimations(view, projection, viewPos, lightDir);
+        endBoneRing();
+
+        // Despawned or long-culled entities
+        for (auto it = m_motionHistory.begin(); it != m_motionHistory.end();) {
+            it = (it->second.frame + 1 < m_frameIndex) ? m_motionHistory.erase(it) : std::next(it);
+        }
+
         glBindVertexArray(0);
+        ++m_frameIndex;
     }
 
-private:
-    Shader m_colorShader;
-    Shader m_modelShader;
-    Shader m_skinnedShader;
-    Shader m_terrainShader;
-    bool m_fogEnabled = false;
-    float m_fogDensity = -1.0f;  // -1 means use shader default
-    glm::vec3 m_fogColor = glm::vec3(-1.0f);  // -1 means use shader default
-    bool m_shadowsEnabled = false;
-    GLuint m_shadowMap = 0;
-    glm::mat4 m_lightSpaceMatrix = glm::mat4(1.0f);
-
     Shader* getShader(ShaderType type) {
         switch (type) {
             case ShaderType::Color: return &m_colorShader;
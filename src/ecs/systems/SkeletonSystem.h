@@ -1,29 +1,38 @@
 #pragma once
 #include "../Registry.h"
+#include "../../core/CpuProfiler.h"
 
 class SkeletonSystem {
 public:
     void update(Registry& registry) {
+        CPU_PROFILE_ZONE("SkeletonSystem");
         registry.forEachSkeleton([](Entity entity, Skeleton& skeleton) {
-            if (skeleton.joints.empty()) return;
+            if (skeleton.jointCount() == 0) return;
 
-            // Ensure jointWorldTransforms is the right size
-            if (skeleton.jointWorldTransforms.size() != skeleton.joints.size()) {
-                skeleton.jointWorldTransforms.resize(skeleton.joints.size(), glm::mat4(1.0f));
-            }
+            // Skinned with a crowd pose (AnimationSystem pose sharing)
+            if (skeleton.sharedPose) return;
+
+            // Pose not re-evaluated (animation LOD, paused): the matrices still hold
+            if (!skeleton.poseChanged) return;
+            skeleton.poseChanged = false;
 
-            for (size_t i = 0; i < skeleton.joints.size(); ++i) {
-                const auto& joint = skeleton.joints[i];
+            updateMatrices(skeleton);
+        });
+    }
 
-                if (joint.parentIndex >= 0) {
-                    skeleton.jointWorldTransforms[i] = skeleton.jointWorldTransforms[joint.parentIndex] * joint.localTransform;
-                } else {
-                    skeleton.jointWorldTransforms[i] = joint.localTransform;
-                }
+    // World and skinning matrices of the current local pose
+    static void updateMatrices(Skeleton& skeleton) {
+        for (size_t i = 0; i < skeleton.jointCount(); ++i) {
+            const auto& joint = skeleton.def->joints[i];
 
-                // boneMatrices for GPU skinning (with inverseBindMatrix)
-                skeleton.boneMatrices[i] = skeleton.jointWorldTransforms[i] * joint.inverseBindMatrix;
+            if (joint.parentIndex >= 0) {
+                skeleton.jointWorldTransforms[i] = skeleton.jointWorldTransforms[joint.parentIndex] * skeleton.localTransforms[i];
+            } else {
+                skeleton.jointWorldTransforms[i] = skeleton.localTransforms[i];
             }
-        });
+
+            // boneMatrices for GPU skinning (with inverseBindMatrix)
+            skeleton.boneMatrices[i] = skeleton.jointWorldTransforms[i] * joint.inverseBindMatrix;
+        }
     }
 };
@@ -3,53 +3,50 @@
 #include "../components/DynamicTerrain.h"
 #include "../components/Mesh.h"
 #include "../../Shader.h"
+#include "../../assets/AssetLoader.h"
 #include <glad/glad.h>
-#include <stb_image.h>
 #include <algorithm>
+#include <iostream>
 #include <vector>
 #include <utility>
 
 class TerrainSystem {
 public:
-    void init() {
+    // snowTexture is AssetManager's shared "snow" texture (cooked with its mips)
+    void init(GLuint snowTexture) {
         m_shader.loadFromFiles("shaders/terrain.vert", "shaders/terrain.frag");
-        loadTexture("assets/textures/snow.jpg");
+        m_texture = snowTexture;
     }
 
     // Find vertices belonging to left/right foot and cache them
     void findFootVertices(const MeshGroup& meshGroup, const Skeleton& skeleton) {
         m_leftFootVertices.clear();
         m_rightFootVertices.clear();
+        if (!skeleton.def) return;
 
         // Find ALL foot-related joint indices (foot, toe, etc.)
-        std::vector<int> leftFootJoints, rightFootJoints;
         std::cout << "=== Joint names ===" << std::endl;
-        for (size_t i = 0; i < skeleton.jointNames.size(); ++i) {
-            const std::string& name = skeleton.jointNames[i];
-            std::cout << "  [" << i << "] " << name << std::endl;
-
-            // Check for left foot/toe bones (case insensitive matching)
-            if (name.find("Left") != std::string::npos || name.find("left") != std::string::npos ||
-                name.find("_l") != std::string::npos || name.find(".L") != std::string::npos) {
-                if (name.find("Foot") != std::string::npos || name.find("foot") != std::string::npos ||
-                    name.find("Toe") != std::string::npos || name.find("toe") != std::string::npos) {
-                    leftFootJoints.push_back(static_cast<int>(i));
-                }
-            }
-            // Check for right foot/toe bones
-            if (name.find("Right") != std::string::npos || name.find("right") != std::string::npos ||
-                name.find("_r") != std::string::npos || name.find(".R") != std::string::npos) {
-                if (name.find("Foot") != std::string::npos || name.find("foot") != std::string::npos ||
-                    name.find("Toe") != std::string::npos || name.find("toe") != std::string::npos) {
-                    rightFootJoints.push_back(static_cast<int>(i));
-                }
-            }
+        const std::vector<std::string>& jointNames = skeleton.def->jointNames;
+        for (size_t i = 0; i < jointNames.size(); ++i) {
+            std::cout << "  [" << i << "] " << jointNames[i] << std::endl;
         }
+        std::vector<int> leftFootJoints = findFootJoints(*skeleton.def, FootSide::Left);
+        std::vector<int> rightFootJoints = findFootJoints(*skeleton.def, FootSide::Right);
         std::cout << "Left foot joints: " << leftFootJoints.size() << ", Right: " << rightFootJoints.size() << std::endl;
 
-        // Find the lowest vertices that are influenced by foot bones
+        // Find the lowest vertices that are influenced by foot bones. The model
+        // normally keeps its foot vertices (GeometryRetention::FootVertices);
+        // otherwise they are read back from the vertex buffer once.
         for (const auto& mesh : meshGroup.meshes) {
-            for (const auto& v : mesh.skinnedVertices) {
+            CpuGeometry readBack;
+            const CpuGeometry* geometry = &mesh.cpuGeometry;
+            if (mesh.hasSkinning && geometry->skin.empty()) {
+                readBack = readBackCpuGeometry(mesh, GeometryRetention::FootVertices, footJointMask(*skeleton.def));
+                geometry = &readBack;
+                std::cout << "TerrainSystem: Read back " << readBack.vertexCount() << " foot vertices" << std::endl;
+            }
+            for (size_t i = 0; i < geometry->vertexCount(); ++i) {
+                const SkinnedVertex v = unpackCpuVertex(mesh, *geometry, i);
                 // Only consider vertices with low Y (near feet in bind pose)
                 if (v.position.y > 0.2f) continue;
 
@@ -117,29 +114,6 @@ public:
         return glm::vec3(worldPos);
     }
 
-    void loadTexture(const char* path) {
-        int width, height, channels;
-        // Don't flip - most textures don't need it
-        unsigned char* data = stbi_load(path, &width, &height, &channels, 0);
-        if (data) {
-            glGenTextures(1, &m_texture);
-            glBindTexture(GL_TEXTURE_2D, m_texture);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-            GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-            glGenerateMipmap(GL_TEXTURE_2D);
-
-            stbi_image_free(data);
-            std::cout << "Loaded terrain texture: " << path << " (" << width << "x" << height << ")" << std::endl;
-        } else {
-            std::cerr << "Failed to load terrain texture: " << path << std::endl;
-        }
-    }
-
     void update(DynamicTerrain& terrain, Registry& registry, float dt) {
         if (!terrain.initialized) {
             terrain.init();
@@ -343,7 +317,7 @@ private:
     }
 
     Shader m_shader;
-    GLuint m_texture = 0;
+    GLuint m_texture = 0;  // Owned by AssetManager
     glm::vec3 m_currentCenter = glm::vec3(0.0f);
     glm::vec3 m_lastPlayerPos = glm::vec3(0.0f);
 
@@ -4,6 +4,8 @@
 #include "../../ui/FontManager.h"
 #include "../../ui/TextCache.h"
 #include "../../ui/UIRenderer.h"
+#include "../../rendering/GpuProfiler.h"
+#include "../../core/CpuProfiler.h"
 #include <algorithm>
 #include <vector>
 
@@ -26,6 +28,8 @@ public:
     TextCache& textCache() { return m_textCache; }
 
     void update(Registry& registry, int screenWidth, int screenHeight) {
+        CPU_PROFILE_ZONE("UISystem");
+        GPU_PROFILE_SCOPE("UI text");
         m_renderer.beginFrame(screenWidth, screenHeight);
 
         // Collect all UI text entities and sort by layer
@@ -0,0 +1,68 @@
+#pragma once
+#include "../Registry.h"
+#include "../../core/CpuProfiler.h"
+#include <glm/glm.hpp>
+
+struct VertexAnimationSettings {
+    bool enabled = true;
+    float distance = 20.0f;    // Beyond: drawn from the baked frames instead of skinned
+    float hysteresis = 0.1f;   // Band around the distance, as a fraction of it
+};
+
+// Switches VertexAnimation entities between skinning and baked vertex
+// animation by their distance to the active camera. Runs before
+// AnimationSystem, which keeps advancing the playback time of active entities
+// but skips their pose, so switching back is seamless.
+class VertexAnimationSystem {
+public:
+    void setSettings(const VertexAnimationSettings& settings) { m_settings = settings; }
+    const VertexAnimationSettings& settings() const { return m_settings; }
+
+    // Entities drawn from baked frames after the last update
+    size_t activeCount() const { return m_activeCount; }
+
+    void update(Registry& registry) {
+        CPU_PROFILE_ZONE("VertexAnimationSystem");
+        m_activeCount = 0;
+
+        glm::vec3 viewPos(0.0f);
+        Entity camera = registry.getActiveCamera();
+        auto* cameraTransform = (camera != NULL_ENTITY) ? registry.getTransform(camera) : nullptr;
+        if (cameraTransform) viewPos = cameraTransform->position;
+
+        registry.forEachVertexAnimation([&](Entity entity, Transform& transform, Animation& anim, VertexAnimation& vat) {
+            vat.prevTime = anim.time;
+
+            bool active = false;
+            if (m_settings.enabled && cameraTransform && !vat.rejected && vat.canPlay(anim.clipIndex) &&
+                canDraw(registry, entity, vat)) {
+                const float band = vat.active ? 1.0f - m_settings.hysteresis : 1.0f + m_settings.hysteresis;
+                active = glm::length(transform.position - viewPos) > m_settings.distance * band;
+            }
+
+            // Back to skinning: AnimationSystem evaluates the pose this frame whatever its LOD
+            if (vat.active && !active) vat.poseStale = true;
+            vat.active = active;
+            if (active) ++m_activeCount;
+        });
+    }
+
+private:
+    // Whether the renderer can draw every MeshGroup the entity may use (its
+    // own and each LOD level's) from the baked frames; otherwise it would
+    // fall back to skinning with a skeleton AnimationSystem left alone
+    static bool canDraw(Registry& registry, Entity entity, const VertexAnimation& vat) {
+        if (auto* meshGroup = registry.getMeshGroup(entity)) {
+            if (!vat.set->covers(*meshGroup)) return false;
+        }
+        if (auto* lod = registry.getLevelOfDetail(entity)) {
+            for (const LODLevel& level : lod->levels) {
+                if (level.meshGroup && !vat.set->covers(*level.meshGroup)) return false;
+            }
+        }
+        return true;
+    }
+
+    VertexAnimationSettings m_settings;
+    size_t m_activeCount = 0;
+};
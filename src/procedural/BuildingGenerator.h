@@ -5,6 +5,7 @@
 #include <random>
 #include <cmath>
 #include "../ecs/components/Mesh.h"
+#include "../assets/AssetLoader.h"
 
 namespace BuildingGenerator {
 
@@ -58,7 +59,7 @@ inline Mesh createUnitBoxMesh() {
         -0.5f, 0.0f,  0.5f,   0.0f, -1.0f, 0.0f,  0.0f, 1.0f,
     };
 
-    std::vector<unsigned short> indices = {
+    std::vector<uint16_t> indices = {
         0, 1, 2,  2, 3, 0,     // Front
         4, 5, 6,  6, 7, 4,     // Back
         8, 9, 10,  10, 11, 8,  // Right
@@ -67,34 +68,7 @@ inline Mesh createUnitBoxMesh() {
         20, 21, 22,  22, 23, 20,  // Bottom
     };
 
-    GLuint vao, vbo, ebo;
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-    glGenBuffers(1, &ebo);
-
-    glBindVertexArray(vao);
-
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned short), indices.data(), GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-
-    glBindVertexArray(0);
-
-    Mesh mesh;
-    mesh.vao = vao;
-    mesh.indexCount = static_cast<int>(indices.size());
-    mesh.indexType = GL_UNSIGNED_SHORT;
-    mesh.texture = 0;
-    return mesh;
+    return uploadStaticMesh(vertices, indices);
 }
 
 // exclusionMin/exclusionMax: XZ AABB to exclude buildings from, vec2(0) to disable
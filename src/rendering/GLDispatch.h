@@ -0,0 +1,355 @@
+#pragma once
+#include <glad/glad.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// GL dispatch layer: swaps glad's function pointers for
+//  - Null: no-op entry points returning valid fake handles (no context needed),
+//    so CPU-side submission can be measured on machines without a GPU
+//  - Recording: counts every call per entry point and optionally writes the
+//    command stream as text (one call per line) for diffing between builds
+// Recording wraps whichever backend is underneath (native driver or null).
+// Only the entry points this codebase calls are covered; add new ones to the list.
+
+enum class GLBackend { Native, Null };
+
+// X(returnType, name without "gl", (params), (args))
+#define GL_DISPATCH_ENTRY_POINTS(X) \
+    X(void, ActiveTexture, (GLenum texture), (texture)) \
+    X(void, AttachShader, (GLuint program, GLuint shader), (program, shader)) \
+    X(void, BindBuffer, (GLenum target, GLuint buffer), (target, buffer)) \
+    X(void, BindBufferBase, (GLenum target, GLuint index, GLuint buffer), (target, index, buffer)) \
+    X(void, BindBufferRange, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, index, buffer, offset, size)) \
+    X(void, BindFramebuffer, (GLenum target, GLuint framebuffer), (target, framebuffer)) \
+    X(void, BindRenderbuffer, (GLenum target, GLuint renderbuffer), (target, renderbuffer)) \
+    X(void, BindTexture, (GLenum target, GLuint texture), (target, texture)) \
+    X(void, BindVertexArray, (GLuint array), (array)) \
+    X(void, BlendFunc, (GLenum sfactor, GLenum dfactor), (sfactor, dfactor)) \
+    X(void, BlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter), (srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter)) \
+    X(void, BufferData, (GLenum target, GLsizeiptr size, const void *data, GLenum usage), (target, size, data, usage)) \
+    X(void, BufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void *data), (target, offset, size, data)) \
+    X(GLenum, CheckFramebufferStatus, (GLenum target), (target)) \
+    X(void, Clear, (GLbitfield mask), (mask)) \
+    X(void, ClearBufferfv, (GLenum buffer, GLint drawbuffer, const GLfloat *value), (buffer, drawbuffer, value)) \
+    X(void, ClearColor, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha)) \
+    X(GLenum, ClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout)) \
+    X(void, ColorMaski, (GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a), (index, r, g, b, a)) \
+    X(void, CompileShader, (GLuint shader), (shader)) \
+    X(void, CompressedTexImage2D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data), (target, level, internalformat, width, height, border, imageSize, data)) \
+    X(void, CompressedTextureSubImage2D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data), (texture, level, xoffset, yoffset, width, height, format, imageSize, data)) \
+    X(void, CopyNamedBufferSubData, (GLuint readBuffer, GLuint writeBuffer, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size), (readBuffer, writeBuffer, readOffset, writeOffset, size)) \
+    X(void, CreateBuffers, (GLsizei n, GLuint *buffers), (n, buffers)) \
+    X(GLuint, CreateProgram, (), ()) \
+    X(GLuint, CreateShader, (GLenum type), (type)) \
+    X(void, DeleteBuffers, (GLsizei n, const GLuint *buffers), (n, buffers)) \
+    X(void, DeleteFramebuffers, (GLsizei n, const GLuint *framebuffers), (n, framebuffers)) \
+    X(void, DeleteProgram, (GLuint program), (program)) \
+    X(void, DeleteRenderbuffers, (GLsizei n, const GLuint *renderbuffers), (n, renderbuffers)) \
+    X(void, DeleteShader, (GLuint shader), (shader)) \
+    X(void, DeleteSync, (GLsync sync), (sync)) \
+    X(void, DeleteTextures, (GLsizei n, const GLuint *textures), (n, textures)) \
+    X(void, DeleteVertexArrays, (GLsizei n, const GLuint *arrays), (n, arrays)) \
+    X(void, DepthMask, (GLboolean flag), (flag)) \
+    X(void, Disable, (GLenum cap), (cap)) \
+    X(void, DisableVertexAttribArray, (GLuint index), (index)) \
+    X(void, DrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count)) \
+    X(void, DrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount), (mode, first, count, instancecount)) \
+    X(void, DrawBuffer, (GLenum buf), (buf)) \
+    X(void, DrawBuffers, (GLsizei n, const GLenum *bufs), (n, bufs)) \
+    X(void, DrawElements, (GLenum mode, GLsizei count, GLenum type, const void *indices), (mode, count, type, indices)) \
+    X(void, DrawElementsInstanced, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount), (mode, count, type, indices, instancecount)) \
+    X(void, Enable, (GLenum cap), (cap)) \
+    X(void, EnableVertexAttribArray, (GLuint index), (index)) \
+    X(GLsync, FenceSync, (GLenum condition, GLbitfield flags), (condition, flags)) \
+    X(void, Flush, (), ()) \
+    X(void, FramebufferRenderbuffer, (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer), (target, attachment, renderbuffertarget, renderbuffer)) \
+    X(void, FramebufferTexture2D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), (target, attachment, textarget, texture, level)) \
+    X(void, GenBuffers, (GLsizei n, GLuint *buffers), (n, buffers)) \
+    X(void, DeleteQueries, (GLsizei n, const GLuint *ids), (n, ids)) \
+    X(void, GenFramebuffers, (GLsizei n, GLuint *framebuffers), (n, framebuffers)) \
+    X(void, GenQueries, (GLsizei n, GLuint *ids), (n, ids)) \
+    X(void, GenRenderbuffers, (GLsizei n, GLuint *renderbuffers), (n, renderbuffers)) \
+    X(void, GenTextures, (GLsizei n, GLuint *textures), (n, textures)) \
+    X(void, GenVertexArrays, (GLsizei n, GLuint *arrays), (n, arrays)) \
+    X(void, GenerateMipmap, (GLenum target), (target)) \
+    X(void, GetNamedBufferParameteri64v, (GLuint buffer, GLenum pname, GLint64 *params), (buffer, pname, params)) \
+    X(void, GetNamedBufferSubData, (GLuint buffer, GLintptr offset, GLsizeiptr size, void *data), (buffer, offset, size, data)) \
+    X(void, GetProgramInfoLog, (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog), (program, bufSize, length, infoLog)) \
+    X(void, GetProgramiv, (GLuint program, GLenum pname, GLint *params), (program, pname, params)) \
+    X(void, GetShaderInfoLog, (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog), (shader, bufSize, length, infoLog)) \
+    X(void, GetShaderiv, (GLuint shader, GLenum pname, GLint *params), (shader, pname, params)) \
+    X(void, GetQueryObjectiv, (GLuint id, GLenum pname, GLint *params), (id, pname, params)) \
+    X(void, GetQueryObjectui64v, (GLuint id, GLenum pname, GLuint64 *params), (id, pname, params)) \
+    X(const GLubyte *, GetString, (GLenum name), (name)) \
+    X(GLuint, GetUniformBlockIndex, (GLuint program, const GLchar *uniformBlockName), (program, uniformBlockName)) \
+    X(GLint, GetUniformLocation, (GLuint program, const GLchar *name), (program, name)) \
+    X(void, LineWidth, (GLfloat width), (width)) \
+    X(void, LinkProgram, (GLuint program), (program)) \
+    X(void *, MapNamedBufferRange, (GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access), (buffer, offset, length, access)) \
+    X(void, NamedBufferData, (GLuint buffer, GLsizeiptr size, const void *data, GLenum usage), (buffer, size, data, usage)) \
+    X(void, NamedBufferStorage, (GLuint buffer, GLsizeiptr size, const void *data, GLbitfield flags), (buffer, size, data, flags)) \
+    X(void, NamedBufferSubData, (GLuint buffer, GLintptr offset, GLsizeiptr size, const void *data), (buffer, offset, size, data)) \
+    X(void, PixelStorei, (GLenum pname, GLint param), (pname, param)) \
+    X(void, QueryCounter, (GLuint id, GLenum target), (id, target)) \
+    X(void, ReadBuffer, (GLenum src), (src)) \
+    X(void, ReadPixels, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels), (x, y, width, height, format, type, pixels)) \
+    X(void, RenderbufferStorageMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height), (target, samples, internalformat, width, height)) \
+    X(void, ShaderSource, (GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length), (shader, count, string, length)) \
+    X(void, StencilFunc, (GLenum func, GLint ref, GLuint mask), (func, ref, mask)) \
+    X(void, StencilMask, (GLuint mask), (mask)) \
+    X(void, StencilOp, (GLenum fail, GLenum zfail, GLenum zpass), (fail, zfail, zpass)) \
+    X(void, TexBuffer, (GLenum target, GLenum internalformat, GLuint buffer), (target, internalformat, buffer)) \
+    X(void, TexImage2D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels), (target, level, internalformat, width, height, border, format, type, pixels)) \
+    X(void, TexParameterfv, (GLenum target, GLenum pname, const GLfloat *params), (target, pname, params)) \
+    X(void, TexParameteri, (GLenum target, GLenum pname, GLint param), (target, pname, param)) \
+    X(void, TextureSubImage2D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels), (texture, level, xoffset, yoffset, width, height, format, type, pixels)) \
+    X(void, Uniform1f, (GLint location, GLfloat v0), (location, v0)) \
+    X(void, Uniform1i, (GLint location, GLint v0), (location, v0)) \
+    X(void, Uniform2fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value)) \
+    X(void, Uniform3fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value)) \
+    X(void, Uniform4fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value)) \
+    X(GLboolean, UnmapNamedBuffer, (GLuint buffer), (buffer)) \
+    X(void, UniformBlockBinding, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding), (program, uniformBlockIndex, uniformBlockBinding)) \
+    X(void, UniformMatrix4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value)) \
+    X(void, UseProgram, (GLuint program), (program)) \
+    X(void, VertexAttribDivisor, (GLuint index, GLuint divisor), (index, divisor)) \
+    X(void, VertexAttribIPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer), (index, size, type, stride, pointer)) \
+    X(void, VertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer), (index, size, type, normalized, stride, pointer)) \
+    X(void, Viewport, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height))
+
+namespace GLDispatch {
+
+enum class Entry : int {
+#define GL_DISPATCH_ENUM(ret, name, params, args) name,
+    GL_DISPATCH_ENTRY_POINTS(GL_DISPATCH_ENUM)
+#undef GL_DISPATCH_ENUM
+    Count
+};
+
+inline const char* entryName(Entry e) {
+    static const char* names[] = {
+#define GL_DISPATCH_NAME(ret, name, params, args) "gl" #name,
+        GL_DISPATCH_ENTRY_POINTS(GL_DISPATCH_NAME)
+#undef GL_DISPATCH_NAME
+    };
+    return names[static_cast<int>(e)];
+}
+
+// Entry points underneath the recorder (native driver or null stubs)
+struct Table {
+#define GL_DISPATCH_FIELD(ret, name, params, args) decltype(glad_gl##name) name = nullptr;
+    GL_DISPATCH_ENTRY_POINTS(GL_DISPATCH_FIELD)
+#undef GL_DISPATCH_FIELD
+};
+
+// ==================== State ====================
+
+inline Table g_inner;
+inline bool g_recording = false;
+inline std::array<uint64_t, static_cast<size_t>(Entry::Count)> g_callCounts{};
+inline uint64_t g_frameCount = 0;
+inline std::ofstream g_stream;
+inline GLuint g_nextFakeHandle = 1;
+
+// ==================== Null backend ====================
+
+namespace detail {
+
+template <typename T> inline T nullResult() { return T{}; }
+template <> inline void nullResult<void>() {}
+template <typename... Args> inline void nullIgnore(const Args&...) {}  // Marks the stubs' parameters used
+
+inline void fakeNames(GLsizei n, GLuint* out) {
+    for (GLsizei i = 0; i < n; ++i) out[i] = g_nextFakeHandle++;
+}
+
+#define GL_DISPATCH_NULL_STUB(ret, name, params, args) \
+    inline ret APIENTRY null_##name params {           \
+        nullIgnore args;                               \
+        return nullResult<ret>();                      \
+    }
+GL_DISPATCH_ENTRY_POINTS(GL_DISPATCH_NULL_STUB)
+#undef GL_DISPATCH_NULL_STUB
+
+// Entry points whose results the engine depends on
+inline void APIENTRY nullGenNames(GLsizei n, GLuint* out) { fakeNames(n, out); }
+inline GLuint APIENTRY nullCreateProgram() { return g_nextFakeHandle++; }
+inline GLuint APIENTRY nullCreateShader(GLenum) { return g_nextFakeHandle++; }
+inline GLenum APIENTRY nullCheckFramebufferStatus(GLenum) { return GL_FRAMEBUFFER_COMPLETE; }
+inline void APIENTRY nullGetObjectiv(GLuint, GLenum pname, GLint* params) {
+    // Compile/link succeed, logs are empty
+    *params = (pname == GL_COMPILE_STATUS || pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+}
+inline void APIENTRY nullGetInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    if (length) *length = 0;
+    if (infoLog && bufSize > 0) infoLog[0] = '\0';
+}
+inline void APIENTRY nullGetQueryObjectiv(GLuint, GLenum, GLint* params) { *params = GL_TRUE; }
+inline void APIENTRY nullGetQueryObjectui64v(GLuint, GLenum, GLuint64* params) { *params = 0; }
+inline void APIENTRY nullGetNamedBufferParameteri64v(GLuint, GLenum, GLint64* params) { *params = 0; }  // Empty buffers: readbacks copy nothing
+// Mappings are backed by host memory so staging writes stay valid
+inline std::unordered_map<GLuint, std::vector<unsigned char>> g_nullMappings;
+inline void* APIENTRY nullMapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield) {
+    auto& storage = g_nullMappings[buffer];
+    if (storage.size() < static_cast<size_t>(offset + length)) storage.resize(offset + length);
+    return storage.data() + offset;
+}
+inline GLboolean APIENTRY nullUnmapNamedBuffer(GLuint buffer) {
+    g_nullMappings.erase(buffer);
+    return GL_TRUE;
+}
+inline const GLubyte* APIENTRY nullGetString(GLenum) {
+    return reinterpret_cast<const GLubyte*>("GLDispatch null backend");
+}
+
+inline Table nullTable() {
+    Table t;
+#define GL_DISPATCH_NULL_ASSIGN(ret, name, params, args) t.name = &null_##name;
+    GL_DISPATCH_ENTRY_POINTS(GL_DISPATCH_NULL_ASSIGN)
+#undef GL_DISPATCH_NULL_ASSIGN
+    t.GenBuffers = &nullGenNames;
+    t.GenTextures = &nullGenNames;
+    t.GenVertexArrays = &nullGenNames;
+    t.GenFramebuffers = &nullGenNames;
+    t.GenRenderbuffers = &nullGenNames;
+    t.CreateBuffers = &nullGenNames;
+    t.GenQueries = &nullGenNames;
+    t.CreateProgram = &nullCreateProgram;
+    t.CreateShader = &nullCreateShader;
+    t.CheckFramebufferStatus = &nullCheckFramebufferStatus;
+    t.GetShaderiv = &nullGetObjectiv;
+    t.GetProgramiv = &nullGetObjectiv;
+    t.GetShaderInfoLog = &nullGetInfoLog;
+    t.GetProgramInfoLog = &nullGetInfoLog;
+    t.GetQueryObjectiv = &nullGetQueryObjectiv;
+    t.GetQueryObjectui64v = &nullGetQueryObjectui64v;
+    t.GetNamedBufferParameteri64v = &nullGetNamedBufferParameteri64v;
+    t.GetString = &nullGetString;
+    t.MapNamedBufferRange = &nullMapNamedBufferRange;
+    t.UnmapNamedBuffer = &nullUnmapNamedBuffer;
+    return t;
+}
+
+// ==================== Recording backend ====================
+
+// Pointer arguments are written as "ptr"/"null" so streams are stable across runs
+template <typename T>
+inline void writeArg(std::ostream& os, T value) {
+    if constexpr (std::is_pointer_v<T>) {
+        os << (value ? " ptr" : " null");
+    } else if constexpr (std::is_same_v<T, GLboolean>) {
+        os << ' ' << static_cast<int>(value);
+    } else {
+        os << ' ' << value;
+    }
+}
+
+struct Recorder {
+    Entry entry;
+
+    template <typename... Args>
+    void operator()(Args... args) const {
+        ++g_callCounts[static_cast<size_t>(entry)];
+        if (g_stream.is_open()) {
+            g_stream << entryName(entry);
+            (writeArg(g_stream, args), ...);
+            g_stream << '\n';
+        }
+    }
+};
+
+#define GL_DISPATCH_RECORD_STUB(ret, name, params, args) \
+    inline ret APIENTRY record_##name params {           \
+        Recorder{Entry::name} args;                      \
+        return g_inner.name args;                        \
+    }
+GL_DISPATCH_ENTRY_POINTS(GL_DISPATCH_RECORD_STUB)
+#undef GL_DISPATCH_RECORD_STUB
+
+}  // namespace detail
+
+// ==================== Installation ====================
+
+// Call after gladLoadGLLoader (Native) or instead of it (Null, no context).
+// recordFile: empty = no recording; "-" = count calls only; otherwise also
+// write the command stream to that file.
+inline bool install(GLBackend backend, const std::string& recordFile) {
+    if (backend == GLBackend::Null) {
+        g_inner = detail::nullTable();
+    } else {
+#define GL_DISPATCH_CAPTURE(ret, name, params, args) g_inner.name = glad_gl##name;
+        GL_DISPATCH_ENTRY_POINTS(GL_DISPATCH_CAPTURE)
+#undef GL_DISPATCH_CAPTURE
+    }
+
+    g_recording = !recordFile.empty();
+    if (g_recording) {
+        if (recordFile != "-") {
+            g_stream.open(recordFile, std::ios::out | std::ios::trunc);
+            if (!g_stream) {
+                std::cerr << "GLDispatch: Failed to open " << recordFile << std::endl;
+                return false;
+            }
+        }
+#define GL_DISPATCH_INSTALL_RECORD(ret, name, params, args) glad_gl##name = &detail::record_##name;
+        GL_DISPATCH_ENTRY_POINTS(GL_DISPATCH_INSTALL_RECORD)
+#undef GL_DISPATCH_INSTALL_RECORD
+    } else {
+#define GL_DISPATCH_INSTALL_INNER(ret, name, params, args) glad_gl##name = g_inner.name;
+        GL_DISPATCH_ENTRY_POINTS(GL_DISPATCH_INSTALL_INNER)
+#undef GL_DISPATCH_INSTALL_INNER
+    }
+
+    std::cout << "GLDispatch: " << (backend == GLBackend::Null ? "null" : "native") << " backend"
+              << (g_recording ? ", recording" : "") << std::endl;
+    return true;
+}
+
+inline bool isRecording() { return g_recording; }
+
+// Marks a frame boundary in the command stream
+inline void endFrame() {
+    if (!g_recording) return;
+    ++g_frameCount;
+    if (g_stream.is_open()) {
+        g_stream << "# frame " << g_frameCount << '\n';
+    }
+}
+
+// Per-entry-point call counts, most frequent first
+inline void printStats(std::ostream& os) {
+    if (!g_recording) return;
+
+    std::vector<std::pair<uint64_t, Entry>> sorted;
+    uint64_t total = 0;
+    for (int i = 0; i < static_cast<int>(Entry::Count); ++i) {
+        if (g_callCounts[i] == 0) continue;
+        sorted.emplace_back(g_callCounts[i], static_cast<Entry>(i));
+        total += g_callCounts[i];
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+
+    uint64_t frames = std::max<uint64_t>(g_frameCount, 1);
+    os << "GLDispatch: " << total << " calls over " << g_frameCount << " frames ("
+       << total / frames << " per frame)" << std::endl;
+    for (const auto& [count, entry] : sorted) {
+        os << "  " << entryName(entry) << ": " << count << " (" << count / frames << "/frame)" << std::endl;
+    }
+}
+
+inline void shutdown() {
+    if (g_stream.is_open()) g_stream.close();
+}
+
+}  // namespace GLDispatch
@@ -0,0 +1,197 @@
+#pragma once
+
+// GPU timing of render passes with GL_TIMESTAMP queries.
+// Each frame writes a timestamp pair per scope; results are read back
+// FRAME_LATENCY frames later and only if already available, so the CPU never
+// waits on the GPU. Timestamps (instead of GL_TIME_ELAPSED) allow nested scopes.
+//
+// Build with ENABLE_GPU_PROFILER to enable; otherwise the macros expand to nothing.
+//   GPU_PROFILE_BEGIN_FRAME() / GPU_PROFILE_END_FRAME()  once per frame
+//   GPU_PROFILE_SCOPE("Shadow casters")                   times the enclosing block
+
+#ifdef ENABLE_GPU_PROFILER
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class GpuProfiler {
+public:
+    static constexpr int FRAME_LATENCY = 4;     // Query sets in flight
+    static constexpr int MAX_SCOPES = 64;       // Per frame, including the frame scope
+    static constexpr int HISTORY_SIZE = 240;    // Samples kept for average / percentiles
+    static constexpr int REPORT_INTERVAL = 300; // Frames between console reports
+
+    static GpuProfiler& instance() {
+        static GpuProfiler profiler;
+        return profiler;
+    }
+
+    void beginFrame() {
+        if (!m_initialized) init();
+
+        ++m_frameIndex;
+        FrameQueries& frame = m_frames[m_frameIndex % FRAME_LATENCY];
+        if (frame.pending) {
+            collect(frame);
+        }
+        frame.count = 0;
+        frame.pending = false;
+        m_depth = 0;
+        m_frameScope = beginScope("Frame");
+    }
+
+    void endFrame() {
+        endScope(m_frameScope);
+        m_frames[m_frameIndex % FRAME_LATENCY].pending = true;
+
+        if (m_frameIndex % REPORT_INTERVAL == 0) {
+            printReport(std::cout);
+        }
+    }
+
+    // Returns the scope slot (or -1 when the frame is full / outside a frame)
+    int beginScope(const char* name) {
+        FrameQueries& frame = m_frames[m_frameIndex % FRAME_LATENCY];
+        if (!m_initialized || frame.count >= MAX_SCOPES) return -1;
+
+        int index = frame.count++;
+        frame.names[index] = name;
+        frame.depth[index] = m_depth++;
+        glQueryCounter(frame.queries[index * 2], GL_TIMESTAMP);
+        return index;
+    }
+
+    void endScope(int index) {
+        if (index < 0) return;
+        FrameQueries& frame = m_frames[m_frameIndex % FRAME_LATENCY];
+        glQueryCounter(frame.queries[index * 2 + 1], GL_TIMESTAMP);
+        --m_depth;
+    }
+
+    // Average, median, 95th percentile and max (ms) per scope, in first-seen order
+    void printReport(std::ostream& os) const {
+        os << "GPU profile (" << m_collectedFrames << " frames, "
+           << m_droppedFrames << " not ready):" << std::endl;
+        for (const std::string& name : m_order) {
+            const ScopeHistory& h = m_history.at(name);
+            if (h.samples.empty()) continue;
+
+            std::vector<float> sorted = h.samples;
+            std::sort(sorted.begin(), sorted.end());
+            float sum = 0.0f;
+            for (float s : sorted) sum += s;
+            auto percentile = [&sorted](float p) {
+                size_t i = static_cast<size_t>(p * (sorted.size() - 1) + 0.5f);
+                return sorted[i];
+            };
+
+            os << "  " << std::string(h.depth * 2, ' ') << std::left << std::setw(24 - h.depth * 2) << name
+               << std::right << std::fixed << std::setprecision(3)
+               << " avg " << std::setw(7) << sum / sorted.size()
+               << "  p50 " << std::setw(7) << percentile(0.5f)
+               << "  p95 " << std::setw(7) << percentile(0.95f)
+               << "  max " << std::setw(7) << sorted.back() << " ms" << std::endl;
+        }
+    }
+
+private:
+    struct FrameQueries {
+        std::array<GLuint, MAX_SCOPES * 2> queries{};
+        std::array<const char*, MAX_SCOPES> names{};
+        std::array<int, MAX_SCOPES> depth{};
+        int count = 0;
+        bool pending = false;
+    };
+
+    struct ScopeHistory {
+        std::vector<float> samples;  // Ring buffer of milliseconds
+        size_t next = 0;
+        int depth = 0;
+    };
+
+    GpuProfiler() = default;
+
+    void init() {
+        for (FrameQueries& frame : m_frames) {
+            glGenQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+        }
+        m_initialized = true;
+    }
+
+    void collect(const FrameQueries& frame) {
+        // The frame scope's end is the last timestamp issued; if it is not
+        // ready, drop this frame instead of stalling
+        GLint available = 0;
+        glGetQueryObjectiv(frame.queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            ++m_droppedFrames;
+            return;
+        }
+
+        for (int i = 0; i < frame.count; ++i) {
+            GLuint64 start = 0, end = 0;
+            glGetQueryObjectui64v(frame.queries[i * 2], GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(frame.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+            float ms = static_cast<float>(end - start) * 1e-6f;
+
+            auto it = m_history.find(frame.names[i]);
+            if (it == m_history.end()) {
+                it = m_history.emplace(frame.names[i], ScopeHistory{}).first;
+                it->second.samples.reserve(HISTORY_SIZE);
+                m_order.push_back(frame.names[i]);
+            }
+            ScopeHistory& h = it->second;
+            h.depth = frame.depth[i];
+            if (h.samples.size() < HISTORY_SIZE) {
+                h.samples.push_back(ms);
+            } else {
+                h.samples[h.next] = ms;
+            }
+            h.next = (h.next + 1) % HISTORY_SIZE;
+        }
+        ++m_collectedFrames;
+    }
+
+    std::array<FrameQueries, FRAME_LATENCY> m_frames;
+    std::unordered_map<std::string, ScopeHistory> m_history;
+    std::vector<std::string> m_order;
+    uint64_t m_frameIndex = 0;
+    uint64_t m_collectedFrames = 0;
+    uint64_t m_droppedFrames = 0;
+    int m_frameScope = -1;
+    int m_depth = 0;
+    bool m_initialized = false;
+};
+
+// RAII scope marker
+class GpuProfileScope {
+public:
+    explicit GpuProfileScope(const char* name) : m_index(GpuProfiler::instance().beginScope(name)) {}
+    ~GpuProfileScope() { GpuProfiler::instance().endScope(m_index); }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    int m_index;
+};
+
+#define GPU_PROFILE_CONCAT_INNER(a, b) a##b
+#define GPU_PROFILE_CONCAT(a, b) GPU_PROFILE_CONCAT_INNER(a, b)
+#define GPU_PROFILE_SCOPE(name) GpuProfileScope GPU_PROFILE_CONCAT(gpuProfileScope_, __LINE__)(name)
+#define GPU_PROFILE_BEGIN_FRAME() GpuProfiler::instance().beginFrame()
+#define GPU_PROFILE_END_FRAME() GpuProfiler::instance().endFrame()
+
+#else
+
+#define GPU_PROFILE_SCOPE(name) ((void)0)
+#define GPU_PROFILE_BEGIN_FRAME() ((void)0)
+#define GPU_PROFILE_END_FRAME() ((void)0)
+
+#endif
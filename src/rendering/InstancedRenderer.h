@@ -6,6 +6,8 @@
 #include <vector>
 #include "../Shader.h"
 #include "../ecs/components/Mesh.h"
+#include "MeshUniforms.h"
+#include "../core/CpuProfiler.h"
 
 // Instance data for a single building
 struct BuildingInstance {
@@ -60,6 +62,7 @@ public:
 
     // Upload instance data to GPU and render
     void render(const Mesh& mesh, Shader& shader) {
+        CPU_PROFILE_ZONE("InstancedRenderer::render");
         if (m_instances.empty()) return;
 
         // Upload instance data
@@ -88,6 +91,7 @@ public:
 
         // Draw all instances
         shader.use();
+        setMeshPositionDequant(shader, mesh);
         glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, mesh.indexType,
                                 nullptr, static_cast<GLsizei>(m_instances.size()));
 
@@ -102,6 +106,7 @@ public:
 
     // Render shadow pass (depth only)
     void renderShadow(const Mesh& mesh, Shader& depthShader, const glm::mat4& lightSpaceMatrix) {
+        CPU_PROFILE_ZONE("InstancedRenderer::renderShadow");
         if (m_instances.empty()) return;
 
         // Upload instance data
@@ -124,6 +129,7 @@ public:
 
         depthShader.use();
         depthShader.setMat4("uLightSpaceMatrix", lightSpaceMatrix);
+        setMeshPositionDequant(depthShader, mesh);
 
         glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, mesh.indexType,
                                 nullptr, static_cast<GLsizei>(m_instances.size()));
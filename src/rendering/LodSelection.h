@@ -0,0 +1,58 @@
+#pragma once
+#include "../assets/AssetLoader.h"
+#include "../ecs/components/LevelOfDetail.h"
+#include "../core/GameConfig.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Screen-space error selection over LoadedModel::lods: a level is usable while
+// its model-space error, scaled by the object's transform and projected at its
+// distance, stays under maxErrorPixels (GameConfig::LOD_ERROR_PIXELS).
+
+// Pixels covered by one world unit at distance 1
+inline float lodPixelScale(float fovYDegrees, int viewportHeight) {
+    return 0.5f * static_cast<float>(viewportHeight) / std::tan(glm::radians(fovYDegrees) * 0.5f);
+}
+
+inline float lodPixelScale(const glm::mat4& projection, int viewportHeight) {
+    return 0.5f * static_cast<float>(viewportHeight) * projection[1][1];
+}
+
+// 0 = full detail (model.meshGroup), k = model.lods[k - 1]
+inline int selectModelLod(const LoadedModel& model, float worldScale, float distance,
+                          float pixelScale, float maxErrorPixels) {
+    const float pixelsPerUnit = worldScale * pixelScale / std::max(distance, 1e-3f);
+    int level = 0;
+    for (size_t i = 0; i < model.lods.size(); ++i) {
+        if (model.lods[i].error * pixelsPerUnit > maxErrorPixels) break;
+        level = static_cast<int>(i) + 1;
+    }
+    return level;
+}
+
+inline const MeshGroup& modelLodMeshGroup(const LoadedModel& model, int level) {
+    return (level <= 0) ? model.meshGroup : model.lods[level - 1].meshGroup;
+}
+
+// LevelOfDetail over a model and its cooked LODs. A level's screenSize is
+// where its error reaches maxErrorPixels: with size = 2 * radius * pixelsPerUnit,
+// error * pixelsPerUnit <= maxErrorPixels exactly when size <= 2 * radius * maxErrorPixels / error.
+inline LevelOfDetail modelLevelOfDetail(const LoadedModel& model, float maxErrorPixels) {
+    LevelOfDetail lod;
+    if (model.bounds.isValid()) {
+        const float skinScale = model.skeleton ? bindPoseSkinScale(*model.skeleton) : 1.0f;
+        lod.boundsCenter = model.bounds.center() * skinScale;
+        lod.boundsRadius = glm::length(model.bounds.halfExtents()) * skinScale;
+    }
+    lod.hysteresis = GameConfig::LOD_HYSTERESIS;
+    lod.crossFadeTime = GameConfig::LOD_CROSS_FADE_TIME;
+
+    lod.levels.push_back({&model.meshGroup, FLT_MAX});
+    for (const ModelLod& level : model.lods) {
+        float screenSize = (level.error > 0.0f) ? 2.0f * lod.boundsRadius * maxErrorPixels / level.error : FLT_MAX;
+        lod.levels.push_back({&level.meshGroup, std::min(screenSize, lod.levels.back().screenSize)});
+    }
+    return lod;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include "../Shader.h"
+#include "../ecs/components/Mesh.h"
+
+// Per-mesh dequantization of the packed positions (see VertexFormat.h). Every
+// vertex shader that reads a Mesh VAO declares uPositionOffset/uPositionScale;
+// the shader must be in use.
+inline void setMeshPositionDequant(const Shader& shader, const Mesh& mesh) {
+    shader.setVec3("uPositionOffset", mesh.positionOffset);
+    shader.setVec3("uPositionScale", mesh.positionScale);
+}
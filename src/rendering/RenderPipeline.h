@@ -2,10 +2,17 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <cfloat>
+#include "../core/AssetManager.h"
 #include "../core/GameConfig.h"
 #include "../core/GameState.h"
 #include "../culling/BuildingCuller.h"
 #include "../Shader.h"
+#include "GpuProfiler.h"
+#include "MeshUniforms.h"
+#include "LodSelection.h"
+#include "VertexAnimationRenderer.h"
+#include "../core/CpuProfiler.h"
 #include "../ecs/Registry.h"
 #include "../ecs/components/Mesh.h"
 #include "../ecs/components/Skeleton.h"
@@ -14,6 +21,23 @@
 // Forward declaration to avoid circular include
 struct SceneContext;
 
+// Effects enabled for the fused post-processing pass
+struct PostProcessParams {
+    bool toon = false;
+    bool motionBlur = false;   // Requires the cinematic pass (needs resolved depth)
+    bool radialBlur = false;   // Ignored when motion blur is enabled
+
+    // Motion blur history is updated in place
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    glm::mat4* prevViewProjection = nullptr;
+    bool* motionBlurInitialized = nullptr;
+    float motionBlurStrength = -1.0f;  // < 0 uses GameConfig::CINEMATIC_MOTION_BLUR
+    float nearPlane = 0.1f;            // Camera planes for the reconstruction depth test
+    float farPlane = 500.0f;
+
+    float radialBlurStrength = 0.0f;
+};
+
 // Centralizes FBO management and post-processing effects
 // Eliminates duplicated rendering code across scenes
 class RenderPipeline {
@@ -22,19 +46,46 @@ public:
         m_ctx = ctx;
     }
 
+    // ==================== Sizing ====================
+
+    // Call once per frame with the drawable size. Screen-sized targets are
+    // reallocated lazily at outputSize * RENDER_SCALE when either changes.
+    void setOutputSize(int width, int height);
+    int outputWidth() const { return m_outputWidth; }
+    int outputHeight() const { return m_outputHeight; }
+    int renderWidth() const { return m_renderWidth; }
+    int renderHeight() const { return m_renderHeight; }
+
     // ==================== FBO Management ====================
 
     void beginShadowPass();
     void endShadowPass();
-    void beginMainPass(bool useToonFBO = false);
-    void beginCinematicPass();
+    void beginMainPass();
+    // writeVelocity: also write per-object motion to attachment 1 (for motion blur)
+    void beginCinematicPass(bool writeVelocity = false);
+    // Blended effects (sun, comets, snow) must not touch the velocity attachment
+    void beginTransparentPass();
 
     // ==================== Post-Processing ====================
 
-    void applyToonPostProcess();
-    void applyMotionBlur(const glm::mat4& currentVP, glm::mat4& prevVP, bool& initialized, float blurStrengthOverride = -1.0f);
-    void applyRadialBlur(float blurStrength);  // For death cinematic - works without camera movement
-    void finalResolveAndBlit();
+    // Resolves the scene MSAA target once, runs the enabled effects in a single
+    // fused pass and writes the result to the default framebuffer.
+    // UI drawn afterwards goes straight on top of the presented image.
+    void resolveAndPostProcess(const PostProcessParams& params = PostProcessParams());
+
+    // Resolves the main pass without presenting. The resolved image stays valid
+    // until the next main-pass resolve, so it can be presented again as a cache.
+    void resolveMainPass();
+    // Draws the last resolved main-pass image to the screen (no effects)
+    void presentResolved();
+
+    // ==================== Frozen Frame ====================
+
+    // The next resolveAndPostProcess copies the presented image (before UI)
+    // and blurs/darkens it once; it can then be shown as a still background.
+    void requestFrameCapture() { m_captureRequested = true; }
+    bool hasFrozenFrame() const { return m_frozenFrameValid; }
+    void presentFrozenFrame();
 
     // ==================== Common Rendering Helpers ====================
 
@@ -53,7 +104,22 @@ public:
     void renderShadowMapDebug();
 
 private:
+    // Tile-max / neighbor-max downsample of the resolved velocity (motion blur)
+    void buildVelocityTiles(const glm::mat4& currentVP, const glm::mat4& prevVP);
+    void captureFrozenFrame();
+    float nearestCometDistance(const glm::vec3& cameraPos, const glm::vec3& fallDir) const;
+
     SceneContext* m_ctx = nullptr;
+    VertexAnimationRenderer m_vertexAnimationShadows;  // Monsters drawn from baked frames
+    GLuint m_sceneFBO = 0;  // MSAA target of the current frame (main or cinematic)
+    bool m_velocityWritten = false;  // Cinematic pass wrote attachment 1 this frame
+    bool m_captureRequested = false;
+    bool m_frozenFrameValid = false;
+
+    int m_outputWidth = GameConfig::WINDOW_WIDTH;
+    int m_outputHeight = GameConfig::WINDOW_HEIGHT;
+    int m_renderWidth = GameConfig::WINDOW_WIDTH;
+    int m_renderHeight = GameConfig::WINDOW_HEIGHT;
 };
 
 // Include SceneContext after class declaration to avoid circular dependency
@@ -61,6 +127,24 @@ private:
 
 // ==================== Implementation ====================
 
+inline void RenderPipeline::setOutputSize(int width, int height) {
+    if (width <= 0 || height <= 0) return;
+
+    float scale = glm::clamp(GameConfig::RENDER_SCALE, 0.25f, 2.0f);
+    m_outputWidth = width;
+    m_outputHeight = height;
+    m_renderWidth = glm::max(1, static_cast<int>(width * scale + 0.5f));
+    m_renderHeight = glm::max(1, static_cast<int>(height * scale + 0.5f));
+
+    if (m_ctx->assetManager && m_ctx->assetManager->resizeRenderTargets(m_renderWidth, m_renderHeight)) {
+        m_frozenFrameValid = false;  // Storage was re-specified
+    }
+
+    m_ctx->screenWidth = width;
+    m_ctx->screenHeight = height;
+    m_ctx->aspectRatio = static_cast<float>(width) / height;
+}
+
 inline void RenderPipeline::beginShadowPass() {
     glViewport(0, 0, GameConfig::SHADOW_MAP_SIZE, GameConfig::SHADOW_MAP_SIZE);
     glBindFramebuffer(GL_FRAMEBUFFER, m_ctx->shadowFBO);
@@ -69,107 +153,212 @@ inline void RenderPipeline::beginShadowPass() {
 
 inline void RenderPipeline::endShadowPass() {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+    glViewport(0, 0, m_renderWidth, m_renderHeight);
 }
 
-inline void RenderPipeline::beginMainPass(bool useToonFBO) {
-    GLuint targetFBO = useToonFBO ? m_ctx->toonFBO : m_ctx->msaaFBO;
-    glBindFramebuffer(GL_FRAMEBUFFER, targetFBO);
-    glViewport(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+inline void RenderPipeline::beginMainPass() {
+    m_sceneFBO = m_ctx->msaaFBO;
+    m_velocityWritten = false;
+    glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFBO);
+    glViewport(0, 0, m_renderWidth, m_renderHeight);
     glClearColor(0.2f, 0.2f, 0.22f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-inline void RenderPipeline::beginCinematicPass() {
-    glBindFramebuffer(GL_FRAMEBUFFER, m_ctx->cinematicMsaaFBO);
-    glViewport(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+inline void RenderPipeline::beginCinematicPass(bool writeVelocity) {
+    m_sceneFBO = m_ctx->cinematicMsaaFBO;
+    m_velocityWritten = writeVelocity;
+    glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFBO);
+    glViewport(0, 0, m_renderWidth, m_renderHeight);
+
+    const GLenum drawBuffers[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(writeVelocity ? 2 : 1, drawBuffers);
+    glColorMaski(1, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
     glClearColor(0.2f, 0.2f, 0.22f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (writeVelocity) {
+        const GLfloat zeroVelocity[] = {0.0f, 0.0f, 0.0f, 0.0f};
+        glClearBufferfv(GL_COLOR, 1, zeroVelocity);
+    }
 }
 
-inline void RenderPipeline::applyToonPostProcess() {
-    glBindFramebuffer(GL_FRAMEBUFFER, m_ctx->msaaFBO);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+inline void RenderPipeline::beginTransparentPass() {
+    glColorMaski(1, GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+}
 
-    m_ctx->toonPostShader->use();
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_ctx->toonColorTex);
-    m_ctx->toonPostShader->setInt("uSceneTex", 0);
-    m_ctx->toonPostShader->setVec2("uTexelSize", glm::vec2(
-        1.0f / GameConfig::WINDOW_WIDTH,
-        1.0f / GameConfig::WINDOW_HEIGHT));
+inline void RenderPipeline::resolveAndPostProcess(const PostProcessParams& params) {
+    GPU_PROFILE_SCOPE("Resolve + post");
+    CPU_PROFILE_ZONE("Resolve + post");
+    const int w = m_renderWidth;
+    const int h = m_renderHeight;
+
+    // Step 1: Single MSAA resolve. The cinematic target shares its depth format
+    // with motionBlurFBO, so depth comes along for velocity reconstruction.
+    bool cinematic = (m_sceneFBO == m_ctx->cinematicMsaaFBO);
+    GLuint resolveFBO = cinematic ? m_ctx->motionBlurFBO : m_ctx->resolveFBO;
+    GLuint colorTex = cinematic ? m_ctx->motionBlurColorTex : m_ctx->resolveColorTex;
+    bool motionBlur = params.motionBlur && cinematic &&
+                      params.prevViewProjection && params.motionBlurInitialized;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_sceneFBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, resolveFBO);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    if (motionBlur) {
+        glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+        // Object velocity (attachment 1); camera-only blur if it wasn't written
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_ctx->velocityFBO);
+        if (m_velocityWritten) {
+            glReadBuffer(GL_COLOR_ATTACHMENT1);
+            glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+            glReadBuffer(GL_COLOR_ATTACHMENT0);
+        } else {
+            const GLfloat zeroVelocity[] = {0.0f, 0.0f, 0.0f, 0.0f};
+            glClearBufferfv(GL_COLOR, 0, zeroVelocity);
+        }
+    }
+    glColorMaski(1, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+    // On first frame, use current matrix as previous (no blur)
+    if (motionBlur && !*params.motionBlurInitialized) {
+        *params.prevViewProjection = params.viewProjection;
+    }
+    if (motionBlur) {
+        buildVelocityTiles(params.viewProjection, *params.prevViewProjection);
+    }
 
+    // Step 2: Fused effects, written straight to the screen.
+    // Upscaling from the internal render size happens here via linear filtering.
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, m_outputWidth, m_outputHeight);
     glDisable(GL_DEPTH_TEST);
+
+    Shader* shader = m_ctx->postProcessShader;
+    shader->use();
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, colorTex);
+    shader->setInt("uColorBuffer", 0);
+    shader->setVec2("uTexelSize", glm::vec2(1.0f / w, 1.0f / h));
+    shader->setInt("uNumSamples", 16);
+
+    shader->setInt("uToonEnabled", params.toon ? 1 : 0);
+    shader->setInt("uMotionBlurEnabled", motionBlur ? 1 : 0);
+    shader->setInt("uRadialBlurEnabled", (params.radialBlur && !motionBlur) ? 1 : 0);
+
+    if (motionBlur) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, m_ctx->motionBlurDepthTex);
+        shader->setInt("uDepthBuffer", 1);
+
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, m_ctx->velocityTex);
+        shader->setInt("uVelocityBuffer", 2);
+
+        glActiveTexture(GL_TEXTURE3);
+        glBindTexture(GL_TEXTURE_2D, m_ctx->neighborMaxTex);
+        shader->setInt("uNeighborMax", 3);
+        shader->setInt("uTileSize", RenderTargets::VELOCITY_TILE_SIZE);
+        shader->setInt("uMaxSamples", 16);
+
+        glm::mat4& prevVP = *params.prevViewProjection;
+        shader->setMat4("uInvViewProjection", glm::inverse(params.viewProjection));
+        shader->setMat4("uPrevViewProjection", prevVP);
+        shader->setVec2("uNearFar", glm::vec2(params.nearPlane, params.farPlane));
+
+        float blurStrength = (params.motionBlurStrength >= 0.0f) ? params.motionBlurStrength : GameConfig::CINEMATIC_MOTION_BLUR;
+        shader->setFloat("uMotionBlurStrength", blurStrength);
+
+        // Store current view-projection for next frame
+        prevVP = params.viewProjection;
+        *params.motionBlurInitialized = true;
+    }
+
+    if (params.radialBlur) {
+        shader->setFloat("uRadialBlurStrength", params.radialBlurStrength);
+        shader->setVec2("uRadialCenter", glm::vec2(0.5f, 0.5f));
+    }
+
     glBindVertexArray(m_ctx->overlayVAO);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glBindVertexArray(0);
+
+    glActiveTexture(GL_TEXTURE0);
     glEnable(GL_DEPTH_TEST);
+
+    if (m_captureRequested) {
+        captureFrozenFrame();
+    }
 }
 
-inline void RenderPipeline::applyMotionBlur(const glm::mat4& currentVP, glm::mat4& prevVP, bool& initialized, float blurStrengthOverride) {
-    // Resolve cinematic MSAA to motion blur FBO
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_ctx->cinematicMsaaFBO);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_ctx->motionBlurFBO);
-    glBlitFramebuffer(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT,
-                      0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT,
-                      GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, GL_NEAREST);
-
-    // Apply motion blur effect to msaaFBO
-    glBindFramebuffer(GL_FRAMEBUFFER, m_ctx->msaaFBO);
-    glViewport(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+inline void RenderPipeline::captureFrozenFrame() {
+    GPU_PROFILE_SCOPE("Frozen frame capture");
+    CPU_PROFILE_ZONE("Frozen frame capture");
+    m_captureRequested = false;
+    const int w = m_renderWidth;
+    const int h = m_renderHeight;
+
+    // Copy the presented image (downscaled to the render size when larger)
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_ctx->frozenCaptureFBO);
+    glBlitFramebuffer(0, 0, m_outputWidth, m_outputHeight, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+    // Blur and darken once, so showing it later costs a single blit
+    glBindFramebuffer(GL_FRAMEBUFFER, m_ctx->frozenFrameFBO);
+    glViewport(0, 0, w, h);
     glDisable(GL_DEPTH_TEST);
 
-    m_ctx->motionBlurShader->use();
-
-    // Bind color buffer
+    Shader* shader = m_ctx->frozenFrameShader;
+    shader->use();
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_ctx->motionBlurColorTex);
-    m_ctx->motionBlurShader->setInt("uColorBuffer", 0);
+    glBindTexture(GL_TEXTURE_2D, m_ctx->frozenCaptureTex);
+    shader->setInt("uScreenTexture", 0);
+    shader->setVec2("uTexelSize", glm::vec2(1.0f / w, 1.0f / h));
+    shader->setFloat("uBlurRadius", glm::max(GameConfig::PAUSE_BACKGROUND_BLUR, 0.0f));
+    shader->setFloat("uDim", glm::clamp(GameConfig::PAUSE_BACKGROUND_DIM, 0.0f, 1.0f));
 
-    // Bind depth buffer
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, m_ctx->motionBlurDepthTex);
-    m_ctx->motionBlurShader->setInt("uDepthBuffer", 1);
+    glBindVertexArray(m_ctx->overlayVAO);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindVertexArray(0);
 
-    // Pass matrices for velocity computation
-    m_ctx->motionBlurShader->setMat4("uViewProjection", currentVP);
-    m_ctx->motionBlurShader->setMat4("uInvViewProjection", glm::inverse(currentVP));
+    // Back to the screen for UI
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, m_outputWidth, m_outputHeight);
+    glEnable(GL_DEPTH_TEST);
+    m_frozenFrameValid = true;
+}
 
-    // On first frame, use current matrix as previous (no blur)
-    if (!initialized) {
-        prevVP = currentVP;
-    }
-    m_ctx->motionBlurShader->setMat4("uPrevViewProjection", prevVP);
+inline void RenderPipeline::presentFrozenFrame() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, m_outputWidth, m_outputHeight);
+    glDisable(GL_DEPTH_TEST);
 
-    // Blur parameters - use override if provided, otherwise use config value
-    float blurStrength = (blurStrengthOverride >= 0.0f) ? blurStrengthOverride : GameConfig::CINEMATIC_MOTION_BLUR;
-    m_ctx->motionBlurShader->setFloat("uBlurStrength", blurStrength);
-    m_ctx->motionBlurShader->setInt("uNumSamples", 16);
+    m_ctx->blitShader->use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_ctx->frozenFrameTex);
+    m_ctx->blitShader->setInt("uScreenTexture", 0);
 
     glBindVertexArray(m_ctx->overlayVAO);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glBindVertexArray(0);
 
     glEnable(GL_DEPTH_TEST);
-
-    // Store current view-projection for next frame
-    prevVP = currentVP;
-    initialized = true;
 }
 
-inline void RenderPipeline::finalResolveAndBlit() {
-    // Step 1: Resolve MSAA FBO to regular texture FBO
+inline void RenderPipeline::resolveMainPass() {
+    const int w = m_renderWidth;
+    const int h = m_renderHeight;
     glBindFramebuffer(GL_READ_FRAMEBUFFER, m_ctx->msaaFBO);
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_ctx->resolveFBO);
-    glBlitFramebuffer(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT,
-                      0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT,
-                      GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
 
-    // Step 2: Blit resolved texture to screen
+inline void RenderPipeline::presentResolved() {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glViewport(0, 0, m_outputWidth, m_outputHeight);
     glDisable(GL_DEPTH_TEST);
 
     m_ctx->blitShader->use();
@@ -184,52 +373,61 @@ inline void RenderPipeline::finalResolveAndBlit() {
     glEnable(GL_DEPTH_TEST);
 }
 
-inline void RenderPipeline::applyRadialBlur(float blurStrength) {
-    // Resolve cinematic MSAA to motion blur FBO (reusing it as intermediate)
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_ctx->cinematicMsaaFBO);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_ctx->motionBlurFBO);
-    glBlitFramebuffer(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT,
-                      0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT,
-                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
-
-    // Apply radial blur effect to msaaFBO
-    glBindFramebuffer(GL_FRAMEBUFFER, m_ctx->msaaFBO);
-    glViewport(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glDisable(GL_DEPTH_TEST);
+inline void RenderPipeline::buildVelocityTiles(const glm::mat4& currentVP, const glm::mat4& prevVP) {
+    GPU_PROFILE_SCOPE("Velocity tiles");
+    CPU_PROFILE_ZONE("Velocity tiles");
+    const int tile = RenderTargets::VELOCITY_TILE_SIZE;
+    const int tilesX = (m_renderWidth + tile - 1) / tile;
+    const int tilesY = (m_renderHeight + tile - 1) / tile;
 
-    m_ctx->radialBlurShader->use();
+    glDisable(GL_DEPTH_TEST);
+    glViewport(0, 0, tilesX, tilesY);
+    glBindVertexArray(m_ctx->overlayVAO);
 
-    // Bind color buffer
+    // Tile-max: longest combined (camera + object) velocity per tile
+    glBindFramebuffer(GL_FRAMEBUFFER, m_ctx->tileMaxFBO);
+    Shader* tileMax = m_ctx->velocityTileMaxShader;
+    tileMax->use();
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_ctx->motionBlurColorTex);
-    m_ctx->radialBlurShader->setInt("uColorBuffer", 0);
-
-    // Radial blur parameters
-    m_ctx->radialBlurShader->setFloat("uBlurStrength", blurStrength);
-    m_ctx->radialBlurShader->setVec2("uCenter", glm::vec2(0.5f, 0.5f));
-    m_ctx->radialBlurShader->setInt("uNumSamples", 16);
+    glBindTexture(GL_TEXTURE_2D, m_ctx->velocityTex);
+    tileMax->setInt("uVelocityBuffer", 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_ctx->motionBlurDepthTex);
+    tileMax->setInt("uDepthBuffer", 1);
+    tileMax->setMat4("uInvViewProjection", glm::inverse(currentVP));
+    tileMax->setMat4("uPrevViewProjection", prevVP);
+    tileMax->setInt("uTileSize", tile);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
-    glBindVertexArray(m_ctx->overlayVAO);
+    // Neighbor-max: 3x3 dilation of the tile-max
+    glBindFramebuffer(GL_FRAMEBUFFER, m_ctx->neighborMaxFBO);
+    Shader* neighborMax = m_ctx->velocityNeighborMaxShader;
+    neighborMax->use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_ctx->tileMaxTex);
+    neighborMax->setInt("uTileMax", 0);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    glBindVertexArray(0);
 
-    glEnable(GL_DEPTH_TEST);
+    glBindVertexArray(0);
 }
 
 inline void RenderPipeline::renderShadowCasters(const glm::mat4& lightSpaceMatrix, const glm::vec3& cameraPos) {
+    GPU_PROFILE_SCOPE("Shadow casters");
+    CPU_PROFILE_ZONE("Shadow casters");
+
     // Render buildings to shadow map
     m_ctx->buildingCuller->updateShadowCasters(lightSpaceMatrix, cameraPos, m_ctx->buildingMaxRenderDistance);
     m_ctx->buildingCuller->renderShadows(*m_ctx->buildingBoxMesh, *m_ctx->depthInstancedShader, lightSpaceMatrix);
 
     // Render FING building shadow
     auto* t = m_ctx->registry->getTransform(m_ctx->fingBuilding);
-    auto* mg = m_ctx->registry->getMeshGroup(m_ctx->fingBuilding);
+    auto* mg = m_ctx->registry->getRenderMeshGroup(m_ctx->fingBuilding);
     if (t && mg) {
         m_ctx->depthShader->use();
         m_ctx->depthShader->setMat4("uLightSpaceMatrix", lightSpaceMatrix);
         m_ctx->depthShader->setMat4("uModel", t->matrix());
         for (const auto& mesh : mg->meshes) {
+            setMeshPositionDequant(*m_ctx->depthShader, mesh);
             glBindVertexArray(mesh.vao);
             glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr);
         }
@@ -237,7 +435,7 @@ inline void RenderPipeline::renderShadowCasters(const glm::mat4& lightSpaceMatri
 
     // Render protagonist shadow (skinned mesh)
     auto* protagonistT = m_ctx->registry->getTransform(m_ctx->protagonist);
-    auto* protagonistMG = m_ctx->registry->getMeshGroup(m_ctx->protagonist);
+    auto* protagonistMG = m_ctx->registry->getRenderMeshGroup(m_ctx->protagonist);
     auto* protagonistSkeleton = m_ctx->registry->getSkeleton(m_ctx->protagonist);
     auto* protagonistR = m_ctx->registry->getRenderable(m_ctx->protagonist);
     if (protagonistT && protagonistMG) {
@@ -252,13 +450,14 @@ inline void RenderPipeline::renderShadowCasters(const glm::mat4& lightSpaceMatri
         m_ctx->skinnedDepthShader->setMat4("uModel", model);
 
         // Set skinning data
-        bool hasSkinning = protagonistSkeleton && !protagonistSkeleton->boneMatrices.empty();
+        bool hasSkinning = protagonistSkeleton && !protagonistSkeleton->skinningMatrices().empty();
         m_ctx->skinnedDepthShader->setInt("uUseSkinning", hasSkinning ? 1 : 0);
         if (hasSkinning) {
-            m_ctx->skinnedDepthShader->setMat4Array("uBones", protagonistSkeleton->boneMatrices);
+            m_ctx->skinnedDepthShader->setMat4Array("uBones", protagonistSkeleton->skinningMatrices());
         }
 
         for (const auto& mesh : protagonistMG->meshes) {
+            setMeshPositionDequant(*m_ctx->skinnedDepthShader, mesh);
             glBindVertexArray(mesh.vao);
             glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr);
         }
@@ -267,7 +466,7 @@ inline void RenderPipeline::renderShadowCasters(const glm::mat4& lightSpaceMatri
     // Render NPC shadows (skinned meshes)
     for (Entity npc : m_ctx->npcs) {
         auto* npcT = m_ctx->registry->getTransform(npc);
-        auto* npcMG = m_ctx->registry->getMeshGroup(npc);
+        auto* npcMG = m_ctx->registry->getRenderMeshGroup(npc);
         auto* npcSkeleton = m_ctx->registry->getSkeleton(npc);
         auto* npcR = m_ctx->registry->getRenderable(npc);
         if (npcT && npcMG) {
@@ -281,13 +480,14 @@ inline void RenderPipeline::renderShadowCasters(const glm::mat4& lightSpaceMatri
             }
             m_ctx->skinnedDepthShader->setMat4("uModel", model);
 
-            bool hasSkinning = npcSkeleton && !npcSkeleton->boneMatrices.empty();
+            bool hasSkinning = npcSkeleton && !npcSkeleton->skinningMatrices().empty();
             m_ctx->skinnedDepthShader->setInt("uUseSkinning", hasSkinning ? 1 : 0);
             if (hasSkinning) {
-                m_ctx->skinnedDepthShader->setMat4Array("uBones", npcSkeleton->boneMatrices);
+                m_ctx->skinnedDepthShader->setMat4Array("uBones", npcSkeleton->skinningMatrices());
             }
 
             for (const auto& mesh : npcMG->meshes) {
+                setMeshPositionDequant(*m_ctx->skinnedDepthShader, mesh);
                 glBindVertexArray(mesh.vao);
                 glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr);
             }
@@ -296,46 +496,78 @@ inline void RenderPipeline::renderShadowCasters(const glm::mat4& lightSpaceMatri
 
     // Render monster shadows (skinned meshes) - only visible monsters
     if (m_ctx->monsterManager) {
+        m_vertexAnimationShadows.beginFrame();
         for (Entity monster : m_ctx->monsterManager->getMonsterEntities()) {
             auto* monsterR = m_ctx->registry->getRenderable(monster);
             if (!monsterR || !monsterR->visible) continue;  // Skip culled monsters
 
             auto* monsterT = m_ctx->registry->getTransform(monster);
-            auto* monsterMG = m_ctx->registry->getMeshGroup(monster);
+            auto* monsterMG = m_ctx->registry->getRenderMeshGroup(monster);
             auto* monsterSkeleton = m_ctx->registry->getSkeleton(monster);
             if (monsterT && monsterMG) {
-                m_ctx->skinnedDepthShader->use();
-                m_ctx->skinnedDepthShader->setMat4("uLightSpaceMatrix", lightSpaceMatrix);
-
                 glm::mat4 model = monsterT->matrix();
                 if (monsterR->meshOffset != glm::vec3(0.0f)) {
                     model = model * glm::translate(glm::mat4(1.0f), monsterR->meshOffset);
                 }
+
+                // Distant monsters: batched from their baked frames, like the main pass
+                auto* monsterVat = m_ctx->registry->getVertexAnimation(monster);
+                auto* monsterAnim = m_ctx->registry->getAnimation(monster);
+                if (m_ctx->vertexAnimationDepthShader && monsterVat && monsterVat->active && monsterVat->set && monsterAnim) {
+                    if (m_vertexAnimationShadows.addInstance(*monsterMG, *monsterVat->set, model, model,
+                                                             monsterAnim->clipIndex, monsterAnim->time, monsterAnim->time)) {
+                        continue;
+                    }
+                    monsterVat->reject();  // Skinned in the main pass too
+                }
+
+                m_ctx->skinnedDepthShader->use();
+                m_ctx->skinnedDepthShader->setMat4("uLightSpaceMatrix", lightSpaceMatrix);
                 m_ctx->skinnedDepthShader->setMat4("uModel", model);
 
-                bool hasSkinning = monsterSkeleton && !monsterSkeleton->boneMatrices.empty();
+                bool hasSkinning = monsterSkeleton && !monsterSkeleton->skinningMatrices().empty();
                 m_ctx->skinnedDepthShader->setInt("uUseSkinning", hasSkinning ? 1 : 0);
                 if (hasSkinning) {
-                    m_ctx->skinnedDepthShader->setMat4Array("uBones", monsterSkeleton->boneMatrices);
+                    m_ctx->skinnedDepthShader->setMat4Array("uBones", monsterSkeleton->skinningMatrices());
                 }
 
                 for (const auto& mesh : monsterMG->meshes) {
+                    setMeshPositionDequant(*m_ctx->skinnedDepthShader, mesh);
                     glBindVertexArray(mesh.vao);
                     glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr);
                 }
             }
         }
+
+        if (m_vertexAnimationShadows.getInstanceCount() > 0) {
+            m_ctx->vertexAnimationDepthShader->use();
+            m_ctx->vertexAnimationDepthShader->setMat4("uLightSpaceMatrix", lightSpaceMatrix);
+            m_vertexAnimationShadows.draw(*m_ctx->vertexAnimationDepthShader, false);
+        }
     }
 }
 
 inline void RenderPipeline::renderBuildings(const BuildingRenderParams& params) {
+    GPU_PROFILE_SCOPE("Buildings");
+    CPU_PROFILE_ZONE("Buildings");
     m_ctx->buildingCuller->render(*m_ctx->buildingBoxMesh, *m_ctx->buildingInstancedShader, params);
 }
 
 inline void RenderPipeline::renderComets(const glm::mat4& view, const glm::mat4& projection,
                                           const glm::vec3& cameraPos, const glm::vec3& fallDir,
                                           const glm::vec3& cometColor) {
-    if (!m_ctx->cometMeshGroup) return;
+    if (!m_ctx->cometModel) return;
+    GPU_PROFILE_SCOPE("Comets");
+    CPU_PROFILE_ZONE("Comets");
+
+    // One LOD for all instances, chosen for the closest comet. The trail
+    // stretch only lengthens the (faded) tail, so the model scale is used.
+    const MeshGroup* meshGroup = &m_ctx->cometModel->meshGroup;
+    if (!m_ctx->cometModel->lods.empty() && m_ctx->cometInstances) {
+        int level = selectModelLod(*m_ctx->cometModel, m_ctx->cometScale, nearestCometDistance(cameraPos, fallDir),
+                                   lodPixelScale(projection, m_renderHeight), GameConfig::LOD_ERROR_PIXELS);
+        meshGroup = &modelLodMeshGroup(*m_ctx->cometModel, level);
+    }
 
     glEnable(GL_DEPTH_TEST);
     glDepthMask(GL_FALSE);
@@ -358,7 +590,7 @@ inline void RenderPipeline::renderComets(const glm::mat4& view, const glm::mat4&
     m_ctx->cometShader->setFloat("uTrailStretch", 15.0f);
     m_ctx->cometShader->setFloat("uGroundY", 0.0f);
 
-    for (const auto& mesh : m_ctx->cometMeshGroup->meshes) {
+    for (const auto& mesh : meshGroup->meshes) {
         if (mesh.texture != 0) {
             glActiveTexture(GL_TEXTURE0);
             glBindTexture(GL_TEXTURE_2D, mesh.texture);
@@ -367,6 +599,7 @@ inline void RenderPipeline::renderComets(const glm::mat4& view, const glm::mat4&
             m_ctx->cometShader->setInt("uHasTexture", 0);
         }
 
+        setMeshPositionDequant(*m_ctx->cometShader, mesh);
         glBindVertexArray(mesh.vao);
         glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr, m_ctx->numComets);
     }
@@ -377,11 +610,28 @@ inline void RenderPipeline::renderComets(const glm::mat4& view, const glm::mat4&
     glEnable(GL_DEPTH_TEST);
 }
 
+// Closest any comet gets to the camera over its fall. Instance positions are
+// camera-relative; the per-instance direction and fall length match comet.vert.
+inline float RenderPipeline::nearestCometDistance(const glm::vec3& cameraPos, const glm::vec3& fallDir) const {
+    float nearest = FLT_MAX;
+    for (const glm::vec4& instance : *m_ctx->cometInstances) {
+        float seed = instance.w * 12.9898f;
+        glm::vec3 dir = glm::normalize(fallDir + glm::vec3(std::sin(seed) * 0.15f, 0.0f, std::cos(seed * 1.5f) * 0.15f));
+        glm::vec3 start(instance);
+        float length = std::max((cameraPos.y + start.y) / std::abs(dir.y), m_ctx->cometFallDistance);
+        float t = glm::clamp(-glm::dot(start, dir), 0.0f, length);
+        nearest = std::min(nearest, glm::length(start + dir * t));
+    }
+    return nearest;
+}
+
 inline void RenderPipeline::renderComets(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos) {
     renderComets(view, projection, cameraPos, m_ctx->cometFallDir, m_ctx->cometColor);
 }
 
 inline void RenderPipeline::renderSun(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos) {
+    GPU_PROFILE_SCOPE("Sun");
+    CPU_PROFILE_ZONE("Sun");
     glm::vec3 sunWorldPos = cameraPos + m_ctx->lightDir * 400.0f;
 
     // Enable depth test so sun is occluded by buildings, but don't write to depth buffer
@@ -422,13 +672,15 @@ inline void RenderPipeline::renderShadowMapDebug() {
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     glBindVertexArray(0);
 
-    // Restore viewport
-    glViewport(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+    // Restore viewport (drawn on the presented image)
+    glViewport(0, 0, m_outputWidth, m_outputHeight);
     glEnable(GL_DEPTH_TEST);
 }
 
 inline void RenderPipeline::renderSnow(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& playerPos) {
     if (!m_ctx->snowShader || m_ctx->snowVAO == 0 || m_ctx->snowParticleCount == 0) return;
+    GPU_PROFILE_SCOPE("Snow particles");
+    CPU_PROFILE_ZONE("Snow particles");
 
     glEnable(GL_DEPTH_TEST);
     glDepthMask(GL_FALSE);
@@ -457,6 +709,8 @@ inline void RenderPipeline::renderSnow(const glm::mat4& view, const glm::mat4& p
 inline void RenderPipeline::renderDangerZones(const glm::mat4& view, const glm::mat4& projection,
                                                const std::vector<glm::vec3>& monsterPositions, float radius) {
     if (!m_ctx->dangerZoneShader || m_ctx->dangerZoneVAO == 0 || monsterPositions.empty()) return;
+    GPU_PROFILE_SCOPE("Danger zones");
+    CPU_PROFILE_ZONE("Danger zones");
 
     glEnable(GL_DEPTH_TEST);
     glDepthMask(GL_FALSE);
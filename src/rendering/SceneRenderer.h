@@ -5,6 +5,7 @@
 #include "../ecs/Registry.h"
 #include "../ecs/systems/RenderSystem.h"
 #include "../Shader.h"
+#include "MeshUniforms.h"
 #include "../DebugRenderer.h"
 #include "../core/GameConfig.h"
 #include "../core/GameState.h"
@@ -33,8 +34,8 @@ public:
         GLuint brickNormalMap = 0;
         GLuint shadowDepthTexture = 0;
 
-        // VAOs
-        GLuint planeVAO = 0;
+        // Meshes
+        Mesh* groundMesh = nullptr;
         GLuint overlayVAO = 0;
         GLuint sunVAO = 0;
 
@@ -126,7 +127,7 @@ public:
         RenderHelpers::renderGroundPlane(*m_config.groundShader, params.view, params.projection,
             lightSpaceMatrix, m_config.lightDir, params.cameraPos,
             params.gameState->fogEnabled, true, m_config.snowTexture,
-            m_config.shadowDepthTexture, m_config.planeVAO);
+            m_config.shadowDepthTexture, *m_config.groundMesh);
 
         // Render sun billboard
         renderSun(params);
@@ -164,12 +165,13 @@ private:
         // Render FING building to shadow map
         if (params.fingBuilding != NULL_ENTITY) {
             auto* t = params.registry->getTransform(params.fingBuilding);
-            auto* mg = params.registry->getMeshGroup(params.fingBuilding);
+            auto* mg = params.registry->getRenderMeshGroup(params.fingBuilding);
             if (t && mg) {
                 m_config.depthShader->use();
                 m_config.depthShader->setMat4("uLightSpaceMatrix", lightSpaceMatrix);
                 m_config.depthShader->setMat4("uModel", t->matrix());
                 for (const auto& mesh : mg->meshes) {
+                    setMeshPositionDequant(*m_config.depthShader, mesh);
                     glBindVertexArray(mesh.vao);
                     glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr);
                 }
@@ -257,6 +259,7 @@ private:
                 m_config.cometShader->setInt("uHasTexture", 0);
             }
 
+            setMeshPositionDequant(*m_config.cometShader, mesh);
             glBindVertexArray(mesh.vao);
             glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr,
                                      m_config.numComets);
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "../Shader.h"
+#include "../ecs/components/Mesh.h"
+#include "../ecs/components/VertexAnimation.h"
+#include "../core/CpuProfiler.h"
+
+// Instance data for one vertex-animated entity
+struct VertexAnimationInstance {
+    glm::mat4 model;
+    glm::mat4 prevModel;   // Last frame's model matrix (velocity buffer)
+    int32_t clip;
+    float time;            // Clip time, looped in the shader
+    float prevTime;        // Last frame's clip time
+    float pad;
+};
+static_assert(sizeof(VertexAnimationInstance) == 144, "VertexAnimationInstance layout");
+
+// Draws far-away crowd members from their baked vertex animation frames
+// (vertex_animation.vert): instances are batched per mesh group (model or LOD
+// level) and each batch is one instanced draw per mesh, with no skeleton or
+// bone upload. The caller sets the view and lighting uniforms.
+class VertexAnimationRenderer {
+public:
+    VertexAnimationRenderer() = default;
+    ~VertexAnimationRenderer() {
+        cleanup();
+    }
+
+    VertexAnimationRenderer(const VertexAnimationRenderer&) = delete;
+    VertexAnimationRenderer& operator=(const VertexAnimationRenderer&) = delete;
+
+    void cleanup() {
+        if (m_instanceBuffer) {
+            glDeleteBuffers(1, &m_instanceBuffer);
+            m_instanceBuffer = 0;
+            m_capacity = 0;
+        }
+    }
+
+    // Clear instances for new frame
+    void beginFrame() {
+        m_batches.clear();
+        m_batchIndex.clear();
+        m_instanceCount = 0;
+    }
+
+    // Queue one entity. Returns false (nothing queued) if the set has no
+    // frames for the clip or does not match the meshes.
+    bool addInstance(const MeshGroup& meshGroup, const VertexAnimationSet& set, const glm::mat4& model,
+                     const glm::mat4& prevModel, int clip, float time, float prevTime) {
+        if (clip < 0 || clip >= static_cast<int>(set.clips.size()) || clip >= MAX_VERTEX_ANIMATION_CLIPS) return false;
+        if (!set.covers(meshGroup)) return false;
+
+        auto it = m_batchIndex.find(&meshGroup);
+        if (it == m_batchIndex.end()) {
+            it = m_batchIndex.emplace(&meshGroup, m_batches.size()).first;
+            m_batches.push_back({&meshGroup, &set, {}});
+        }
+        Batch& batch = m_batches[it->second];
+        if (batch.set != &set) return false;
+
+        VertexAnimationInstance instance;
+        instance.model = model;
+        instance.prevModel = prevModel;
+        instance.clip = clip;
+        instance.time = time;
+        instance.prevTime = prevTime;
+        instance.pad = 0.0f;
+        batch.instances.push_back(instance);
+        ++m_instanceCount;
+        return true;
+    }
+
+    // Upload every batch and draw it with `shader` (vertex_animation.vert or
+    // vertex_animation_depth.vert). `materials` binds each mesh's texture and
+    // normal map for the lit pass.
+    void draw(const Shader& shader, bool materials) {
+        CPU_PROFILE_ZONE("VertexAnimationRenderer::draw");
+        if (m_instanceCount == 0) return;
+
+        // All batches back to back in one buffer
+        m_upload.clear();
+        m_upload.reserve(m_instanceCount);
+        for (const Batch& batch : m_batches) {
+            m_upload.insert(m_upload.end(), batch.instances.begin(), batch.instances.end());
+        }
+        if (m_upload.size() > m_capacity) {
+            if (!m_instanceBuffer) glCreateBuffers(1, &m_instanceBuffer);
+            m_capacity = m_upload.size() * 2;
+            glNamedBufferData(m_instanceBuffer, m_capacity * sizeof(VertexAnimationInstance), nullptr, GL_DYNAMIC_DRAW);
+        }
+        glNamedBufferSubData(m_instanceBuffer, 0, m_upload.size() * sizeof(VertexAnimationInstance), m_upload.data());
+
+        shader.use();
+        shader.setInt("uVertexAnimation", 3);
+
+        size_t first = 0;
+        for (const Batch& batch : m_batches) {
+            std::vector<glm::vec4> clips(MAX_VERTEX_ANIMATION_CLIPS, glm::vec4(0.0f));
+            for (size_t c = 0; c < batch.set->clips.size() && c < clips.size(); ++c) {
+                const VertexAnimationClip& clip = batch.set->clips[c];
+                clips[c] = glm::vec4(float(clip.firstFrame), float(clip.frameCount), clip.duration, 0.0f);
+            }
+            shader.setVec4Array("uVertexAnimationClips", clips);
+
+            for (size_t m = 0; m < batch.meshGroup->meshes.size(); ++m) {
+                const Mesh& mesh = batch.meshGroup->meshes[m];
+                const VertexAnimationTexture& frames = batch.set->meshes[m];
+
+                glActiveTexture(GL_TEXTURE3);
+                glBindTexture(GL_TEXTURE_BUFFER, frames.texture);
+                shader.setInt("uVertexCount", static_cast<int>(frames.vertexCount));
+                shader.setVec3("uAnimPositionOffset", frames.positionOffset);
+                shader.setVec3("uAnimPositionScale", frames.positionScale);  // Instead of the mesh's bind-pose dequantization
+
+                if (materials) {
+                    if (mesh.texture) {
+                        glActiveTexture(GL_TEXTURE0);
+                        glBindTexture(GL_TEXTURE_2D, mesh.texture);
+                    }
+                    shader.setInt("uHasTexture", mesh.texture ? 1 : 0);
+                    if (mesh.normalMap) {
+                        glActiveTexture(GL_TEXTURE2);
+                        glBindTexture(GL_TEXTURE_2D, mesh.normalMap);
+                        shader.setInt("uNormalMap", 2);
+                        shader.setInt("uHasNormalMap", 1);
+                    } else {
+                        shader.setInt("uHasNormalMap", 0);
+                    }
+                }
+
+                glBindVertexArray(mesh.vao);
+                bindInstanceAttributes(first);
+                glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, mesh.indexType,
+                                        nullptr, static_cast<GLsizei>(batch.instances.size()));
+                unbindInstanceAttributes();
+            }
+            first += batch.instances.size();
+        }
+
+        glBindVertexArray(0);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    size_t getInstanceCount() const { return m_instanceCount; }
+    size_t getBatchCount() const { return m_batches.size(); }
+
+private:
+    struct Batch {
+        const MeshGroup* meshGroup;
+        const VertexAnimationSet* set;
+        std::vector<VertexAnimationInstance> instances;
+    };
+
+    // Attribute locations after the vertex format (0-4)
+    static constexpr GLuint MODEL_ATTRIB = 5;       // 5-8
+    static constexpr GLuint PREV_MODEL_ATTRIB = 9;  // 9-12
+    static constexpr GLuint CLIP_ATTRIB = 13;
+    static constexpr GLuint TIME_ATTRIB = 14;       // time, prevTime
+
+    void bindInstanceAttributes(size_t first) {
+        const GLsizei stride = sizeof(VertexAnimationInstance);
+        const size_t base = first * sizeof(VertexAnimationInstance);
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+        for (GLuint i = 0; i < 4; ++i) {
+            glEnableVertexAttribArray(MODEL_ATTRIB + i);
+            glVertexAttribPointer(MODEL_ATTRIB + i, 4, GL_FLOAT, GL_FALSE, stride,
+                                  (void*)(base + offsetof(VertexAnimationInstance, model) + sizeof(glm::vec4) * i));
+            glVertexAttribDivisor(MODEL_ATTRIB + i, 1);
+
+            glEnableVertexAttribArray(PREV_MODEL_ATTRIB + i);
+            glVertexAttribPointer(PREV_MODEL_ATTRIB + i, 4, GL_FLOAT, GL_FALSE, stride,
+                                  (void*)(base + offsetof(VertexAnimationInstance, prevModel) + sizeof(glm::vec4) * i));
+            glVertexAttribDivisor(PREV_MODEL_ATTRIB + i, 1);
+        }
+        glEnableVertexAttribArray(CLIP_ATTRIB);
+        glVertexAttribIPointer(CLIP_ATTRIB, 1, GL_INT, stride, (void*)(base + offsetof(VertexAnimationInstance, clip)));
+        glVertexAttribDivisor(CLIP_ATTRIB, 1);
+        glEnableVertexAttribArray(TIME_ATTRIB);
+        glVertexAttribPointer(TIME_ATTRIB, 2, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(VertexAnimationInstance, time)));
+        glVertexAttribDivisor(TIME_ATTRIB, 1);
+    }
+
+    void unbindInstanceAttributes() {
+        for (GLuint attrib = MODEL_ATTRIB; attrib <= TIME_ATTRIB; ++attrib) {
+            glVertexAttribDivisor(attrib, 0);
+            glDisableVertexAttribArray(attrib);
+        }
+    }
+
+    GLuint m_instanceBuffer = 0;
+    size_t m_capacity = 0;  // Instances the buffer holds
+    size_t m_instanceCount = 0;
+    std::vector<Batch> m_batches;
+    std::unordered_map<const MeshGroup*, size_t> m_batchIndex;
+    std::vector<VertexAnimationInstance> m_upload;
+};
@@ -19,4 +19,11 @@ public:
 
     // Called when transitioning AWAY from this scene
     virtual void onExit(SceneContext& ctx) = 0;
+
+    // Static screens may let the main loop throttle after a period without input
+    virtual bool allowsIdleThrottle() const { return false; }
+
+    // Scenes that show the previous scene's last frame as a still background;
+    // the scene manager has that frame captured before switching
+    virtual bool wantsFrozenBackground() const { return false; }
 };
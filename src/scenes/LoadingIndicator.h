@@ -0,0 +1,32 @@
+#pragma once
+#include "SceneContext.h"
+#include "../ecs/Registry.h"
+#include "../ecs/systems/UISystem.h"
+#include "../core/AssetManager.h"
+#include <string>
+
+// "LOADING n%" line for the scenes that run while models stream in
+// (main menu, intro text). Hidden once every model is resident.
+inline void updateLoadingIndicator(SceneContext& ctx) {
+    auto* text = ctx.registry->getUIText(ctx.loadingText);
+    if (!text || !ctx.assetManager) return;
+
+    bool loading = !ctx.assetManager->streamingFinished();
+    std::string label = text->text;
+    if (loading) {
+        label = "LOADING " + std::to_string(static_cast<int>(ctx.assetManager->streamingProgress() * 100.0f)) + "%";
+    }
+    if (text->visible != loading || text->text != label) {
+        text->visible = loading;
+        text->text = label;
+        ctx.uiSystem->clearCache();
+    }
+}
+
+inline void hideLoadingIndicator(SceneContext& ctx) {
+    auto* text = ctx.registry->getUIText(ctx.loadingText);
+    if (text && text->visible) {
+        text->visible = false;
+        ctx.uiSystem->clearCache();
+    }
+}
@@ -5,6 +5,9 @@
 #include "../ecs/Registry.h"
 #include "../ecs/systems/RenderSystem.h"
 #include "../Shader.h"
+#include "../rendering/GpuProfiler.h"
+#include "../rendering/MeshUniforms.h"
+#include "../core/CpuProfiler.h"
 #include "../DebugRenderer.h"
 #include "../core/GameConfig.h"
 #include "../core/GameState.h"
@@ -30,9 +33,11 @@ inline void renderGroundPlane(Shader& groundShader,
                               const glm::vec3& lightDir, const glm::vec3& viewPos,
                               bool fogEnabled, bool shadowsEnabled,
                               GLuint snowTexture, GLuint shadowDepthTexture,
-                              GLuint planeVAO,
+                              const Mesh& groundMesh,
                               float fogDensity = -1.0f,  // -1 means use shader default
                               const glm::vec3& fogColor = glm::vec3(-1.0f)) {
+    GPU_PROFILE_SCOPE("Ground");
+    CPU_PROFILE_ZONE("Ground");
     groundShader.use();
     groundShader.setMat4("uView", view);
     groundShader.setMat4("uProjection", projection);
@@ -59,15 +64,18 @@ inline void renderGroundPlane(Shader& groundShader,
     glBindTexture(GL_TEXTURE_2D, shadowDepthTexture);
     groundShader.setInt("uShadowMap", 1);
 
-    glBindVertexArray(planeVAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr);
+    setMeshPositionDequant(groundShader, groundMesh);
+    glBindVertexArray(groundMesh.vao);
+    glDrawElements(GL_TRIANGLES, groundMesh.indexCount, groundMesh.indexType, nullptr);
     glBindVertexArray(0);
 }
 
-// Render snow overlay effect
+// Render snow overlay effect (width/height: size of the bound render target)
 inline void renderSnowOverlay(Shader& overlayShader, GLuint overlayVAO,
-                              const GameState& gameState) {
+                              const GameState& gameState, int width, int height) {
     if (!gameState.snowEnabled) return;
+    GPU_PROFILE_SCOPE("Snow overlay");
+    CPU_PROFILE_ZONE("Snow overlay");
 
     glDisable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
@@ -75,7 +83,7 @@ inline void renderSnowOverlay(Shader& overlayShader, GLuint overlayVAO,
 
     overlayShader.use();
     overlayShader.setVec3("iResolution",
-        glm::vec3((float)GameConfig::WINDOW_WIDTH, (float)GameConfig::WINDOW_HEIGHT, 1.0f));
+        glm::vec3((float)width, (float)height, 1.0f));
     overlayShader.setFloat("iTime", gameState.gameTime);
     overlayShader.setFloat("uSnowSpeed", gameState.snowSpeed);
     overlayShader.setFloat("uSnowDirectionDeg", gameState.snowAngle);
@@ -89,27 +97,6 @@ inline void renderSnowOverlay(Shader& overlayShader, GLuint overlayVAO,
     glEnable(GL_DEPTH_TEST);
 }
 
-// Update FING building LOD based on distance
-inline void updateFingLOD(Registry& registry, GameState& gameState,
-                          Entity fingBuilding,
-                          const glm::vec3& viewerPos,
-                          MeshGroup& highDetail, MeshGroup& lowDetail,
-                          float lodSwitchDistance) {
-    auto* fingT = registry.getTransform(fingBuilding);
-    if (!fingT) return;
-
-    float dist = glm::length(viewerPos - fingT->position);
-    bool shouldUseHighDetail = dist < lodSwitchDistance;
-
-    if (shouldUseHighDetail != gameState.fingUsingHighDetail) {
-        gameState.fingUsingHighDetail = shouldUseHighDetail;
-        auto* meshGroup = registry.getMeshGroup(fingBuilding);
-        if (meshGroup) {
-            meshGroup->meshes = gameState.fingUsingHighDetail ? highDetail.meshes : lowDetail.meshes;
-        }
-    }
-}
-
 // Setup render system for shadow rendering
 inline void setupRenderSystem(RenderSystem& renderSystem,
                               bool fogEnabled, bool shadowsEnabled,
@@ -23,13 +23,18 @@ class PlayerMovementSystem;
 class CameraOrbitSystem;
 class FollowCameraSystem;
 class FreeCameraSystem;
+class LODSystem;
+class VertexAnimationSystem;
 class BuildingCuller;
 class Shader;
 class RenderPipeline;
 class MonsterManager;
+class AssetManager;
+class BenchmarkRecorder;
 struct AxisRenderer;
 struct Mesh;
 struct MeshGroup;
+struct LoadedModel;
 
 // All shared resources passed to scenes
 // Scenes should not own these - they're owned by main.cpp
@@ -45,6 +50,10 @@ struct SceneContext {
     float dt = 0.0f;
     float aspectRatio = 16.0f / 9.0f;
 
+    // Output (drawable) size in pixels, updated by RenderPipeline::setOutputSize
+    int screenWidth = 0;
+    int screenHeight = 0;
+
     // Systems
     RenderSystem* renderSystem = nullptr;
     UISystem* uiSystem = nullptr;
@@ -58,9 +67,12 @@ struct SceneContext {
     CameraOrbitSystem* cameraOrbitSystem = nullptr;
     FollowCameraSystem* followCameraSystem = nullptr;
     FreeCameraSystem* freeCameraSystem = nullptr;
+    LODSystem* lodSystem = nullptr;
+    VertexAnimationSystem* vertexAnimationSystem = nullptr;
 
     // Render pipeline
     RenderPipeline* renderPipeline = nullptr;
+    AssetManager* assetManager = nullptr;
 
     // Building culling
     BuildingCuller* buildingCuller = nullptr;
@@ -78,19 +90,21 @@ struct SceneContext {
     Shader* cometShader = nullptr;
     Shader* depthShader = nullptr;
     Shader* skinnedDepthShader = nullptr;
-    Shader* motionBlurShader = nullptr;
-    Shader* toonPostShader = nullptr;
+    Shader* vertexAnimationDepthShader = nullptr;  // Shadows of VertexAnimation entities (optional)
+    Shader* postProcessShader = nullptr;
+    Shader* velocityTileMaxShader = nullptr;
+    Shader* velocityNeighborMaxShader = nullptr;
+    Shader* frozenFrameShader = nullptr;
     Shader* blitShader = nullptr;
     Shader* snowShader = nullptr;
-    Shader* radialBlurShader = nullptr;
 
     // Textures
     GLuint snowTexture = 0;
     GLuint brickTexture = 0;
     GLuint brickNormalMap = 0;
 
-    // VAOs
-    GLuint planeVAO = 0;
+    // Meshes
+    Mesh* groundMesh = nullptr;
     GLuint overlayVAO = 0;
     GLuint sunVAO = 0;
 
@@ -104,8 +118,16 @@ struct SceneContext {
     GLuint motionBlurFBO = 0;
     GLuint motionBlurColorTex = 0;
     GLuint motionBlurDepthTex = 0;
-    GLuint toonFBO = 0;
-    GLuint toonColorTex = 0;
+    GLuint velocityFBO = 0;
+    GLuint velocityTex = 0;
+    GLuint tileMaxFBO = 0;
+    GLuint tileMaxTex = 0;
+    GLuint neighborMaxFBO = 0;
+    GLuint neighborMaxTex = 0;
+    GLuint frozenCaptureFBO = 0;
+    GLuint frozenCaptureTex = 0;
+    GLuint frozenFrameFBO = 0;
+    GLuint frozenFrameTex = 0;
 
     // Motion blur state
     glm::mat4* prevViewProjection = nullptr;
@@ -128,15 +150,16 @@ struct SceneContext {
     // Monster system
     MonsterManager* monsterManager = nullptr;
 
-    // FING building data for LOD and collision
-    MeshGroup* fingHighDetail = nullptr;
-    MeshGroup* fingLowDetail = nullptr;
+    // Frame timings for the benchmark scene
+    BenchmarkRecorder* benchmarkRecorder = nullptr;
+
+    // FING building data for collision
     glm::vec3 fingWorldCenter;
     glm::vec3 fingWorldHalfExtents;
-    float lodSwitchDistance = 0.0f;
 
     // Comet rendering data
-    MeshGroup* cometMeshGroup = nullptr;
+    LoadedModel* cometModel = nullptr;
+    const std::vector<glm::vec4>* cometInstances = nullptr;  // Start position (camera-relative) + time offset
     int numComets = 0;
     float cometFallSpeed = 0.0f;
     float cometCycleTime = 0.0f;
@@ -166,6 +189,7 @@ struct SceneContext {
     Entity menuOption3 = NULL_ENTITY;  // EXIT option
     Entity sprintHint = NULL_ENTITY;
     Entity godModeHint = NULL_ENTITY;
+    Entity loadingText = NULL_ENTITY;  // Asset streaming progress
 
     // Pause menu UI entities
     Entity pauseFogToggle = NULL_ENTITY;
@@ -1,6 +1,8 @@
 #pragma once
 #include "IScene.h"
 #include "SceneContext.h"
+#include "../rendering/RenderPipeline.h"
+#include "../core/CpuProfiler.h"
 #include <unordered_map>
 #include <memory>
 
@@ -12,7 +14,8 @@ enum class SceneType {
     GodMode,
     PauseMenu,
     DeathCinematic,  // Dramatic death sequence with motion blur
-    YouDied          // Death screen when monster catches player
+    YouDied,         // Death screen when monster catches player
+    Benchmark        // Camera-path benchmark (started from config / --benchmark)
 };
 
 class SceneManager {
@@ -47,6 +50,7 @@ public:
     // Process scene transitions and call lifecycle methods
     // Call this once per frame before scene update/render
     void processTransitions(SceneContext& ctx) {
+        CPU_PROFILE_ZONE("Scene transitions");
         if (m_sceneChangeRequested) {
             m_sceneChangeRequested = false;
 
@@ -69,8 +73,14 @@ public:
         }
     }
 
+    // Whether the main loop may cap the frame rate while idle
+    bool allowsIdleThrottle() const {
+        return m_currentScenePtr && m_currentScenePtr->allowsIdleThrottle();
+    }
+
     // Update current scene
     void update(SceneContext& ctx) {
+        CPU_PROFILE_ZONE("Scene update");
         if (m_currentScenePtr) {
             m_currentScenePtr->update(ctx);
         }
@@ -78,13 +88,24 @@ public:
 
     // Render current scene
     void render(SceneContext& ctx) {
+        CPU_PROFILE_ZONE("Scene render");
+        // Leaving for a scene that shows this one frozen: capture this frame
+        if (m_sceneChangeRequested && ctx.renderPipeline) {
+            auto it = m_scenes.find(m_nextScene);
+            if (it != m_scenes.end() && it->second->wantsFrozenBackground()) {
+                ctx.renderPipeline->requestFrameCapture();
+            }
+        }
+
         if (m_currentScenePtr) {
             m_currentScenePtr->render(ctx);
         }
     }
 
     // Force initial scene enter (call once after all scenes registered)
-    void initialize(SceneContext& ctx) {
+    void initialize(SceneContext& ctx, SceneType first = SceneType::MainMenu) {
+        m_currentScene = first;
+        m_previousScene = first;
         auto it = m_scenes.find(m_currentScene);
         m_currentScenePtr = (it != m_scenes.end()) ? it->second.get() : nullptr;
         if (m_currentScenePtr) {
@@ -0,0 +1,223 @@
+#pragma once
+#include "../IScene.h"
+#include "../SceneContext.h"
+#include "../SceneManager.h"
+#include "../RenderHelpers.h"
+#include "../../ecs/Registry.h"
+#include "../../ecs/systems/RenderSystem.h"
+#include "../../ecs/systems/UISystem.h"
+#include "../../ecs/systems/MinimapSystem.h"
+#include "../../ecs/systems/AnimationSystem.h"
+#include "../../ecs/systems/VertexAnimationSystem.h"
+#include "../../ecs/systems/SkeletonSystem.h"
+#include "../../ecs/systems/LODSystem.h"
+#include "../../systems/MonsterManager.h"
+#include "../../ecs/components/MonsterData.h"
+#include "../../core/BenchmarkRecorder.h"
+#include "../../core/GameState.h"
+#include "../../core/GameConfig.h"
+#include "../../culling/BuildingCuller.h"
+#include "../../rendering/RenderPipeline.h"
+#include "../../NurbsCurve.h"
+#include "../../Shader.h"
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Flies every configured camera path at every monster density and records
+// frame timings. Runs the gameplay render path (shadows, buildings, monsters,
+// danger zones, snow, post, minimap) with the main loop on a fixed timestep,
+// so the same build and settings always simulate the same frames.
+// ESC aborts and still writes the runs recorded so far.
+class BenchmarkScene : public IScene {
+public:
+    void onEnter(SceneContext& ctx) override {
+        ctx.inputSystem->captureMouse(false);
+
+        m_runs.clear();
+        for (const BenchmarkPath& path : GameConfig::BENCHMARK_PATHS) {
+            for (float density : GameConfig::BENCHMARK_DENSITIES) {
+                m_runs.push_back({&path, density});
+            }
+        }
+        m_runIndex = 0;
+
+        if (m_runs.empty()) {
+            std::cerr << "BenchmarkScene: No benchmark paths configured" << std::endl;
+            ctx.gameState->shouldQuit = true;
+            return;
+        }
+        startRun(ctx);
+    }
+
+    void update(SceneContext& ctx) override {
+        if (m_runIndex >= m_runs.size()) return;
+
+        if (ctx.input.escapePressed) {
+            std::cout << "Benchmark: aborted" << std::endl;
+            finish(ctx);
+            return;
+        }
+
+        const BenchmarkPath& path = *m_runs[m_runIndex].path;
+        m_time += ctx.dt;
+        if (m_time >= path.duration) {
+            ctx.benchmarkRecorder->endRun();
+            if (++m_runIndex >= m_runs.size()) {
+                finish(ctx);
+                return;
+            }
+            startRun(ctx);
+        }
+
+        // Constant-rate parameter (no easing) so every frame moves the same amount
+        const BenchmarkPath& current = *m_runs[m_runIndex].path;
+        float t = m_time / current.duration;
+        m_cameraPos = m_curve.evaluate(t);
+        glm::vec3 lookAt = current.hasLookAt ? current.lookAt : m_cameraPos + m_curve.tangent(t);
+        m_view = glm::lookAt(m_cameraPos, lookAt, glm::vec3(0.0f, 1.0f, 0.0f));
+
+        auto* camT = ctx.registry->getTransform(ctx.camera);
+        if (camT) {
+            camT->position = m_cameraPos;
+        }
+
+        ctx.vertexAnimationSystem->update(*ctx.registry);
+        ctx.animationSystem->update(*ctx.registry, ctx.dt);
+        ctx.skeletonSystem->update(*ctx.registry);
+
+        // Monsters treat the camera's ground position as the player (visibility + AI)
+        glm::vec3 groundPos(m_cameraPos.x, 0.0f, m_cameraPos.z);
+        if (ctx.monsterManager) {
+            ctx.monsterManager->update(ctx.dt, groundPos);
+        }
+
+        auto* cam = ctx.registry->getCamera(ctx.camera);
+        if (cam && ctx.renderPipeline) {
+            ctx.lodSystem->update(*ctx.registry, m_cameraPos, lodPixelScale(cam->fov, ctx.renderPipeline->renderHeight()), ctx.dt);
+        }
+    }
+
+    void render(SceneContext& ctx) override {
+        auto* cam = ctx.registry->getCamera(ctx.camera);
+        if (!cam || m_runIndex >= m_runs.size()) return;
+
+        glm::mat4 projection = cam->projectionMatrix(ctx.aspectRatio);
+
+        // Update building culling
+        ctx.buildingCuller->update(m_view, projection, m_cameraPos, ctx.buildingMaxRenderDistance);
+
+        // === SHADOW PASS ===
+        glm::mat4 lightSpaceMatrix = RenderHelpers::computeLightSpaceMatrix(m_cameraPos, ctx.lightDir);
+
+        ctx.renderPipeline->beginShadowPass();
+        ctx.renderPipeline->renderShadowCasters(lightSpaceMatrix, m_cameraPos);
+        ctx.renderPipeline->endShadowPass();
+
+        // === MAIN RENDER PASS ===
+        ctx.renderPipeline->beginMainPass();
+
+        RenderHelpers::setupRenderSystem(*ctx.renderSystem, ctx.gameState->fogEnabled, true,
+                                          ctx.shadowDepthTexture, lightSpaceMatrix);
+        ctx.renderSystem->setFogDensity(GameConfig::FOG_DENSITY);
+        ctx.renderSystem->setFogColor(GameConfig::FOG_COLOR);
+        ctx.renderSystem->updateWithView(*ctx.registry, ctx.aspectRatio, m_view);
+
+        BuildingRenderParams params;
+        params.view = m_view;
+        params.projection = projection;
+        params.lightSpaceMatrix = lightSpaceMatrix;
+        params.lightDir = ctx.lightDir;
+        params.viewPos = m_cameraPos;
+        params.texture = ctx.brickTexture;
+        params.normalMap = ctx.brickNormalMap;
+        params.shadowMap = ctx.shadowDepthTexture;
+        params.textureScale = GameConfig::BUILDING_TEXTURE_SCALE;
+        params.fogEnabled = ctx.gameState->fogEnabled;
+        params.shadowsEnabled = true;
+        params.fogColor = GameConfig::FOG_COLOR;
+        params.fogDensity = GameConfig::FOG_DENSITY;
+        ctx.renderPipeline->renderBuildings(params);
+
+        RenderHelpers::renderGroundPlane(*ctx.groundShader, m_view, projection, lightSpaceMatrix,
+            ctx.lightDir, m_cameraPos, ctx.gameState->fogEnabled, true,
+            ctx.snowTexture, ctx.shadowDepthTexture, *ctx.groundMesh,
+            GameConfig::FOG_DENSITY, GameConfig::FOG_COLOR);
+
+        std::vector<glm::vec3> monsterPositions;
+        if (ctx.monsterManager) {
+            monsterPositions = ctx.monsterManager->getPositions();
+            ctx.renderPipeline->renderDangerZones(m_view, projection, monsterPositions, MonsterData::DETECTION_RADIUS);
+        }
+
+        ctx.renderPipeline->renderSun(m_view, projection, m_cameraPos);
+        ctx.renderPipeline->renderComets(m_view, projection, m_cameraPos);
+        ctx.renderPipeline->renderSnow(m_view, projection, m_cameraPos);
+
+        RenderHelpers::renderSnowOverlay(*ctx.overlayShader, ctx.overlayVAO, *ctx.gameState,
+            ctx.renderPipeline->renderWidth(), ctx.renderPipeline->renderHeight());
+
+        // === RESOLVE + POST-PROCESSING (writes to screen) ===
+        PostProcessParams post;
+        post.toon = ctx.gameState->toonShadingEnabled;
+        ctx.renderPipeline->resolveAndPostProcess(post);
+
+        // Minimap heading from the view direction (FacingDirection convention)
+        glm::vec3 forward = -glm::vec3(m_view[0][2], m_view[1][2], m_view[2][2]);
+        float yaw = glm::degrees(std::atan2(-forward.x, -forward.z));
+
+        std::vector<glm::vec3> minimapMarkers;
+        auto* fingBuildingT = ctx.registry->getTransform(ctx.fingBuilding);
+        if (fingBuildingT) {
+            minimapMarkers.push_back(fingBuildingT->position);
+        }
+        ctx.minimapSystem->render(ctx.screenWidth, ctx.screenHeight, yaw,
+            ctx.uiSystem->fonts(), ctx.uiSystem->textCache(), m_cameraPos,
+            minimapMarkers, *ctx.buildingFootprints, monsterPositions);
+
+        ctx.uiSystem->update(*ctx.registry, ctx.screenWidth, ctx.screenHeight);
+    }
+
+    void onExit(SceneContext& ctx) override {
+        // Nothing special needed
+    }
+
+private:
+    struct Run {
+        const BenchmarkPath* path;
+        float density;
+    };
+
+    std::vector<Run> m_runs;
+    size_t m_runIndex = 0;
+    NurbsCurve m_curve;
+    float m_time = 0.0f;
+    glm::vec3 m_cameraPos = glm::vec3(0.0f);
+    glm::mat4 m_view = glm::mat4(1.0f);
+
+    // Same seed and start time for every run, so runs differ only in path and density
+    void startRun(SceneContext& ctx) {
+        const Run& run = m_runs[m_runIndex];
+        std::cout << "Benchmark: " << run.path->name << " @ density " << run.density << std::endl;
+
+        m_curve.setControlPoints(run.path->points);
+        m_time = 0.0f;
+        ctx.gameState->gameTime = 0.0f;
+
+        if (ctx.monsterManager) {
+            ctx.monsterManager->despawnAll();
+            ctx.monsterManager->spawnAll(run.density, GameConfig::BENCHMARK_SEED);
+        }
+
+        ctx.benchmarkRecorder->beginRun(run.path->name, run.density, GameConfig::BENCHMARK_WARMUP_FRAMES);
+    }
+
+    void finish(SceneContext& ctx) {
+        ctx.benchmarkRecorder->endRun();
+        ctx.benchmarkRecorder->writeReport(GameConfig::BENCHMARK_OUTPUT);
+        m_runIndex = m_runs.size();
+        ctx.gameState->shouldQuit = true;
+    }
+};
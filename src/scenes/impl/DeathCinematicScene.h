@@ -5,6 +5,7 @@
 #include "../RenderHelpers.h"
 #include "../../ecs/Registry.h"
 #include "../../ecs/systems/AnimationSystem.h"
+#include "../../ecs/systems/VertexAnimationSystem.h"
 #include "../../ecs/systems/SkeletonSystem.h"
 #include "../../ecs/systems/FollowCameraSystem.h"
 #include "../../ecs/systems/RenderSystem.h"
@@ -62,6 +63,7 @@ public:
         }
 
         // Update animations in slow motion for dramatic effect
+        ctx.vertexAnimationSystem->update(*ctx.registry);
         ctx.animationSystem->update(*ctx.registry, slowDt);
         ctx.skeletonSystem->update(*ctx.registry);
     }
@@ -129,7 +131,7 @@ public:
         // Render ground plane
         RenderHelpers::renderGroundPlane(*ctx.groundShader, view, projection, lightSpaceMatrix,
             ctx.lightDir, cameraPos, ctx.gameState->fogEnabled, true,
-            ctx.snowTexture, ctx.shadowDepthTexture, ctx.planeVAO,
+            ctx.snowTexture, ctx.shadowDepthTexture, *ctx.groundMesh,
             GameConfig::FOG_DENSITY, GameConfig::FOG_COLOR);
 
         // Render monster danger zones
@@ -150,13 +152,14 @@ public:
         }
 
         // Render snow overlay
-        RenderHelpers::renderSnowOverlay(*ctx.overlayShader, ctx.overlayVAO, *ctx.gameState);
-
-        // === RADIAL BLUR POST-PROCESS (dramatic tunnel vision effect) ===
-        ctx.renderPipeline->applyRadialBlur(DEATH_BLUR_STRENGTH);
-
-        // === FINAL RESOLVE AND BLIT ===
-        ctx.renderPipeline->finalResolveAndBlit();
+        RenderHelpers::renderSnowOverlay(*ctx.overlayShader, ctx.overlayVAO, *ctx.gameState,
+            ctx.renderPipeline->renderWidth(), ctx.renderPipeline->renderHeight());
+
+        // === RESOLVE + RADIAL BLUR (dramatic tunnel vision effect) ===
+        PostProcessParams post;
+        post.radialBlur = true;
+        post.radialBlurStrength = DEATH_BLUR_STRENGTH;
+        ctx.renderPipeline->resolveAndPostProcess(post);
     }
 
     void onExit(SceneContext& ctx) override {
@@ -9,7 +9,9 @@
 #include "../../ecs/systems/MinimapSystem.h"
 #include "../../ecs/systems/FreeCameraSystem.h"
 #include "../../ecs/systems/AnimationSystem.h"
+#include "../../ecs/systems/VertexAnimationSystem.h"
 #include "../../ecs/systems/SkeletonSystem.h"
+#include "../../ecs/systems/LODSystem.h"
 #include "../../core/GameState.h"
 #include "../../core/GameConfig.h"
 #include "../../culling/BuildingCuller.h"
@@ -70,6 +72,7 @@ public:
         }
 
         // Update animations
+        ctx.vertexAnimationSystem->update(*ctx.registry);
         ctx.animationSystem->update(*ctx.registry, ctx.dt);
         ctx.skeletonSystem->update(*ctx.registry);
 
@@ -99,11 +102,11 @@ public:
             }
         }
 
-        // LOD update based on camera distance
+        // LOD update based on projected size from the camera
+        auto* cam = ctx.registry->getCamera(ctx.camera);
         auto* camT = ctx.registry->getTransform(ctx.camera);
-        if (camT && ctx.fingHighDetail && ctx.fingLowDetail) {
-            RenderHelpers::updateFingLOD(*ctx.registry, *ctx.gameState, ctx.fingBuilding,
-                camT->position, *ctx.fingHighDetail, *ctx.fingLowDetail, ctx.lodSwitchDistance);
+        if (cam && camT && ctx.renderPipeline) {
+            ctx.lodSystem->update(*ctx.registry, camT->position, lodPixelScale(cam->fov, ctx.renderPipeline->renderHeight()), ctx.dt);
         }
     }
 
@@ -127,7 +130,7 @@ public:
         ctx.renderPipeline->endShadowPass();
 
         // === MAIN RENDER PASS ===
-        ctx.renderPipeline->beginMainPass(ctx.gameState->toonShadingEnabled);
+        ctx.renderPipeline->beginMainPass();
 
         // Debug axes
         if (GameConfig::SHOW_AXES && ctx.axes) {
@@ -147,7 +150,7 @@ public:
         // Render ground plane with shadows
         RenderHelpers::renderGroundPlane(*ctx.groundShader, view, projection, lightSpaceMatrix,
             ctx.lightDir, cameraPos, ctx.gameState->fogEnabled, true,
-            ctx.snowTexture, ctx.shadowDepthTexture, ctx.planeVAO,
+            ctx.snowTexture, ctx.shadowDepthTexture, *ctx.groundMesh,
             GameConfig::FOG_DENSITY, GameConfig::FOG_COLOR);
 
         // Render buildings with shadows
@@ -179,19 +182,16 @@ public:
             ctx.renderPipeline->renderSnow(view, projection, protagonistT->position);
         }
 
-        // === TOON POST-PROCESSING ===
-        if (ctx.gameState->toonShadingEnabled) {
-            ctx.renderPipeline->applyToonPostProcess();
-        }
+        // === RESOLVE + POST-PROCESSING (writes to screen) ===
+        PostProcessParams post;
+        post.toon = ctx.gameState->toonShadingEnabled;
+        ctx.renderPipeline->resolveAndPostProcess(post);
 
         // Render minimap (simplified, no markers)
-        ctx.minimapSystem->render(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+        ctx.minimapSystem->render(ctx.screenWidth, ctx.screenHeight);
 
         // Render UI
-        ctx.uiSystem->update(*ctx.registry, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
-
-        // === FINAL RESOLVE AND BLIT ===
-        ctx.renderPipeline->finalResolveAndBlit();
+        ctx.uiSystem->update(*ctx.registry, ctx.screenWidth, ctx.screenHeight);
     }
 
     void onExit(SceneContext& ctx) override {
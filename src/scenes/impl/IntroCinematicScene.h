@@ -5,6 +5,7 @@
 #include "../RenderHelpers.h"
 #include "../../ecs/Registry.h"
 #include "../../ecs/systems/AnimationSystem.h"
+#include "../../ecs/systems/VertexAnimationSystem.h"
 #include "../../ecs/systems/SkeletonSystem.h"
 #include "../../ecs/systems/CinematicSystem.h"
 #include "../../ecs/systems/RenderSystem.h"
@@ -56,6 +57,7 @@ public:
         }
 
         // Update animations for visual effect
+        ctx.vertexAnimationSystem->update(*ctx.registry);
         ctx.animationSystem->update(*ctx.registry, ctx.dt);
         ctx.skeletonSystem->update(*ctx.registry);
     }
@@ -84,7 +86,7 @@ public:
         ctx.renderPipeline->endShadowPass();
 
         // === RENDER TO CINEMATIC MSAA FBO ===
-        ctx.renderPipeline->beginCinematicPass();
+        ctx.renderPipeline->beginCinematicPass(true);
 
         // Debug axes
         if (GameConfig::SHOW_AXES && cam && camT && ctx.axes) {
@@ -99,7 +101,9 @@ public:
                                           ctx.shadowDepthTexture, lightSpaceMatrix);
         ctx.renderSystem->setFogDensity(GameConfig::FOG_DENSITY);
         ctx.renderSystem->setFogColor(GameConfig::FOG_COLOR);
+        ctx.renderSystem->setVelocityEnabled(true);
         ctx.renderSystem->updateWithView(*ctx.registry, ctx.aspectRatio, cinematicView);
+        ctx.renderSystem->setVelocityEnabled(false);
 
         // Render buildings
         BuildingRenderParams params;
@@ -121,9 +125,12 @@ public:
         // Render ground plane
         RenderHelpers::renderGroundPlane(*ctx.groundShader, cinematicView, projection, lightSpaceMatrix,
             ctx.lightDir, cameraPos, ctx.gameState->fogEnabled, true,
-            ctx.snowTexture, ctx.shadowDepthTexture, ctx.planeVAO,
+            ctx.snowTexture, ctx.shadowDepthTexture, *ctx.groundMesh,
             GameConfig::FOG_DENSITY, GameConfig::FOG_COLOR);
 
+        // Blended effects keep the opaque velocity underneath
+        ctx.renderPipeline->beginTransparentPass();
+
         // Render sun
         ctx.renderPipeline->renderSun(cinematicView, projection, cameraPos);
 
@@ -136,14 +143,20 @@ public:
         }
 
         // Render snow overlay
-        RenderHelpers::renderSnowOverlay(*ctx.overlayShader, ctx.overlayVAO, *ctx.gameState);
-
-        // === MOTION BLUR POST-PROCESS ===
-        ctx.renderPipeline->applyMotionBlur(currentViewProjection,
-            *ctx.prevViewProjection, ctx.gameState->motionBlurInitialized);
-
-        // === FINAL RESOLVE AND BLIT ===
-        ctx.renderPipeline->finalResolveAndBlit();
+        RenderHelpers::renderSnowOverlay(*ctx.overlayShader, ctx.overlayVAO, *ctx.gameState,
+            ctx.renderPipeline->renderWidth(), ctx.renderPipeline->renderHeight());
+
+        // === RESOLVE + MOTION BLUR (writes to screen) ===
+        PostProcessParams post;
+        post.motionBlur = true;
+        post.viewProjection = currentViewProjection;
+        post.prevViewProjection = ctx.prevViewProjection;
+        post.motionBlurInitialized = &ctx.gameState->motionBlurInitialized;
+        if (cam) {
+            post.nearPlane = cam->nearPlane;
+            post.farPlane = cam->farPlane;
+        }
+        ctx.renderPipeline->resolveAndPostProcess(post);
     }
 
     void onExit(SceneContext& ctx) override {
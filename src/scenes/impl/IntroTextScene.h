@@ -6,6 +6,7 @@
 #include "../../ecs/systems/UISystem.h"
 #include "../../core/GameState.h"
 #include "../../core/GameConfig.h"
+#include "../LoadingIndicator.h"
 #include <glad/glad.h>
 
 class IntroTextScene : public IScene {
@@ -24,12 +25,19 @@ public:
                 }
             }
         }
+        m_waitingForAssets = false;
+        updateLoadingIndicator(ctx);
     }
 
     void update(SceneContext& ctx) override {
+        updateLoadingIndicator(ctx);
+        if (m_waitingForAssets) {
+            startCinematic(ctx);
+        }
+
         // Skip intro with Enter or Escape
         if (ctx.input.enterPressed || ctx.input.escapePressed) {
-            ctx.sceneManager->switchTo(SceneType::IntroCinematic);
+            startCinematic(ctx);
             return;
         }
 
@@ -77,7 +85,7 @@ public:
             // All text complete, wait a moment then transition
             ctx.gameState->introLinePauseTimer += ctx.dt;
             if (ctx.gameState->introLinePauseTimer >= 2.0f) {
-                ctx.sceneManager->switchTo(SceneType::IntroCinematic);
+                startCinematic(ctx);
             }
         }
     }
@@ -88,7 +96,7 @@ public:
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // Only render UI
-        ctx.uiSystem->update(*ctx.registry, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+        ctx.uiSystem->update(*ctx.registry, ctx.screenWidth, ctx.screenHeight);
     }
 
     void onExit(SceneContext& ctx) override {
@@ -101,5 +109,17 @@ public:
                 }
             }
         }
+        hideLoadingIndicator(ctx);
+    }
+
+private:
+    // The cinematic needs every model, so the intro holds on its last line until streaming is done
+    void startCinematic(SceneContext& ctx) {
+        m_waitingForAssets = !ctx.assetManager->streamingFinished();
+        if (!m_waitingForAssets) {
+            ctx.sceneManager->switchTo(SceneType::IntroCinematic);
+        }
     }
+
+    bool m_waitingForAssets = false;
 };
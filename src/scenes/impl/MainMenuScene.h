@@ -8,6 +8,7 @@
 #include "../../core/GameState.h"
 #include "../../core/GameConfig.h"
 #include "../RenderHelpers.h"
+#include "../LoadingIndicator.h"
 #include "../../rendering/RenderPipeline.h"
 #include "../../Shader.h"
 #include <glm/gtc/matrix_transform.hpp>
@@ -27,6 +28,11 @@ public:
 
         // Reset intro text state when entering main menu
         ctx.gameState->resetIntroText();
+
+        // Other scenes reuse the resolve target, so the cached backdrop is stale
+        m_backdropValid = false;
+        m_godModeRequested = false;
+        updateLoadingIndicator(ctx);
     }
 
     void update(SceneContext& ctx) override {
@@ -40,11 +46,19 @@ public:
             updateMenuColors(ctx);
         }
 
+        updateLoadingIndicator(ctx);
+
+        // God mode drops straight into the world, so it waits here for streaming to finish
+        if (m_godModeRequested && ctx.assetManager->streamingFinished()) {
+            ctx.sceneManager->switchTo(SceneType::GodMode);
+            m_godModeRequested = false;
+        }
+
         if (ctx.input.enterPressed) {
             if (ctx.gameState->menuSelection == 0) {
-                ctx.sceneManager->switchTo(SceneType::IntroText);
+                ctx.sceneManager->switchTo(SceneType::IntroText);  // Intro text covers the rest of the load
             } else if (ctx.gameState->menuSelection == 1) {
-                ctx.sceneManager->switchTo(SceneType::GodMode);
+                m_godModeRequested = true;
             } else {
                 // Exit the game
                 ctx.gameState->shouldQuit = true;
@@ -53,6 +67,64 @@ public:
     }
 
     void render(SceneContext& ctx) override {
+        // The backdrop is cached in the resolve target and only re-rendered at
+        // MENU_BACKDROP_FPS (or once when 0); the overlay and text go on top every frame
+        int w = ctx.renderPipeline->renderWidth();
+        int h = ctx.renderPipeline->renderHeight();
+        m_backdropAge += ctx.dt;
+        bool sizeChanged = (w != m_backdropWidth || h != m_backdropHeight);
+        bool due = GameConfig::MENU_BACKDROP_FPS > 0.0f && m_backdropAge >= 1.0f / GameConfig::MENU_BACKDROP_FPS;
+        bool modelsChanged = ctx.assetManager->residentGeneration() != m_backdropGeneration;  // Streamed-in models
+        if (!m_backdropValid || sizeChanged || due || modelsChanged) {
+            renderBackdrop(ctx);
+            m_backdropValid = true;
+            m_backdropAge = 0.0f;
+            m_backdropWidth = w;
+            m_backdropHeight = h;
+            m_backdropGeneration = ctx.assetManager->residentGeneration();
+        }
+        ctx.renderPipeline->presentResolved();
+
+        // Draw 85% black overlay
+        glDisable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        ctx.solidOverlayShader->use();
+        ctx.solidOverlayShader->setVec4("uColor", glm::vec4(0.0f, 0.0f, 0.0f, 0.85f));
+        glBindVertexArray(ctx.overlayVAO);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+        glEnable(GL_DEPTH_TEST);
+
+        // Render UI on top
+        ctx.uiSystem->update(*ctx.registry, ctx.screenWidth, ctx.screenHeight);
+    }
+
+    bool allowsIdleThrottle() const override { return true; }
+
+    void onExit(SceneContext& ctx) override {
+        // Hide menu UI
+        ctx.registry->getUIText(ctx.menuOption1)->visible = false;
+        ctx.registry->getUIText(ctx.menuOption2)->visible = false;
+        ctx.registry->getUIText(ctx.menuOption3)->visible = false;
+        hideLoadingIndicator(ctx);
+    }
+
+private:
+    const glm::vec4 m_colorSelected = glm::vec4(255.0f, 255.0f, 255.0f, 255.0f);
+    const glm::vec4 m_colorUnselected = glm::vec4(128.0f, 128.0f, 128.0f, 255.0f);
+
+    // Cached backdrop state
+    bool m_backdropValid = false;
+    float m_backdropAge = 0.0f;
+    int m_backdropWidth = 0;
+    int m_backdropHeight = 0;
+    uint32_t m_backdropGeneration = 0;
+
+    bool m_godModeRequested = false;
+
+    void renderBackdrop(SceneContext& ctx) {
         // Static camera backdrop
         const glm::vec3 menuCamPos = glm::vec3(-4.82f, 4.57f, 19.15f);
         const glm::vec3 menuCamLookAt = glm::vec3(-4.16f, 4.81f, 19.85f);
@@ -61,11 +133,8 @@ public:
         auto* cam = ctx.registry->getCamera(ctx.camera);
         glm::mat4 projection = cam ? cam->projectionMatrix(ctx.aspectRatio) : glm::mat4(1.0f);
 
-        // Clear with sky color (render directly to screen, no MSAA for menu)
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        glViewport(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
-        glClearColor(0.2f, 0.2f, 0.22f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        // Clears with sky color
+        ctx.renderPipeline->beginMainPass();
 
         // Render FING model with very low fog for menu backdrop
         constexpr float menuFogDensity = 0.002f;  // Much lower than normal game fog
@@ -75,44 +144,21 @@ public:
 
         // Render ground plane (no buildings, no shadows, low fog)
         RenderHelpers::renderGroundPlane(*ctx.groundShader, menuView, projection, glm::mat4(1.0f),
-            ctx.lightDir, menuCamPos, ctx.gameState->fogEnabled, false, ctx.snowTexture, 0, ctx.planeVAO,
+            ctx.lightDir, menuCamPos, ctx.gameState->fogEnabled, false, ctx.snowTexture, 0, *ctx.groundMesh,
             menuFogDensity);
 
         // Render snow overlay
-        RenderHelpers::renderSnowOverlay(*ctx.overlayShader, ctx.overlayVAO, *ctx.gameState);
+        RenderHelpers::renderSnowOverlay(*ctx.overlayShader, ctx.overlayVAO, *ctx.gameState,
+            ctx.renderPipeline->renderWidth(), ctx.renderPipeline->renderHeight());
 
         // Render falling comets (custom fall direction for menu backdrop)
         glm::vec3 menuCometFallDir = glm::normalize(glm::vec3(0.85f, -0.12f, 0.4f));
         glm::vec3 menuCometColor = glm::vec3(1.0f, 0.4f, 0.1f);
         ctx.renderPipeline->renderComets(menuView, projection, menuCamPos, menuCometFallDir, menuCometColor);
 
-        // Draw 85% black overlay
-        glDisable(GL_DEPTH_TEST);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-        ctx.solidOverlayShader->use();
-        ctx.solidOverlayShader->setVec4("uColor", glm::vec4(0.0f, 0.0f, 0.0f, 0.85f));
-        glBindVertexArray(ctx.overlayVAO);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-        glEnable(GL_DEPTH_TEST);
-
-        // Render UI on top
-        ctx.uiSystem->update(*ctx.registry, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
-    }
-
-    void onExit(SceneContext& ctx) override {
-        // Hide menu UI
-        ctx.registry->getUIText(ctx.menuOption1)->visible = false;
-        ctx.registry->getUIText(ctx.menuOption2)->visible = false;
-        ctx.registry->getUIText(ctx.menuOption3)->visible = false;
+        ctx.renderPipeline->resolveMainPass();
     }
 
-private:
-    const glm::vec4 m_colorSelected = glm::vec4(255.0f, 255.0f, 255.0f, 255.0f);
-    const glm::vec4 m_colorUnselected = glm::vec4(128.0f, 128.0f, 128.0f, 255.0f);
-
     void updateMenuColors(SceneContext& ctx) {
         auto* text1 = ctx.registry->getUIText(ctx.menuOption1);
         auto* text2 = ctx.registry->getUIText(ctx.menuOption2);
@@ -6,6 +6,7 @@
 #include "../../ecs/systems/UISystem.h"
 #include "../../core/GameState.h"
 #include "../../core/GameConfig.h"
+#include "../../rendering/RenderPipeline.h"
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <cstdio>
@@ -60,14 +61,21 @@ public:
     }
 
     void render(SceneContext& ctx) override {
-        // Clear with black
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        // Frozen gameplay frame (captured on pause), otherwise black
+        if (ctx.renderPipeline->hasFrozenFrame()) {
+            ctx.renderPipeline->presentFrozenFrame();
+        } else {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glViewport(0, 0, ctx.screenWidth, ctx.screenHeight);
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        }
 
-        // Only render UI
-        ctx.uiSystem->update(*ctx.registry, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+        ctx.uiSystem->update(*ctx.registry, ctx.screenWidth, ctx.screenHeight);
     }
 
+    bool wantsFrozenBackground() const override { return true; }
+
     void onExit(SceneContext& ctx) override {
         // Hide pause menu UI
         ctx.registry->getUIText(ctx.pauseFogToggle)->visible = false;
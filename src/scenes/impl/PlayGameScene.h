@@ -13,7 +13,9 @@
 #include "../../ecs/systems/PhysicsSystem.h"
 #include "../../ecs/systems/CollisionSystem.h"
 #include "../../ecs/systems/AnimationSystem.h"
+#include "../../ecs/systems/VertexAnimationSystem.h"
 #include "../../ecs/systems/SkeletonSystem.h"
+#include "../../ecs/systems/LODSystem.h"
 #include "../../systems/MonsterManager.h"
 #include "../../ecs/components/MonsterData.h"
 #include "../../core/GameState.h"
@@ -76,6 +78,7 @@ public:
 
         ctx.physicsSystem->update(*ctx.registry, ctx.dt);
         ctx.collisionSystem->update(*ctx.registry);
+        ctx.vertexAnimationSystem->update(*ctx.registry);
         ctx.animationSystem->update(*ctx.registry, ctx.dt);
         ctx.skeletonSystem->update(*ctx.registry);
 
@@ -93,9 +96,10 @@ public:
         }
 
         // LOD updates
-        if (protagonistT && ctx.fingHighDetail && ctx.fingLowDetail) {
-            RenderHelpers::updateFingLOD(*ctx.registry, *ctx.gameState, ctx.fingBuilding,
-                protagonistT->position, *ctx.fingHighDetail, *ctx.fingLowDetail, ctx.lodSwitchDistance);
+        auto* cam = ctx.registry->getCamera(ctx.camera);
+        auto* camT = ctx.registry->getTransform(ctx.camera);
+        if (cam && camT && ctx.renderPipeline) {
+            ctx.lodSystem->update(*ctx.registry, camT->position, lodPixelScale(cam->fov, ctx.renderPipeline->renderHeight()), ctx.dt);
         }
     }
 
@@ -130,7 +134,7 @@ public:
         ctx.renderPipeline->endShadowPass();
 
         // === MAIN RENDER PASS ===
-        ctx.renderPipeline->beginMainPass(ctx.gameState->toonShadingEnabled);
+        ctx.renderPipeline->beginMainPass();
 
         // Debug axes
         if (GameConfig::SHOW_AXES && cam && camT && ctx.axes) {
@@ -167,7 +171,7 @@ public:
         // Render ground plane
         RenderHelpers::renderGroundPlane(*ctx.groundShader, playView, projection, lightSpaceMatrix,
             ctx.lightDir, cameraPos, ctx.gameState->fogEnabled, true,
-            ctx.snowTexture, ctx.shadowDepthTexture, ctx.planeVAO,
+            ctx.snowTexture, ctx.shadowDepthTexture, *ctx.groundMesh,
             GameConfig::FOG_DENSITY, GameConfig::FOG_COLOR);
 
         // Render monster danger zones (red circles showing detection radius)
@@ -188,12 +192,13 @@ public:
         }
 
         // Render snow overlay
-        RenderHelpers::renderSnowOverlay(*ctx.overlayShader, ctx.overlayVAO, *ctx.gameState);
+        RenderHelpers::renderSnowOverlay(*ctx.overlayShader, ctx.overlayVAO, *ctx.gameState,
+            ctx.renderPipeline->renderWidth(), ctx.renderPipeline->renderHeight());
 
-        // === TOON POST-PROCESSING ===
-        if (ctx.gameState->toonShadingEnabled) {
-            ctx.renderPipeline->applyToonPostProcess();
-        }
+        // === RESOLVE + POST-PROCESSING (writes to screen) ===
+        PostProcessParams post;
+        post.toon = ctx.gameState->toonShadingEnabled;
+        ctx.renderPipeline->resolveAndPostProcess(post);
 
         // Render minimap
         std::vector<glm::vec3> minimapMarkers;
@@ -207,17 +212,14 @@ public:
             monsterPositions = ctx.monsterManager->getPositions();
         }
 
-        ctx.minimapSystem->render(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT,
+        ctx.minimapSystem->render(ctx.screenWidth, ctx.screenHeight,
             protagonistFacing ? protagonistFacing->yaw : 0.0f,
             ctx.uiSystem->fonts(), ctx.uiSystem->textCache(),
             protagonistT ? protagonistT->position : glm::vec3(0.0f),
             minimapMarkers, *ctx.buildingFootprints, monsterPositions);
 
         // Render UI
-        ctx.uiSystem->update(*ctx.registry, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
-
-        // === FINAL RESOLVE AND BLIT ===
-        ctx.renderPipeline->finalResolveAndBlit();
+        ctx.uiSystem->update(*ctx.registry, ctx.screenWidth, ctx.screenHeight);
 
         // === DEBUG: Shadow map visualization ===
         ctx.renderPipeline->renderShadowMapDebug();
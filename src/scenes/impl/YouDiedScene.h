@@ -32,12 +32,12 @@ public:
     void render(SceneContext& ctx) override {
         // Clear with black
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        glViewport(0, 0, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+        glViewport(0, 0, ctx.screenWidth, ctx.screenHeight);
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // Render UI (the YOU DIED text)
-        ctx.uiSystem->update(*ctx.registry, GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+        ctx.uiSystem->update(*ctx.registry, ctx.screenWidth, ctx.screenHeight);
     }
 
     void onExit(SceneContext& ctx) override {
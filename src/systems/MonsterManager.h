@@ -8,6 +8,8 @@
 #include "../ecs/components/FacingDirection.h"
 #include "../core/AssetManager.h"
 #include "../procedural/BuildingGenerator.h"
+#include "../core/CpuProfiler.h"
+#include "../rendering/LodSelection.h"
 #include <vector>
 #include <random>
 #include <cmath>
@@ -35,8 +37,12 @@ public:
         std::uniform_real_distribution<float> spawnChance(0.0f, 1.0f);
         std::uniform_int_distribution<int> streetDir(0, 1);  // 0 = X direction, 1 = Z direction
         std::uniform_real_distribution<float> streetOffset(-4.0f, 4.0f);  // Random offset within street
+        // Separate stream so walk-cycle offsets don't change the spawn layout
+        std::mt19937 animRng(seed + 1);
+        std::uniform_real_distribution<float> animStartTime(0.0f, 2.0f);
 
         LoadedModel& monsterModel = m_assetManager->getModel("monster");
+        const LevelOfDetail monsterLod = modelLevelOfDetail(monsterModel, GameConfig::LOD_ERROR_PIXELS);
 
         float offsetX = BuildingGenerator::getGridOffsetX();
         float offsetZ = BuildingGenerator::getGridOffsetZ();
@@ -80,7 +86,8 @@ public:
                     patrolEnd = glm::vec3(streetX + streetOffset(rng), 0.0f, endZ);
                 }
 
-                Entity monster = spawnMonster(monsterModel, patrolStart, patrolEnd, x, z);
+                float animStart = animStartTime(animRng);
+                Entity monster = spawnMonster(monsterModel, monsterLod, patrolStart, patrolEnd, x, z, animStart);
                 m_monsters.push_back(monster);
             }
         }
@@ -88,8 +95,17 @@ public:
         std::cout << "MonsterManager: Spawned " << m_monsters.size() << " monsters" << std::endl;
     }
 
+    // Remove all spawned monsters (e.g. before respawning at another density)
+    void despawnAll() {
+        for (Entity e : m_monsters) {
+            m_registry->destroy(e);
+        }
+        m_monsters.clear();
+    }
+
     // Update all monsters - returns true if player was caught
     UpdateResult update(float dt, const glm::vec3& playerPos) {
+        CPU_PROFILE_ZONE("MonsterManager");
         UpdateResult result;
 
         m_registry->forEachMonster([&](Entity entity, Transform& transform, MonsterData& data, Animation* anim) {
@@ -156,8 +172,11 @@ private:
     AssetManager* m_assetManager = nullptr;
     std::vector<Entity> m_monsters;
 
-    Entity spawnMonster(LoadedModel& model, const glm::vec3& patrolStart, const glm::vec3& patrolEnd,
-                        int gridX, int gridZ) {
+    // Everything large (meshes, joint hierarchy, clips) is shared with the model;
+    // the entity only gets handles and its own pose and playback state
+    Entity spawnMonster(const LoadedModel& model, const LevelOfDetail& lod,
+                        const glm::vec3& patrolStart, const glm::vec3& patrolEnd,
+                        int gridX, int gridZ, float animStart) {
         Entity monster = m_registry->create();
 
         // Transform - start at patrol midpoint
@@ -173,10 +192,8 @@ private:
 
         m_registry->addTransform(monster, transform);
 
-        // MeshGroup
-        MeshGroup meshGroup;
-        meshGroup.meshes = model.meshGroup.meshes;
-        m_registry->addMeshGroup(monster, std::move(meshGroup));
+        // Meshes: the model and its cooked LODs, referenced (LODSystem picks the level)
+        m_registry->addLevelOfDetail(monster, lod);
 
         // Renderable
         Renderable renderable;
@@ -189,18 +206,23 @@ private:
         facing.yaw = 0.0f;
         m_registry->addFacingDirection(monster, facing);
 
-        // Skeleton and Animation
+        // Skeleton and Animation: per-instance pose and playback over the model's shared data
         if (model.skeleton) {
-            Skeleton skeleton = *model.skeleton;
-            m_registry->addSkeleton(monster, std::move(skeleton));
+            m_registry->addSkeleton(monster, Skeleton(model.skeleton));
 
             Animation anim;
             anim.clipIndex = 0;
             anim.playing = true;
-            anim.time = static_cast<float>(std::rand() % 1000) / 1000.0f * 2.0f;  // Random start time
+            anim.time = animStart;
             anim.speedMultiplier = 1.0f;
-            anim.clips = model.clips;
+            anim.clipSet = model.clips;
+            anim.sharePose = true;  // Crowd: skinned with the pose of its clip phase
             m_registry->addAnimation(monster, anim);
+
+            // Drawn from the baked clips when far away (VertexAnimationSystem)
+            if (model.vertexAnimation) {
+                m_registry->addVertexAnimation(monster, VertexAnimation{model.vertexAnimation});
+            }
         }
 
         // MonsterData - patrol info
@@ -0,0 +1,141 @@
+// cook_assets - standalone asset cooker (no GL/SDL), for CI and Linux hosts.
+// Bakes every model in ModelManifest.h and texture in TextureManifest.h into an
+// AssetPack the game memory-maps at startup. Build and run from the repository root:
+//
+//   g++ -std=c++17 -O2 -pthread -Ilibraries/tinygltf -Ilibraries/glm -o cook_assets
+//       tools/cook_assets.cpp src/assets/AssetCooker.cpp src/assets/AssetPack.cpp
+//       src/assets/ModelDecoder.cpp src/assets/MeshOptimizer.cpp src/assets/MeshSimplifier.cpp
+//       src/assets/TextureCompressor.cpp src/assets/AnimationCompressor.cpp
+//       src/assets/VertexAnimationBaker.cpp
+//   ./cook_assets [--bc7 | --uncompressed] [--no-mesh-opt] [--no-lods] [--no-anim-compression]
+//                 [--no-vertex-animation] [assets/models.pack]
+//   ./cook_assets --self-test
+//
+// Textures default to BC1/BC3 (colour) and BC5 (normal maps); --bc7 switches
+// colour textures to BC7, --uncompressed stores RGB8/RGBA8. --no-mesh-opt keeps
+// index and vertex order as exported, --no-lods skips the simplified levels,
+// --no-anim-compression stores the source animation keys, --no-vertex-animation
+// skips baking crowd models' clips into per-vertex frames.
+// --self-test writes nothing: it runs verifyOptimizeMesh (MeshOptimizer.h) on
+// every mesh in ModelManifest.h plus a synthetic grid.
+// Exits non-zero if any asset fails to cook or the written pack does not validate
+// (or, with --self-test, if any mesh fails the check).
+
+#include "../src/assets/AssetCooker.h"
+#include "../src/assets/AssetPack.h"
+#include "../src/assets/MeshOptimizer.h"
+#include "../src/assets/ModelDecoder.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+
+// Flat n x n quad grid with rows of triangles in scanline order (a poor
+// vertex cache order) and 32-bit indices
+DecodedMesh gridMesh(uint32_t n) {
+    DecodedMesh mesh;
+    mesh.indexType = PACK_INDEX_UINT32;
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    for (uint32_t y = 0; y <= n; ++y) {
+        for (uint32_t x = 0; x <= n; ++x) positions.push_back(glm::vec3(float(x), 0.0f, float(y)));
+    }
+    for (uint32_t y = 0; y < n; ++y) {
+        for (uint32_t x = 0; x < n; ++x) {
+            uint32_t v = y * (n + 1) + x;
+            indices.insert(indices.end(), {v, v + n + 1, v + 1, v + 1, v + n + 1, v + n + 2});
+        }
+    }
+    mesh.positionScale = glm::vec3(float(n) / 65535.0f);
+    mesh.vertices.resize(positions.size() * sizeof(PackedVertex));
+    for (size_t v = 0; v < positions.size(); ++v) {
+        PackedVertex packed{};
+        packed.position[0] = static_cast<uint16_t>(positions[v].x / float(n) * 65535.0f);
+        packed.position[2] = static_cast<uint16_t>(positions[v].z / float(n) * 65535.0f);
+        std::memcpy(&mesh.vertices[v * sizeof(PackedVertex)], &packed, sizeof(packed));
+    }
+    mesh.indexCount = static_cast<uint32_t>(indices.size());
+    mesh.indexData = writeIndices(indices, mesh.indexType);
+    return mesh;
+}
+
+// MeshOptimizer on CPU only: triangle permutation, ACMR, determinism
+int selfTest() {
+    size_t meshes = 0, failures = 0;
+    auto check = [&](const std::string& name, const DecodedMesh& mesh) {
+        std::string error;
+        ++meshes;
+        if (!verifyOptimizeMesh(mesh, error)) {
+            std::cerr << "cook_assets: self-test " << name << ": " << error << std::endl;
+            ++failures;
+        }
+    };
+
+    check("grid", gridMesh(64));
+    for (const ModelSource& source : modelManifest()) {
+        DecodedModel model;
+        if (!decodeGLB(source.path, model)) {
+            std::cerr << "cook_assets: self-test could not decode " << source.path << std::endl;
+            ++failures;
+            continue;
+        }
+        for (size_t m = 0; m < model.meshes.size(); ++m) check(source.name + " mesh " + std::to_string(m), model.meshes[m]);
+    }
+    std::cout << "cook_assets: self-test " << (failures ? "FAILED" : "passed") << " (" << meshes << " meshes, "
+              << failures << " failures)" << std::endl;
+    return failures ? 1 : 0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    std::string outPath = "assets/models.pack";
+    CookOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--self-test") {
+            return selfTest();
+        } else if (arg == "--bc7") {
+            options.bc7 = true;
+        } else if (arg == "--uncompressed") {
+            options.compressTextures = false;
+        } else if (arg == "--no-mesh-opt") {
+            options.optimizeMeshes = false;
+        } else if (arg == "--no-lods") {
+            options.generateLods = false;
+        } else if (arg == "--no-anim-compression") {
+            options.compressAnimations = false;
+        } else if (arg == "--no-vertex-animation") {
+            options.bakeVertexAnimation = false;
+        } else {
+            outPath = arg;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = cookAssetPack(modelManifest(), textureManifest(), outPath, options);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "cook_assets: " << (ok ? "done" : "FAILED") << " in " << seconds << "s" << std::endl;
+    if (!ok) return 1;
+
+    // Every manifest entry must be present and match its source
+    AssetPack pack;
+    if (!pack.open(outPath)) return 1;
+    for (const ModelSource& source : modelManifest()) {
+        const PackModel* model = pack.findModel(source.name);
+        if (!model || !pack.isCurrent(*model, source.path)) {
+            std::cerr << "cook_assets: " << source.name << " missing or stale in " << outPath << std::endl;
+            return 1;
+        }
+    }
+    for (const TextureSource& source : textureManifest()) {
+        const PackNamedTexture* texture = pack.findTexture(source.name);
+        if (!texture || !pack.isCurrent(*texture, source.path)) {
+            std::cerr << "cook_assets: " << source.name << " missing or stale in " << outPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}